@@ -0,0 +1,314 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+// Startup cost of loading a level set from a packed archive against loose per-asset files. Run without arguments it
+// generates the level set, then measures each mode in a fresh child process so peak RSS is per mode. The files are
+// read once while generating, so both modes run against a warm page cache. No GPU is involved: a device upload is
+// stood in for by reading every byte of the data handed to it.
+
+#include "Asset/ArchiveWriter.hpp"
+#include "Asset/AssetArchive.hpp"
+#include "Core/Log.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <random>
+
+#if defined(ENGINE_PLATFORM_WINDOWS)
+    #include <psapi.h>
+#else
+    #include <sys/resource.h>
+#endif
+
+using namespace X;
+using namespace X::Core;
+using namespace X::Render;
+
+namespace {
+    namespace fs = std::filesystem;
+    using Clock  = std::chrono::steady_clock;
+
+    constexpr u32 kMeshes       = 48;
+    constexpr u32 kTextures     = 24;
+    constexpr u32 kShaders      = 16;
+    constexpr u32 kTextureSize  = 1024;
+    constexpr u32 kRuns         = 3;
+    constexpr const char* kPack = "Level.xpak";
+
+    u64 GetPeakResidentBytes() {
+#if defined(ENGINE_PLATFORM_WINDOWS)
+        PROCESS_MEMORY_COUNTERS counters {};
+        K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+        return counters.PeakWorkingSetSize;
+#else
+        rusage usage {};
+        getrusage(RUSAGE_SELF, &usage);
+    #if defined(ENGINE_PLATFORM_MACOS)
+        return CAST<u64>(usage.ru_maxrss);
+    #else
+        return CAST<u64>(usage.ru_maxrss) * 1024;
+    #endif
+#endif
+    }
+
+    // Stands in for the device copying an upload, so every byte is read once
+    u64 gChecksum = 0;
+    void Upload(const void* data, u64 size) {
+        const u8* bytes = CAST<const u8*>(data);
+        u64 sum         = 0;
+        for (u64 i = 0; i + 8 <= size; i += 8) {
+            u64 word;
+            std::memcpy(&word, bytes + i, 8);
+            sum += word;
+        }
+        gChecksum += sum;
+    }
+
+    MeshData MakeMesh(u32 rings, u32 segments) {
+        MeshData data;
+        for (u32 ring = 0; ring <= rings; ++ring) {
+            const f32 theta = 3.14159265f * CAST<f32>(ring) / rings;
+            for (u32 segment = 0; segment <= segments; ++segment) {
+                const f32 phi = 6.2831853f * CAST<f32>(segment) / segments;
+                const Vec3 normal(std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi));
+                data.positions.push_back(normal);
+                data.normals.push_back(normal);
+                data.tangents.emplace_back(-std::sin(phi), 0.0f, std::cos(phi), 1.0f);
+                data.uvs.emplace_back(CAST<f32>(segment) / segments, CAST<f32>(ring) / rings);
+            }
+        }
+        for (u32 ring = 0; ring < rings; ++ring) {
+            for (u32 segment = 0; segment < segments; ++segment) {
+                const u32 corner = ring * (segments + 1) + segment;
+                const u32 below  = corner + segments + 1;
+                for (const u32 index : {corner, corner + 1, below, corner + 1, below + 1, below}) {
+                    data.indices.push_back(index);
+                }
+            }
+        }
+        return data;
+    }
+
+    // Loose files hold the same GPU-ready data as the archive, section by section, as a per-asset loader would
+    // write them
+    template<typename T>
+    void WriteValue(std::ofstream& file, const T& value) {
+        file.write(RCAST<const char*>(&value), sizeof(T));
+    }
+
+    void WriteSection(std::ofstream& file, const void* data, u64 size) {
+        WriteValue(file, size);
+        file.write(CAST<const char*>(data), CAST<std::streamsize>(size));
+    }
+
+    template<typename T>
+    void ReadValue(std::ifstream& file, T& value) {
+        file.read(RCAST<char*>(&value), sizeof(T));
+    }
+
+    void ReadSection(std::ifstream& file, vector<u8>& data) {
+        u64 size = 0;
+        ReadValue(file, size);
+        data.resize(CAST<size_t>(size));
+        file.read(RCAST<char*>(data.data()), CAST<std::streamsize>(size));
+    }
+
+    bool Generate(const fs::path& directory) {
+        fs::create_directories(directory);
+        Asset::ArchiveWriter writer;
+        std::mt19937 rng(11);
+
+        for (u32 i = 0; i < kMeshes; ++i) {
+            const u32 rings = 32 + rng() % 224;
+            MeshDesc desc;
+            desc.optimize = false;
+            PackedMesh packed;
+            if (!Mesh::Pack(MakeMesh(rings, rings * 2), desc, packed)) return false;
+
+            const str name = fmt::format("mesh{}", i);
+            writer.AddMesh(name, packed);
+            std::ofstream file(directory / (name + ".mesh"), std::ios::binary);
+            WriteValue(file, packed.layout);
+            for (const vector<u8>& stream : packed.vertexData) {
+                WriteSection(file, stream.data(), stream.size());
+            }
+            WriteSection(file, packed.indexData.data(), packed.indexData.size());
+            WriteSection(file, packed.lods.data(), packed.lods.size() * sizeof(MeshLod));
+        }
+
+        for (u32 i = 0; i < kTextures; ++i) {
+            vector<vector<u8>> levels;
+            vector<TextureSubresource> subresources;
+            for (u32 size = kTextureSize; size > 0; size /= 2) {
+                vector<u8>& level = levels.emplace_back(CAST<size_t>(size) * size * 4);
+                for (size_t p = 0; p < level.size(); ++p) {
+                    level[p] = CAST<u8>(p * 7 + i);
+                }
+            }
+            u32 width = kTextureSize;
+            for (const vector<u8>& level : levels) {
+                subresources.push_back({level.data(), level.size(), width * 4});
+                width /= 2;
+            }
+
+            TextureImage image;
+            image.layout.width     = kTextureSize;
+            image.layout.height    = kTextureSize;
+            image.layout.mipLevels = CAST<u32>(levels.size());
+            image.subresources     = subresources.data();
+            image.subresourceCount = CAST<u32>(subresources.size());
+
+            const str name = fmt::format("texture{}", i);
+            writer.AddTexture(name, image);
+            std::ofstream file(directory / (name + ".texture"), std::ios::binary);
+            WriteValue(file, image.layout);
+            for (const TextureSubresource& subresource : subresources) {
+                WriteValue(file, subresource.stride);
+                WriteSection(file, subresource.data, subresource.size);
+            }
+        }
+
+        for (u32 i = 0; i < kShaders; ++i) {
+            str source;
+            for (u32 line = 0; line < 400; ++line) {
+                source += fmt::format("float4 value{} = float4({}, 0, 0, 1);\n", line, line);
+            }
+            const str name = fmt::format("shader{}", i);
+            writer.AddShader(name, Diligent::SHADER_TYPE_PIXEL, source);
+            std::ofstream file(directory / (name + ".hlsl"), std::ios::binary);
+            file << source;
+        }
+        return writer.Write((directory / kPack).string());
+    }
+
+    void LoadArchive(const fs::path& directory) {
+        Asset::AssetArchive archive;
+        if (!archive.Open((directory / kPack).string())) return;
+
+        vector<TextureSubresource> subresources;
+        for (u32 i = 0; i < archive.GetAssetCount(); ++i) {
+            const Asset::ArchiveEntry& entry = archive.GetEntry(i);
+            switch (entry.type) {
+                case Asset::AssetType::Mesh: {
+                    MeshImage image;
+                    if (!archive.GetMesh(entry, image)) break;
+                    for (u32 stream = 0; stream < kMaxVertexStreams; ++stream) {
+                        Upload(image.vertexData[stream], image.vertexDataSize[stream]);
+                    }
+                    Upload(image.indexData, image.indexDataSize);
+                    break;
+                }
+                case Asset::AssetType::Texture: {
+                    TextureImage image;
+                    if (!archive.GetTexture(entry, image, subresources)) break;
+                    for (u32 s = 0; s < image.subresourceCount; ++s) {
+                        Upload(image.subresources[s].data, image.subresources[s].size);
+                    }
+                    break;
+                }
+                default: {
+                    Diligent::ShaderCreateInfo createInfo;
+                    if (archive.GetShader(entry, createInfo)) { Upload(createInfo.Source, createInfo.SourceLength); }
+                    break;
+                }
+            }
+            archive.Evict(entry);
+        }
+    }
+
+    void LoadLoose(const fs::path& directory) {
+        for (const auto& item : fs::directory_iterator(directory)) {
+            const fs::path& path = item.path();
+            const str extension  = path.extension().string();
+            std::ifstream file(path, std::ios::binary);
+            if (extension == ".mesh") {
+                PackedMesh mesh;
+                ReadValue(file, mesh.layout);
+                for (vector<u8>& stream : mesh.vertexData) {
+                    ReadSection(file, stream);
+                }
+                ReadSection(file, mesh.indexData);
+                vector<u8> lods;
+                ReadSection(file, lods);
+                const MeshImage image = mesh.GetImage();
+                for (u32 stream = 0; stream < kMaxVertexStreams; ++stream) {
+                    Upload(image.vertexData[stream], image.vertexDataSize[stream]);
+                }
+                Upload(image.indexData, image.indexDataSize);
+            } else if (extension == ".texture") {
+                TextureLayout layout;
+                ReadValue(file, layout);
+                vector<vector<u8>> levels(layout.mipLevels);
+                for (vector<u8>& level : levels) {
+                    u32 stride = 0;
+                    ReadValue(file, stride);
+                    ReadSection(file, level);
+                }
+                for (const vector<u8>& level : levels) {
+                    Upload(level.data(), level.size());
+                }
+            } else if (extension == ".hlsl") {
+                std::ostringstream source;
+                source << file.rdbuf();
+                const str text = source.str();
+                Upload(text.data(), text.size());
+            }
+        }
+    }
+
+    int RunChild(const str& mode, const fs::path& directory) {
+        const u64 baseline = GetPeakResidentBytes();
+        const auto start   = Clock::now();
+        if (mode == "archive") {
+            LoadArchive(directory);
+        } else {
+            LoadLoose(directory);
+        }
+        const f64 milliseconds = std::chrono::duration<f64, std::milli>(Clock::now() - start).count();
+        const u64 peak         = GetPeakResidentBytes();
+
+        Log::Info("{:>7}: {:7.2f} ms, peak RSS {:6.1f} MB ({:+.1f} MB while loading), checksum {:x}",
+                  mode,
+                  milliseconds,
+                  CAST<f64>(peak) / 1048576.0,
+                  CAST<f64>(peak - baseline) / 1048576.0,
+                  gChecksum);
+        return 0;
+    }
+}  // namespace
+
+int main(int argc, char** argv) {
+    Log::Initialize();
+    if (argc == 3) {
+        const int result = RunChild(argv[1], argv[2]);
+        Log::Shutdown();
+        return result;
+    }
+
+    const fs::path directory = fs::temp_directory_path() / "XAssetBench";
+    fs::remove_all(directory);
+    if (!Generate(directory)) {
+        Log::Error("Failed to generate the level set in {}", directory.string());
+        Log::Shutdown();
+        return 1;
+    }
+    Log::Info("Level set: {} meshes, {} textures ({}x{} with mips), {} shaders",
+              kMeshes,
+              kTextures,
+              kTextureSize,
+              kTextureSize,
+              kShaders);
+    Log::Flush();
+
+    for (u32 run = 0; run < kRuns; ++run) {
+        for (const char* mode : {"archive", "loose"}) {
+            const str command = fmt::format("\"{}\" {} \"{}\"", argv[0], mode, directory.string());
+            std::system(command.c_str());
+        }
+    }
+
+    fs::remove_all(directory);
+    Log::Shutdown();
+    return 0;
+}
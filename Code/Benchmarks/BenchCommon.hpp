@@ -0,0 +1,22 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#pragma once
+
+#include "EnginePCH.h"
+#include "Core/Timing.hpp"
+
+namespace X::Bench {
+    // Runs fn the given number of times and returns the fastest run in milliseconds
+    template<typename F>
+    f64 Measure(u32 iterations, F&& fn) {
+        f64 best = 1.0e12;
+        for (u32 iteration = 0; iteration < iterations; ++iteration) {
+            const auto start = Core::Clock::now();
+            fn();
+            best = std::min(best, Core::ElapsedMs(start));
+        }
+        return best;
+    }
+}  // namespace X::Bench
@@ -0,0 +1,177 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include "BenchCommon.hpp"
+#include "Core/JobSystem.hpp"
+#include "Core/Log.hpp"
+#include "Math/Bvh.hpp"
+#include "Render/Camera.hpp"
+#include "Render/Culling.hpp"
+
+#include <random>
+
+using namespace X;
+using namespace X::Bench;
+using namespace X::Core;
+using namespace X::Math;
+
+namespace {
+    constexpr u32 kObjects    = 200000;
+    constexpr u32 kIterations = 10;
+    constexpr u32 kQueries    = 10000;
+    constexpr u32 kBruteForce = 100;  // Queries timed against the brute-force loops, which take seconds per thousand
+    constexpr f32 kWorldSize  = 2000.0f;
+
+    void LogStats(const char* name, const Bvh& bvh) {
+        const BvhStats stats = bvh.ComputeStats();
+        Log::Info("{:<22} height {:3}, SAH cost {:8.1f}", name, stats.height, stats.sahCost);
+    }
+}  // namespace
+
+int main() {
+    Log::Initialize();
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<f32> position(-kWorldSize * 0.5f, kWorldSize * 0.5f);
+    std::uniform_real_distribution<f32> size(0.5f, 4.0f);
+    std::uniform_real_distribution<f32> step(-2.0f, 2.0f);
+
+    vector<AABB> boxes(kObjects);
+    for (auto& box : boxes) {
+        const Vec3 center(position(rng), position(rng), position(rng));
+        const f32 radius = size(rng);
+        box              = {center - Vec3(radius), center + Vec3(radius)};
+    }
+
+    // Building
+    Bvh bvh;
+    const f64 insertMs = Measure(kIterations, [&] {
+        bvh.Clear();
+        for (u32 i = 0; i < kObjects; ++i) {
+            bvh.Insert(boxes[i], i);
+        }
+    });
+    LogStats("Incremental insert", bvh);
+    const f64 rebuildMs = Measure(kIterations, [&] { bvh.Rebuild(); });
+    LogStats("SAH rebuild", bvh);
+    Log::Info("{} objects: insert one by one {:.2f} ms, rebuild {:.2f} ms", kObjects, insertMs, rebuildMs);
+
+    // Every object moves a little, as in a frame of simulation. Refit keeps the topology, rebuild starts over.
+    for (u32 i = 0; i < kObjects; ++i) {
+        const Vec3 offset(step(rng), step(rng), step(rng));
+        boxes[i].min += offset;
+        boxes[i].max += offset;
+        bvh.Update(i, boxes[i]);
+    }
+    const f64 refitMs = Measure(kIterations, [&] { bvh.Refit(); });
+    LogStats("After refit", bvh);
+    Log::Info("All objects moved: refit {:.2f} ms ({:.1f}x faster than rebuild)", refitMs, rebuildMs / refitMs);
+    bvh.Rebuild();
+
+    // Camera culling against the brute-force SIMD path
+    Render::Camera camera;
+    camera.SetPerspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, kWorldSize * 0.25f);
+    camera.LookAt(Vec3(1.0f, 0.0f, 0.0f));
+    const Frustum& frustum = camera.GetFrustum();
+
+    AABBSoA boxSoA;
+    boxSoA.Resize(kObjects);
+    for (u32 i = 0; i < kObjects; ++i) {
+        boxSoA.Set(i, boxes[i]);
+    }
+
+    Render::FrustumCuller culler;
+    const f64 bruteCullMs = Measure(kIterations, [&] { culler.Cull(frustum, boxSoA); });
+    const u32 bruteCount  = culler.GetVisibleCount();
+    const f64 bvhCullMs   = Measure(kIterations, [&] { culler.Cull(frustum, bvh); });
+    Log::Info("Frustum: brute force SIMD {:.3f} ms, BVH {:.3f} ms ({:.1f}x), {} / {} visible",
+              bruteCullMs,
+              bvhCullMs,
+              bruteCullMs / bvhCullMs,
+              culler.GetVisibleCount(),
+              bruteCount);
+
+    // Closest-hit raycasts
+    vector<Ray> rays(kQueries);
+    for (auto& ray : rays) {
+        ray.origin    = Vec3(position(rng), position(rng), position(rng));
+        ray.direction = glm::normalize(Vec3(step(rng), step(rng), step(rng)));
+    }
+
+    constexpr f32 kRayLength = 500.0f;
+    u32 bruteHits            = 0;
+    const f64 bruteRayMs     = Measure(kIterations, [&] {
+        bruteHits = 0;
+        for (u32 r = 0; r < kBruteForce; ++r) {
+            const Ray& ray = rays[r];
+            const Vec3 inverse(1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z);
+            f32 closest = kRayLength;
+            bool hit    = false;
+            for (const auto& box : boxes) {
+                const f32 distance = IntersectRay(box, ray.origin, inverse, closest);
+                if (distance >= 0.0f) {
+                    closest = distance;
+                    hit     = true;
+                }
+            }
+            bruteHits += hit;
+        }
+    });
+    u32 bvhHits        = 0;
+    const f64 bvhRayMs = Measure(kIterations, [&] {
+        bvhHits = 0;
+        for (u32 r = 0; r < kBruteForce; ++r) {
+            BvhHandle handle;
+            f32 distance;
+            bvhHits += bvh.RaycastClosest(rays[r], kRayLength, handle, distance);
+        }
+    });
+    const f64 allRaysMs = Measure(kIterations, [&] {
+        for (const auto& ray : rays) {
+            BvhHandle handle;
+            f32 distance;
+            bvh.RaycastClosest(ray, kRayLength, handle, distance);
+        }
+    });
+    Log::Info("Raycasts: brute force {:.1f} us, BVH {:.2f} us per ray ({:.0f}x), {} / {} hits, {:.2f} Mrays/s",
+              1000.0 * bruteRayMs / kBruteForce,
+              1000.0 * bvhRayMs / kBruteForce,
+              bruteRayMs / bvhRayMs,
+              bvhHits,
+              bruteHits,
+              kQueries / allRaysMs / 1000.0);
+
+    // Overlap queries the size of a small trigger volume
+    vector<AABB> queries(kBruteForce);
+    for (auto& query : queries) {
+        const Vec3 center(position(rng), position(rng), position(rng));
+        query = {center - Vec3(20.0f), center + Vec3(20.0f)};
+    }
+
+    u32 bruteOverlaps        = 0;
+    const f64 bruteOverlapMs = Measure(kIterations, [&] {
+        bruteOverlaps = 0;
+        for (u32 q = 0; q < kBruteForce; ++q) {
+            for (const auto& box : boxes) {
+                bruteOverlaps += Overlaps(box, queries[q]);
+            }
+        }
+    });
+    u32 bvhOverlaps        = 0;
+    const f64 bvhOverlapMs = Measure(kIterations, [&] {
+        bvhOverlaps = 0;
+        for (u32 q = 0; q < kBruteForce; ++q) {
+            bvh.QueryOverlap(queries[q], [&bvhOverlaps](BvhHandle) { ++bvhOverlaps; });
+        }
+    });
+    Log::Info("Overlaps: brute force {:.1f} us, BVH {:.2f} us per query ({:.0f}x), {} / {} pairs",
+              1000.0 * bruteOverlapMs / kBruteForce,
+              1000.0 * bvhOverlapMs / kBruteForce,
+              bruteOverlapMs / bvhOverlapMs,
+              bvhOverlaps,
+              bruteOverlaps);
+
+    Log::Shutdown();
+    return 0;
+}
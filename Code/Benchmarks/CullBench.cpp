@@ -0,0 +1,97 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include "BenchCommon.hpp"
+#include "Core/JobSystem.hpp"
+#include "Core/Log.hpp"
+#include "Math/Simd.hpp"
+#include "Render/Camera.hpp"
+#include "Render/Culling.hpp"
+
+#include <random>
+
+using namespace X;
+using namespace X::Bench;
+using namespace X::Core;
+using namespace X::Math;
+
+namespace {
+    constexpr u32 kBounds     = 1000000;
+    constexpr u32 kIterations = 20;
+    constexpr f32 kWorldSize  = 2000.0f;
+
+    template<typename Bounds>
+    void Compare(
+      const char* name, const Render::Camera& camera, const Bounds& bounds, f64 referenceMs, JobSystem& jobs) {
+        Render::FrustumCuller culler;
+        for (const auto level : {Simd::Level::Scalar, Simd::Level::SSE4, Simd::Level::AVX2}) {
+            if (level > Simd::GetSupportedLevel()) { break; }
+            Simd::SetLevel(level);
+            const f64 serialMs   = Measure(kIterations, [&] { culler.Cull(camera.GetFrustum(), bounds, nullptr); });
+            const f64 parallelMs = Measure(kIterations, [&] { culler.Cull(camera.GetFrustum(), bounds, &jobs); });
+            Log::Info("{:<8} {:<6} {:7.3f} ms serial ({:5.2f}x), {:7.3f} ms on {} threads, {} of {} visible ({:.1f}%)",
+                      name,
+                      Simd::GetLevelName(level),
+                      serialMs,
+                      referenceMs / serialMs,
+                      parallelMs,
+                      jobs.GetThreadCount(),
+                      culler.GetVisibleCount(),
+                      bounds.GetCount(),
+                      100.0 * culler.GetVisibleCount() / bounds.GetCount());
+        }
+        Simd::SetLevel(Simd::GetSupportedLevel());
+    }
+}  // namespace
+
+int main() {
+    Log::Initialize();
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<f32> position(-kWorldSize * 0.5f, kWorldSize * 0.5f);
+    std::uniform_real_distribution<f32> size(0.5f, 4.0f);
+
+    vector<Sphere> spheres(kBounds);
+    vector<AABB> boxes(kBounds);
+    SphereSoA sphereSoA;
+    AABBSoA boxSoA;
+    sphereSoA.Resize(kBounds);
+    boxSoA.Resize(kBounds);
+    for (u32 i = 0; i < kBounds; ++i) {
+        const Vec3 center(position(rng), position(rng), position(rng));
+        const f32 radius = size(rng);
+        spheres[i]       = {center, radius};
+        boxes[i]         = {center - Vec3(radius), center + Vec3(radius)};
+        sphereSoA.Set(i, spheres[i]);
+        boxSoA.Set(i, boxes[i]);
+    }
+
+    Render::Camera camera;
+    camera.SetPerspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, kWorldSize * 0.5f);
+    camera.LookAt(Vec3(1.0f, 0.0f, 0.0f));
+
+    // Array-of-structs loop over Frustum::Intersects, what a renderer does without a culling stage
+    vector<u32> visible;
+    visible.reserve(kBounds);
+    const f64 sphereReferenceMs = Measure(kIterations, [&] {
+        visible.clear();
+        for (u32 i = 0; i < kBounds; ++i) {
+            if (camera.GetFrustum().Intersects(spheres[i])) { visible.push_back(i); }
+        }
+    });
+    const f64 boxReferenceMs = Measure(kIterations, [&] {
+        visible.clear();
+        for (u32 i = 0; i < kBounds; ++i) {
+            if (camera.GetFrustum().Intersects(boxes[i])) { visible.push_back(i); }
+        }
+    });
+    Log::Info("AoS loop: spheres {:.3f} ms, boxes {:.3f} ms", sphereReferenceMs, boxReferenceMs);
+
+    JobSystem jobs;
+    Compare("Spheres", camera, sphereSoA, sphereReferenceMs, jobs);
+    Compare("AABBs", camera, boxSoA, boxReferenceMs, jobs);
+
+    Log::Shutdown();
+    return 0;
+}
@@ -0,0 +1,97 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include "Core/JobSystem.hpp"
+#include "Core/Log.hpp"
+#include "Core/Timing.hpp"
+
+#include <cmath>
+
+using namespace X;
+using namespace X::Core;
+
+namespace {
+    // Submits jobCount empty jobs and waits on them, returns ns per job
+    f64 MeasureSchedulingOverhead(JobSystem& jobs, u32 jobCount) {
+        JobCounter counter;
+        const auto start = Clock::now();
+        for (u32 i = 0; i < jobCount; ++i) {
+            jobs.Run([] {}, &counter);
+        }
+        jobs.Wait(counter);
+        return ElapsedMs(start) * 1.0e6 / jobCount;
+    }
+
+    // Spreads a fixed amount of ALU work over the pool, returns wall time in ms
+    f64 MeasureParallelFor(JobSystem& jobs, vector<f32>& data, u32 batchSize) {
+        const auto start = Clock::now();
+        jobs.ParallelFor(CAST<u32>(data.size()), batchSize, [&data](u32 begin, u32 end) {
+            for (u32 i = begin; i < end; ++i) {
+                f32 value = data[i];
+                for (u32 k = 0; k < 64; ++k) {
+                    value = std::sqrt(value * value + 1.0f) * 0.5f;
+                }
+                data[i] = value;
+            }
+        });
+        return ElapsedMs(start);
+    }
+
+    // Chains jobs through counters so each stage only starts once the previous one completes
+    f64 MeasureDependencyChain(JobSystem& jobs, u32 chainLength) {
+        vector<unique_ptr<JobCounter>> counters(chainLength);
+        for (auto& counter : counters) {
+            counter = make_unique<JobCounter>();
+        }
+
+        const auto start = Clock::now();
+        for (u32 i = 0; i < chainLength; ++i) {
+            jobs.Run([] {}, counters[i].get(), i > 0 ? counters[i - 1].get() : nullptr);
+        }
+        jobs.Wait(*counters.back());
+        return ElapsedMs(start) * 1.0e6 / chainLength;
+    }
+}  // namespace
+
+int main() {
+    Log::Initialize();
+
+    constexpr u32 kOverheadJobs  = 1 << 20;
+    constexpr u32 kElementCount  = 1 << 22;
+    constexpr u32 kBatchSize     = 4096;
+    constexpr u32 kChainLength   = 1 << 14;
+    constexpr u32 kIterations    = 5;
+    const u32 hardwareThreads    = std::max(std::thread::hardware_concurrency(), 2u);
+    const u32 maxWorkers         = hardwareThreads - 1;
+
+    vector<f32> data(kElementCount, 1.0f);
+    f64 baselineMs = 0.0;
+
+    Log::Info("Job system benchmark: {} hardware threads", hardwareThreads);
+    Log::Info("{:>8} | {:>12} | {:>12} | {:>14} | {:>8}", "workers", "ns/job", "ns/dep-job", "parallel-for ms", "speedup");
+
+    for (u32 workers = 1; workers <= maxWorkers; ++workers) {
+        JobSystem jobs(workers);
+
+        f64 overhead = 1.0e9;
+        f64 chain    = 1.0e9;
+        f64 forMs    = 1.0e9;
+        for (u32 i = 0; i < kIterations; ++i) {
+            overhead = std::min(overhead, MeasureSchedulingOverhead(jobs, kOverheadJobs));
+            chain    = std::min(chain, MeasureDependencyChain(jobs, kChainLength));
+            forMs    = std::min(forMs, MeasureParallelFor(jobs, data, kBatchSize));
+        }
+
+        if (workers == 1) { baselineMs = forMs; }
+        Log::Info("{:>8} | {:>12.1f} | {:>12.1f} | {:>14.3f} | {:>7.2f}x",
+                  workers,
+                  overhead,
+                  chain,
+                  forMs,
+                  baselineMs / forMs);
+    }
+
+    Log::Shutdown();
+    return 0;
+}
@@ -0,0 +1,148 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include "Core/Log.hpp"
+#include "Render/Camera.hpp"
+#include "Render/MeshSimplifier.hpp"
+
+#include <chrono>
+#include <random>
+
+using namespace X;
+using namespace X::Core;
+using namespace X::Render;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr u32 kTerrainSize   = 256;  // Quads per side, one unit apart
+    constexpr u32 kRings         = 128;
+    constexpr u32 kSegments      = 256;
+    constexpr f32 kPi            = 3.14159265f;
+    constexpr u32 kInstances     = 20000;
+    constexpr f32 kMaxDistance   = 2000.0f;
+    constexpr u32 kViewport      = 1080;
+    constexpr f32 kPixelErrors[] = {0.5f, 1.0f, 2.0f};
+
+    // A rolling heightfield, open along its four sides
+    MeshData MakeTerrain() {
+        MeshData data;
+        for (u32 y = 0; y <= kTerrainSize; ++y) {
+            for (u32 x = 0; x <= kTerrainSize; ++x) {
+                const f32 fx     = CAST<f32>(x);
+                const f32 fy     = CAST<f32>(y);
+                const f32 height = 6.0f * std::sin(fx * 0.05f) * std::cos(fy * 0.04f) + std::sin(fx * 0.3f + fy * 0.2f);
+                data.positions.emplace_back(fx - kTerrainSize * 0.5f, height, fy - kTerrainSize * 0.5f);
+            }
+        }
+        for (u32 y = 0; y < kTerrainSize; ++y) {
+            for (u32 x = 0; x < kTerrainSize; ++x) {
+                const u32 corner = y * (kTerrainSize + 1) + x;
+                const u32 below  = corner + kTerrainSize + 1;
+                for (const u32 index : {corner, below, corner + 1, corner + 1, below, below + 1}) {
+                    data.indices.push_back(index);
+                }
+            }
+        }
+        return data;
+    }
+
+    // A lumpy rock with a texture seam down one side and at the poles, radius about 2
+    MeshData MakeRock() {
+        MeshData data;
+        for (u32 ring = 0; ring <= kRings; ++ring) {
+            const f32 theta = kPi * CAST<f32>(ring) / kRings;
+            for (u32 segment = 0; segment <= kSegments; ++segment) {
+                const f32 phi = 2.0f * kPi * CAST<f32>(segment) / kSegments;
+                const Vec3 normal(std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi));
+                const f32 radius = 2.0f + 0.2f * std::sin(theta * 7.0f) * std::cos(phi * 5.0f);
+                data.positions.push_back(normal * radius);
+                data.uvs.emplace_back(CAST<f32>(segment) / kSegments, CAST<f32>(ring) / kRings);
+            }
+        }
+        for (u32 ring = 0; ring < kRings; ++ring) {
+            for (u32 segment = 0; segment < kSegments; ++segment) {
+                const u32 corner = ring * (kSegments + 1) + segment;
+                const u32 below  = corner + kSegments + 1;
+                for (const u32 index : {corner, corner + 1, below, corner + 1, below + 1, below}) {
+                    data.indices.push_back(index);
+                }
+            }
+        }
+        return data;
+    }
+
+    void ReportLods(const char* name, MeshData& data) {
+        MeshLodOptions options;
+        options.ratios = {0.5f, 0.25f, 0.125f, 0.0625f, 0.03125f};
+
+        const auto start = Clock::now();
+        GenerateLods(data, options);
+        const f64 milliseconds = std::chrono::duration<f64, std::milli>(Clock::now() - start).count();
+
+        Log::Info("{}: {} LODs generated in {:.1f} ms", name, data.lods.size(), milliseconds);
+        for (u32 lod = 0; lod < data.lods.size(); ++lod) {
+            const MeshLod& level = data.lods[lod];
+            Log::Info("  LOD {}: {:>6} triangles, error {:.4f}", lod, level.indexCount / 3, level.error);
+        }
+    }
+
+    // Instances spread evenly over distance, as in a large open scene
+    void ReportSelection(const char* name, const MeshData& data, const Camera& camera) {
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<f32> distances(1.0f, kMaxDistance);
+        vector<f32> distance(kInstances);
+        for (f32& d : distance) {
+            d = distances(rng);
+        }
+
+        const u32 lodCount = CAST<u32>(data.lods.size());
+        for (const f32 pixelError : kPixelErrors) {
+            u64 triangles = 0;
+            u32 histogram[8] {};
+            const auto start = Clock::now();
+            for (u32 instance = 0; instance < kInstances; ++instance) {
+                const f32 pixelsPerUnit = camera.GetPixelsPerUnit(distance[instance], kViewport);
+                const u32 lod           = SelectLod(data.lods.data(), lodCount, pixelsPerUnit, pixelError);
+                triangles += data.lods[lod].indexCount / 3;
+                ++histogram[std::min(lod, 7u)];
+            }
+            const f64 microseconds = std::chrono::duration<f64, std::micro>(Clock::now() - start).count();
+
+            const u64 fullDetail = CAST<u64>(data.lods[0].indexCount / 3) * kInstances;
+            Log::Info("{} at {:.1f} px: {:.1f}M of {:.1f}M triangles ({:.1f}% saved), LODs {} {} {} {} {} {}, "
+                      "{:.1f} us",
+                      name,
+                      pixelError,
+                      CAST<f64>(triangles) / 1.0e6,
+                      CAST<f64>(fullDetail) / 1.0e6,
+                      100.0 * (1.0 - CAST<f64>(triangles) / CAST<f64>(fullDetail)),
+                      histogram[0],
+                      histogram[1],
+                      histogram[2],
+                      histogram[3],
+                      histogram[4],
+                      histogram[5],
+                      microseconds);
+        }
+    }
+}  // namespace
+
+int main() {
+    Log::Initialize();
+
+    MeshData terrain = MakeTerrain();
+    MeshData rock    = MakeRock();
+    ReportLods("Terrain", terrain);
+    ReportLods("Rock", rock);
+
+    Camera camera;
+    camera.SetPerspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, kMaxDistance);
+    Log::Info("{} instances between 1 and {} units, {}p", kInstances, kMaxDistance, kViewport);
+    ReportSelection("Terrain", terrain, camera);
+    ReportSelection("Rock", rock, camera);
+
+    Log::Shutdown();
+    return 0;
+}
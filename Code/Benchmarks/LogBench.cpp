@@ -0,0 +1,103 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include "Core/Log.hpp"
+
+#include <chrono>
+#include <thread>
+
+using namespace X;
+using namespace X::Core;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    struct Result {
+        const char* name;
+        u32 threads;
+        f64 nsPerCall;
+        u64 dropped;
+    };
+
+    // Logs messagesPerThread lines from each thread into a file-only logger, returns the average ns per call seen by
+    // the callers. Draining the queue afterwards is not part of the measurement, that is the point of async mode.
+    Result Measure(const char* name, const LogConfig& config, u32 threads, u32 messagesPerThread) {
+        Log::Initialize(config);
+
+        vector<std::thread> workers;
+        vector<f64> elapsed(threads, 0.0);
+        for (u32 t = 0; t < threads; ++t) {
+            workers.emplace_back([t, messagesPerThread, &elapsed] {
+                const auto start = Clock::now();
+                for (u32 i = 0; i < messagesPerThread; ++i) {
+                    Log::Info("Worker {} processed item {} in {:.3f} ms", t, i, 0.25);
+                }
+                elapsed[t] = std::chrono::duration<f64, std::nano>(Clock::now() - start).count();
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        const u64 dropped = Log::GetDroppedMessages();
+        Log::Shutdown();
+
+        f64 total = 0.0;
+        for (const f64 ns : elapsed) {
+            total += ns;
+        }
+        return {name, threads, total / (CAST<f64>(threads) * messagesPerThread), dropped};
+    }
+
+    f64 MeasureStripped(u32 count) {
+        const auto start = Clock::now();
+        for (u32 i = 0; i < count; ++i) {
+            Log::Debug("Stripped in Release {}", i);
+        }
+        return std::chrono::duration<f64, std::nano>(Clock::now() - start).count() / count;
+    }
+}  // namespace
+
+int main() {
+    constexpr u32 kMessages = 200000;
+    const str path          = "LogBench.log";
+
+    LogConfig sync;
+    sync.async    = false;
+    sync.console  = false;
+    sync.filePath = path;
+
+    LogConfig drop      = sync;
+    drop.async          = true;
+    drop.overflow       = LogOverflow::Drop;
+    LogConfig block     = drop;
+    block.overflow      = LogOverflow::Block;
+    block.queueCapacity = 1 << 16;
+
+    vector<Result> results;
+    for (const u32 threads : {1u, 4u}) {
+        results.push_back(Measure("sync", sync, threads, kMessages / threads));
+        results.push_back(Measure("async drop", drop, threads, kMessages / threads));
+        results.push_back(Measure("async block", block, threads, kMessages / threads));
+    }
+
+    // Debug lines go to a console-free logger so nothing is printed when they are compiled in
+    Log::Initialize(drop);
+    const f64 strippedNs = MeasureStripped(kMessages);
+    Log::Shutdown();
+
+    Log::Initialize();
+    for (const auto& result : results) {
+        Log::Info("{:<12} {} thread(s): {:8.1f} ns/call, {} dropped",
+                  result.name,
+                  result.threads,
+                  result.nsPerCall,
+                  result.dropped);
+    }
+    Log::Info("Log::Debug: {:.2f} ns/call ({})", strippedNs, Log::kDebugEnabled ? "compiled in" : "stripped");
+    Log::Shutdown();
+
+    std::remove(path.c_str());
+    return 0;
+}
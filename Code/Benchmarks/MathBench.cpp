@@ -0,0 +1,141 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include "BenchCommon.hpp"
+#include "Core/Log.hpp"
+#include "Math/Simd.hpp"
+
+#include <random>
+
+using namespace X;
+using namespace X::Bench;
+using namespace X::Core;
+using namespace X::Math;
+
+namespace {
+    constexpr size_t kCounts[] = {100000, 1000000, 10000000};
+    constexpr u32 kIterations  = 5;
+
+    Mat4 RandomAffine(std::mt19937& rng) {
+        std::uniform_real_distribution<f32> value(-2.0f, 2.0f);
+        Mat4 m(1.0f);
+        for (i32 c = 0; c < 4; ++c) {
+            for (i32 r = 0; r < 3; ++r) {
+                m[c][r] = value(rng);
+            }
+        }
+        return m;
+    }
+
+    // Times the plain glm loop against the batch function at every level the CPU supports
+    template<typename Reference, typename Batch>
+    void Compare(const char* name, size_t count, Reference&& reference, Batch&& batch) {
+        const f64 glmMs = Measure(kIterations, reference);
+
+        str levels;
+        for (const auto level : {Simd::Level::Scalar, Simd::Level::SSE4, Simd::Level::AVX2}) {
+            if (level > Simd::GetSupportedLevel()) { break; }
+            Simd::SetLevel(level);
+            const f64 ms = Measure(kIterations, batch);
+            levels += fmt::format(" | {} {:8.3f} ms ({:4.2f}x)", Simd::GetLevelName(level), ms, glmMs / ms);
+        }
+        Simd::SetLevel(Simd::GetSupportedLevel());
+
+        Log::Info("{:<16} {:>9} | glm {:8.3f} ms{}", name, count, glmMs, levels);
+    }
+}  // namespace
+
+int main() {
+    Log::Initialize();
+    Log::Info("SIMD level: {}", Simd::GetLevelName(Simd::GetSupportedLevel()));
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<f32> value(-10.0f, 10.0f);
+    const Mat4 m = RandomAffine(rng);
+
+    for (const size_t count : kCounts) {
+        // Each case allocates its own arrays so 10M elements fit in memory
+        {
+            vector<Mat4> in(count), out(count);
+            for (auto& world : in) {
+                world = RandomAffine(rng);
+            }
+            Compare(
+              "MultiplyMat4",
+              count,
+              [&] {
+                  for (size_t i = 0; i < count; ++i) {
+                      out[i] = m * in[i];
+                  }
+              },
+              [&] { Simd::MultiplyMat4(m, in.data(), out.data(), count); });
+        }
+        {
+            vector<Quat> in(count);
+            vector<Mat4> out(count);
+            for (auto& q : in) {
+                q = glm::normalize(Quat(value(rng), value(rng), value(rng), value(rng)));
+            }
+            Compare(
+              "QuatToMat4",
+              count,
+              [&] {
+                  for (size_t i = 0; i < count; ++i) {
+                      out[i] = glm::mat4_cast(in[i]);
+                  }
+              },
+              [&] { Simd::QuatToMat4(in.data(), out.data(), count); });
+        }
+        {
+            vector<Vec3> in(count), out(count);
+            for (auto& p : in) {
+                p = Vec3(value(rng), value(rng), value(rng));
+            }
+            Compare(
+              "TransformPoints",
+              count,
+              [&] {
+                  for (size_t i = 0; i < count; ++i) {
+                      out[i] = Vec3(m * Vec4(in[i], 1.0f));
+                  }
+              },
+              [&] { Simd::TransformPoints(m, in.data(), out.data(), count); });
+
+            const Mat3 basis(m);
+            Compare(
+              "TransformNormals",
+              count,
+              [&] {
+                  for (size_t i = 0; i < count; ++i) {
+                      out[i] = glm::normalize(basis * in[i]);
+                  }
+              },
+              [&] { Simd::TransformNormals(m, in.data(), out.data(), count); });
+        }
+        {
+            vector<AABB> in(count), out(count);
+            for (auto& box : in) {
+                const Vec3 a(value(rng), value(rng), value(rng));
+                const Vec3 b(value(rng), value(rng), value(rng));
+                box = {glm::min(a, b), glm::max(a, b)};
+            }
+            Compare(
+              "TransformAABBs",
+              count,
+              [&] {
+                  for (size_t i = 0; i < count; ++i) {
+                      const Vec3 center = Vec3(m * Vec4(in[i].GetCenter(), 1.0f));
+                      const Vec3 e      = in[i].GetExtents();
+                      const Vec3 radius = glm::abs(Vec3(m[0])) * e.x + glm::abs(Vec3(m[1])) * e.y +
+                                          glm::abs(Vec3(m[2])) * e.z;
+                      out[i] = {center - radius, center + radius};
+                  }
+              },
+              [&] { Simd::TransformAABBs(m, in.data(), out.data(), count); });
+        }
+    }
+
+    Log::Shutdown();
+    return 0;
+}
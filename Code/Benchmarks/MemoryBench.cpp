@@ -0,0 +1,220 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include "Core/Memory.hpp"
+#include "Core/Log.hpp"
+
+#include <chrono>
+#include <list>
+#include <memory_resource>
+
+using namespace X;
+using namespace X::Core;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    f64 ElapsedNs(Clock::time_point start) {
+        return std::chrono::duration<f64, std::nano>(Clock::now() - start).count();
+    }
+
+    // Keeps the optimizer from dropping allocations whose results are never read
+    void Touch(void* pointer) {
+        static volatile u8 sink;
+        sink = *CAST<u8*>(pointer);
+    }
+
+    struct Particle {
+        Vec3 position;
+        Vec3 velocity;
+        f32 lifetime;
+        u32 flags;
+    };
+
+    // Frame-style workload: many small allocations of mixed size, all freed together at the end of the frame
+    f64 FrameHeap(u32 frames, u32 allocationsPerFrame) {
+        vector<void*> live(allocationsPerFrame);
+        const auto start = Clock::now();
+        for (u32 frame = 0; frame < frames; ++frame) {
+            for (u32 i = 0; i < allocationsPerFrame; ++i) {
+                live[i] = ::operator new(16 + (i % 16) * 16);
+                Touch(live[i]);
+            }
+            for (void* pointer : live) {
+                ::operator delete(pointer);
+            }
+        }
+        return ElapsedNs(start) / (CAST<f64>(frames) * allocationsPerFrame);
+    }
+
+    f64 FrameArena(u32 frames, u32 allocationsPerFrame) {
+        LinearArena arena(1 << 20);
+        const auto start = Clock::now();
+        for (u32 frame = 0; frame < frames; ++frame) {
+            arena.Reset();
+            for (u32 i = 0; i < allocationsPerFrame; ++i) {
+                void* pointer = arena.Allocate(16 + (i % 16) * 16);
+                Touch(pointer);
+            }
+        }
+        return ElapsedNs(start) / (CAST<f64>(frames) * allocationsPerFrame);
+    }
+
+    // Churn workload: objects created and destroyed in an interleaved order
+    f64 ChurnHeap(u32 iterations, u32 liveCount) {
+        vector<Particle*> live(liveCount);
+        for (auto& particle : live) {
+            particle = new Particle();
+        }
+
+        const auto start = Clock::now();
+        for (u32 i = 0; i < iterations; ++i) {
+            const u32 slot = (i * 7919u) % liveCount;
+            delete live[slot];
+            live[slot] = new Particle();
+            Touch(live[slot]);
+        }
+        const f64 ns = ElapsedNs(start) / iterations;
+
+        for (auto* particle : live) {
+            delete particle;
+        }
+        return ns;
+    }
+
+    f64 ChurnPool(u32 iterations, u32 liveCount) {
+        ObjectPool<Particle> pool(4096);
+        vector<Particle*> live(liveCount);
+        for (auto& particle : live) {
+            particle = pool.New();
+        }
+
+        const auto start = Clock::now();
+        for (u32 i = 0; i < iterations; ++i) {
+            const u32 slot = (i * 7919u) % liveCount;
+            pool.Delete(live[slot]);
+            live[slot] = pool.New();
+            Touch(live[slot]);
+        }
+        const f64 ns = ElapsedNs(start) / iterations;
+
+        for (auto* particle : live) {
+            pool.Delete(particle);
+        }
+        return ns;
+    }
+
+    // Many short per-frame containers, the way render lists and gameplay queries use them. Returns ns per container.
+    f64 VectorHeap(u32 frames, u32 containers) {
+        const auto start = Clock::now();
+        for (u32 frame = 0; frame < frames; ++frame) {
+            for (u32 c = 0; c < containers; ++c) {
+                vector<u32> values;
+                for (u32 i = 0; i < 24; ++i) {
+                    values.push_back(i);
+                }
+                Touch(values.data());
+            }
+        }
+        return ElapsedNs(start) / (CAST<f64>(frames) * containers);
+    }
+
+    f64 VectorArena(u32 frames, u32 containers) {
+        LinearArena arena(1 << 20);
+        ArenaResource resource(arena);
+        const auto start = Clock::now();
+        for (u32 frame = 0; frame < frames; ++frame) {
+            arena.Reset();
+            for (u32 c = 0; c < containers; ++c) {
+                std::pmr::vector<u32> values(&resource);
+                for (u32 i = 0; i < 24; ++i) {
+                    values.push_back(i);
+                }
+                Touch(values.data());
+            }
+        }
+        return ElapsedNs(start) / (CAST<f64>(frames) * containers);
+    }
+
+    f64 ListHeap(u32 frames, u32 elements) {
+        const auto start = Clock::now();
+        for (u32 frame = 0; frame < frames; ++frame) {
+            std::list<u64> values;
+            for (u32 i = 0; i < elements; ++i) {
+                values.push_back(i);
+            }
+            Touch(&values.back());
+        }
+        return ElapsedNs(start) / (CAST<f64>(frames) * elements);
+    }
+
+    f64 ListPool(u32 frames, u32 elements) {
+        PoolResource resource(32, 4096);
+        const auto start = Clock::now();
+        for (u32 frame = 0; frame < frames; ++frame) {
+            std::pmr::list<u64> values(&resource);
+            for (u32 i = 0; i < elements; ++i) {
+                values.push_back(i);
+            }
+            Touch(&values.back());
+        }
+        return ElapsedNs(start) / (CAST<f64>(frames) * elements);
+    }
+
+    template<typename F>
+    f64 Best(u32 iterations, F&& measure) {
+        f64 best = 1.0e12;
+        for (u32 i = 0; i < iterations; ++i) {
+            best = std::min(best, measure());
+        }
+        return best;
+    }
+
+    void Report(const char* name, f64 heapNs, f64 customNs) {
+        Log::Info("{:<24} | {:>10.2f} | {:>10.2f} | {:>7.2f}x", name, heapNs, customNs, heapNs / customNs);
+    }
+}  // namespace
+
+int main() {
+    Log::Initialize();
+
+    constexpr u32 kIterations = 5;
+    constexpr u32 kFrames     = 200;
+    constexpr u32 kPerFrame   = 10000;
+    constexpr u32 kChurn      = 1 << 21;
+    constexpr u32 kLive       = 1 << 14;
+
+    Log::Info("Memory benchmark, ns per allocation (per container for vectors, best of {})", kIterations);
+    Log::Info("{:<24} | {:>10} | {:>10} | {:>8}", "workload", "default", "engine", "speedup");
+
+    Report("frame scratch (arena)",
+           Best(kIterations, [] { return FrameHeap(kFrames, kPerFrame); }),
+           Best(kIterations, [] { return FrameArena(kFrames, kPerFrame); }));
+    Report("object churn (pool)",
+           Best(kIterations, [] { return ChurnHeap(kChurn, kLive); }),
+           Best(kIterations, [] { return ChurnPool(kChurn, kLive); }));
+    Report("pmr::vector (arena)",
+           Best(kIterations, [] { return VectorHeap(kFrames, kPerFrame); }),
+           Best(kIterations, [] { return VectorArena(kFrames, kPerFrame); }));
+    Report("pmr::list (pool)",
+           Best(kIterations, [] { return ListHeap(kFrames, kPerFrame); }),
+           Best(kIterations, [] { return ListPool(kFrames, kPerFrame); }));
+
+    // Counters over two frames of the arena workload, the second frame never reaches the system allocator
+    LinearArena arena(1 << 20);
+    for (u32 frame = 0; frame < 2; ++frame) {
+        arena.Reset();
+        for (u32 i = 0; i < kPerFrame; ++i) {
+            arena.Allocate(16 + (i % 16) * 16);
+        }
+    }
+    const AllocationStats stats = arena.GetCounters().GetStats();
+    Log::Info("Arena counters over 2 frames: {} allocations, {} KB peak, {} upstream allocations",
+              stats.allocations,
+              stats.peakBytesInUse / 1024,
+              stats.upstreamAllocations);
+
+    Log::Shutdown();
+    return 0;
+}
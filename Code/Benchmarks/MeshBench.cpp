@@ -0,0 +1,153 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include "Core/Log.hpp"
+#include "Render/MeshOptimizer.hpp"
+
+#include <random>
+
+using namespace X;
+using namespace X::Core;
+using namespace X::Render;
+
+namespace {
+    constexpr u32 kGridSize     = 512;  // Quads per side
+    constexpr u32 kRings        = 256;
+    constexpr u32 kSegments     = 512;
+    constexpr f32 kPi           = 3.14159265f;
+    constexpr u32 kCacheSizes[] = {16, 32};
+
+    // Row by row, the order a heightfield generator produces. Each row reuses the previous one's vertices only after
+    // a full row of other vertices has gone through the cache.
+    MeshData MakeGrid() {
+        MeshData data;
+        for (u32 y = 0; y <= kGridSize; ++y) {
+            for (u32 x = 0; x <= kGridSize; ++x) {
+                data.positions.emplace_back(CAST<f32>(x), 0.0f, CAST<f32>(y));
+                data.normals.emplace_back(0.0f, 1.0f, 0.0f);
+                data.uvs.emplace_back(CAST<f32>(x) / kGridSize, CAST<f32>(y) / kGridSize);
+            }
+        }
+        for (u32 y = 0; y < kGridSize; ++y) {
+            for (u32 x = 0; x < kGridSize; ++x) {
+                const u32 corner = y * (kGridSize + 1) + x;
+                const u32 below  = corner + kGridSize + 1;
+                for (const u32 index : {corner, below, corner + 1, corner + 1, below, below + 1}) {
+                    data.indices.push_back(index);
+                }
+            }
+        }
+        return data;
+    }
+
+    MeshData MakeSphere() {
+        MeshData data;
+        for (u32 ring = 0; ring <= kRings; ++ring) {
+            const f32 theta = kPi * CAST<f32>(ring) / kRings;
+            for (u32 segment = 0; segment <= kSegments; ++segment) {
+                const f32 phi = 2.0f * kPi * CAST<f32>(segment) / kSegments;
+                const Vec3 normal(std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi));
+                data.positions.push_back(normal);
+                data.normals.push_back(normal);
+                data.uvs.emplace_back(CAST<f32>(segment) / kSegments, CAST<f32>(ring) / kRings);
+            }
+        }
+        for (u32 ring = 0; ring < kRings; ++ring) {
+            for (u32 segment = 0; segment < kSegments; ++segment) {
+                const u32 corner = ring * (kSegments + 1) + segment;
+                const u32 below  = corner + kSegments + 1;
+                for (const u32 index : {corner, corner + 1, below, corner + 1, below + 1, below}) {
+                    data.indices.push_back(index);
+                }
+            }
+        }
+        return data;
+    }
+
+    // Triangles and vertices in random order, as some exporters and welding passes leave them
+    MeshData Shuffle(MeshData data) {
+        std::mt19937 rng(42);
+        vector<u32> triangles(data.GetTriangleCount());
+        for (u32 triangle = 0; triangle < triangles.size(); ++triangle) {
+            triangles[triangle] = triangle;
+        }
+        std::shuffle(triangles.begin(), triangles.end(), rng);
+
+        vector<u32> vertices(data.GetVertexCount());
+        for (u32 vertex = 0; vertex < vertices.size(); ++vertex) {
+            vertices[vertex] = vertex;
+        }
+        std::shuffle(vertices.begin(), vertices.end(), rng);
+
+        MeshData shuffled = data;
+        for (u32 vertex = 0; vertex < vertices.size(); ++vertex) {
+            shuffled.positions[vertices[vertex]] = data.positions[vertex];
+            shuffled.normals[vertices[vertex]]   = data.normals[vertex];
+            shuffled.uvs[vertices[vertex]]       = data.uvs[vertex];
+        }
+        for (u32 triangle = 0; triangle < triangles.size(); ++triangle) {
+            for (u32 corner = 0; corner < 3; ++corner) {
+                shuffled.indices[triangle * 3 + corner] = vertices[data.indices[triangles[triangle] * 3 + corner]];
+            }
+        }
+        return shuffled;
+    }
+
+    // Average distance in vertices between consecutive first uses, 1 when the fetch streams through memory
+    f32 FetchStride(const MeshData& data) {
+        vector<u8> seen(data.GetVertexCount(), 0);
+        u64 distance = 0;
+        u32 previous = 0;
+        u32 count    = 0;
+        for (const u32 index : data.indices) {
+            if (seen[index]) continue;
+            seen[index] = 1;
+            if (count++ > 0) { distance += index > previous ? index - previous : previous - index; }
+            previous = index;
+        }
+        return count > 1 ? CAST<f32>(distance) / CAST<f32>(count - 1) : 0.0f;
+    }
+
+    void Report(const char* name, const MeshData& source) {
+        Log::Info("{}: {} triangles, {} vertices", name, source.GetTriangleCount(), source.GetVertexCount());
+        for (const u32 cacheSize : kCacheSizes) {
+            MeshData data = source;
+            MeshOptimizeOptions options;
+            options.cacheSize               = cacheSize;
+            const MeshOptimizeReport report = OptimizeMesh(data, options);
+
+            Log::Info("  cache {:>2}: ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}, fetch stride {:.1f} -> {:.1f}, "
+                      "{:.1f} ms",
+                      cacheSize,
+                      report.before.acmr,
+                      report.after.acmr,
+                      report.before.atvr,
+                      report.after.atvr,
+                      FetchStride(source),
+                      FetchStride(data),
+                      report.milliseconds);
+        }
+
+        // Overdraw reordering trades a little vertex reuse for drawing outward-facing clusters first
+        MeshData data = source;
+        MeshOptimizeOptions options;
+        options.overdrawThreshold       = 1.0f;
+        const MeshOptimizeReport report = OptimizeMesh(data, options);
+        Log::Info("  cache 16 without overdraw pass: ACMR {:.3f}", report.after.acmr);
+    }
+}  // namespace
+
+int main() {
+    Log::Initialize();
+
+    const MeshData grid   = MakeGrid();
+    const MeshData sphere = MakeSphere();
+    Report("Grid", grid);
+    Report("Grid, shuffled", Shuffle(grid));
+    Report("Sphere", sphere);
+    Report("Sphere, shuffled", Shuffle(sphere));
+
+    Log::Shutdown();
+    return 0;
+}
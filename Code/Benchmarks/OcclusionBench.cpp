@@ -0,0 +1,142 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include "BenchCommon.hpp"
+#include "Core/JobSystem.hpp"
+#include "Core/Log.hpp"
+#include "Math/Simd.hpp"
+#include "Render/Camera.hpp"
+#include "Render/Culling.hpp"
+#include "Render/Occlusion.hpp"
+
+#include <random>
+
+using namespace X;
+using namespace X::Bench;
+using namespace X::Core;
+using namespace X::Math;
+
+namespace {
+    constexpr u32 kRooms      = 16;  // Per side
+    constexpr f32 kRoomSize   = 20.0f;
+    constexpr f32 kWallHeight = 4.0f;
+    constexpr f32 kDoorWidth  = 2.0f;
+    constexpr u32 kObjects    = 200000;
+    constexpr u32 kIterations = 20;
+
+    // Twelve triangles, the kind of hull an artist would author as an occluder
+    void AppendBox(const AABB& box, vector<Vec3>& positions, vector<u32>& indices) {
+        const u32 base = CAST<u32>(positions.size());
+        for (u32 corner = 0; corner < 8; ++corner) {
+            positions.emplace_back((corner & 1) ? box.max.x : box.min.x,
+                                   (corner & 2) ? box.max.y : box.min.y,
+                                   (corner & 4) ? box.max.z : box.min.z);
+        }
+        constexpr u32 kFaces[6][4] = {{0, 1, 3, 2}, {4, 6, 7, 5}, {0, 4, 5, 1}, {2, 3, 7, 6}, {0, 2, 6, 4}, {1, 5, 7, 3}};
+        for (const auto& face : kFaces) {
+            for (const u32 corner : {face[0], face[1], face[2], face[0], face[2], face[3]}) {
+                indices.push_back(base + corner);
+            }
+        }
+    }
+}  // namespace
+
+int main() {
+    Log::Initialize();
+
+    // A grid of rooms whose walls each have a doorway in the middle, split into two wall segments
+    vector<Vec3> positions;
+    vector<u32> indices;
+    u32 walls = 0;
+    for (u32 line = 0; line <= kRooms; ++line) {
+        for (u32 room = 0; room < kRooms; ++room) {
+            const f32 along          = CAST<f32>(line) * kRoomSize;
+            const f32 start          = CAST<f32>(room) * kRoomSize;
+            const f32 half           = (kRoomSize - kDoorWidth) * 0.5f;
+            const f32 segments[2][2] = {{start, start + half}, {start + half + kDoorWidth, start + kRoomSize}};
+            for (const auto& segment : segments) {
+                AppendBox({Vec3(segment[0], 0.0f, along - 0.1f), Vec3(segment[1], kWallHeight, along + 0.1f)},
+                          positions,
+                          indices);
+                AppendBox({Vec3(along - 0.1f, 0.0f, segment[0]), Vec3(along + 0.1f, kWallHeight, segment[1])},
+                          positions,
+                          indices);
+                walls += 2;
+            }
+        }
+    }
+
+    // Furniture-sized boxes scattered over every room
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<f32> position(0.5f, kRooms * kRoomSize - 0.5f);
+    std::uniform_real_distribution<f32> size(0.2f, 1.0f);
+    AABBSoA objects;
+    objects.Reserve(kObjects);
+    for (u32 i = 0; i < kObjects; ++i) {
+        const Vec3 extent(size(rng), size(rng), size(rng));
+        const Vec3 center(position(rng), extent.y, position(rng));
+        objects.Add({center - extent, center + extent});
+    }
+
+    // Standing in a corner room looking down the diagonal, through several doorways
+    Render::Camera camera;
+    camera.SetPerspective(glm::radians(70.0f), 16.0f / 9.0f, 0.1f, kRooms * kRoomSize * 1.5f);
+    camera.SetPosition(Vec3(kRoomSize * 0.5f, 1.7f, kRoomSize * 0.5f));
+    camera.LookAt(Vec3(kRooms * kRoomSize, 1.7f, kRooms * kRoomSize));
+
+    JobSystem jobs;
+    Render::FrustumCuller frustumCuller;
+    frustumCuller.Cull(camera.GetFrustum(), objects, &jobs);
+    const u32 frustumVisible = frustumCuller.GetVisibleCount();
+    vector<u32> visible(frustumCuller.GetVisible(), frustumCuller.GetVisible() + frustumVisible);
+    Log::Info("{} objects, {} wall occluders ({} triangles), {} left after frustum culling",
+              kObjects,
+              walls,
+              indices.size() / 3,
+              frustumVisible);
+
+    Render::OcclusionCuller occlusion;
+    const auto addOccluders = [&] {
+        occlusion.Begin(camera.GetViewProjection(), camera.GetDepthZeroToOne());
+        occlusion.AddOccluder(positions.data(),
+                              CAST<u32>(positions.size()),
+                              indices.data(),
+                              CAST<u32>(indices.size()),
+                              Mat4(1.0f));
+    };
+
+    for (const auto level : {Simd::Level::Scalar, Simd::Level::SSE4, Simd::Level::AVX2}) {
+        if (level > Simd::GetSupportedLevel()) { break; }
+        Simd::SetLevel(level);
+
+        const f64 setupMs    = Measure(kIterations, addOccluders);
+        const f64 serialMs   = Measure(kIterations, [&] { occlusion.Rasterize(nullptr); });
+        const f64 parallelMs = Measure(kIterations, [&] { occlusion.Rasterize(&jobs); });
+
+        u32 kept           = 0;
+        const f64 filterMs = Measure(kIterations, [&] {
+            vector<u32> list = visible;
+            kept             = occlusion.Filter(objects, list.data(), frustumVisible, &jobs);
+        });
+
+        // Stats accumulate over the timed Filter calls, the percentage is the same for each
+        Log::Info("{:<6} setup {:.3f} ms, raster {:.3f} ms serial / {:.3f} ms on {} threads, test {:.3f} ms",
+                  Simd::GetLevelName(level),
+                  setupMs,
+                  serialMs,
+                  parallelMs,
+                  jobs.GetThreadCount(),
+                  filterMs);
+        Log::Info("       {} of {} triangles rasterized, {} of {} draws kept, {:.1f}% rejected",
+                  occlusion.GetStats().rasterizedTriangles,
+                  occlusion.GetStats().triangles,
+                  kept,
+                  frustumVisible,
+                  occlusion.GetStats().GetRejectedPercent());
+    }
+    Simd::SetLevel(Simd::GetSupportedLevel());
+
+    Log::Shutdown();
+    return 0;
+}
@@ -0,0 +1,192 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+// Startup cost of building every shader permutation and pipeline a material set needs, cold against warm. Run
+// without arguments it clears the cache directory, then starts a fresh child process per run so every run pays for
+// device creation and nothing but the files on disk carries over. The first run compiles from source, the rest load
+// bytecode and the driver's pipeline cache. Needs a Vulkan device, which may be a software one (lavapipe) when
+// no GPU is present.
+
+#include "Core/Log.hpp"
+#include "Render/PipelineCache.hpp"
+#include "Render/RenderDevice.hpp"
+
+#include <chrono>
+#include <filesystem>
+
+using namespace X;
+using namespace X::Core;
+using namespace X::Render;
+
+namespace {
+    namespace fs = std::filesystem;
+    using Clock  = std::chrono::steady_clock;
+
+    constexpr u32 kFeatureBits        = 6;  // 64 permutations
+    constexpr u32 kRuns               = 3;
+    constexpr const char* kFeatures[] = {"NORMAL_MAP", "ALPHA_TEST", "EMISSIVE", "VERTEX_COLOR", "DETAIL_MAP", "FOG"};
+
+    constexpr const char* kVertexShader = R"(
+cbuffer Camera { float4x4 ViewProjection; };
+struct VSInput {
+    float3 Position : ATTRIB0;
+    float3 Normal   : ATTRIB1;
+    float2 TexCoord : ATTRIB2;
+};
+struct PSInput {
+    float4 Position : SV_POSITION;
+    float3 Normal   : NORMAL;
+    float2 TexCoord : TEXCOORD0;
+    float  Depth    : TEXCOORD1;
+};
+void main(in VSInput input, out PSInput output) {
+    output.Position = mul(float4(input.Position, 1.0), ViewProjection);
+    output.Normal   = input.Normal;
+    output.TexCoord = input.TexCoord;
+    output.Depth    = output.Position.w;
+#if VERTEX_COLOR
+    output.Normal = normalize(output.Normal + input.Position * 0.01);
+#endif
+}
+)";
+
+    constexpr const char* kPixelShader = R"(
+Texture2D    BaseColor;
+SamplerState BaseColor_sampler;
+Texture2D    NormalMap;
+SamplerState NormalMap_sampler;
+Texture2D    DetailMap;
+SamplerState DetailMap_sampler;
+cbuffer Material { float4 Tint; float4 Emissive; float4 FogColor; };
+struct PSInput {
+    float4 Position : SV_POSITION;
+    float3 Normal   : NORMAL;
+    float2 TexCoord : TEXCOORD0;
+    float  Depth    : TEXCOORD1;
+};
+float4 main(in PSInput input) : SV_TARGET {
+    float4 color = BaseColor.Sample(BaseColor_sampler, input.TexCoord) * Tint;
+    float3 normal = normalize(input.Normal);
+#if NORMAL_MAP
+    normal = normalize(normal + NormalMap.Sample(NormalMap_sampler, input.TexCoord).xyz * 2.0 - 1.0);
+#endif
+#if DETAIL_MAP
+    color.rgb *= DetailMap.Sample(DetailMap_sampler, input.TexCoord * 8.0).rgb * 2.0;
+#endif
+#if ALPHA_TEST
+    clip(color.a - 0.5);
+#endif
+    float3 lit = color.rgb * saturate(dot(normal, normalize(float3(0.3, 1.0, 0.2))));
+#if EMISSIVE
+    lit += Emissive.rgb;
+#endif
+#if FOG
+    lit = lerp(lit, FogColor.rgb, saturate(input.Depth / 500.0));
+#endif
+    return float4(lit, color.a);
+}
+)";
+
+    RefCntAutoPtr<IShader> CreateShader(PipelineCache& cache,
+                                        const char* source,
+                                        Diligent::SHADER_TYPE type,
+                                        u32 permutation,
+                                        const char* name) {
+        vector<Diligent::ShaderMacro> macros;
+        for (u32 bit = 0; bit < kFeatureBits; ++bit) {
+            macros.push_back({kFeatures[bit], permutation & (1u << bit) ? "1" : "0"});
+        }
+
+        Diligent::ShaderCreateInfo createInfo;
+        createInfo.Source                          = source;
+        createInfo.SourceLanguage                  = Diligent::SHADER_SOURCE_LANGUAGE_HLSL;
+        createInfo.Desc.ShaderType                 = type;
+        createInfo.Desc.Name                       = name;
+        createInfo.Desc.UseCombinedTextureSamplers = true;
+        createInfo.Macros                          = {macros.data(), CAST<u32>(macros.size())};
+        return cache.CreateShader(createInfo);
+    }
+
+    int RunChild(const str& directory) {
+        const auto start = Clock::now();
+        RenderDeviceConfig config;
+        config.api                    = GraphicsAPI::Vulkan;
+        config.headless               = true;
+        config.pipelineCacheDirectory = directory;
+
+        RenderDevice device;
+        if (!device.Initialize(nullptr, 64, 64, config)) return 1;
+        const f64 deviceMs   = std::chrono::duration<f64, std::milli>(Clock::now() - start).count();
+        PipelineCache& cache = *device.GetPipelineCache();
+
+        const Diligent::LayoutElement layout[] = {
+          {0, 0, 3, Diligent::VT_FLOAT32, false},
+          {1, 0, 3, Diligent::VT_FLOAT32, false},
+          {2, 0, 2, Diligent::VT_FLOAT32, false},
+        };
+
+        const auto buildStart = Clock::now();
+        u32 pipelines         = 0;
+        for (u32 permutation = 0; permutation < (1u << kFeatureBits); ++permutation) {
+            // Vertex shaders only see one of the features, most permutations share theirs
+            const u32 vertexPermutation = permutation & (1u << 3);
+            const RefCntAutoPtr<IShader> vertex =
+              CreateShader(cache, kVertexShader, Diligent::SHADER_TYPE_VERTEX, vertexPermutation, "Bench VS");
+            const RefCntAutoPtr<IShader> pixel =
+              CreateShader(cache, kPixelShader, Diligent::SHADER_TYPE_PIXEL, permutation, "Bench PS");
+            if (!vertex || !pixel) return 1;
+
+            Diligent::GraphicsPipelineStateCreateInfo createInfo;
+            createInfo.PSODesc.Name                               = "Bench pipeline";
+            createInfo.PSODesc.ResourceLayout.DefaultVariableType = Diligent::SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE;
+            createInfo.pVS                                        = vertex;
+            createInfo.pPS                                        = pixel;
+
+            Diligent::GraphicsPipelineDesc& graphics = createInfo.GraphicsPipeline;
+            graphics.NumRenderTargets                = 1;
+            graphics.RTVFormats[0]                   = Diligent::TEX_FORMAT_RGBA8_UNORM_SRGB;
+            graphics.DSVFormat                       = Diligent::TEX_FORMAT_D32_FLOAT;
+            graphics.PrimitiveTopology               = Diligent::PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+            graphics.InputLayout.LayoutElements      = layout;
+            graphics.InputLayout.NumElements         = CAST<u32>(std::size(layout));
+            if (cache.CreateGraphicsPipeline(createInfo)) { ++pipelines; }
+        }
+        const f64 buildMs = std::chrono::duration<f64, std::milli>(Clock::now() - buildStart).count();
+
+        const PipelineCacheStats stats = cache.GetStats();
+        Log::Info("{}: device {:7.1f} ms, {} pipelines in {:8.1f} ms ({} shaders compiled, {} loaded, {} shared){}",
+                  stats.warm ? "warm" : "cold",
+                  deviceMs,
+                  pipelines,
+                  buildMs,
+                  stats.shadersCompiled,
+                  stats.shadersLoaded,
+                  stats.shaderHits,
+                  stats.driverCache ? ", driver cache" : "");
+        return 0;
+    }
+}  // namespace
+
+int main(int argc, char** argv) {
+    Log::Initialize();
+    if (argc == 2) {
+        const int result = RunChild(argv[1]);
+        Log::Shutdown();
+        return result;
+    }
+
+    const fs::path directory = fs::temp_directory_path() / "XPipelineCacheBench";
+    fs::remove_all(directory);
+    Log::Info("{} permutations of a lit material, one pipeline each", 1u << kFeatureBits);
+    Log::Flush();
+
+    for (u32 run = 0; run < kRuns; ++run) {
+        const str command = fmt::format("\"{}\" \"{}\"", argv[0], directory.string());
+        std::system(command.c_str());
+    }
+
+    fs::remove_all(directory);
+    Log::Shutdown();
+    return 0;
+}
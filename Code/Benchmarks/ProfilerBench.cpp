@@ -0,0 +1,56 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include "Core/Profiler.hpp"
+#include "Core/Log.hpp"
+
+#include <chrono>
+
+using namespace X;
+using namespace X::Core;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    // Opens and closes zoneCount nested pairs of zones, returns ns per zone
+    f64 MeasureZones(u32 zoneCount) {
+        const auto start = Clock::now();
+        for (u32 i = 0; i < zoneCount / 2; ++i) {
+            PROFILE_SCOPE("Outer");
+            PROFILE_SCOPE("Inner");
+        }
+        return std::chrono::duration<f64, std::nano>(Clock::now() - start).count() / zoneCount;
+    }
+
+    f64 Best(u32 iterations, u32 zoneCount) {
+        f64 best = 1.0e12;
+        for (u32 i = 0; i < iterations; ++i) {
+            best = std::min(best, MeasureZones(zoneCount));
+        }
+        return best;
+    }
+}  // namespace
+
+int main() {
+    Log::Initialize();
+
+    // Stay under the per-thread buffer so the capturing case measures recording, not dropping
+    constexpr u32 kZones      = Profiler::kEventsPerThread / 2;
+    constexpr u32 kIterations = 20;
+
+#if !defined(ENGINE_PROFILER_ENABLED)
+    Log::Warn("Profiler zones are compiled out (ENABLE_PROFILER=OFF), both numbers measure an empty loop");
+#endif
+
+    const f64 idleNs = Best(kIterations, kZones);
+
+    Profiler::BeginCapture();
+    const f64 capturingNs = Best(kIterations, kZones);
+    Profiler::EndCapture();
+
+    Log::Info("Profiler zone cost: {:.2f} ns idle, {:.2f} ns capturing", idleNs, capturingNs);
+
+    Log::Shutdown();
+    return 0;
+}
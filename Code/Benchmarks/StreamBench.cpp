@@ -0,0 +1,265 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+// Frame cost of bringing a level set in, loaded synchronously on the frame that asks for it against streamed through
+// the AssetManager. Assets are scattered around the viewer and the page cache is dropped before each mode where the
+// platform allows, so reads hit the device. Frames are paced at 60 Hz and the main thread time spent on assets is
+// recorded per frame. No GPU is involved, so the streamed frame cost is bookkeeping and read hand-off only; GPU
+// upload time is not measured here.
+
+#include "Asset/ArchiveWriter.hpp"
+#include "Asset/AssetManager.hpp"
+#include "Core/FileReader.hpp"
+#include "Core/Log.hpp"
+#include "Core/Timing.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <random>
+#include <thread>
+
+#if defined(ENGINE_PLATFORM_LINUX)
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+using namespace X;
+using namespace X::Core;
+using namespace X::Render;
+
+namespace {
+    namespace fs = std::filesystem;
+
+    constexpr u32 kMeshes       = 96;
+    constexpr u32 kTextures     = 32;
+    constexpr u32 kTextureSize  = 1024;
+    constexpr f32 kWorldRadius  = 500.0f;
+    constexpr f64 kFrameMs      = 1000.0 / 60.0;
+    constexpr u32 kMaxFrames    = 6000;
+    constexpr const char* kPack = "Stream.xpak";
+
+    struct Placement {
+        str name;
+        Asset::AssetType type;
+        Vec3 position;
+    };
+
+    // Written pages are flushed first, clean ones can then be dropped without privileges
+    void DropPageCache(const fs::path& path) {
+#if defined(ENGINE_PLATFORM_LINUX)
+        const int file = open(path.c_str(), O_RDONLY);
+        if (file < 0) return;
+        fdatasync(file);
+        posix_fadvise(file, 0, 0, POSIX_FADV_DONTNEED);
+        close(file);
+#else
+        (void)path;
+#endif
+    }
+
+    MeshData MakeMesh(u32 rings, u32 segments) {
+        MeshData data;
+        for (u32 ring = 0; ring <= rings; ++ring) {
+            const f32 theta = 3.14159265f * CAST<f32>(ring) / rings;
+            for (u32 segment = 0; segment <= segments; ++segment) {
+                const f32 phi = 6.2831853f * CAST<f32>(segment) / segments;
+                const Vec3 normal(std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi));
+                data.positions.push_back(normal);
+                data.normals.push_back(normal);
+                data.uvs.emplace_back(CAST<f32>(segment) / segments, CAST<f32>(ring) / rings);
+            }
+        }
+        for (u32 ring = 0; ring < rings; ++ring) {
+            for (u32 segment = 0; segment < segments; ++segment) {
+                const u32 corner = ring * (segments + 1) + segment;
+                const u32 below  = corner + segments + 1;
+                for (const u32 index : {corner, corner + 1, below, corner + 1, below + 1, below}) {
+                    data.indices.push_back(index);
+                }
+            }
+        }
+        return data;
+    }
+
+    bool Generate(const fs::path& path, vector<Placement>& placements) {
+        Asset::ArchiveWriter writer;
+        std::mt19937 rng(5);
+        std::uniform_real_distribution<f32> coordinate(-kWorldRadius, kWorldRadius);
+        const auto place = [&](const str& name, Asset::AssetType type) {
+            placements.push_back({name, type, Vec3(coordinate(rng), 0.0f, coordinate(rng))});
+        };
+
+        for (u32 i = 0; i < kMeshes; ++i) {
+            const u32 rings = 32 + rng() % 160;
+            MeshDesc desc;
+            desc.optimize = false;
+            PackedMesh packed;
+            if (!Mesh::Pack(MakeMesh(rings, rings * 2), desc, packed)) return false;
+            const str name = fmt::format("mesh{}", i);
+            writer.AddMesh(name, packed);
+            place(name, Asset::AssetType::Mesh);
+        }
+
+        for (u32 i = 0; i < kTextures; ++i) {
+            vector<vector<u8>> levels;
+            vector<TextureSubresource> subresources;
+            u32 width = kTextureSize;
+            for (u32 size = kTextureSize; size > 0; size /= 2) {
+                vector<u8>& level = levels.emplace_back(CAST<size_t>(size) * size * 4);
+                for (size_t p = 0; p < level.size(); ++p) {
+                    level[p] = CAST<u8>(p * 3 + i);
+                }
+            }
+            for (const vector<u8>& level : levels) {
+                subresources.push_back({level.data(), level.size(), width * 4});
+                width /= 2;
+            }
+
+            TextureImage image;
+            image.layout.width     = kTextureSize;
+            image.layout.height    = kTextureSize;
+            image.layout.mipLevels = CAST<u32>(levels.size());
+            image.subresources     = subresources.data();
+            image.subresourceCount = CAST<u32>(subresources.size());
+
+            const str name = fmt::format("texture{}", i);
+            writer.AddTexture(name, image);
+            place(name, Asset::AssetType::Texture);
+        }
+        return writer.Write(path.string());
+    }
+
+    // What a loader without streaming does: every read and parse on the frame that asked
+    void RunBlocking(const fs::path& path, const vector<Placement>& placements) {
+        Asset::AssetArchive archive;
+        FileReader reader;
+        if (!archive.Open(path.string()) || !reader.Open(path.string(), 1)) return;
+
+        const auto start = Clock::now();
+        vector<u8> blob;
+        vector<TextureSubresource> subresources;
+        u32 loaded = 0;
+        for (const Placement& placement : placements) {
+            const Asset::ArchiveEntry* entry = archive.Find(placement.name);
+            if (!entry) continue;
+            blob.resize(CAST<size_t>(entry->size));
+            ReadRequest request {entry->offset, entry->size, blob.data(), false};
+            reader.Read(&request, 1);
+            if (!request.succeeded) continue;
+
+            MeshImage mesh;
+            TextureImage texture;
+            const bool parsed = placement.type == Asset::AssetType::Mesh
+                                  ? Asset::AssetArchive::ParseMesh(blob.data(), blob.size(), mesh)
+                                  : Asset::AssetArchive::ParseTexture(blob.data(), blob.size(), texture, subresources);
+            if (parsed) { ++loaded; }
+        }
+        const f64 milliseconds = ElapsedMs(start);
+        Log::Info("Blocking:  {} assets in one frame of {:.1f} ms ({:.0f} frames of 60 Hz budget)",
+                  loaded,
+                  milliseconds,
+                  milliseconds / kFrameMs);
+    }
+
+    void RunStreaming(const fs::path& path, const vector<Placement>& placements) {
+        JobSystem jobs;
+        Asset::AssetManager assets(nullptr, jobs);
+        if (!assets.Mount(path.string())) return;
+
+        const auto start = Clock::now();
+        vector<u32> loadedFrame(placements.size(), 0);
+        vector<Asset::MeshHandle> meshes;
+        vector<Asset::TextureHandle> textures;
+        f64 worstFrameMs = 0.0;
+        f64 totalMs      = 0.0;
+
+        const auto requestStart = Clock::now();
+        for (const Placement& placement : placements) {
+            if (placement.type == Asset::AssetType::Mesh) {
+                meshes.push_back(assets.LoadMesh(placement.name, placement.position));
+            } else {
+                textures.push_back(assets.LoadTexture(placement.name, placement.position));
+            }
+        }
+        const f64 requestMs = ElapsedMs(requestStart);
+
+        u32 frame = 0;
+        for (; frame < kMaxFrames; ++frame) {
+            const auto frameStart = Clock::now();
+            assets.Update();
+            const f64 frameMs = ElapsedMs(frameStart) + (frame == 0 ? requestMs : 0.0);
+            worstFrameMs      = std::max(worstFrameMs, frameMs);
+            totalMs += frameMs;
+
+            u32 meshIndex    = 0;
+            u32 textureIndex = 0;
+            for (size_t i = 0; i < placements.size(); ++i) {
+                const Asset::AssetState state = placements[i].type == Asset::AssetType::Mesh
+                                                  ? assets.GetState(meshes[meshIndex++])
+                                                  : assets.GetState(textures[textureIndex++]);
+                if (loadedFrame[i] == 0 && state == Asset::AssetState::Loaded) { loadedFrame[i] = frame + 1; }
+            }
+            if (assets.IsIdle()) break;
+            std::this_thread::sleep_until(start + std::chrono::duration<f64, std::milli>(kFrameMs * (frame + 1)));
+        }
+
+        // Load order against distance: the nearest quarter should arrive well before the farthest
+        vector<size_t> order(placements.size());
+        for (size_t i = 0; i < order.size(); ++i) {
+            order[i] = i;
+        }
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return glm::dot(placements[a].position, placements[a].position) <
+                   glm::dot(placements[b].position, placements[b].position);
+        });
+        const size_t quarter = order.size() / 4;
+        f64 nearFrames       = 0.0;
+        f64 farFrames        = 0.0;
+        for (size_t i = 0; i < quarter; ++i) {
+            nearFrames += loadedFrame[order[i]];
+            farFrames += loadedFrame[order[order.size() - 1 - i]];
+        }
+
+        const Asset::StreamingStats stats = assets.GetStats();
+        Log::Info("Streaming: {} assets over {} frames, worst frame {:.3f} ms, average {:.3f} ms",
+                  stats.loaded,
+                  frame + 1,
+                  worstFrameMs,
+                  totalMs / (frame + 1));
+        Log::Info("           {} batches, {:.1f} MB read, io_uring {}, nearest quarter loaded by frame {:.1f} on "
+                  "average, farthest by {:.1f}",
+                  stats.batches,
+                  CAST<f64>(stats.bytesRead) / 1048576.0,
+                  stats.ioUring ? "on" : "off",
+                  nearFrames / CAST<f64>(quarter),
+                  farFrames / CAST<f64>(quarter));
+    }
+}  // namespace
+
+int main() {
+    Log::Initialize();
+
+    const fs::path path = fs::temp_directory_path() / kPack;
+    vector<Placement> placements;
+    if (!Generate(path, placements)) {
+        Log::Error("Failed to generate {}", path.string());
+        Log::Shutdown();
+        return 1;
+    }
+    Log::Info("Level set: {} meshes, {} textures ({}x{} with mips), {:.1f} MB",
+              kMeshes,
+              kTextures,
+              kTextureSize,
+              kTextureSize,
+              CAST<f64>(fs::file_size(path)) / 1048576.0);
+
+    DropPageCache(path);
+    RunBlocking(path, placements);
+    DropPageCache(path);
+    RunStreaming(path, placements);
+
+    fs::remove(path);
+    Log::Shutdown();
+    return 0;
+}
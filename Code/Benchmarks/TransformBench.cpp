@@ -0,0 +1,96 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include "Core/JobSystem.hpp"
+#include "Core/Log.hpp"
+#include "Math/Transform.hpp"
+
+#include <chrono>
+#include <random>
+
+using namespace X;
+using namespace X::Core;
+using namespace X::Math;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr u32 kTransforms = 1000000;
+    constexpr u32 kChildren   = 4;     // Per transform, every tree is a complete 4-ary tree
+    constexpr u32 kTreeSize   = 1365;  // 1 + 4 + 16 + 64 + 256 + 1024
+    constexpr u32 kIterations = 10;
+
+    void Build(TransformHierarchy& hierarchy, vector<TransformHandle>& handles) {
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<f32> offset(-1.0f, 1.0f);
+
+        hierarchy.Reserve(kTransforms);
+        handles.reserve(kTransforms);
+        while (handles.size() < kTransforms) {
+            const size_t root = handles.size();
+            for (u32 i = 0; i < kTreeSize && handles.size() < kTransforms; ++i) {
+                Transform local;
+                local.position = Vec3(offset(rng), offset(rng), offset(rng));
+                const TransformHandle parent = i == 0 ? kInvalidTransform : handles[root + (i - 1) / kChildren];
+                handles.push_back(hierarchy.Create(local, parent));
+            }
+        }
+    }
+
+    // Marks every stride-th transform dirty each iteration, returns the best ms per Update
+    f64 Measure(TransformHierarchy& hierarchy, const vector<TransformHandle>& handles, u32 stride, JobSystem* jobs) {
+        f64 best = 1.0e12;
+        for (u32 iteration = 0; iteration < kIterations; ++iteration) {
+            if (stride > 0) {
+                for (size_t i = iteration % stride; i < handles.size(); i += stride) {
+                    hierarchy.SetPosition(handles[i], Vec3(CAST<f32>(iteration), 0.0f, 0.0f));
+                }
+            }
+
+            const auto start = Clock::now();
+            hierarchy.Update(jobs);
+            best = std::min(best, std::chrono::duration<f64, std::milli>(Clock::now() - start).count());
+        }
+        return best;
+    }
+}  // namespace
+
+int main() {
+    Log::Initialize();
+
+    TransformHierarchy hierarchy;
+    vector<TransformHandle> handles;
+    Build(hierarchy, handles);
+
+    // The first Update sorts the hierarchy and computes every world matrix
+    auto start = Clock::now();
+    hierarchy.Update();
+    const f64 firstMs = std::chrono::duration<f64, std::milli>(Clock::now() - start).count();
+    Log::Info("{} transforms in {} tasks, first update (sort + full) {:.2f} ms",
+              hierarchy.GetCount(),
+              hierarchy.GetStats().tasks,
+              firstMs);
+
+    JobSystem jobs;
+    struct Case {
+        const char* name;
+        u32 stride;
+    };
+    for (const Case& workload : {Case {"all dirty", 1}, Case {"1% dirty", 100}, Case {"static", 0}}) {
+        const f64 serialMs   = Measure(hierarchy, handles, workload.stride, nullptr);
+        const f64 parallelMs = Measure(hierarchy, handles, workload.stride, &jobs);
+        const auto& stats    = hierarchy.GetStats();
+        Log::Info("{:<10} {:8.3f} ms serial, {:8.3f} ms on {} threads ({} updated, {} of {} tasks skipped)",
+                  workload.name,
+                  serialMs,
+                  parallelMs,
+                  jobs.GetThreadCount(),
+                  stats.updated,
+                  stats.skippedTasks,
+                  stats.tasks);
+    }
+
+    Log::Shutdown();
+    return 0;
+}
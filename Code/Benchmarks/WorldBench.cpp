@@ -0,0 +1,131 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include "BenchCommon.hpp"
+#include "Core/JobSystem.hpp"
+#include "Core/Log.hpp"
+#include "Math/Transform.hpp"
+#include "Scene/World.hpp"
+
+#include <random>
+
+using namespace X;
+using namespace X::Bench;
+using namespace X::Core;
+using namespace X::Scene;
+
+namespace {
+    constexpr u32 kEntities   = 1000000;
+    constexpr u32 kChurn      = 100000;
+    constexpr u32 kIterations = 10;
+
+    struct Velocity {
+        Vec3 linear {0.0f};
+    };
+
+    struct WorldMatrix {
+        Mat4 matrix {1.0f};
+    };
+
+    struct Tag {};
+
+    // The same data as heap objects reached through pointers, the layout the ECS replaces
+    struct GameObject {
+        Math::Transform transform;
+        Velocity velocity;
+        WorldMatrix world;
+    };
+
+    void Integrate(Math::Transform& transform, const Velocity& velocity, WorldMatrix& world) {
+        transform.position += velocity.linear * 0.016f;
+        world.matrix = transform.ToMatrix();
+    }
+}  // namespace
+
+int main() {
+    Log::Initialize();
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<f32> value(-1.0f, 1.0f);
+
+    World world;
+    world.Reserve(kEntities);
+    vector<Entity> entities;
+    entities.reserve(kEntities);
+
+    auto start = Clock::now();
+    for (u32 i = 0; i < kEntities; ++i) {
+        Math::Transform transform;
+        transform.position = Vec3(value(rng), value(rng), value(rng));
+        const Velocity velocity {Vec3(value(rng), value(rng), value(rng))};
+        entities.push_back(world.Create(transform, velocity, WorldMatrix {}));
+    }
+    const WorldStats stats = world.GetStats();
+    Log::Info("Created {} entities in {:.2f} ms ({} chunks, {:.1f} MB)",
+              stats.entities,
+              ElapsedMs(start),
+              stats.chunks,
+              CAST<f64>(stats.chunkBytes) / (1024.0 * 1024.0));
+
+    // Pointer-chasing baseline, allocated shuffled the way long-lived objects end up scattered over the heap
+    vector<unique_ptr<GameObject>> objects(kEntities);
+    {
+        vector<u32> order(kEntities);
+        for (u32 i = 0; i < kEntities; ++i) {
+            order[i] = i;
+        }
+        std::shuffle(order.begin(), order.end(), rng);
+        for (const u32 i : order) {
+            objects[i] = make_unique<GameObject>();
+        }
+    }
+
+    const f64 objectMs = Measure(kIterations, [&] {
+        for (const auto& object : objects) {
+            Integrate(object->transform, object->velocity, object->world);
+        }
+    });
+
+    Query<Math::Transform, const Velocity, WorldMatrix> query(world);
+    const f64 serialMs = Measure(kIterations, [&] { query.Each(Integrate); });
+
+    JobSystem jobs;
+    const f64 parallelMs = Measure(kIterations, [&] { query.ParallelEach(&jobs, Integrate); });
+
+    Log::Info("Integrate {} entities: objects {:.2f} ms, query {:.2f} ms, parallel query {:.2f} ms on {} threads",
+              kEntities,
+              objectMs,
+              serialMs,
+              parallelMs,
+              jobs.GetThreadCount());
+
+    // Structural changes: each moves the entity between archetypes and swap-removes its old row
+    start = Clock::now();
+    for (u32 i = 0; i < kChurn; ++i) {
+        world.Add<Tag>(entities[i * (kEntities / kChurn)]);
+    }
+    const f64 addMs = ElapsedMs(start);
+
+    start = Clock::now();
+    for (u32 i = 0; i < kChurn; ++i) {
+        world.Remove<Tag>(entities[i * (kEntities / kChurn)]);
+    }
+    const f64 removeMs = ElapsedMs(start);
+
+    start = Clock::now();
+    for (u32 i = 0; i < kChurn; ++i) {
+        world.Destroy(entities[i * (kEntities / kChurn)]);
+    }
+    const f64 destroyMs = ElapsedMs(start);
+
+    Log::Info("{} adds {:.2f} ms, removes {:.2f} ms, destroys {:.2f} ms ({:.0f} ns per change)",
+              kChurn,
+              addMs,
+              removeMs,
+              destroyMs,
+              (addMs + removeMs + destroyMs) * 1.0e6 / (3.0 * kChurn));
+
+    Log::Shutdown();
+    return 0;
+}
@@ -0,0 +1,102 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#pragma once
+
+#include "EnginePCH.h"
+#include "Render/Mesh.hpp"
+#include "Render/Texture.hpp"
+
+#include <type_traits>
+
+// On-disk layout of packed asset archives, shared by the offline packer and the runtime reader. Everything is stored
+// in the host's native byte order and alignment so the reader can use it in place:
+//
+//   ArchiveHeader | ArchiveEntry[entryCount] sorted by name hash | names | blob | blob | ...
+//
+// Blobs start on kBlobAlignment boundaries so each asset occupies whole pages and can be prefetched or evicted without
+// touching its neighbours. Offsets inside a blob are relative to the blob and kSectionAlignment aligned.
+namespace X::Asset {
+
+    inline constexpr u32 kArchiveMagic     = 0x4B415058;  // "XPAK"
+    inline constexpr u32 kArchiveVersion   = 1;
+    inline constexpr u64 kBlobAlignment    = 4096;
+    inline constexpr u64 kSectionAlignment = 16;
+
+    enum class AssetType : u32 {
+        Mesh    = 1,
+        Texture = 2,
+        Shader  = 3,
+    };
+
+    struct ArchiveHeader {
+        u32 magic {kArchiveMagic};
+        u32 version {kArchiveVersion};
+        u32 entryCount {0};
+        u32 reserved {0};
+        u64 entriesOffset {0};
+        u64 namesOffset {0};
+        u64 fileSize {0};  // Catches truncated files
+    };
+
+    struct ArchiveEntry {
+        u64 nameHash {0};
+        u64 offset {0};
+        u64 size {0};
+        u32 nameOffset {0};  // Into the names block, not null terminated
+        u32 nameLength {0};
+        AssetType type {AssetType::Mesh};
+        u32 reserved {0};
+    };
+
+    struct MeshBlob {
+        Render::MeshLayout layout;
+        u64 vertexOffset[Render::kMaxVertexStreams] {};
+        u64 vertexSize[Render::kMaxVertexStreams] {};
+        u64 indexOffset {0};
+        u64 indexSize {0};
+        u64 lodsOffset {0};  // layout.lodCount MeshLods
+    };
+
+    struct TextureBlobSubresource {
+        u64 offset {0};
+        u64 size {0};
+        u32 stride {0};
+        u32 reserved {0};
+    };
+
+    struct TextureBlob {
+        Render::TextureLayout layout;
+        u32 subresourceCount {0};
+        u64 subresourcesOffset {0};  // subresourceCount TextureBlobSubresources
+    };
+
+    // Shaders are kept as source and compiled by the device on load
+    struct ShaderBlob {
+        u32 type {0};      // Diligent::SHADER_TYPE
+        u32 language {0};  // Diligent::SHADER_SOURCE_LANGUAGE
+        u64 sourceOffset {0};
+        u64 sourceSize {0};
+        u64 entryPointOffset {0};  // Null terminated
+    };
+
+    static_assert(std::is_trivially_copyable_v<ArchiveHeader> && std::is_trivially_copyable_v<ArchiveEntry> &&
+                  std::is_trivially_copyable_v<MeshBlob> && std::is_trivially_copyable_v<TextureBlob> &&
+                  std::is_trivially_copyable_v<ShaderBlob>);
+
+    // FNV-1a, the lookup key for asset names
+    constexpr u64 HashAssetName(strview name) {
+        u64 hash = 0xCBF29CE484222325ull;
+        for (const char c : name) {
+            hash ^= CAST<u8>(c);
+            hash *= 0x100000001B3ull;
+        }
+        return hash;
+    }
+
+    constexpr u64 AlignUp(u64 value, u64 alignment) {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+}  // namespace X::Asset
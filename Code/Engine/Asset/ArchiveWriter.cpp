@@ -0,0 +1,181 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include "ArchiveWriter.hpp"
+#include "Core/Log.hpp"
+
+namespace X::Asset {
+    using namespace X::Core;
+
+    namespace {
+        // Appends a kSectionAlignment aligned copy of data to blob and returns its offset
+        u64 AppendSection(vector<u8>& blob, const void* data, u64 size) {
+            const u64 offset = AlignUp(blob.size(), kSectionAlignment);
+            blob.resize(CAST<size_t>(offset + size));
+            if (size > 0) { std::memcpy(blob.data() + offset, data, CAST<size_t>(size)); }
+            return offset;
+        }
+
+        template<typename T>
+        void WriteHeader(vector<u8>& blob, const T& header) {
+            std::memcpy(blob.data(), &header, sizeof(T));
+        }
+    }  // namespace
+
+    vector<u8>* ArchiveWriter::BeginAsset(strview name, AssetType type) {
+        const u64 hash = HashAssetName(name);
+        for (const PendingAsset& asset : _assets) {
+            if (asset.nameHash != hash) continue;
+            if (asset.name == name) {
+                Log::Error("Asset {} was added twice", name);
+            } else {
+                Log::Error("Asset names {} and {} have the same hash, rename one of them", asset.name, name);
+            }
+            return nullptr;
+        }
+
+        PendingAsset& asset = _assets.emplace_back();
+        asset.name          = name;
+        asset.nameHash      = hash;
+        asset.type          = type;
+        return &asset.blob;
+    }
+
+    bool ArchiveWriter::AddMesh(strview name, const Render::PackedMesh& mesh) {
+        vector<u8>* blob = BeginAsset(name, AssetType::Mesh);
+        if (!blob) return false;
+
+        MeshBlob header;
+        header.layout = mesh.layout;
+        blob->resize(sizeof(MeshBlob));
+        for (u32 stream = 0; stream < Render::kMaxVertexStreams; ++stream) {
+            const vector<u8>& data      = mesh.vertexData[stream];
+            header.vertexSize[stream]   = data.size();
+            header.vertexOffset[stream] = AppendSection(*blob, data.data(), data.size());
+        }
+        header.indexSize   = mesh.indexData.size();
+        header.indexOffset = AppendSection(*blob, mesh.indexData.data(), header.indexSize);
+        header.lodsOffset  = AppendSection(*blob, mesh.lods.data(), mesh.lods.size() * sizeof(Render::MeshLod));
+        WriteHeader(*blob, header);
+        return true;
+    }
+
+    bool ArchiveWriter::AddTexture(strview name, const Render::TextureImage& image) {
+        vector<u8>* blob = BeginAsset(name, AssetType::Texture);
+        if (!blob) return false;
+
+        TextureBlob header;
+        header.layout           = image.layout;
+        header.subresourceCount = image.subresourceCount;
+        blob->resize(sizeof(TextureBlob));
+
+        // The table goes first so the pixels that follow stay contiguous
+        vector<TextureBlobSubresource> subresources(image.subresourceCount);
+        header.subresourcesOffset = AppendSection(*blob,
+                                                  subresources.data(),
+                                                  subresources.size() * sizeof(TextureBlobSubresource));
+        for (u32 i = 0; i < image.subresourceCount; ++i) {
+            const Render::TextureSubresource& source = image.subresources[i];
+            subresources[i].size                     = source.size;
+            subresources[i].stride                   = source.stride;
+            subresources[i].offset                   = AppendSection(*blob, source.data, source.size);
+        }
+        std::memcpy(blob->data() + header.subresourcesOffset,
+                    subresources.data(),
+                    subresources.size() * sizeof(TextureBlobSubresource));
+        WriteHeader(*blob, header);
+        return true;
+    }
+
+    bool ArchiveWriter::AddShader(strview name,
+                                  Diligent::SHADER_TYPE type,
+                                  strview source,
+                                  strview entryPoint,
+                                  Diligent::SHADER_SOURCE_LANGUAGE language) {
+        vector<u8>* blob = BeginAsset(name, AssetType::Shader);
+        if (!blob) return false;
+
+        ShaderBlob header;
+        header.type     = CAST<u32>(type);
+        header.language = CAST<u32>(language);
+        blob->resize(sizeof(ShaderBlob));
+        header.sourceSize       = source.size();
+        header.sourceOffset     = AppendSection(*blob, source.data(), source.size());
+        const str terminated    = str(entryPoint);
+        header.entryPointOffset = AppendSection(*blob, terminated.c_str(), terminated.size() + 1);
+        WriteHeader(*blob, header);
+        return true;
+    }
+
+    bool ArchiveWriter::Write(const str& path) const {
+        vector<const PendingAsset*> sorted;
+        sorted.reserve(_assets.size());
+        for (const PendingAsset& asset : _assets) {
+            sorted.push_back(&asset);
+        }
+        std::sort(sorted.begin(), sorted.end(), [](const PendingAsset* a, const PendingAsset* b) {
+            return a->nameHash < b->nameHash;
+        });
+
+        str names;
+        for (const PendingAsset* asset : sorted) {
+            names += asset->name;
+        }
+
+        ArchiveHeader header;
+        header.entryCount    = CAST<u32>(sorted.size());
+        header.entriesOffset = sizeof(ArchiveHeader);
+        header.namesOffset   = header.entriesOffset + sorted.size() * sizeof(ArchiveEntry);
+
+        vector<ArchiveEntry> entries(sorted.size());
+        u64 offset     = AlignUp(header.namesOffset + names.size(), kBlobAlignment);
+        u32 nameOffset = 0;
+        for (size_t i = 0; i < sorted.size(); ++i) {
+            entries[i].nameHash   = sorted[i]->nameHash;
+            entries[i].offset     = offset;
+            entries[i].size       = sorted[i]->blob.size();
+            entries[i].nameOffset = nameOffset;
+            entries[i].nameLength = CAST<u32>(sorted[i]->name.size());
+            entries[i].type       = sorted[i]->type;
+            offset                = AlignUp(offset + entries[i].size, kBlobAlignment);
+            nameOffset += entries[i].nameLength;
+        }
+        header.fileSize = offset;
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            Log::Error("Failed to open {} for writing", path);
+            return false;
+        }
+
+        u64 written       = 0;
+        const auto append = [&](const void* data, u64 size) {
+            file.write(CAST<const char*>(data), CAST<std::streamsize>(size));
+            written += size;
+        };
+        const auto pad = [&](u64 target) {
+            static constexpr char zeros[kBlobAlignment] {};
+            while (written < target) {
+                append(zeros, std::min(target - written, kBlobAlignment));
+            }
+        };
+
+        append(&header, sizeof(header));
+        append(entries.data(), entries.size() * sizeof(ArchiveEntry));
+        append(names.data(), names.size());
+        for (size_t i = 0; i < sorted.size(); ++i) {
+            pad(entries[i].offset);
+            append(sorted[i]->blob.data(), sorted[i]->blob.size());
+        }
+        pad(header.fileSize);
+
+        file.close();
+        if (!file) {
+            Log::Error("Failed to write {}", path);
+            return false;
+        }
+        Log::Info("Wrote {} assets to {} ({:.1f} MB)", sorted.size(), path, CAST<f64>(header.fileSize) / 1048576.0);
+        return true;
+    }
+}  // namespace X::Asset
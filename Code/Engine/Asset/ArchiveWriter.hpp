@@ -0,0 +1,45 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#pragma once
+
+#include "EnginePCH.h"
+#include "ArchiveFormat.hpp"
+
+namespace X::Asset {
+
+    // Builds an archive in memory, one blob per asset, and writes it out in a single pass. Used by the offline packer.
+    class ArchiveWriter {
+    public:
+        // Each returns false, after logging, when the name is already taken or its hash collides with another
+        bool AddMesh(strview name, const Render::PackedMesh& mesh);
+        bool AddTexture(strview name, const Render::TextureImage& image);
+        bool AddShader(strview name,
+                       Diligent::SHADER_TYPE type,
+                       strview source,
+                       strview entryPoint                       = "main",
+                       Diligent::SHADER_SOURCE_LANGUAGE language = Diligent::SHADER_SOURCE_LANGUAGE_HLSL);
+
+        // Logs and returns false when the file cannot be written
+        bool Write(const str& path) const;
+
+        u32 GetAssetCount() const {
+            return CAST<u32>(_assets.size());
+        }
+
+    private:
+        struct PendingAsset {
+            str name;
+            u64 nameHash {0};
+            AssetType type {AssetType::Mesh};
+            vector<u8> blob;
+        };
+
+        // Starts a blob under name, or returns nullptr when the name cannot be used
+        vector<u8>* BeginAsset(strview name, AssetType type);
+
+        vector<PendingAsset> _assets;
+    };
+
+}  // namespace X::Asset
@@ -0,0 +1,247 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include "AssetArchive.hpp"
+#include "Core/Log.hpp"
+#include "Core/Profiler.hpp"
+
+namespace X::Asset {
+    using namespace X::Core;
+
+    namespace {
+        // Section [offset, offset + size) of a blob, or nullptr when it does not fit
+        const u8* GetSection(const u8* blob, u64 blobSize, u64 offset, u64 size) {
+            if (!blob || offset > blobSize || size > blobSize - offset) return nullptr;
+            return blob + offset;
+        }
+    }  // namespace
+
+    bool AssetArchive::Open(const str& path) {
+        PROFILE_SCOPE("AssetArchive::Open");
+        Close();
+        if (!_file.Open(path)) return false;
+
+        // Everything is validated once here so lookups can trust the table of contents
+        const u8* data     = _file.GetData();
+        const u64 size     = _file.GetSize();
+        const auto* header = RCAST<const ArchiveHeader*>(data);
+        if (size < sizeof(ArchiveHeader) || header->magic != kArchiveMagic) {
+            Log::Error("{} is not an asset archive", path);
+            _file.Close();
+            return false;
+        }
+        if (header->version != kArchiveVersion) {
+            Log::Error("{} is archive version {}, expected {}. Repack it.", path, header->version, kArchiveVersion);
+            _file.Close();
+            return false;
+        }
+
+        // Checked without sums that a corrupt header could wrap back into range
+        const u64 entriesOffset = header->entriesOffset;
+        const u64 namesOffset   = header->namesOffset;
+        bool valid = header->fileSize == size && entriesOffset >= sizeof(ArchiveHeader) && entriesOffset <= size &&
+                     entriesOffset % alignof(ArchiveEntry) == 0 &&
+                     header->entryCount <= (size - entriesOffset) / sizeof(ArchiveEntry) &&
+                     entriesOffset + CAST<u64>(header->entryCount) * sizeof(ArchiveEntry) <= namesOffset &&
+                     namesOffset <= size;
+
+        const auto* entries = RCAST<const ArchiveEntry*>(data + (valid ? entriesOffset : 0));
+        for (u32 i = 0; valid && i < header->entryCount; ++i) {
+            const ArchiveEntry& entry = entries[i];
+            valid = entry.offset % kBlobAlignment == 0 && entry.offset <= size && entry.size <= size - entry.offset &&
+                    entry.nameOffset <= size - namesOffset &&
+                    entry.nameLength <= size - namesOffset - entry.nameOffset &&
+                    (i == 0 || entries[i - 1].nameHash < entry.nameHash);
+        }
+        if (!valid) {
+            Log::Error("{} is truncated or corrupt", path);
+            _file.Close();
+            return false;
+        }
+
+        _path    = path;
+        _header  = header;
+        _entries = entries;
+        _names   = RCAST<const char*>(data + namesOffset);
+        Log::Info("Mapped {} ({} assets, {:.1f} MB)", path, header->entryCount, CAST<f64>(size) / 1048576.0);
+        return true;
+    }
+
+    void AssetArchive::Close() {
+        _file.Close();
+        _path.clear();
+        _header  = nullptr;
+        _entries = nullptr;
+        _names   = nullptr;
+    }
+
+    const ArchiveEntry* AssetArchive::Find(strview name) const {
+        if (!_header) return nullptr;
+
+        const auto byHash         = [](const ArchiveEntry& entry, u64 hash) { return entry.nameHash < hash; };
+        const u64 hash            = HashAssetName(name);
+        const ArchiveEntry* end   = _entries + _header->entryCount;
+        const ArchiveEntry* entry = std::lower_bound(_entries, end, hash, byHash);
+        if (entry == end || entry->nameHash != hash || GetName(*entry) != name) return nullptr;
+        return entry;
+    }
+
+    strview AssetArchive::GetName(const ArchiveEntry& entry) const {
+        return {_names + entry.nameOffset, entry.nameLength};
+    }
+
+    bool AssetArchive::ParseMesh(const u8* blob, u64 size, Render::MeshImage& image) {
+        const auto* header = RCAST<const MeshBlob*>(GetSection(blob, size, 0, sizeof(MeshBlob)));
+        if (!header) return false;
+
+        image.layout = header->layout;
+        for (u32 stream = 0; stream < Render::kMaxVertexStreams; ++stream) {
+            const u64 streamSize         = header->vertexSize[stream];
+            image.vertexData[stream]     = GetSection(blob, size, header->vertexOffset[stream], streamSize);
+            image.vertexDataSize[stream] = streamSize;
+        }
+        image.indexData     = GetSection(blob, size, header->indexOffset, header->indexSize);
+        image.indexDataSize = header->indexSize;
+        image.lods          = RCAST<const Render::MeshLod*>(
+          GetSection(blob, size, header->lodsOffset, CAST<u64>(header->layout.lodCount) * sizeof(Render::MeshLod)));
+        // Mesh::Create checks the sizes against the layout, only the ranges need checking here
+        return image.indexData && image.lods;
+    }
+
+    bool AssetArchive::ParseTexture(const u8* blob,
+                                    u64 size,
+                                    Render::TextureImage& image,
+                                    vector<Render::TextureSubresource>& subresources) {
+        const auto* header = RCAST<const TextureBlob*>(GetSection(blob, size, 0, sizeof(TextureBlob)));
+        if (!header) return false;
+
+        const u64 tableSize = CAST<u64>(header->subresourceCount) * sizeof(TextureBlobSubresource);
+        const auto* table   = RCAST<const TextureBlobSubresource*>(
+          GetSection(blob, size, header->subresourcesOffset, tableSize));
+        if (!table) return false;
+
+        subresources.resize(header->subresourceCount);
+        for (u32 i = 0; i < header->subresourceCount; ++i) {
+            subresources[i].data   = GetSection(blob, size, table[i].offset, table[i].size);
+            subresources[i].size   = table[i].size;
+            subresources[i].stride = table[i].stride;
+            if (!subresources[i].data) return false;
+        }
+        image.layout           = header->layout;
+        image.subresources     = subresources.data();
+        image.subresourceCount = header->subresourceCount;
+        return true;
+    }
+
+    bool AssetArchive::ParseShader(const u8* blob, u64 size, Diligent::ShaderCreateInfo& createInfo) {
+        const auto* header = RCAST<const ShaderBlob*>(GetSection(blob, size, 0, sizeof(ShaderBlob)));
+        if (!header) return false;
+
+        const auto* source     = RCAST<const char*>(GetSection(blob, size, header->sourceOffset, header->sourceSize));
+        const auto* entryPoint = RCAST<const char*>(GetSection(blob, size, header->entryPointOffset, 1));
+        // The entry point must be terminated inside the blob
+        if (!source || !entryPoint || !std::memchr(entryPoint, 0, CAST<size_t>(size - header->entryPointOffset))) {
+            return false;
+        }
+
+        createInfo.Source          = source;
+        createInfo.SourceLength    = CAST<size_t>(header->sourceSize);
+        createInfo.EntryPoint      = entryPoint;
+        createInfo.SourceLanguage  = CAST<Diligent::SHADER_SOURCE_LANGUAGE>(header->language);
+        createInfo.Desc.ShaderType = CAST<Diligent::SHADER_TYPE>(header->type);
+        return true;
+    }
+
+    bool AssetArchive::CheckType(const ArchiveEntry& entry, AssetType type) const {
+        if (entry.type == type) return true;
+        Log::Error("Asset {} in {} is not of type {}", GetName(entry), _path, CAST<u32>(type));
+        return false;
+    }
+
+    bool AssetArchive::GetMesh(const ArchiveEntry& entry, Render::MeshImage& image) const {
+        if (!CheckType(entry, AssetType::Mesh)) return false;
+        if (ParseMesh(GetBlob(entry), entry.size, image)) return true;
+        Log::Error("Mesh {} in {} is malformed", GetName(entry), _path);
+        return false;
+    }
+
+    bool AssetArchive::GetTexture(const ArchiveEntry& entry,
+                                  Render::TextureImage& image,
+                                  vector<Render::TextureSubresource>& subresources) const {
+        if (!CheckType(entry, AssetType::Texture)) return false;
+        if (ParseTexture(GetBlob(entry), entry.size, image, subresources)) return true;
+        Log::Error("Texture {} in {} is malformed", GetName(entry), _path);
+        return false;
+    }
+
+    bool AssetArchive::GetShader(const ArchiveEntry& entry, Diligent::ShaderCreateInfo& createInfo) const {
+        if (!CheckType(entry, AssetType::Shader)) return false;
+        if (ParseShader(GetBlob(entry), entry.size, createInfo)) return true;
+        Log::Error("Shader {} in {} is malformed", GetName(entry), _path);
+        return false;
+    }
+
+    bool AssetArchive::LoadMesh(IRenderDevice* device, strview name, Render::Mesh& mesh) const {
+        PROFILE_SCOPE("AssetArchive::LoadMesh");
+        const ArchiveEntry* entry = Find(name);
+        if (!entry) {
+            Log::Error("No mesh {} in {}", name, _path);
+            return false;
+        }
+
+        Render::MeshImage image;
+        if (!GetMesh(*entry, image)) return false;
+        const bool created = mesh.Create(device, image, str(name).c_str());
+        Evict(*entry);
+        return created;
+    }
+
+    bool AssetArchive::LoadTexture(IRenderDevice* device, strview name, Render::Texture& texture) const {
+        PROFILE_SCOPE("AssetArchive::LoadTexture");
+        const ArchiveEntry* entry = Find(name);
+        if (!entry) {
+            Log::Error("No texture {} in {}", name, _path);
+            return false;
+        }
+
+        Render::TextureImage image;
+        vector<Render::TextureSubresource> subresources;
+        if (!GetTexture(*entry, image, subresources)) return false;
+        const bool created = texture.Create(device, image, str(name).c_str());
+        Evict(*entry);
+        return created;
+    }
+
+    bool AssetArchive::LoadShader(IRenderDevice* device, strview name, RefCntAutoPtr<IShader>& shader) const {
+        PROFILE_SCOPE("AssetArchive::LoadShader");
+        const ArchiveEntry* entry = Find(name);
+        if (!entry) {
+            Log::Error("No shader {} in {}", name, _path);
+            return false;
+        }
+
+        const str shaderName = str(name);
+        Diligent::ShaderCreateInfo createInfo;
+        if (!GetShader(*entry, createInfo)) return false;
+        createInfo.Desc.Name = shaderName.c_str();
+
+        RefCntAutoPtr<IShader> created;
+        device->CreateShader(createInfo, &created);
+        Evict(*entry);
+        if (!created) {
+            Log::Error("Failed to compile shader {} from {}", name, _path);
+            return false;
+        }
+        shader = std::move(created);
+        return true;
+    }
+
+    void AssetArchive::Prefetch(const ArchiveEntry& entry) const {
+        _file.Prefetch(entry.offset, entry.size);
+    }
+
+    void AssetArchive::Evict(const ArchiveEntry& entry) const {
+        _file.Evict(entry.offset, entry.size);
+    }
+}  // namespace X::Asset
@@ -0,0 +1,81 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#pragma once
+
+#include "EnginePCH.h"
+#include "ArchiveFormat.hpp"
+#include "Core/MappedFile.hpp"
+
+namespace X::Asset {
+
+    // Read-only view of a packed asset archive. Opening maps the file and checks the table of contents, nothing else
+    // is read until an asset is asked for. Assets are handed to the device straight from the mapping: there is no
+    // per-asset allocation, copy or parsing on the CPU beyond the fixed-size blob header. Lookups are a binary search
+    // by name hash. Const methods are safe to call from several threads.
+    class AssetArchive {
+    public:
+        // Logs and returns false when the file is missing, truncated or not an archive of this version
+        bool Open(const str& path);
+        void Close();
+
+        // nullptr when there is no asset by that name
+        const ArchiveEntry* Find(strview name) const;
+        strview GetName(const ArchiveEntry& entry) const;
+
+        // Views into the mapping, valid until Close. Log and return false when the entry is of another type or its
+        // blob is malformed.
+        bool GetMesh(const ArchiveEntry& entry, Render::MeshImage& image) const;
+        bool GetTexture(const ArchiveEntry& entry,
+                        Render::TextureImage& image,
+                        vector<Render::TextureSubresource>& subresources) const;
+        bool GetShader(const ArchiveEntry& entry, Diligent::ShaderCreateInfo& createInfo) const;
+
+        // Creates the GPU resource for an asset from the mapping, then evicts its pages since the device keeps its
+        // own copy. Log and return false when the asset is missing or creation fails.
+        bool LoadMesh(IRenderDevice* device, strview name, Render::Mesh& mesh) const;
+        bool LoadTexture(IRenderDevice* device, strview name, Render::Texture& texture) const;
+        bool LoadShader(IRenderDevice* device, strview name, RefCntAutoPtr<IShader>& shader) const;
+
+        // Point an image at the sections of a blob read from an archive, wherever it is in memory. Return false when
+        // the blob is malformed. The blob must outlive the image.
+        static bool ParseMesh(const u8* blob, u64 size, Render::MeshImage& image);
+        static bool ParseTexture(const u8* blob,
+                                 u64 size,
+                                 Render::TextureImage& image,
+                                 vector<Render::TextureSubresource>& subresources);
+        static bool ParseShader(const u8* blob, u64 size, Diligent::ShaderCreateInfo& createInfo);
+
+        // Starts reading an asset's pages ahead of use, for loaders that know what comes next
+        void Prefetch(const ArchiveEntry& entry) const;
+        void Evict(const ArchiveEntry& entry) const;
+
+        u32 GetAssetCount() const {
+            return _header ? _header->entryCount : 0;
+        }
+        const ArchiveEntry& GetEntry(u32 index) const {
+            return _entries[index];
+        }
+        u64 GetSize() const {
+            return _file.GetSize();
+        }
+        bool IsOpen() const {
+            return _header != nullptr;
+        }
+
+    private:
+        const u8* GetBlob(const ArchiveEntry& entry) const {
+            return _file.GetData() + entry.offset;
+        }
+        // Logs when the entry is of another type
+        bool CheckType(const ArchiveEntry& entry, AssetType type) const;
+
+        Core::MappedFile _file;
+        str _path;
+        const ArchiveHeader* _header {nullptr};
+        const ArchiveEntry* _entries {nullptr};
+        const char* _names {nullptr};
+    };
+
+}  // namespace X::Asset
@@ -0,0 +1,433 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include "AssetManager.hpp"
+#include "Core/FileReader.hpp"
+#include "Core/Log.hpp"
+#include "Core/Profiler.hpp"
+#include "Core/Timing.hpp"
+
+namespace X::Asset {
+    using namespace X::Core;
+
+    namespace {
+        const char* GetTypeName(AssetType type) {
+            switch (type) {
+                case AssetType::Mesh:
+                    return "mesh";
+                case AssetType::Texture:
+                    return "texture";
+                default:
+                    return "shader";
+            }
+        }
+    }  // namespace
+
+    struct AssetManager::Slot {
+        // Written under the lock, read without it by the render thread's accessors
+        std::atomic<AssetState> state {AssetState::Unloaded};
+        u32 generation {1};  // Starts at 1 so default handles never match
+        u32 references {0};
+        AssetType type {AssetType::Mesh};
+        const ArchiveEntry* entry {nullptr};
+        Vec3 position {0.0f};
+        bool placed {false};
+
+        // Owned by whichever stage the state names
+        vector<u8> blob;
+        Render::MeshImage meshImage;
+        Render::TextureImage textureImage;
+        vector<Render::TextureSubresource> subresources;
+        Diligent::ShaderCreateInfo shaderInfo;
+
+        Render::Mesh mesh;
+        Render::Texture texture;
+        RefCntAutoPtr<IShader> shader;
+    };
+
+    AssetManager::AssetManager(IRenderDevice* device, JobSystem& jobs, const AssetManagerConfig& config)
+        : _device(device), _jobs(jobs), _config(config), _slots(std::max(config.maxAssets, 1u)) {
+        _config.ioThreads = std::max(_config.ioThreads, 1u);
+        _config.batchSize = std::max(_config.batchSize, 1u);
+        _freeSlots.reserve(_slots.size());
+        for (u32 index = CAST<u32>(_slots.size()); index > 0; --index) {
+            _freeSlots.push_back(index - 1);
+        }
+    }
+
+    AssetManager::~AssetManager() {
+        {
+            std::lock_guard guard(_lock);
+            _stopping = true;
+        }
+        _requestsReady.notify_all();
+        for (std::thread& thread : _ioThreads) {
+            thread.join();
+        }
+        // Decode jobs touch the slots, let them finish before the slots go
+        _jobs.Wait(_decodeJobs);
+    }
+
+    bool AssetManager::Mount(const str& archivePath) {
+        if (_archive.IsOpen()) {
+            Log::Error("Cannot mount {}, {} is already mounted", archivePath, _archivePath);
+            return false;
+        }
+        if (!_archive.Open(archivePath)) return false;
+
+        _archivePath = archivePath;
+        for (u32 i = 0; i < _config.ioThreads; ++i) {
+            _ioThreads.emplace_back([this, i] {
+                PROFILE_THREAD(fmt::format("I/O {}", i).c_str());
+                IoThreadMain();
+            });
+        }
+        return true;
+    }
+
+    MeshHandle AssetManager::LoadMesh(strview name, optional<Vec3> position) {
+        MeshHandle handle;
+        handle.index = Load(name, AssetType::Mesh, position, handle.generation);
+        return handle;
+    }
+
+    TextureHandle AssetManager::LoadTexture(strview name, optional<Vec3> position) {
+        TextureHandle handle;
+        handle.index = Load(name, AssetType::Texture, position, handle.generation);
+        return handle;
+    }
+
+    ShaderHandle AssetManager::LoadShader(strview name, optional<Vec3> position) {
+        ShaderHandle handle;
+        handle.index = Load(name, AssetType::Shader, position, handle.generation);
+        return handle;
+    }
+
+    u32 AssetManager::Load(strview name, AssetType type, const optional<Vec3>& position, u32& generation) {
+        // The archive is immutable once mounted, so lookups need no lock
+        const ArchiveEntry* entry = _archive.Find(name);
+        if (!entry || entry->type != type) {
+            Log::Error("No {} named {} in {}", GetTypeName(type), name, _archivePath);
+            return ~0u;
+        }
+
+        std::lock_guard guard(_lock);
+        u32 index = 0;
+        if (const auto it = _loadedEntries.find(entry); it != _loadedEntries.end()) {
+            index      = it->second;
+            Slot& slot = _slots[index];
+            ++slot.references;
+            // Released before its read was issued, queue it again
+            if (slot.state.load(std::memory_order_relaxed) == AssetState::Unloaded) {
+                slot.state.store(AssetState::Queued, std::memory_order_relaxed);
+                _queue.push_back(index);
+                _requestsReady.notify_one();
+            }
+        } else {
+            if (_freeSlots.empty()) {
+                Log::Error("Cannot load {}, all {} asset slots are in use", name, _slots.size());
+                return ~0u;
+            }
+            index = _freeSlots.back();
+            _freeSlots.pop_back();
+
+            Slot& slot      = _slots[index];
+            slot.references = 1;
+            slot.type       = type;
+            slot.entry      = entry;
+            slot.position   = position.value_or(Vec3(0.0f));
+            slot.placed     = position.has_value();
+            slot.state.store(AssetState::Queued, std::memory_order_relaxed);
+            _loadedEntries.emplace(entry, index);
+            _queue.push_back(index);
+            _requestsReady.notify_one();
+        }
+        generation = _slots[index].generation;
+        return index;
+    }
+
+    void AssetManager::Release(u32 index, u32 generation) {
+        std::lock_guard guard(_lock);
+        if (index >= _slots.size()) return;
+        Slot& slot = _slots[index];
+        if (slot.generation != generation || slot.references == 0) return;
+        // A slot reloaded and released again before Update freed it is already listed
+        if (--slot.references == 0 && std::find(_released.begin(), _released.end(), index) == _released.end()) {
+            _released.push_back(index);
+        }
+    }
+
+    AssetState AssetManager::GetState(u32 index, u32 generation) const {
+        std::lock_guard guard(_lock);
+        if (index >= _slots.size() || _slots[index].generation != generation) return AssetState::Unloaded;
+        return _slots[index].state.load(std::memory_order_relaxed);
+    }
+
+    const AssetManager::Slot* AssetManager::GetLoaded(u32 index, u32 generation, AssetType type) const {
+        // Generations only change in Update, on this thread. The type is stable once the state reads Loaded.
+        if (index >= _slots.size()) return nullptr;
+        const Slot& slot = _slots[index];
+        if (slot.generation != generation || slot.state.load(std::memory_order_acquire) != AssetState::Loaded) {
+            return nullptr;
+        }
+        return slot.type == type ? &slot : nullptr;
+    }
+
+    const Render::Mesh* AssetManager::GetMesh(MeshHandle handle) const {
+        const Slot* slot = GetLoaded(handle.index, handle.generation, AssetType::Mesh);
+        return slot ? &slot->mesh : nullptr;
+    }
+
+    const Render::Texture* AssetManager::GetTexture(TextureHandle handle) const {
+        const Slot* slot = GetLoaded(handle.index, handle.generation, AssetType::Texture);
+        return slot ? &slot->texture : nullptr;
+    }
+
+    IShader* AssetManager::GetShader(ShaderHandle handle) const {
+        const Slot* slot = GetLoaded(handle.index, handle.generation, AssetType::Shader);
+        return slot ? slot->shader.RawPtr() : nullptr;
+    }
+
+    void AssetManager::SetViewer(const Vec3& position) {
+        std::lock_guard guard(_lock);
+        _viewer = position;
+    }
+
+    f32 AssetManager::GetDistance(const Slot& slot, const Vec3& viewer) {
+        // Unplaced assets are wanted everywhere, ahead of anything in the world
+        if (!slot.placed) return -1.0f;
+        const Vec3 offset = slot.position - viewer;
+        return glm::dot(offset, offset);
+    }
+
+    void AssetManager::IoThreadMain() {
+        FileReader reader;
+        const bool opened = reader.Open(_archivePath, _config.batchSize);
+        {
+            std::lock_guard guard(_lock);
+            _stats.ioUring = _stats.ioUring || reader.IsUsingIoUring();
+        }
+
+        vector<u32> batch;
+        vector<ReadRequest> reads;
+        for (;;) {
+            batch.clear();
+            {
+                std::unique_lock lock(_lock);
+                _requestsReady.wait(lock, [this] { return _stopping || !_queue.empty(); });
+                if (_stopping) return;
+
+                // Nearest at the back, where the batch is taken from
+                const Vec3 viewer = _viewer;
+                std::sort(_queue.begin(), _queue.end(), [&](u32 a, u32 b) {
+                    return GetDistance(_slots[a], viewer) > GetDistance(_slots[b], viewer);
+                });
+
+                u64 bytes = 0;
+                while (!_queue.empty() && batch.size() < _config.batchSize) {
+                    const u32 index = _queue.back();
+                    Slot& slot      = _slots[index];
+                    if (slot.references == 0) {
+                        // Released while queued, Update recycles the slot
+                        slot.state.store(AssetState::Unloaded, std::memory_order_relaxed);
+                        _queue.pop_back();
+                        continue;
+                    }
+                    if (!batch.empty() && bytes + slot.entry->size > _config.batchBytes) break;
+
+                    bytes += slot.entry->size;
+                    batch.push_back(index);
+                    _queue.pop_back();
+                    slot.state.store(AssetState::Reading, std::memory_order_relaxed);
+                }
+                _inFlight += CAST<u32>(batch.size());
+            }
+            if (batch.empty()) continue;
+
+            // In file order, so the device sees one mostly sequential sweep
+            std::sort(batch.begin(), batch.end(), [this](u32 a, u32 b) {
+                return _slots[a].entry->offset < _slots[b].entry->offset;
+            });
+            reads.resize(batch.size());
+            u64 bytes = 0;
+            for (size_t i = 0; i < batch.size(); ++i) {
+                Slot& slot = _slots[batch[i]];
+                slot.blob.resize(CAST<size_t>(slot.entry->size));
+                reads[i] = {slot.entry->offset, slot.entry->size, slot.blob.data(), false};
+                bytes += slot.entry->size;
+            }
+            if (opened) {
+                PROFILE_SCOPE("AssetManager::Read");
+                reader.Read(reads.data(), CAST<u32>(reads.size()));
+            }
+
+            std::lock_guard guard(_lock);
+            _stats.bytesRead += bytes;
+            ++_stats.batches;
+            for (size_t i = 0; i < batch.size(); ++i) {
+                const u32 index = batch[i];
+                Slot& slot      = _slots[index];
+                if (reads[i].succeeded) {
+                    slot.state.store(AssetState::Decoding, std::memory_order_relaxed);
+                    _jobs.Run([this, index] { Decode(index); }, &_decodeJobs);
+                } else {
+                    Log::Error("Failed to read {} from {}", _archive.GetName(*slot.entry), _archivePath);
+                    slot.blob = {};
+                    slot.state.store(AssetState::Failed, std::memory_order_relaxed);
+                    --_inFlight;
+                }
+            }
+        }
+    }
+
+    void AssetManager::Decode(u32 index) {
+        PROFILE_SCOPE("AssetManager::Decode");
+        // Blobs are GPU-ready, decoding only points the images at their sections and checks they fit. Compressed
+        // formats would be expanded here.
+        Slot& slot      = _slots[index];
+        const u8* blob  = slot.blob.data();
+        const u64 size  = slot.blob.size();
+        bool parsed     = false;
+        switch (slot.type) {
+            case AssetType::Mesh:
+                parsed = AssetArchive::ParseMesh(blob, size, slot.meshImage);
+                break;
+            case AssetType::Texture:
+                parsed = AssetArchive::ParseTexture(blob, size, slot.textureImage, slot.subresources);
+                break;
+            default:
+                parsed = AssetArchive::ParseShader(blob, size, slot.shaderInfo);
+                break;
+        }
+
+        std::lock_guard guard(_lock);
+        --_inFlight;
+        if (!parsed) {
+            Log::Error("{} {} in {} is malformed", GetTypeName(slot.type), _archive.GetName(*slot.entry), _archivePath);
+            slot.blob = {};
+            slot.state.store(AssetState::Failed, std::memory_order_relaxed);
+            return;
+        }
+        slot.state.store(AssetState::Uploading, std::memory_order_relaxed);
+        _uploads.push_back(index);
+    }
+
+    bool AssetManager::Upload(Slot& slot) {
+        if (!_device) return true;
+
+        const str name(_archive.GetName(*slot.entry));
+        switch (slot.type) {
+            case AssetType::Mesh:
+                return slot.mesh.Create(_device, slot.meshImage, name.c_str());
+            case AssetType::Texture:
+                return slot.texture.Create(_device, slot.textureImage, name.c_str());
+            default: {
+                slot.shaderInfo.Desc.Name = name.c_str();
+                RefCntAutoPtr<IShader> shader;
+                _device->CreateShader(slot.shaderInfo, &shader);
+                if (!shader) {
+                    Log::Error("Failed to compile shader {} from {}", name, _archivePath);
+                    return false;
+                }
+                slot.shader = std::move(shader);
+                return true;
+            }
+        }
+    }
+
+    void AssetManager::Unload(u32 index) {
+        Slot& slot = _slots[index];
+        _loadedEntries.erase(slot.entry);
+        slot.mesh         = {};
+        slot.texture      = {};
+        slot.shader       = {};
+        slot.blob         = {};
+        slot.subresources = {};
+        slot.entry        = nullptr;
+        slot.references   = 0;
+        ++slot.generation;
+        slot.state.store(AssetState::Unloaded, std::memory_order_relaxed);
+        _freeSlots.push_back(index);
+    }
+
+    void AssetManager::Update() {
+        PROFILE_SCOPE("AssetManager::Update");
+        const auto start = Clock::now();
+
+        Vec3 viewer;
+        vector<u32> pending;
+        {
+            std::lock_guard guard(_lock);
+            viewer = _viewer;
+            pending.swap(_uploads);
+        }
+        std::sort(pending.begin(), pending.end(), [&](u32 a, u32 b) {
+            return GetDistance(_slots[a], viewer) < GetDistance(_slots[b], viewer);
+        });
+
+        // Uploading slots belong to this thread until their state changes
+        u32 uploads = 0;
+        u64 bytes   = 0;
+        size_t next = 0;
+        for (; next < pending.size(); ++next) {
+            Slot& slot     = _slots[pending[next]];
+            const u64 size = slot.entry->size;
+            if (uploads > 0) {
+                const f64 predictedMs = ElapsedMs(start) + _uploadMsPerByte * CAST<f64>(size);
+                if (bytes + size > _config.uploadBudgetBytes || predictedMs > _config.uploadBudgetMs) break;
+            }
+
+            const auto uploadStart = Clock::now();
+            const bool created     = Upload(slot);
+            const f64 costPerByte  = ElapsedMs(uploadStart) / CAST<f64>(std::max<u64>(size, 1));
+            _uploadMsPerByte = _uploadMsPerByte == 0.0 ? costPerByte : _uploadMsPerByte * 0.9 + costPerByte * 0.1;
+
+            // The device has its own copy now
+            slot.blob         = {};
+            slot.subresources = {};
+            slot.state.store(created ? AssetState::Loaded : AssetState::Failed, std::memory_order_release);
+            ++uploads;
+            bytes += size;
+        }
+
+        std::lock_guard guard(_lock);
+        _uploads.insert(_uploads.end(), pending.begin() + CAST<ptrdiff_t>(next), pending.end());
+
+        // Assets still reading, decoding or waiting to upload are freed on a later frame
+        std::erase_if(_released, [this](u32 index) {
+            const Slot& slot = _slots[index];
+            if (slot.references > 0) return true;
+            const AssetState state = slot.state.load(std::memory_order_relaxed);
+            if (state != AssetState::Loaded && state != AssetState::Failed && state != AssetState::Unloaded) {
+                return false;
+            }
+            Unload(index);
+            return true;
+        });
+
+        _stats.uploads     = uploads;
+        _stats.uploadBytes = bytes;
+        _stats.uploadMs    = ElapsedMs(start);
+        _stats.maxUploadMs = std::max(_stats.maxUploadMs, _stats.uploadMs);
+    }
+
+    bool AssetManager::IsIdle() const {
+        std::lock_guard guard(_lock);
+        return _queue.empty() && _uploads.empty() && _inFlight == 0;
+    }
+
+    StreamingStats AssetManager::GetStats() const {
+        std::lock_guard guard(_lock);
+        StreamingStats stats      = _stats;
+        stats.queued              = CAST<u32>(_queue.size());
+        stats.inFlight            = _inFlight;
+        stats.waitingForUpload    = CAST<u32>(_uploads.size());
+        for (const auto& [entry, index] : _loadedEntries) {
+            const AssetState state = _slots[index].state.load(std::memory_order_relaxed);
+            if (state == AssetState::Loaded) { ++stats.loaded; }
+            if (state == AssetState::Failed) { ++stats.failed; }
+        }
+        return stats;
+    }
+}  // namespace X::Asset
@@ -0,0 +1,160 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#pragma once
+
+#include "EnginePCH.h"
+#include "AssetArchive.hpp"
+#include "Core/JobSystem.hpp"
+
+#include <condition_variable>
+
+namespace X::Asset {
+
+    struct AssetManagerConfig {
+        u32 ioThreads {2};
+        u32 maxAssets {4096};                 // Loaded or in flight at once
+        u32 batchSize {16};                   // Most reads an I/O thread submits together
+        u64 batchBytes {32ull << 20};         // Most bytes an I/O thread reads per batch, a larger asset goes alone
+        f32 uploadBudgetMs {2.0f};            // Render thread time per frame spent creating GPU resources
+        u64 uploadBudgetBytes {64ull << 20};  // Data per frame handed to the device
+    };
+
+    // Loaded, Failed and Unloaded are final until the asset is released or loaded again
+    enum class AssetState : u8 {
+        Unloaded,
+        Queued,     // Waiting for an I/O thread
+        Reading,    // Batched read in flight
+        Decoding,   // Blob being parsed on a job thread
+        Uploading,  // Waiting for the render thread's per-frame budget
+        Loaded,
+        Failed,
+    };
+
+    // Slot index plus the generation it was loaded with. Unloading bumps the generation, so stale handles resolve to
+    // nothing instead of whatever reuses the slot.
+    template<typename T>
+    struct AssetHandle {
+        u32 index {~0u};
+        u32 generation {0};
+
+        bool IsValid() const {
+            return index != ~0u;
+        }
+        bool operator==(const AssetHandle& other) const = default;
+    };
+
+    using MeshHandle    = AssetHandle<Render::Mesh>;
+    using TextureHandle = AssetHandle<Render::Texture>;
+    using ShaderHandle  = AssetHandle<IShader>;
+
+    struct StreamingStats {
+        u32 queued {0};
+        u32 inFlight {0};  // Reading or decoding
+        u32 waitingForUpload {0};
+        u32 loaded {0};
+        u32 failed {0};
+        u64 bytesRead {0};
+        u32 batches {0};
+        bool ioUring {false};
+        // Last Update call
+        u32 uploads {0};
+        u64 uploadBytes {0};
+        f64 uploadMs {0.0};
+        f64 maxUploadMs {0.0};  // Worst Update since the manager was created
+    };
+
+    // Streams assets out of a mounted archive without blocking the frame. Loading a name returns a handle at once
+    // and takes a reference, loading it again shares the asset. The request then moves through:
+    //
+    //   I/O threads: read in batches, nearest to the viewer first, with io_uring where available
+    //   job system:  parse the blob into GPU-ready images
+    //   Update:      create the GPU resource, within a per-frame time and byte budget
+    //
+    // Load, Release, SetViewer and GetState are safe from any thread. Update, the Get accessors and the resources
+    // they return belong to the render thread. Released assets are freed by the next Update, so anything recorded
+    // with them this frame stays valid. Without a device, assets load without GPU resources.
+    class AssetManager {
+    public:
+        AssetManager(IRenderDevice* device, Core::JobSystem& jobs, const AssetManagerConfig& config = {});
+        ~AssetManager();
+
+        AssetManager(const AssetManager&)            = delete;
+        AssetManager& operator=(const AssetManager&) = delete;
+
+        // The archive assets are loaded from. Logs and returns false when it cannot be opened. Call before loading.
+        bool Mount(const str& archivePath);
+
+        // position places the asset in the world for prioritising, without one it goes ahead of everything placed.
+        // Returns an invalid handle, after logging, when the archive has no such asset or every slot is taken.
+        MeshHandle LoadMesh(strview name, optional<Vec3> position = std::nullopt);
+        TextureHandle LoadTexture(strview name, optional<Vec3> position = std::nullopt);
+        ShaderHandle LoadShader(strview name, optional<Vec3> position = std::nullopt);
+
+        template<typename T>
+        void Release(AssetHandle<T> handle) {
+            Release(handle.index, handle.generation);
+        }
+        template<typename T>
+        AssetState GetState(AssetHandle<T> handle) const {
+            return GetState(handle.index, handle.generation);
+        }
+
+        // nullptr until the asset has loaded
+        const Render::Mesh* GetMesh(MeshHandle handle) const;
+        const Render::Texture* GetTexture(TextureHandle handle) const;
+        IShader* GetShader(ShaderHandle handle) const;
+
+        // Queued requests are served in order of distance from here
+        void SetViewer(const Vec3& position);
+
+        // Render thread, once per frame: creates GPU resources for decoded assets, nearest first, until the frame's
+        // budget is spent, then frees released assets. At least one asset is uploaded per call so a single one larger
+        // than the budget still loads.
+        void Update();
+
+        // True when nothing is queued, in flight or waiting for upload
+        bool IsIdle() const;
+        StreamingStats GetStats() const;
+
+    private:
+        struct Slot;
+
+        u32 Load(strview name, AssetType type, const optional<Vec3>& position, u32& generation);
+        void Release(u32 index, u32 generation);
+        AssetState GetState(u32 index, u32 generation) const;
+        const Slot* GetLoaded(u32 index, u32 generation, AssetType type) const;
+        // Squared, and below zero for unplaced assets
+        static f32 GetDistance(const Slot& slot, const Vec3& viewer);
+        void IoThreadMain();
+        void Decode(u32 index);
+        bool Upload(Slot& slot);
+        void Unload(u32 index);
+
+        IRenderDevice* _device {nullptr};
+        Core::JobSystem& _jobs;
+        AssetManagerConfig _config;
+        AssetArchive _archive;
+        str _archivePath;
+
+        vector<Slot> _slots;
+        vector<u32> _freeSlots;
+        unordered_map<const ArchiveEntry*, u32> _loadedEntries;
+
+        mutable std::mutex _lock;
+        std::condition_variable _requestsReady;
+        vector<u32> _queue;     // Waiting for I/O
+        vector<u32> _uploads;   // Decoded, waiting for Update
+        vector<u32> _released;  // Reference count hit zero, freed by Update
+        u32 _inFlight {0};      // Reading or decoding
+        Vec3 _viewer {0.0f};
+        bool _stopping {false};
+        StreamingStats _stats;
+        f64 _uploadMsPerByte {0.0};  // Running estimate, keeps uploads that would overrun the budget for next frame
+
+        Core::JobCounter _decodeJobs;
+        vector<std::thread> _ioThreads;
+    };
+
+}  // namespace X::Asset
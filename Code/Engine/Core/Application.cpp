@@ -3,10 +3,23 @@
 //
 
 #include "Application.hpp"
+#include "JobSystem.hpp"
 #include "Log.hpp"
+#include "Profiler.hpp"
 #include "Renderer.hpp"
+#include "Render/PipelineCache.hpp"
+
+#include <chrono>
+#include <filesystem>
 
 namespace X::Core {
+    namespace {
+        f64 Now() {
+            using namespace std::chrono;
+            return duration<f64>(steady_clock::now().time_since_epoch()).count();
+        }
+    }  // namespace
+
     Application* Application::_instance = nullptr;
 
     Application::Application(const ApplicationConfig& config) : _config(config) {
@@ -18,47 +31,408 @@ namespace X::Core {
 
         Log::Info("Initializing Application: {}", _config.title);
 
-        InitializeWindow();
+        _jobSystem = make_unique<JobSystem>(_config.workerThreads);
+
+        // The window's client API depends on the backend, so resolve it before creating either
+        if (_config.graphicsAPI == Render::GraphicsAPI::Auto) {
+            _config.graphicsAPI = Render::RenderDevice::SelectBestAPI();
+        }
+
+        if (!_config.headless) { InitializeWindow(); }
+
+        if (_config.graphicsAPI == Render::GraphicsAPI::Null) {
+            Log::Info("Null graphics API selected, running without a renderer");
+            return;
+        }
+
         InitializeRenderer();
+
+#if defined(ENGINE_GL_SUPPORTED)
+        // OpenGL needs a window created with a GL context, so falling back means recreating the window
+        if (!_renderer && !_config.headless && _config.graphicsAPI == Render::GraphicsAPI::Vulkan) {
+            Log::Warn("Vulkan initialization failed, falling back to OpenGL");
+            DestroyWindow();
+            _config.graphicsAPI = Render::GraphicsAPI::OpenGL;
+            InitializeWindow();
+            InitializeRenderer();
+        }
+#endif
     }
 
     Application::~Application() {
         Log::Info("Shutting down Application");
         Shutdown();
 
+        // Streamed resources go before the device that created them
+        _assets.reset();
         if (_renderer) { _renderer.reset(); }
 
-        if (_window) { glfwDestroyWindow(_window); }
+        DestroyWindow();
 
         glfwTerminate();
+
+        _jobSystem.reset();
         _instance = nullptr;
     }
 
     void Application::Run() {
         Log::Info("Running Application");
 
-        _running       = true;
-        _lastFrameTime = CAST<f32>(glfwGetTime());
+        _running         = true;
+        _lastFrameTime   = Now();
+        _lastPresentTime = Now();
+        _renderWidth     = _config.width;
+        _renderHeight    = _config.height;
+        _frameStats.Reset();
+
+        PROFILE_THREAD("Main");
+        if (_config.profileFrames > 0) { Profiler::BeginCapture(); }
 
+        if (!_assets) { InitializeAssets(); }
         Initialize();
 
-        while (_running && !glfwWindowShouldClose(_window)) {
-            f32 currentTime = CAST<f32>(glfwGetTime());
-            f32 dT          = currentTime - _lastFrameTime;
-            _lastFrameTime  = currentTime;
+        if (_config.pipelined && _renderer) {
+            RunPipelined();
+        } else {
+            RunSerial();
+        }
+
+        // Closed before the requested number of frames, export what was captured
+        if (Profiler::IsCapturing()) { FinishProfileCapture(); }
+
+        LogFrameStats();
+        Log::Info("Shutdown Application");
+    }
+
+    void Application::RunSerial() {
+        FramePacket packet;
+        packet.userData   = CreateFrameData();
+        packet.frameArena = make_unique<LinearArena>(_config.frameArenaSize);
+
+        while (ShouldContinue()) {
+            {
+                PROFILE_SCOPE("Frame");
+                SimulateFrame(packet);
+                RenderFrame(packet);
+            }
+            OnFrameRendered(packet.frameIndex);
+        }
+    }
+
+    void Application::RunPipelined() {
+        FramePipeline<FramePacket> pipeline(_config.pipelineDepth);
+        pipeline.ForEachSlot([this](FramePacket& packet) {
+            packet.userData   = CreateFrameData();
+            packet.frameArena = make_unique<LinearArena>(_config.frameArenaSize);
+        });
+
+        Log::Info("Pipelined frame loop enabled ({} frames buffered)", pipeline.GetDepth());
+
+        // A GL context can only be current on one thread, hand it to the render thread for the duration
+        const bool moveGLContext = _window && _config.graphicsAPI == Render::GraphicsAPI::OpenGL;
+        if (moveGLContext) { glfwMakeContextCurrent(nullptr); }
 
+        std::thread renderThread([this, &pipeline, moveGLContext] {
+            PROFILE_THREAD("Render");
+            if (moveGLContext) { glfwMakeContextCurrent(_window); }
+
+            while (const FramePacket* packet = pipeline.BeginRead()) {
+                const u64 frameIndex = packet->frameIndex;
+                RenderFrame(*packet);
+                pipeline.EndRead();
+                OnFrameRendered(frameIndex);
+            }
+
+            if (moveGLContext) { glfwMakeContextCurrent(nullptr); }
+        });
+
+        // GLFW requires event processing on the main thread, so the simulation stays here
+        while (ShouldContinue()) {
+            FramePacket* packet = pipeline.BeginWrite();
+            if (!packet) break;
+            SimulateFrame(*packet);
+            pipeline.EndWrite();
+        }
+
+        pipeline.Close();
+        renderThread.join();
+
+        if (moveGLContext) { glfwMakeContextCurrent(_window); }
+    }
+
+    void Application::SimulateFrame(FramePacket& packet) {
+        PROFILE_SCOPE("Simulate");
+        packet.simulationStart = Now();
+
+        // The slot's previous frame has been rendered by now, everything it allocated can go
+        packet.frameArena->Reset();
+        _frameArena = packet.frameArena.get();
+
+        const f64 currentTime = packet.simulationStart;
+        f32 dT                = CAST<f32>(currentTime - _lastFrameTime);
+        _lastFrameTime        = currentTime;
+        if (_config.fixedDeltaTime > 0.0f) { dT = _config.fixedDeltaTime; }
+
+        if (_window) {
+            PROFILE_SCOPE("PollEvents");
             glfwPollEvents();
             ProcessInput();
+        }
+        {
+            PROFILE_SCOPE("Update");
             Update(dT);
+        }
+
+        packet.frameIndex = _frameIndex++;
+        packet.deltaTime  = dT;
+        packet.width      = _config.width;
+        packet.height     = _config.height;
 
-            if (_renderer) {
-                _renderer->BeginFrame();
+        if (_renderer) { _renderer->CaptureFrameState(packet.renderState); }
+        if (packet.userData) { ExtractFrameData(*packet.userData); }
+    }
+
+    void Application::RenderFrame(const FramePacket& packet) {
+        PROFILE_SCOPE("RenderFrame");
+        if (_assets) {
+            _assets->SetViewer(packet.renderState.cameraPosition);
+            _assets->Update();
+        }
+        if (_renderer) {
+            // Resizes are applied here rather than in the GLFW callback so the swap chain is only ever touched by
+            // the thread that renders
+            if (packet.width != _renderWidth || packet.height != _renderHeight) {
+                _renderWidth  = packet.width;
+                _renderHeight = packet.height;
+                _renderer->OnWindowResize(packet.width, packet.height);
+            }
+
+            _renderPacket = &packet;
+            _renderer->BeginFrame(packet.renderState);
+            {
+                PROFILE_SCOPE("Render");
                 Render();
-                _renderer->EndFrame();
             }
+            _renderer->EndFrame();
+            _renderPacket = nullptr;
         }
 
-        Log::Info("Shutdown Application");
+        const f64 now = Now();
+        _frameStats.AddFrame((now - _lastPresentTime) * 1000.0, (now - packet.simulationStart) * 1000.0);
+        _lastPresentTime = now;
+    }
+
+    void Application::OnFrameRendered(u64 frameIndex) {
+        if (_config.profileFrames > 0 && frameIndex + 1 == _config.profileFrames && Profiler::IsCapturing()) {
+            FinishProfileCapture();
+        }
+    }
+
+    void Application::FinishProfileCapture() {
+        Profiler::EndCapture();
+        Profiler::ExportChromeTrace(_config.profileOutput);
+    }
+
+    void Application::LogFrameStats() const {
+        const FrameStats stats = _frameStats.GetStats();
+        if (stats.frameCount == 0) return;
+
+        Log::Info("Frame stats ({}): {} frames, {:.2f} fps, frame {:.3f} ms avg / {:.3f} ms max, latency {:.3f} ms "
+                  "avg / {:.3f} ms max",
+                  _config.pipelined ? "pipelined" : "serial",
+                  stats.frameCount,
+                  stats.framesPerSecond,
+                  stats.averageFrameMs,
+                  stats.maxFrameMs,
+                  stats.averageLatencyMs,
+                  stats.maxLatencyMs);
+
+        if (_assets) {
+            const Asset::StreamingStats streaming = _assets->GetStats();
+            if (streaming.batches > 0) {
+                Log::Info("Streaming stats: {} loaded, {} failed, {} pending, {:.1f} MB read in {} batches (io_uring "
+                          "{}), worst upload frame {:.3f} ms",
+                          streaming.loaded,
+                          streaming.failed,
+                          streaming.queued + streaming.inFlight + streaming.waitingForUpload,
+                          CAST<f64>(streaming.bytesRead) / 1048576.0,
+                          streaming.batches,
+                          streaming.ioUring ? "on" : "off",
+                          streaming.maxUploadMs);
+            }
+        }
+
+        if (!_renderer) return;
+        const Render::RenderStats& render = _renderer->GetStats();
+        if (render.packets == 0) return;
+
+        Log::Info("Render stats (last frame): {} draws submitted, {} draw calls issued ({} instanced, {} merged), "
+                  "{} dropped",
+                  render.packets,
+                  render.drawCalls,
+                  render.instancedDraws,
+                  render.mergedPackets,
+                  render.droppedPackets);
+        Log::Info("State stats (last frame): {} pipeline binds, {} resource binds, {} vertex / {} index buffer binds, "
+                  "{} redundant binds skipped",
+                  render.pipelineBinds,
+                  render.resourceBinds,
+                  render.vertexBufferBinds,
+                  render.indexBufferBinds,
+                  render.skippedBinds);
+        if (render.bindlessPackets > 0) {
+            Log::Info("Bindless stats (last frame): {} draws bindless; {} resource binds and {} draw calls, {} and {} "
+                      "with per-material bindings ({:.1f}% fewer binds)",
+                      render.bindlessPackets,
+                      render.resourceBinds,
+                      render.drawCalls,
+                      render.perMaterialResourceBinds,
+                      render.perMaterialDrawCalls,
+                      render.GetResourceBindSavingsPercent());
+        }
+        if (render.reducedPackets > 0) {
+            Log::Info("LOD stats (last frame): {} triangles of {} at full detail ({:.1f}% saved), {} draws reduced",
+                      render.triangles,
+                      render.fullDetailTriangles,
+                      render.GetTriangleSavingsPercent(),
+                      render.reducedPackets);
+        }
+
+        const auto device = _renderer->_device;
+        if (!device) return;
+        const auto logRing = [](const char* name, const Render::GpuRingStats& ring) {
+            Log::Info("{} ring: peak {} KB / {} KB, {} failed allocations, {} fence waits",
+                      name,
+                      ring.peak / 1024,
+                      ring.capacity / 1024,
+                      ring.failedAllocations,
+                      ring.fenceWaits);
+        };
+        logRing("Constant", device->GetConstantRing().GetStats());
+        logRing("Vertex", device->GetVertexRing().GetStats());
+
+        if (const Render::PipelineCache* cache = device->GetPipelineCache()) {
+            const Render::PipelineCacheStats pipelines = cache->GetStats();
+            Log::Info("Pipeline cache ({}): {} shaders compiled, {} loaded, {} shared in {:.1f} ms; {} pipelines "
+                      "created, {} shared in {:.1f} ms{}",
+                      pipelines.warm ? "warm" : "cold",
+                      pipelines.shadersCompiled,
+                      pipelines.shadersLoaded,
+                      pipelines.shaderHits,
+                      pipelines.shaderMs,
+                      pipelines.pipelinesCreated,
+                      pipelines.pipelineHits,
+                      pipelines.pipelineMs,
+                      pipelines.driverCache ? " (driver cache)" : "");
+        }
+
+        const Render::GpuFrameStats& gpu = _renderer->GetGpuStats();
+        if (gpu.passes.empty()) return;
+
+        str passes;
+        for (const auto& pass : gpu.passes) {
+            passes += fmt::format("{}{} {:.3f} ms", passes.empty() ? "" : ", ", pass.name, pass.milliseconds);
+        }
+        Log::Info("GPU stats (frame {}): {:.3f} ms total, {}", gpu.frameIndex, gpu.frameMilliseconds, passes);
+        if (gpu.hasPipelineStats) {
+            Log::Info("GPU pipeline stats: {} vertices, {} primitives, {} VS invocations, clipping {} in / {} out, "
+                      "{} PS invocations",
+                      gpu.pipeline.inputVertices,
+                      gpu.pipeline.inputPrimitives,
+                      gpu.pipeline.vertexInvocations,
+                      gpu.pipeline.clippingInvocations,
+                      gpu.pipeline.clippingPrimitives,
+                      gpu.pipeline.pixelInvocations);
+        }
+    }
+
+    bool Application::ShouldContinue() const {
+        if (!_running) return false;
+        if (!_config.headless && (!_window || glfwWindowShouldClose(_window))) return false;
+        if (_config.frameCount > 0 && _frameIndex >= _config.frameCount) return false;
+        return true;
+    }
+
+    ApplicationConfig Application::ParseCommandLine(i32 argc, char** argv, ApplicationConfig config) {
+        for (i32 i = 1; i < argc; ++i) {
+            const strview arg  = argv[i];
+            const bool hasNext = i + 1 < argc;
+
+            if (arg == "--headless") {
+                config.headless = true;
+            } else if (arg == "--pipelined") {
+                config.pipelined = true;
+            } else if (arg == "--no-vsync") {
+                config.vsync = false;
+            } else if (arg == "--no-bindless") {
+                config.bindless = false;
+            } else if (arg == "--frames" && hasNext) {
+                config.frameCount = CAST<u32>(std::strtoul(argv[++i], nullptr, 10));
+            } else if (arg == "--fixed-dt" && hasNext) {
+                config.fixedDeltaTime = std::strtof(argv[++i], nullptr);
+            } else if (arg == "--pipeline-depth" && hasNext) {
+                config.pipelineDepth = CAST<u32>(std::strtoul(argv[++i], nullptr, 10));
+            } else if (arg == "--frames-in-flight" && hasNext) {
+                config.framesInFlight = CAST<u32>(std::strtoul(argv[++i], nullptr, 10));
+            } else if (arg == "--present-mode" && hasNext) {
+                const strview mode = argv[++i];
+                if (mode == "fifo") {
+                    config.presentMode = Render::PresentMode::Fifo;
+                } else if (mode == "mailbox") {
+                    config.presentMode = Render::PresentMode::Mailbox;
+                } else if (mode == "immediate") {
+                    config.presentMode = Render::PresentMode::Immediate;
+                } else {
+                    Log::Warn("Unknown present mode '{}'", mode);
+                }
+            } else if (arg == "--profile" && hasNext) {
+                config.profileFrames = CAST<u32>(std::strtoul(argv[++i], nullptr, 10));
+            } else if (arg == "--profile-output" && hasNext) {
+                config.profileOutput = argv[++i];
+            } else if (arg == "--assets" && hasNext) {
+                config.assetArchive = argv[++i];
+            } else if (arg == "--upload-budget" && hasNext) {
+                config.assetUploadBudgetMs = std::strtof(argv[++i], nullptr);
+            } else if (arg == "--pipeline-cache" && hasNext) {
+                config.pipelineCache = argv[++i];
+            } else if (arg == "--workers" && hasNext) {
+                config.workerThreads = CAST<u32>(std::strtoul(argv[++i], nullptr, 10));
+            } else if (arg == "--api" && hasNext) {
+                const strview api = argv[++i];
+                if (api == "vulkan") {
+                    config.graphicsAPI = Render::GraphicsAPI::Vulkan;
+                } else if (api == "opengl") {
+                    config.graphicsAPI = Render::GraphicsAPI::OpenGL;
+                } else if (api == "d3d11") {
+                    config.graphicsAPI = Render::GraphicsAPI::D3D11;
+                } else if (api == "d3d12") {
+                    config.graphicsAPI = Render::GraphicsAPI::D3D12;
+                } else if (api == "null") {
+                    config.graphicsAPI = Render::GraphicsAPI::Null;
+                } else {
+                    Log::Warn("Unknown graphics API '{}', using auto", api);
+                }
+            } else {
+                Log::Warn("Ignoring unknown argument '{}'", arg);
+            }
+        }
+        return config;
+    }
+
+    void Application::InitializeAssets() {
+        Asset::AssetManagerConfig config;
+        config.ioThreads      = _config.ioThreads;
+        config.uploadBudgetMs = _config.assetUploadBudgetMs;
+
+        IRenderDevice* device = _renderer && _renderer->_device ? _renderer->_device->GetDevice() : nullptr;
+        _assets               = make_unique<Asset::AssetManager>(device, *_jobSystem, config);
+
+        // Applications without packed assets simply never load any
+        if (std::filesystem::exists(_config.assetArchive)) {
+            _assets->Mount(_config.assetArchive);
+        } else {
+            Log::Debug("No asset archive at {}, streaming disabled", _config.assetArchive);
+        }
     }
 
     void Application::InitializeWindow() {
@@ -71,8 +445,18 @@ namespace X::Core {
 
         glfwSetErrorCallback(GLFWErrorCallback);
 
-        // Configure GLFW for Diligent Engine
-        glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+        // Configure GLFW for Diligent Engine. Every backend except OpenGL creates its own surface from the native
+        // window handle.
+        glfwDefaultWindowHints();
+        if (_config.graphicsAPI == Render::GraphicsAPI::OpenGL) {
+            glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_API);
+            glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+            glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+            glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+            glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GLFW_TRUE);
+        } else {
+            glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+        }
         glfwWindowHint(GLFW_RESIZABLE, GLFW_TRUE);
 
         // Create window
@@ -107,11 +491,31 @@ namespace X::Core {
         Log::Info("Window created: {}x{}", _config.width, _config.height);
     }
 
+    void Application::DestroyWindow() {
+        if (_window) {
+            glfwDestroyWindow(_window);
+            _window = nullptr;
+        }
+    }
+
     void Application::InitializeRenderer() {
         Log::Info("Initializing renderer");
         _renderer = std::make_shared<Render::Renderer>();
 
-        if (!_renderer->Initialize(_window, _config.width, _config.height)) {
+        Render::RenderDeviceConfig deviceConfig;
+        deviceConfig.api                    = _config.graphicsAPI;
+        deviceConfig.headless               = _config.headless;
+        deviceConfig.vsync                  = _config.vsync;
+        deviceConfig.presentMode            = _config.presentMode;
+        deviceConfig.framesInFlight         = _config.framesInFlight;
+        deviceConfig.pipelineCacheDirectory = _config.pipelineCache;
+        deviceConfig.bindless               = _config.bindless;
+
+        // One deferred context per thread that can run recording jobs
+        deviceConfig.deferredContexts = _config.deferredContexts;
+        if (deviceConfig.deferredContexts == 0) { deviceConfig.deferredContexts = _jobSystem->GetThreadCount(); }
+
+        if (!_renderer->Initialize(_window, _config.width, _config.height, deviceConfig)) {
             Log::Error("Failed to initialize renderer");
             _renderer.reset();
         }
@@ -138,8 +542,7 @@ namespace X::Core {
             app->_config.width  = static_cast<uint32_t>(width);
             app->_config.height = static_cast<uint32_t>(height);
 
-            if (app->_renderer) { app->_renderer->OnWindowResize(width, height); }
-
+            // The renderer picks the new size up from the next frame packet
             app->OnWindowResize(width, height);
         }
     }
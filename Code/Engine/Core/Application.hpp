@@ -5,6 +5,10 @@
 #pragma once
 
 #include "EnginePCH.h"
+#include "FramePipeline.hpp"
+#include "FrameStats.hpp"
+#include "Asset/AssetManager.hpp"
+#include "Render/RenderDevice.hpp"
 
 namespace X::Core {
 
@@ -14,6 +18,24 @@ namespace X::Core {
         u32 height {600};
         bool vsync {true};
         bool fullscreen = {false};
+        u32 workerThreads {0};      // 0 = hardware_concurrency - 1
+        bool pipelined {false};     // Run Update and Render on separate threads, one frame apart
+        u32 pipelineDepth {2};      // Frames buffered between the simulation and render threads (2 or 3)
+        bool headless {false};      // No window or swap chain, render into offscreen targets
+        u32 frameCount {0};         // Stop after this many frames, 0 = run until closed
+        f32 fixedDeltaTime {0.0f};  // Constant dT passed to Update, 0 = measured wall time
+        Render::GraphicsAPI graphicsAPI {Render::GraphicsAPI::Auto};
+        Render::PresentMode presentMode {Render::PresentMode::Mailbox};  // Used when vsync is off
+        u32 framesInFlight {2};
+        u32 deferredContexts {0};         // 0 = one per job system thread
+        u64 frameArenaSize {1ull << 20};  // Block size of each frame slot's linear arena
+        u32 profileFrames {0};            // Capture CPU zones for the first N frames, 0 = off
+        str profileOutput {"profile.json"};
+        str assetArchive {"Assets.xpak"};  // Mounted by the AssetManager when it exists
+        u32 ioThreads {2};                 // Asset streaming reads
+        f32 assetUploadBudgetMs {2.0f};    // Render thread time per frame spent creating streamed GPU resources
+        str pipelineCache {"Cache"};       // Compiled shaders and pipelines kept between runs, empty = off
+        bool bindless {true};              // Bindless material templates where the backend supports them
     };
 
     class Application {
@@ -23,11 +45,23 @@ namespace X::Core {
 
         void Run();
 
+        // Applies --headless, --frames, --fixed-dt, --pipelined, --pipeline-depth, --workers, --api, --no-vsync,
+        // --present-mode, --frames-in-flight, --profile, --profile-output, --assets, --upload-budget,
+        // --pipeline-cache and --no-bindless
+        static ApplicationConfig ParseCommandLine(i32 argc, char** argv, ApplicationConfig config = {});
+
         virtual void Initialize() {}
         virtual void Update(f32 dT) {}
         virtual void Render() {}
         virtual void Shutdown() {}
 
+        // Called once per frame slot. Return a FrameData subclass to carry simulation state over to Render().
+        virtual unique_ptr<FrameData> CreateFrameData() {
+            return nullptr;
+        }
+        // Called on the simulation thread after Update to fill the frame's data
+        virtual void ExtractFrameData(FrameData& data) {}
+
         virtual void OnWindowResize(u32 width, u32 height) {}
         virtual void OnKeyPressed(i32 key, i32 action, i32 mods) {}
         virtual void OnMouseButton(i32 button, i32 action, i32 mods) {}
@@ -41,10 +75,34 @@ namespace X::Core {
             return _renderer;
         }
 
+        JobSystem* GetJobSystem() const {
+            return _jobSystem.get();
+        }
+
+        // Streams from config.assetArchive. Load from any thread, resolve handles inside Render().
+        Asset::AssetManager* GetAssets() const {
+            return _assets.get();
+        }
+
         bool IsRunning() const {
             return _running;
         }
 
+        // The frame currently being rendered, only valid inside Render()
+        const FramePacket* GetRenderPacket() const {
+            return _renderPacket;
+        }
+
+        // Linear arena of the frame being simulated, only valid inside Update() and ExtractFrameData(). Memory lives
+        // until the frame has been rendered, so it can be referenced from FrameData.
+        LinearArena* GetFrameArena() const {
+            return _frameArena;
+        }
+
+        FrameStats GetFrameStats() const {
+            return _frameStats.GetStats();
+        }
+
         void Close() {
             _running = false;
         }
@@ -55,8 +113,19 @@ namespace X::Core {
 
     private:
         void InitializeWindow();
+        void DestroyWindow();
         void InitializeRenderer();
+        void InitializeAssets();
         void ProcessInput();
+        bool ShouldContinue() const;
+
+        void RunSerial();
+        void RunPipelined();
+        void SimulateFrame(FramePacket& packet);
+        void RenderFrame(const FramePacket& packet);
+        void LogFrameStats() const;
+        void OnFrameRendered(u64 frameIndex);
+        void FinishProfileCapture();
 
         static void GLFWErrorCallback(i32 error, const char* description);
         static void GLFWWindowCloseCallback(GLFWwindow* window);
@@ -69,12 +138,23 @@ namespace X::Core {
         ApplicationConfig _config;
         GLFWwindow* _window {nullptr};
         shared_ptr<Render::Renderer> _renderer {nullptr};
+        unique_ptr<JobSystem> _jobSystem {nullptr};
+        unique_ptr<Asset::AssetManager> _assets {nullptr};
         bool _running {false};
 
-        f32 _lastFrameTime {0.0f};
+        f64 _lastFrameTime {0.0};
+        u64 _frameIndex {0};
+        LinearArena* _frameArena {nullptr};
+
+        // Render side state, owned by the render thread in pipelined mode
+        const FramePacket* _renderPacket {nullptr};
+        u32 _renderWidth {0};
+        u32 _renderHeight {0};
+        f64 _lastPresentTime {0.0};
+        FrameStatsCollector _frameStats;
 
         static Application* _instance;
     };
 
-    unique_ptr<Application> CreateApplication();
+    unique_ptr<Application> CreateApplication(const ApplicationConfig& config);
 }  // namespace X::Core
\ No newline at end of file
@@ -0,0 +1,343 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include "FileReader.hpp"
+#include "Log.hpp"
+
+#if !defined(ENGINE_PLATFORM_WINDOWS)
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+#if defined(ENGINE_PLATFORM_LINUX) && __has_include(<linux/io_uring.h>)
+    #define ENGINE_HAS_IO_URING
+    #include <linux/io_uring.h>
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+#endif
+
+#include <atomic>
+#include <thread>
+
+namespace X::Core {
+#if defined(ENGINE_HAS_IO_URING)
+    // The raw ring interface, so there is no dependency on liburing
+    struct FileReader::Ring {
+        static constexpr u64 kCancelUserData = ~0ull;  // Read requests are tagged with their index
+
+        int fd {-1};
+        u32 entries {0};
+        void* sqRing {MAP_FAILED};
+        size_t sqRingSize {0};
+        void* cqRing {MAP_FAILED};
+        size_t cqRingSize {0};
+        io_uring_sqe* sqes {nullptr};
+        size_t sqesSize {0};
+
+        u32* sqTail {nullptr};
+        u32* sqMask {nullptr};
+        u32* sqArray {nullptr};
+        u32* cqHead {nullptr};
+        u32* cqTail {nullptr};
+        u32* cqMask {nullptr};
+        io_uring_cqe* cqes {nullptr};
+
+        ~Ring() {
+            if (sqes) { munmap(sqes, sqesSize); }
+            if (cqRing != MAP_FAILED && cqRing != sqRing) { munmap(cqRing, cqRingSize); }
+            if (sqRing != MAP_FAILED) { munmap(sqRing, sqRingSize); }
+            if (fd >= 0) { close(fd); }
+        }
+
+        bool Create(u32 depth) {
+            io_uring_params params {};
+            fd = CAST<int>(syscall(__NR_io_uring_setup, depth, &params));
+            if (fd < 0) return false;
+
+            entries    = params.sq_entries;
+            sqRingSize = params.sq_off.array + params.sq_entries * sizeof(u32);
+            cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+            // Newer kernels map both rings with one call
+            const bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+            if (singleMap) { sqRingSize = cqRingSize = std::max(sqRingSize, cqRingSize); }
+
+            const auto map = [this](size_t size, u64 offset) {
+                return mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, CAST<off_t>(offset));
+            };
+            sqRing = map(sqRingSize, IORING_OFF_SQ_RING);
+            if (sqRing == MAP_FAILED) return false;
+            cqRing = singleMap ? sqRing : map(cqRingSize, IORING_OFF_CQ_RING);
+            if (cqRing == MAP_FAILED) return false;
+
+            sqesSize      = params.sq_entries * sizeof(io_uring_sqe);
+            void* sqeData = map(sqesSize, IORING_OFF_SQES);
+            if (sqeData == MAP_FAILED) return false;
+            sqes = CAST<io_uring_sqe*>(sqeData);
+
+            u8* sq  = CAST<u8*>(sqRing);
+            u8* cq  = CAST<u8*>(cqRing);
+            sqTail  = RCAST<u32*>(sq + params.sq_off.tail);
+            sqMask  = RCAST<u32*>(sq + params.sq_off.ring_mask);
+            sqArray = RCAST<u32*>(sq + params.sq_off.array);
+            cqHead  = RCAST<u32*>(cq + params.cq_off.head);
+            cqTail  = RCAST<u32*>(cq + params.cq_off.tail);
+            cqMask  = RCAST<u32*>(cq + params.cq_off.ring_mask);
+            cqes    = RCAST<io_uring_cqe*>(cq + params.cq_off.cqes);
+            return true;
+        }
+
+        void Queue(int file, u64 offset, void* destination, u32 size, u64 userData) {
+            io_uring_sqe sqe {};
+            sqe.opcode    = IORING_OP_READ;
+            sqe.fd        = file;
+            sqe.off       = offset;
+            sqe.addr      = RCAST<u64>(destination);
+            sqe.len       = size;
+            sqe.user_data = userData;
+            Push(sqe);
+        }
+
+        // Asks the kernel to cancel every read it has taken. Kernels before 5.19 reject the request and the reads
+        // run to completion instead, either way Drain is what guarantees they are done.
+        void QueueCancelAll() {
+            io_uring_sqe sqe {};
+            sqe.opcode    = IORING_OP_ASYNC_CANCEL;
+            sqe.user_data = kCancelUserData;
+#if defined(IORING_ASYNC_CANCEL_ANY)
+            sqe.cancel_flags = IORING_ASYNC_CANCEL_ANY;
+#endif
+            Push(sqe);
+        }
+
+        // Takes back the last count queued entries. The kernel only reads the queue inside io_uring_enter, so
+        // entries it has not taken yet are still ours.
+        void Unqueue(u32 count) {
+            std::atomic_ref<u32>(*sqTail).store(*sqTail - count, std::memory_order_release);
+        }
+
+        // Submits up to count queued reads and, if the kernel took all of them, waits for at least one completion.
+        // Returns how many it took, the rest stay queued in the ring to be passed again, or -1 on failure. Running out
+        // of kernel resources counts as taking none.
+        long Submit(u32 count) {
+            for (;;) {
+                const long result = syscall(__NR_io_uring_enter, fd, count, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+                if (result >= 0) return result;
+                if (errno == EAGAIN || errno == EBUSY) return 0;
+                if (errno != EINTR) return -1;
+            }
+        }
+
+        template<typename F>
+        void Reap(const F& onCompletion) {
+            u32 head       = *cqHead;
+            const u32 tail = std::atomic_ref<u32>(*cqTail).load(std::memory_order_acquire);
+            for (; head != tail; ++head) {
+                const io_uring_cqe& cqe = cqes[head & *cqMask];
+                if (cqe.user_data != kCancelUserData) { onCompletion(cqe.user_data, cqe.res); }
+            }
+            std::atomic_ref<u32>(*cqHead).store(head, std::memory_order_release);
+        }
+
+        // Waits until inFlight reads have completed, so none can still write into a destination once the ring is
+        // gone. Completions are posted to the shared queue without our help, so if waiting in the kernel fails
+        // this polls it instead.
+        void Drain(u32 inFlight) {
+            for (;;) {
+                Reap([&](u64, i32) { --inFlight; });
+                if (inFlight == 0) return;
+                if (Submit(0) < 0) { std::this_thread::yield(); }
+            }
+        }
+
+        // Only this thread produces submissions, so the tail is read plainly and published with a release store
+        void Push(const io_uring_sqe& sqe) {
+            const u32 tail = *sqTail;
+            const u32 slot = tail & *sqMask;
+            sqes[slot]     = sqe;
+            sqArray[slot]  = slot;
+            std::atomic_ref<u32>(*sqTail).store(tail + 1, std::memory_order_release);
+        }
+    };
+#else
+    struct FileReader::Ring {};
+#endif
+
+    FileReader::FileReader() = default;
+
+    FileReader::~FileReader() {
+        Close();
+    }
+
+    bool FileReader::Open(const str& path, u32 queueDepth) {
+        Close();
+
+#if defined(ENGINE_PLATFORM_WINDOWS)
+        _file = CreateFileA(path.c_str(),
+                            GENERIC_READ,
+                            FILE_SHARE_READ,
+                            nullptr,
+                            OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                            nullptr);
+        if (_file == INVALID_HANDLE_VALUE) {
+            Log::Error("Failed to open {} (error {})", path, GetLastError());
+            return false;
+        }
+#else
+        _file = open(path.c_str(), O_RDONLY);
+        if (_file < 0) {
+            Log::Error("Failed to open {} (errno {})", path, errno);
+            return false;
+        }
+#endif
+
+#if defined(ENGINE_HAS_IO_URING)
+        auto ring = make_unique<Ring>();
+        if (ring->Create(std::max(queueDepth, 1u))) {
+            _ring = std::move(ring);
+        } else {
+            Log::Debug("io_uring is unavailable (errno {}), reading {} with pread", errno, path);
+        }
+#else
+        (void)queueDepth;
+#endif
+        return true;
+    }
+
+    void FileReader::Close() {
+        _ring.reset();
+#if defined(ENGINE_PLATFORM_WINDOWS)
+        if (_file != INVALID_HANDLE_VALUE) { CloseHandle(_file); }
+        _file = INVALID_HANDLE_VALUE;
+#else
+        if (_file >= 0) { close(_file); }
+        _file = -1;
+#endif
+    }
+
+    bool FileReader::IsOpen() const {
+#if defined(ENGINE_PLATFORM_WINDOWS)
+        return _file != INVALID_HANDLE_VALUE;
+#else
+        return _file >= 0;
+#endif
+    }
+
+    bool FileReader::ReadDirect(ReadRequest& request) {
+        u8* destination = CAST<u8*>(request.destination);
+        u64 done        = 0;
+        while (done < request.size) {
+#if defined(ENGINE_PLATFORM_WINDOWS)
+            OVERLAPPED overlapped {};
+            const u64 offset      = request.offset + done;
+            overlapped.Offset     = CAST<DWORD>(offset);
+            overlapped.OffsetHigh = CAST<DWORD>(offset >> 32);
+            DWORD read            = 0;
+            const DWORD chunk     = CAST<DWORD>(std::min<u64>(request.size - done, 1u << 30));
+            if (!ReadFile(_file, destination + done, chunk, &read, &overlapped) || read == 0) return false;
+#else
+            const size_t chunk = CAST<size_t>(std::min<u64>(request.size - done, 1u << 30));
+            const ssize_t read = pread(_file, destination + done, chunk, CAST<off_t>(request.offset + done));
+            if (read < 0 && errno == EINTR) continue;
+            if (read <= 0) return false;
+#endif
+            done += CAST<u64>(read);
+        }
+        return true;
+    }
+
+    void FileReader::Read(ReadRequest* requests, u32 count) {
+        for (u32 i = 0; i < count; ++i) {
+            requests[i].succeeded = false;
+        }
+        if (!IsOpen()) return;
+
+#if defined(ENGINE_HAS_IO_URING)
+        if (_ring) {
+            // Bytes read so far per request, reads that come back short are queued again for the rest
+            vector<u64> progress(count, 0);
+            vector<u32> continuations;
+            u32 next     = 0;
+            u32 pending  = 0;  // Queued in the ring but not yet taken by the kernel
+            u32 inFlight = 0;
+            while (next < count || pending > 0 || inFlight > 0 || !continuations.empty()) {
+                u32 queued = 0;
+                while (inFlight + pending + queued < _ring->entries && (next < count || !continuations.empty())) {
+                    u32 index = 0;
+                    if (!continuations.empty()) {
+                        index = continuations.back();
+                        continuations.pop_back();
+                    } else {
+                        index = next++;
+                    }
+                    ReadRequest& request = requests[index];
+                    if (request.size == 0) {
+                        request.succeeded = true;
+                        continue;
+                    }
+                    // Large ranges are read a gigabyte at a time, the length field is 32-bit
+                    const u64 remaining = request.size - progress[index];
+                    const u32 size      = CAST<u32>(std::min<u64>(remaining, 1u << 30));
+                    _ring->Queue(_file,
+                                 request.offset + progress[index],
+                                 CAST<u8*>(request.destination) + progress[index],
+                                 size,
+                                 index);
+                    ++queued;
+                }
+                pending += queued;
+                if (pending == 0 && inFlight == 0) break;
+
+                long submitted = _ring->Submit(pending);
+                if (submitted == 0 && pending > 0 && inFlight > 0) {
+                    // Nothing went in and so the kernel did not wait either, let a read land before trying again
+                    submitted = _ring->Submit(0);
+                }
+                if (submitted < 0 || (submitted == 0 && inFlight == 0)) {
+                    // The kernel may still be writing into the destinations of reads it took, so take back the
+                    // ones it did not, cancel the rest and wait for all of them before dropping the ring. What is
+                    // left (and every later batch) is read with pread.
+                    Log::Warn("io_uring submission failed (errno {}), falling back to pread", errno);
+                    if (inFlight > 0) {
+                        _ring->Unqueue(pending);
+                        _ring->QueueCancelAll();
+                        _ring->Submit(1);
+                        _ring->Drain(inFlight);
+                    }
+                    _ring.reset();
+                    for (u32 i = 0; i < count; ++i) {
+                        if (!requests[i].succeeded) { requests[i].succeeded = ReadDirect(requests[i]); }
+                    }
+                    return;
+                }
+                pending  -= CAST<u32>(submitted);
+                inFlight += CAST<u32>(submitted);
+
+                _ring->Reap([&](u64 userData, i32 result) {
+                    --inFlight;
+                    const u32 index      = CAST<u32>(userData);
+                    ReadRequest& request = requests[index];
+                    if (result < 0) {
+                        // Kernels without IORING_OP_READ reject it, so try once more the portable way
+                        request.succeeded = ReadDirect(request);
+                        return;
+                    }
+                    if (result == 0) return;  // Past the end of the file
+                    progress[index] += CAST<u64>(result);
+                    if (progress[index] < request.size) {
+                        continuations.push_back(index);
+                    } else {
+                        request.succeeded = true;
+                    }
+                });
+            }
+            return;
+        }
+#endif
+
+        for (u32 i = 0; i < count; ++i) {
+            requests[i].succeeded = ReadDirect(requests[i]);
+        }
+    }
+}  // namespace X::Core
@@ -0,0 +1,56 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#pragma once
+
+#include "EnginePCH.h"
+
+namespace X::Core {
+
+    struct ReadRequest {
+        u64 offset {0};
+        u64 size {0};
+        void* destination {nullptr};
+        bool succeeded {false};  // Set by Read, false on errors and reads past the end of the file
+    };
+
+    // Reads batches of ranges from one file. On Linux the whole batch is queued on an io_uring and collected with one
+    // system call for submission and completion, letting the kernel and device work on every read at once. Without
+    // io_uring (other platforms, old kernels, or sandboxes that block it) each range is a positional read. One reader
+    // per thread, the ring is not shared.
+    class FileReader {
+    public:
+        FileReader();
+        ~FileReader();
+
+        FileReader(const FileReader&)            = delete;
+        FileReader& operator=(const FileReader&) = delete;
+
+        // queueDepth is the most reads in flight at once on io_uring. Logs and returns false when the file cannot be
+        // opened. A ring that cannot be created only falls back to positional reads.
+        bool Open(const str& path, u32 queueDepth = 64);
+        void Close();
+
+        // Blocks until every request has completed or failed. Short reads are continued until the range is full.
+        void Read(ReadRequest* requests, u32 count);
+
+        bool IsOpen() const;
+        bool IsUsingIoUring() const {
+            return _ring != nullptr;
+        }
+
+    private:
+        struct Ring;
+
+        bool ReadDirect(ReadRequest& request);
+
+        unique_ptr<Ring> _ring;
+#if defined(ENGINE_PLATFORM_WINDOWS)
+        HANDLE _file {INVALID_HANDLE_VALUE};
+#else
+        int _file {-1};
+#endif
+    };
+
+}  // namespace X::Core
@@ -0,0 +1,99 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#pragma once
+
+#include "EnginePCH.h"
+#include "Memory.hpp"
+#include "Render/FrameState.hpp"
+
+#include <atomic>
+#include <semaphore>
+
+namespace X::Core {
+
+    // Application-defined data extracted from the simulation each frame. Subclass it and return an instance from
+    // Application::CreateFrameData to hand extra state to Render().
+    class FrameData {
+    public:
+        virtual ~FrameData() = default;
+    };
+
+    // Everything the render side needs to draw one frame. Filled by the simulation thread and read-only once
+    // published to the render thread.
+    struct FramePacket {
+        u64 frameIndex {0};
+        f32 deltaTime {0.0f};
+        f64 simulationStart {0.0};
+        u32 width {0};
+        u32 height {0};
+        Render::FrameState renderState;
+        unique_ptr<FrameData> userData;
+        // Reset when the simulation starts filling the packet, so allocations stay valid until it has been rendered
+        unique_ptr<LinearArena> frameArena;
+    };
+
+    // Fixed ring of frame slots shared by exactly one producer and one consumer. The producer blocks while every
+    // slot is still being read and the consumer blocks until a slot is published. Frames published before Close are
+    // still handed to the consumer.
+    template<typename T>
+    class FramePipeline {
+    public:
+        static constexpr u32 kMaxDepth = 3;
+
+        explicit FramePipeline(u32 depth)
+            : _slots(std::clamp(depth, 1u, kMaxDepth)), _free(CAST<ptrdiff_t>(_slots.size())), _ready(0) {}
+
+        template<typename F>
+        void ForEachSlot(F&& fn) {
+            for (auto& slot : _slots) {
+                fn(slot);
+            }
+        }
+
+        // Returns nullptr once the pipeline has been closed
+        T* BeginWrite() {
+            _free.acquire();
+            if (_closed.load(std::memory_order_acquire)) return nullptr;
+            return &_slots[_writeIndex.load(std::memory_order_relaxed) % _slots.size()];
+        }
+
+        void EndWrite() {
+            _writeIndex.store(_writeIndex.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+            _ready.release();
+        }
+
+        // Returns nullptr once the pipeline has been closed and every published frame has been read
+        const T* BeginRead() {
+            _ready.acquire();
+            // Close releases once more than there are published frames, that extra count is the last one taken
+            if (_readIndex == _writeIndex.load(std::memory_order_acquire)) return nullptr;
+            return &_slots[_readIndex % _slots.size()];
+        }
+
+        void EndRead() {
+            ++_readIndex;
+            _free.release();
+        }
+
+        void Close() {
+            _closed.store(true, std::memory_order_release);
+            _free.release();
+            _ready.release();
+        }
+
+        u32 GetDepth() const {
+            return CAST<u32>(_slots.size());
+        }
+
+    private:
+        vector<T> _slots;
+        std::counting_semaphore<> _free;
+        std::counting_semaphore<> _ready;
+        std::atomic<bool> _closed {false};
+        std::atomic<u64> _writeIndex {0};  // Frames published
+        u64 _readIndex {0};
+    };
+
+}  // namespace X::Core
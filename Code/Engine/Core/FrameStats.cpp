@@ -0,0 +1,40 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include "FrameStats.hpp"
+
+namespace X::Core {
+    void FrameStatsCollector::AddFrame(f64 frameMs, f64 latencyMs) {
+        std::lock_guard lock(_lock);
+        ++_frameCount;
+        _totalFrameMs += frameMs;
+        _totalLatencyMs += latencyMs;
+        _maxFrameMs   = std::max(_maxFrameMs, frameMs);
+        _maxLatencyMs = std::max(_maxLatencyMs, latencyMs);
+    }
+
+    FrameStats FrameStatsCollector::GetStats() const {
+        std::lock_guard lock(_lock);
+
+        FrameStats stats;
+        stats.frameCount = _frameCount;
+        if (_frameCount == 0) return stats;
+
+        stats.averageFrameMs   = _totalFrameMs / CAST<f64>(_frameCount);
+        stats.averageLatencyMs = _totalLatencyMs / CAST<f64>(_frameCount);
+        stats.maxFrameMs       = _maxFrameMs;
+        stats.maxLatencyMs     = _maxLatencyMs;
+        stats.framesPerSecond  = _totalFrameMs > 0.0 ? 1000.0 * CAST<f64>(_frameCount) / _totalFrameMs : 0.0;
+        return stats;
+    }
+
+    void FrameStatsCollector::Reset() {
+        std::lock_guard lock(_lock);
+        _frameCount     = 0;
+        _totalFrameMs   = 0.0;
+        _maxFrameMs     = 0.0;
+        _totalLatencyMs = 0.0;
+        _maxLatencyMs   = 0.0;
+    }
+}  // namespace X::Core
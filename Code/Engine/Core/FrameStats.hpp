@@ -0,0 +1,39 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#pragma once
+
+#include "EnginePCH.h"
+
+#include <mutex>
+
+namespace X::Core {
+
+    struct FrameStats {
+        u64 frameCount {0};
+        f64 averageFrameMs {0.0};
+        f64 maxFrameMs {0.0};
+        f64 averageLatencyMs {0.0};
+        f64 maxLatencyMs {0.0};
+        f64 framesPerSecond {0.0};
+    };
+
+    // Accumulates frame time (present to present) and latency (simulation start to present). Written by whichever
+    // thread presents, readable from any thread.
+    class FrameStatsCollector {
+    public:
+        void AddFrame(f64 frameMs, f64 latencyMs);
+        FrameStats GetStats() const;
+        void Reset();
+
+    private:
+        mutable std::mutex _lock;
+        u64 _frameCount {0};
+        f64 _totalFrameMs {0.0};
+        f64 _maxFrameMs {0.0};
+        f64 _totalLatencyMs {0.0};
+        f64 _maxLatencyMs {0.0};
+    };
+
+}  // namespace X::Core
@@ -0,0 +1,380 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include "JobSystem.hpp"
+#include "Log.hpp"
+#include "Profiler.hpp"
+
+namespace X::Core {
+    namespace {
+        thread_local u32 tThreadIndex        = JobSystem::kInvalidThreadIndex;
+        thread_local const JobSystem* tOwner = nullptr;
+        thread_local u32 tRandomState        = 0x9E3779B9u;
+
+        u32 NextRandom() {
+            // xorshift32, only used to pick steal victims
+            u32 x = tRandomState;
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            tRandomState = x;
+            return x;
+        }
+    }  // namespace
+
+    // Chase-Lev work-stealing deque (Le et al. 2013). The owning thread pushes and pops at the bottom, every other
+    // thread steals from the top. Fixed capacity, Push fails when full and the caller runs the job inline.
+    class WorkStealingDeque {
+    public:
+        static constexpr i64 kCapacity = 4096;
+        static constexpr i64 kMask     = kCapacity - 1;
+
+        bool Push(Job* job) {
+            const i64 bottom = _bottom.load(std::memory_order_relaxed);
+            const i64 top    = _top.load(std::memory_order_acquire);
+            if (bottom - top >= kCapacity) return false;
+
+            _buffer[bottom & kMask].store(job, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            _bottom.store(bottom + 1, std::memory_order_relaxed);
+            return true;
+        }
+
+        Job* Pop() {
+            const i64 bottom = _bottom.load(std::memory_order_relaxed) - 1;
+            _bottom.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            i64 top = _top.load(std::memory_order_relaxed);
+
+            if (top > bottom) {
+                _bottom.store(bottom + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            Job* job = _buffer[bottom & kMask].load(std::memory_order_relaxed);
+            if (top == bottom) {
+                // Last element, race any thieves for it
+                if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                    job = nullptr;
+                }
+                _bottom.store(bottom + 1, std::memory_order_relaxed);
+            }
+            return job;
+        }
+
+        Job* Steal() {
+            i64 top = _top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const i64 bottom = _bottom.load(std::memory_order_acquire);
+            if (top >= bottom) return nullptr;
+
+            Job* job = _buffer[top & kMask].load(std::memory_order_relaxed);
+            if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                return nullptr;
+            }
+            return job;
+        }
+
+        bool IsEmpty() const {
+            return _bottom.load(std::memory_order_relaxed) <= _top.load(std::memory_order_relaxed);
+        }
+
+    private:
+        alignas(64) std::atomic<i64> _top {0};
+        alignas(64) std::atomic<i64> _bottom {0};
+        alignas(64) array<std::atomic<Job*>, kCapacity> _buffer {};
+    };
+
+    // Per-thread ring of job slots. Only the owning thread allocates from it, any thread may release a slot.
+    struct JobSystem::JobPool {
+        static constexpr u32 kCapacity = 4096;
+        static constexpr u32 kMask     = kCapacity - 1;
+
+        array<Job, kCapacity> jobs;
+        u32 next {0};
+    };
+
+    JobCounter::~JobCounter() {
+        std::lock_guard lock(_continuationLock);
+        if (_parkedOn) { _parkedOn->DropParked(*this); }
+    }
+
+    JobSystem::JobSystem(u32 workerCount) {
+        if (workerCount == 0) {
+            const u32 hardwareThreads = std::thread::hardware_concurrency();
+            workerCount               = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+        }
+
+        const u32 threadCount = workerCount + 1;
+        _queues.reserve(threadCount);
+        _pools.reserve(threadCount);
+        for (u32 i = 0; i < threadCount; ++i) {
+            _queues.push_back(make_unique<WorkStealingDeque>());
+            _pools.push_back(make_unique<JobPool>());
+        }
+
+        // The constructing thread participates as thread 0
+        tThreadIndex = 0;
+        tOwner       = this;
+
+        _running = true;
+        _workers.reserve(workerCount);
+        for (u32 i = 1; i <= workerCount; ++i) {
+            _workers.emplace_back(&JobSystem::WorkerMain, this, i);
+        }
+
+        Log::Info("Job system started with {} worker threads", workerCount);
+    }
+
+    JobSystem::~JobSystem() {
+        _running = false;
+        _wakeEpoch.fetch_add(1);
+        _wakeEpoch.notify_all();
+
+        for (auto& worker : _workers) {
+            if (worker.joinable()) { worker.join(); }
+        }
+
+        // Anything still queued at this point was never waited on, drop it
+        u32 dropped = 0;
+        while (Job* job = FindJob()) {
+            DropJob(job);
+            ++dropped;
+        }
+        {
+            // Workers are gone, so only a counter destroyed concurrently could touch these, which callers must not do
+            std::lock_guard parkedLock(_parkedLock);
+            for (JobCounter* counter : _parkedCounters) {
+                for (Job* job : counter->_continuations) {
+                    DropJob(job);
+                    ++dropped;
+                }
+                counter->_continuations.clear();
+                counter->_parkedOn = nullptr;
+            }
+            _parkedCounters.clear();
+        }
+        if (dropped > 0) { Log::Warn("Job system destroyed with {} jobs that never ran", dropped); }
+
+        if (tOwner == this) {
+            tThreadIndex = kInvalidThreadIndex;
+            tOwner       = nullptr;
+        }
+    }
+
+    void JobSystem::Wait(JobCounter& counter) {
+        // A counter owned by the caller may be destroyed as soon as this returns, so also wait out the thread that
+        // completed its last job
+        while (!counter.IsDone() || counter._completing.load(std::memory_order_acquire) != 0) {
+            if (Job* job = FindJob()) {
+                Execute(job);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    u32 JobSystem::GetThreadIndex() const {
+        return tOwner == this ? tThreadIndex : kInvalidThreadIndex;
+    }
+
+    Job* JobSystem::AllocateJob() {
+        const u32 threadIndex = GetThreadIndex();
+        if (threadIndex == kInvalidThreadIndex) {
+            // Threads outside the pool have no ring of their own
+            Job* job           = new Job;
+            job->heapAllocated = true;
+            job->inUse.store(true, std::memory_order_relaxed);
+            return job;
+        }
+
+        JobPool& pool = *_pools[threadIndex];
+        for (;;) {
+            for (u32 attempt = 0; attempt < JobPool::kCapacity; ++attempt) {
+                Job& job = pool.jobs[pool.next++ & JobPool::kMask];
+                if (!job.inUse.load(std::memory_order_acquire)) {
+                    job.inUse.store(true, std::memory_order_relaxed);
+                    return &job;
+                }
+            }
+
+            // Every slot is in flight, help drain the queues until one frees up
+            if (Job* pending = FindJob()) {
+                Execute(pending);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void JobSystem::FreeJob(Job* job) {
+        if (job->heapAllocated) {
+            delete job;
+            return;
+        }
+        job->counter = nullptr;
+        job->invoke  = nullptr;
+        job->destroy = nullptr;
+        job->inUse.store(false, std::memory_order_release);
+    }
+
+    void JobSystem::DropJob(Job* job) {
+        if (job->destroy) { job->destroy(*job); }
+        FreeJob(job);
+    }
+
+    // Called by a counter's destructor with its continuation lock held
+    void JobSystem::DropParked(JobCounter& counter) {
+        {
+            std::lock_guard parkedLock(_parkedLock);
+            _parkedCounters.erase(&counter);
+        }
+        Log::Warn("Job counter destroyed with {} jobs held back on it", counter._continuations.size());
+        for (Job* job : counter._continuations) {
+            DropJob(job);
+        }
+        counter._continuations.clear();
+        counter._parkedOn = nullptr;
+    }
+
+    void JobSystem::Submit(Job* job, JobCounter* counter, JobCounter* dependency) {
+        job->counter = counter;
+        if (counter) { counter->_value.fetch_add(1, std::memory_order_relaxed); }
+
+        if (dependency && !dependency->IsDone()) {
+            std::lock_guard lock(dependency->_continuationLock);
+            // Re-check under the lock, CompleteJob drains continuations while holding it
+            if (!dependency->IsDone()) {
+                if (dependency->_continuations.empty()) {
+                    std::lock_guard parkedLock(_parkedLock);
+                    _parkedCounters.insert(dependency);
+                    dependency->_parkedOn = this;
+                }
+                dependency->_continuations.push_back(job);
+                return;
+            }
+        }
+
+        Push(job);
+    }
+
+    void JobSystem::Push(Job* job) {
+        const u32 threadIndex = GetThreadIndex();
+        if (threadIndex != kInvalidThreadIndex) {
+            if (!_queues[threadIndex]->Push(job)) {
+                Execute(job);
+                return;
+            }
+        } else {
+            std::lock_guard lock(_globalLock);
+            _globalQueue.push_back(job);
+            _globalQueueSize.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        WakeWorkers();
+    }
+
+    Job* JobSystem::FindJob() {
+        const u32 threadIndex = GetThreadIndex();
+        if (threadIndex != kInvalidThreadIndex) {
+            if (Job* job = _queues[threadIndex]->Pop()) { return job; }
+        }
+
+        if (_globalQueueSize.load(std::memory_order_relaxed) > 0) {
+            std::lock_guard lock(_globalLock);
+            if (!_globalQueue.empty()) {
+                Job* job = _globalQueue.front();
+                _globalQueue.pop_front();
+                _globalQueueSize.fetch_sub(1, std::memory_order_relaxed);
+                return job;
+            }
+        }
+
+        const u32 queueCount = CAST<u32>(_queues.size());
+        const u32 start      = NextRandom() % queueCount;
+        for (u32 i = 0; i < queueCount; ++i) {
+            const u32 victim = (start + i) % queueCount;
+            if (victim == threadIndex) continue;
+            if (Job* job = _queues[victim]->Steal()) { return job; }
+        }
+
+        return nullptr;
+    }
+
+    void JobSystem::Execute(Job* job) {
+        job->invoke(*job);
+        JobCounter* counter = job->counter;
+        FreeJob(job);
+        if (counter) { CompleteJob(counter); }
+    }
+
+    void JobSystem::CompleteJob(JobCounter* counter) {
+        // Published by the decrement below, so Wait sees it whenever it sees the count reach zero
+        counter->_completing.fetch_add(1, std::memory_order_relaxed);
+        if (counter->_value.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            vector<Job*> released;
+            {
+                std::lock_guard lock(counter->_continuationLock);
+                if (!counter->_continuations.empty()) {
+                    // Still under the continuation lock, so a job parked on a reused counter re-registers it after
+                    std::lock_guard parkedLock(_parkedLock);
+                    _parkedCounters.erase(counter);
+                    counter->_parkedOn = nullptr;
+                }
+                released.swap(counter->_continuations);
+            }
+            for (Job* job : released) {
+                Push(job);
+            }
+        }
+        counter->_completing.fetch_sub(1, std::memory_order_release);
+    }
+
+    void JobSystem::WakeWorkers() {
+        // Pairs with the fence in WorkerMain so a worker going to sleep either sees the new job or gets woken
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (_sleepingWorkers.load(std::memory_order_relaxed) == 0) return;
+
+        _wakeEpoch.fetch_add(1, std::memory_order_release);
+        _wakeEpoch.notify_all();
+    }
+
+    bool JobSystem::HasPendingWork() const {
+        if (_globalQueueSize.load(std::memory_order_relaxed) > 0) return true;
+        for (const auto& queue : _queues) {
+            if (!queue->IsEmpty()) return true;
+        }
+        return false;
+    }
+
+    void JobSystem::WorkerMain(u32 threadIndex) {
+        tThreadIndex = threadIndex;
+        tOwner       = this;
+        tRandomState = 0x9E3779B9u * (threadIndex + 1);
+        PROFILE_THREAD(fmt::format("Worker {}", threadIndex).c_str());
+
+        constexpr u32 kSpinCount = 64;
+        u32 idleSpins            = 0;
+
+        while (_running.load(std::memory_order_acquire)) {
+            if (Job* job = FindJob()) {
+                Execute(job);
+                idleSpins = 0;
+                continue;
+            }
+
+            if (++idleSpins < kSpinCount) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            _sleepingWorkers.fetch_add(1, std::memory_order_relaxed);
+            const u32 epoch = _wakeEpoch.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (!HasPendingWork() && _running.load(std::memory_order_acquire)) { _wakeEpoch.wait(epoch); }
+            _sleepingWorkers.fetch_sub(1, std::memory_order_relaxed);
+            idleSpins = 0;
+        }
+    }
+}  // namespace X::Core
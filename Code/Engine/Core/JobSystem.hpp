@@ -0,0 +1,156 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#pragma once
+
+#include "EnginePCH.h"
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace X::Core {
+    class JobCounter;
+    class JobSystem;
+    class WorkStealingDeque;
+
+    struct alignas(64) Job {
+        static constexpr size_t kPayloadSize = 88;
+
+        void (*invoke)(Job& job) {nullptr};
+        void (*destroy)(Job& job) {nullptr};  // Destroys the payload of a job dropped without running
+        JobCounter* counter {nullptr};
+        std::atomic<bool> inUse {false};
+        bool heapAllocated {false};
+        alignas(16) u8 payload[kPayloadSize] {};
+    };
+
+    // Counts outstanding jobs. Jobs submitted with a dependency on a counter are held back until it reaches zero.
+    // Destroying a counter drops the jobs still held back on it without running them.
+    class JobCounter {
+    public:
+        JobCounter() = default;
+        ~JobCounter();
+        JobCounter(const JobCounter&)            = delete;
+        JobCounter& operator=(const JobCounter&) = delete;
+
+        bool IsDone() const {
+            return _value.load(std::memory_order_acquire) == 0;
+        }
+
+        i32 GetValue() const {
+            return _value.load(std::memory_order_acquire);
+        }
+
+    private:
+        friend class JobSystem;
+
+        std::atomic<i32> _value {0};
+        std::atomic<i32> _completing {0};  // CompleteJob calls still touching the counter after decrementing it
+        std::mutex _continuationLock;
+        vector<Job*> _continuations;
+        JobSystem* _parkedOn {nullptr};  // Set while _continuations is non-empty, under _continuationLock
+    };
+
+    class JobSystem {
+    public:
+        static constexpr u32 kInvalidThreadIndex = ~0u;
+
+        // A worker count of zero sizes the pool from std::thread::hardware_concurrency, leaving one core for the
+        // thread that owns the job system.
+        explicit JobSystem(u32 workerCount = 0);
+        // Jobs never waited on, and those held back by counters that never reached zero, are dropped without running
+        ~JobSystem();
+
+        JobSystem(const JobSystem&)            = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        template<typename F>
+        void Run(F&& fn, JobCounter* counter = nullptr, JobCounter* dependency = nullptr) {
+            using Fn = std::decay_t<F>;
+            static_assert(sizeof(Fn) <= Job::kPayloadSize, "Job closure too large, capture by reference instead");
+            static_assert(alignof(Fn) <= 16, "Job closure over-aligned");
+
+            Job* job = AllocateJob();
+            new (job->payload) Fn(std::forward<F>(fn));
+            job->invoke = [](Job& self) {
+                Fn* closure = RCAST<Fn*>(self.payload);
+                (*closure)();
+                closure->~Fn();
+            };
+            job->destroy = [](Job& self) { RCAST<Fn*>(self.payload)->~Fn(); };
+            Submit(job, counter, dependency);
+        }
+
+        // Splits [0, count) into batches of batchSize and calls fn(begin, end) for each batch. fn must outlive the
+        // counter reaching zero.
+        template<typename F>
+        void Dispatch(u32 count, u32 batchSize, const F& fn, JobCounter& counter, JobCounter* dependency = nullptr) {
+            if (count == 0) return;
+            batchSize = std::max(batchSize, 1u);
+            for (u32 begin = 0; begin < count; begin += batchSize) {
+                const u32 end = std::min(begin + batchSize, count);
+                Run([&fn, begin, end] { fn(begin, end); }, &counter, dependency);
+            }
+        }
+
+        template<typename F>
+        void ParallelFor(u32 count, u32 batchSize, const F& fn) {
+            JobCounter counter;
+            Dispatch(count, batchSize, fn, counter);
+            Wait(counter);
+        }
+
+        // Executes queued jobs on the calling thread until the counter reaches zero.
+        void Wait(JobCounter& counter);
+
+        u32 GetWorkerCount() const {
+            return CAST<u32>(_workers.size());
+        }
+
+        // Workers plus the owning thread
+        u32 GetThreadCount() const {
+            return GetWorkerCount() + 1;
+        }
+
+        // 0 for the owning thread, 1..N for workers, kInvalidThreadIndex for any other thread
+        u32 GetThreadIndex() const;
+
+    private:
+        friend class JobCounter;
+        struct JobPool;
+
+        Job* AllocateJob();
+        void FreeJob(Job* job);
+        void DropJob(Job* job);
+        void DropParked(JobCounter& counter);
+        void Submit(Job* job, JobCounter* counter, JobCounter* dependency);
+        void Push(Job* job);
+        Job* FindJob();
+        void Execute(Job* job);
+        void CompleteJob(JobCounter* counter);
+        void WakeWorkers();
+        bool HasPendingWork() const;
+        void WorkerMain(u32 threadIndex);
+
+    private:
+        vector<std::thread> _workers;
+        vector<unique_ptr<WorkStealingDeque>> _queues;
+        vector<unique_ptr<JobPool>> _pools;
+
+        std::mutex _globalLock;
+        std::deque<Job*> _globalQueue;
+        std::atomic<u32> _globalQueueSize {0};
+
+        // Counters with jobs held back on them, so the destructor can reach jobs that never became ready. Counters
+        // leave the set when they reach zero or are destroyed, so every entry is live.
+        std::mutex _parkedLock;
+        std::unordered_set<JobCounter*> _parkedCounters;
+
+        std::atomic<bool> _running {false};
+        std::atomic<u32> _sleepingWorkers {0};
+        std::atomic<u32> _wakeEpoch {0};
+    };
+}  // namespace X::Core
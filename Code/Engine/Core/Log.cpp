@@ -5,38 +5,247 @@
 #include "EnginePCH.h"
 #include "Log.hpp"
 #include <spdlog/sinks/stdout_color_sinks.h>
+#include <spdlog/sinks/basic_file_sink.h>
+
+#include <bit>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 namespace X::Core {
+    // Bounded multi-producer, single-consumer ring (Vyukov). Each cell's sequence tells producers whether it is free
+    // and the writer whether it holds a message, so neither side takes a lock.
+    struct Log::AsyncQueue {
+        struct Record {
+            spdlog::log_clock::time_point time;
+            spdlog::level::level_enum level;
+            u32 length;
+            char text[kMaxMessageSize];
+        };
+
+        struct alignas(64) Cell {
+            std::atomic<u64> sequence;
+            Record record;
+        };
+
+        unique_ptr<Cell[]> cells;
+        u64 mask {0};
+        LogOverflow overflow {LogOverflow::Drop};
+
+        // Producers, the writer and the rarely written flags each get their own cache line
+        alignas(64) std::atomic<u64> enqueuePos {0};
+        alignas(64) u64 dequeuePos {0};            // Writer thread only
+        alignas(64) std::atomic<u64> written {0};  // Messages handed to the sinks and flushed
+        std::atomic<bool> writerSleeping {false};
+        std::atomic<bool> running {true};
+
+        std::mutex mutex;  // Only used to park the writer when the queue is empty
+        std::condition_variable wake;
+        std::thread writer;
+
+        explicit AsyncQueue(u32 capacity) {
+            const u64 size = std::bit_ceil(std::max<u64>(capacity, 2));
+            cells          = make_unique<Cell[]>(size);
+            mask           = size - 1;
+            for (u64 i = 0; i < size; ++i) {
+                cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        // Also runs at static destruction when Shutdown was never called, a joinable thread would terminate
+        ~AsyncQueue() {
+            if (!writer.joinable()) return;
+            // The writer drains whatever is left before it exits
+            running.store(false, std::memory_order_release);
+            wake.notify_one();
+            writer.join();
+        }
+
+        Record* BeginPush(u64& position) {
+            position = enqueuePos.load(std::memory_order_relaxed);
+            for (;;) {
+                Cell& cell     = cells[position & mask];
+                const u64 seq  = cell.sequence.load(std::memory_order_acquire);
+                const i64 diff = CAST<i64>(seq) - CAST<i64>(position);
+                if (diff == 0) {
+                    if (enqueuePos.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                        return &cell.record;
+                    }
+                } else if (diff < 0) {
+                    return nullptr;  // Full
+                } else {
+                    position = enqueuePos.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        void EndPush(u64 position) {
+            cells[position & mask].sequence.store(position + 1, std::memory_order_release);
+            if (writerSleeping.load(std::memory_order_acquire)) { wake.notify_one(); }
+        }
+
+        Record* Front() {
+            Cell& cell = cells[dequeuePos & mask];
+            if (cell.sequence.load(std::memory_order_acquire) != dequeuePos + 1) return nullptr;
+            return &cell.record;
+        }
+
+        void Pop() {
+            cells[dequeuePos & mask].sequence.store(dequeuePos + mask + 1, std::memory_order_release);
+            ++dequeuePos;
+        }
+
+        bool HasPending() const {
+            return enqueuePos.load(std::memory_order_acquire) != dequeuePos;
+        }
+    };
+
     shared_ptr<spdlog::logger> Log::_logger;
+    unique_ptr<Log::AsyncQueue> Log::_queue;
+    std::atomic<u64> Log::_dropped {0};
 
-    void Log::Initialize() {
-        // Create console sink with color support
-        auto consoleSink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
-        consoleSink->set_pattern("[%T] [%^%l%$] %n: %v");
+    void Log::Initialize(const LogConfig& config) {
+        Shutdown();
+
+        vector<spdlog::sink_ptr> sinks;
+        if (config.console) {
+            // Create console sink with color support
+            auto consoleSink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+            consoleSink->set_pattern("[%T] [%^%l%$] %n: %v");
+            sinks.push_back(consoleSink);
+        }
+
+        str fileError;
+        if (!config.filePath.empty()) {
+            try {
+                auto fileSink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(config.filePath, true);
+                fileSink->set_pattern("[%Y-%m-%d %T.%e] [%l] %n: %v");
+                sinks.push_back(fileSink);
+            } catch (const spdlog::spdlog_ex& e) { fileError = e.what(); }
+        }
 
         // Create logger
-        _logger = std::make_shared<spdlog::logger>("ENGINE", consoleSink);
+        _logger = std::make_shared<spdlog::logger>("ENGINE", sinks.begin(), sinks.end());
         _logger->set_level(spdlog::level::trace);
-        _logger->flush_on(spdlog::level::trace);
+        _dropped.store(0, std::memory_order_relaxed);
+
+        if (config.async) {
+            // The writer flushes once per drained batch instead of once per line
+            _logger->flush_on(spdlog::level::off);
+            _queue           = make_unique<AsyncQueue>(config.queueCapacity);
+            _queue->overflow = config.overflow;
+            _queue->writer   = std::thread(&Log::WriterMain);
+        } else {
+            _logger->flush_on(spdlog::level::trace);
+        }
 
         // Register as default logger
         spdlog::register_logger(_logger);
         spdlog::set_default_logger(_logger);
 
-        Info("Logging system initialized");
+        Info("Logging system initialized ({})", config.async ? "async" : "sync");
+        if (!fileError.empty()) { Error("Failed to open log file '{}': {}", config.filePath, fileError); }
     }
 
     void Log::Shutdown() {
         if (_logger) {
             Info("Shutting down logging system");
+
+            _queue.reset();
+
+            const u64 dropped = _dropped.load(std::memory_order_relaxed);
+            if (dropped > 0) { _logger->warn("{} log messages were dropped because the queue was full", dropped); }
+
             _logger->flush();
             spdlog::drop_all();
             _logger.reset();
         }
     }
 
+    void Log::Flush() {
+        if (!_logger) return;
+        if (!_queue) {
+            _logger->flush();
+            return;
+        }
+
+        const u64 target = _queue->enqueuePos.load(std::memory_order_acquire);
+        while (_queue->written.load(std::memory_order_acquire) < target) {
+            _queue->wake.notify_one();
+            std::this_thread::yield();
+        }
+    }
+
+    u64 Log::GetDroppedMessages() {
+        return _dropped.load(std::memory_order_relaxed);
+    }
+
+    void Log::Submit(spdlog::level::level_enum level, char* buffer, size_t formattedSize) {
+        // Not GetLogger, copying the shared_ptr would bounce its refcount between every logging thread
+        if (!_logger) { Initialize(); }
+
+        const u32 length = CAST<u32>(std::min(formattedSize, kMaxMessageSize));
+        if (formattedSize > kMaxMessageSize) { std::memcpy(buffer + kMaxMessageSize - 3, "...", 3); }
+
+        if (!_queue) {
+            _logger->log(level, spdlog::string_view_t(buffer, length));
+            return;
+        }
+
+        const bool mustWrite = level >= spdlog::level::err || _queue->overflow == LogOverflow::Block;
+
+        u64 position               = 0;
+        AsyncQueue::Record* record = _queue->BeginPush(position);
+        while (!record) {
+            if (!mustWrite) {
+                _dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            _queue->wake.notify_one();
+            std::this_thread::yield();
+            record = _queue->BeginPush(position);
+        }
+
+        record->time   = spdlog::log_clock::now();
+        record->level  = level;
+        record->length = length;
+        std::memcpy(record->text, buffer, length);
+        _queue->EndPush(position);
+    }
+
+    void Log::WriterMain() {
+        AsyncQueue& queue = *_queue;
+        for (;;) {
+            u32 batch = 0;
+            while (AsyncQueue::Record* record = queue.Front()) {
+                _logger->log(record->time,
+                             spdlog::source_loc {},
+                             record->level,
+                             spdlog::string_view_t(record->text, record->length));
+                queue.Pop();
+                ++batch;
+            }
+
+            if (batch > 0) {
+                _logger->flush();
+                queue.written.store(queue.dequeuePos, std::memory_order_release);
+                continue;
+            }
+
+            if (!queue.running.load(std::memory_order_acquire)) break;
+
+            // Producers only notify while the writer is parked, the timeout covers a notify that races the flag
+            std::unique_lock lock(queue.mutex);
+            queue.writerSleeping.store(true, std::memory_order_seq_cst);
+            queue.wake.wait_for(lock, std::chrono::milliseconds(50), [&queue] {
+                return queue.HasPending() || !queue.running.load(std::memory_order_acquire);
+            });
+            queue.writerSleeping.store(false, std::memory_order_relaxed);
+        }
+    }
+
     shared_ptr<spdlog::logger> Log::GetLogger() {
         if (!_logger) { Initialize(); }
         return _logger;
     }
-}  // namespace X::Core
\ No newline at end of file
+}  // namespace X::Core
@@ -5,48 +5,96 @@
 #pragma once
 
 #include <spdlog/spdlog.h>
+#include <atomic>
 #include <memory>
 
 namespace X::Core {
 
+    // What Log does with a message when the async queue is full. Error and Critical always wait for space.
+    enum class LogOverflow : uint8_t {
+        Drop,   // Discard and count the message, the caller never waits on the writer thread
+        Block,  // Wait for the writer thread to make room, nothing is lost
+    };
+
+    struct LogConfig {
+        bool async {true};  // Write from a background thread, callers only format and enqueue
+        bool console {true};
+        std::string filePath;           // Empty disables the file sink
+        uint32_t queueCapacity {8192};  // Messages, rounded up to a power of two
+        LogOverflow overflow {LogOverflow::Drop};
+    };
+
+    // Format strings are checked at compile time. Messages are formatted on the calling thread into a fixed-size
+    // buffer without allocating, then either written directly (sync) or copied into a bounded lock-free queue that a
+    // writer thread drains, flushing the sinks once per batch (async). Trace and Debug compile to nothing in Release
+    // builds, although their arguments are still evaluated. Initialize and Shutdown must not race with logging.
     class Log {
     public:
-        static void Initialize();
+        static constexpr size_t kMaxMessageSize = 480;  // Longer messages are truncated
+
+#if defined(ENGINE_RELEASE)
+        static constexpr bool kDebugEnabled = false;
+#else
+        static constexpr bool kDebugEnabled = true;
+#endif
+
+        static void Initialize(const LogConfig& config = {});
         static void Shutdown();
 
+        // Blocks until everything logged so far has reached the sinks
+        static void Flush();
+        static uint64_t GetDroppedMessages();
+
         template<typename... Args>
-        static void Trace(const std::string& format, Args&&... args) {
-            GetLogger()->trace(fmt::runtime(format), std::forward<Args>(args)...);
+        static void Trace(fmt::format_string<Args...> format, Args&&... args) {
+            if constexpr (kDebugEnabled) { Write(spdlog::level::trace, format, std::forward<Args>(args)...); }
         }
 
         template<typename... Args>
-        static void Debug(const std::string& format, Args&&... args) {
-            GetLogger()->debug(fmt::runtime(format), std::forward<Args>(args)...);
+        static void Debug(fmt::format_string<Args...> format, Args&&... args) {
+            if constexpr (kDebugEnabled) { Write(spdlog::level::debug, format, std::forward<Args>(args)...); }
         }
 
         template<typename... Args>
-        static void Info(const std::string& format, Args&&... args) {
-            GetLogger()->info(fmt::runtime(format), std::forward<Args>(args)...);
+        static void Info(fmt::format_string<Args...> format, Args&&... args) {
+            Write(spdlog::level::info, format, std::forward<Args>(args)...);
         }
 
         template<typename... Args>
-        static void Warn(const std::string& format, Args&&... args) {
-            GetLogger()->warn(fmt::runtime(format), std::forward<Args>(args)...);
+        static void Warn(fmt::format_string<Args...> format, Args&&... args) {
+            Write(spdlog::level::warn, format, std::forward<Args>(args)...);
         }
 
         template<typename... Args>
-        static void Error(const std::string& format, Args&&... args) {
-            GetLogger()->error(fmt::runtime(format), std::forward<Args>(args)...);
+        static void Error(fmt::format_string<Args...> format, Args&&... args) {
+            Write(spdlog::level::err, format, std::forward<Args>(args)...);
         }
 
+        // Also flushes, so the message is written even if the process dies right after
         template<typename... Args>
-        static void Critical(const std::string& format, Args&&... args) {
-            GetLogger()->critical(fmt::runtime(format), std::forward<Args>(args)...);
+        static void Critical(fmt::format_string<Args...> format, Args&&... args) {
+            Write(spdlog::level::critical, format, std::forward<Args>(args)...);
+            Flush();
         }
 
     private:
+        struct AsyncQueue;
+
+        template<typename... Args>
+        static void Write(spdlog::level::level_enum level, fmt::format_string<Args...> format, Args&&... args) {
+            char buffer[kMaxMessageSize];
+            const auto result = fmt::format_to_n(buffer, kMaxMessageSize, format, std::forward<Args>(args)...);
+            Submit(level, buffer, result.size);
+        }
+
+        // formattedSize is the untruncated length reported by format_to_n
+        static void Submit(spdlog::level::level_enum level, char* buffer, size_t formattedSize);
+        static void WriterMain();
+
         static std::shared_ptr<spdlog::logger> GetLogger();
         static std::shared_ptr<spdlog::logger> _logger;
+        static std::unique_ptr<AsyncQueue> _queue;
+        static std::atomic<uint64_t> _dropped;
     };
 
-}  // namespace X::Core
\ No newline at end of file
+}  // namespace X::Core
@@ -0,0 +1,157 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include "MappedFile.hpp"
+#include "Log.hpp"
+
+#if !defined(ENGINE_PLATFORM_WINDOWS)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace X::Core {
+    namespace {
+        // Page-aligned range covering [offset, offset + size) of a mapping that starts at base
+        std::pair<u8*, size_t> PageRange(const u8* base, u64 mappedSize, u64 offset, u64 size) {
+#if defined(ENGINE_PLATFORM_WINDOWS)
+            SYSTEM_INFO info;
+            GetSystemInfo(&info);
+            const u64 pageSize = info.dwPageSize;
+#else
+            const u64 pageSize = CAST<u64>(sysconf(_SC_PAGESIZE));
+#endif
+            const u64 end   = std::min(offset + size, mappedSize);
+            const u64 first = offset / pageSize * pageSize;
+            if (offset >= end) return {nullptr, 0};
+            return {CCAST<u8*>(base) + first, CAST<size_t>(end - first)};
+        }
+    }  // namespace
+
+    MappedFile::~MappedFile() {
+        Close();
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept {
+        *this = std::move(other);
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+        if (this == &other) return *this;
+        Close();
+        _data = std::exchange(other._data, nullptr);
+        _size = std::exchange(other._size, 0);
+#if defined(ENGINE_PLATFORM_WINDOWS)
+        _file    = std::exchange(other._file, INVALID_HANDLE_VALUE);
+        _mapping = std::exchange(other._mapping, nullptr);
+#endif
+        return *this;
+    }
+
+#if defined(ENGINE_PLATFORM_WINDOWS)
+    bool MappedFile::Open(const str& path) {
+        Close();
+
+        _file = CreateFileA(path.c_str(),
+                            GENERIC_READ,
+                            FILE_SHARE_READ,
+                            nullptr,
+                            OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL,
+                            nullptr);
+        if (_file == INVALID_HANDLE_VALUE) {
+            Log::Error("Failed to open {} (error {})", path, GetLastError());
+            return false;
+        }
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(_file, &size) || size.QuadPart == 0) {
+            Log::Error("Cannot map {}, it is empty or its size is unknown", path);
+            Close();
+            return false;
+        }
+
+        _mapping = CreateFileMappingA(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (_mapping) { _data = CAST<const u8*>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0)); }
+        if (!_data) {
+            Log::Error("Failed to map {} (error {})", path, GetLastError());
+            Close();
+            return false;
+        }
+        _size = CAST<u64>(size.QuadPart);
+        return true;
+    }
+
+    void MappedFile::Close() {
+        if (_data) { UnmapViewOfFile(_data); }
+        if (_mapping) { CloseHandle(_mapping); }
+        if (_file != INVALID_HANDLE_VALUE) { CloseHandle(_file); }
+        _data    = nullptr;
+        _size    = 0;
+        _mapping = nullptr;
+        _file    = INVALID_HANDLE_VALUE;
+    }
+
+    void MappedFile::Prefetch(u64 offset, u64 size) const {
+        const auto [address, length] = PageRange(_data, _size, offset, size);
+        if (!address) return;
+        WIN32_MEMORY_RANGE_ENTRY range {address, length};
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+    }
+
+    void MappedFile::Evict(u64 offset, u64 size) const {
+        const auto [address, length] = PageRange(_data, _size, offset, size);
+        // Unlocking pages that were never locked removes them from the working set
+        if (address) { VirtualUnlock(address, length); }
+    }
+#else
+    bool MappedFile::Open(const str& path) {
+        Close();
+
+        const int file = open(path.c_str(), O_RDONLY);
+        if (file < 0) {
+            Log::Error("Failed to open {} (errno {})", path, errno);
+            return false;
+        }
+
+        struct stat info {};
+        if (fstat(file, &info) != 0 || info.st_size == 0) {
+            Log::Error("Cannot map {}, it is empty or its size is unknown", path);
+            close(file);
+            return false;
+        }
+
+        void* data = mmap(nullptr, CAST<size_t>(info.st_size), PROT_READ, MAP_SHARED, file, 0);
+        // The mapping keeps its own reference to the file
+        close(file);
+        if (data == MAP_FAILED) {
+            Log::Error("Failed to map {} (errno {})", path, errno);
+            return false;
+        }
+
+        _data = CAST<const u8*>(data);
+        _size = CAST<u64>(info.st_size);
+        return true;
+    }
+
+    void MappedFile::Close() {
+        if (_data) { munmap(CCAST<u8*>(_data), CAST<size_t>(_size)); }
+        _data = nullptr;
+        _size = 0;
+    }
+
+    void MappedFile::Prefetch(u64 offset, u64 size) const {
+        const auto [address, length] = PageRange(_data, _size, offset, size);
+        if (address) { madvise(address, length, MADV_WILLNEED); }
+    }
+
+    void MappedFile::Evict(u64 offset, u64 size) const {
+        const auto [address, length] = PageRange(_data, _size, offset, size);
+        // Clean shared file pages are simply unmapped, the page cache keeps them
+        if (address) { madvise(address, length, MADV_DONTNEED); }
+    }
+#endif
+
+}  // namespace X::Core
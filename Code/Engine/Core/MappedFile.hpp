@@ -0,0 +1,52 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#pragma once
+
+#include "EnginePCH.h"
+
+namespace X::Core {
+
+    // Read-only memory mapping of a whole file. Pages are faulted in from the OS page cache on first touch, so opening
+    // is cheap whatever the file size and nothing is copied into the heap. The file must not change while mapped.
+    class MappedFile {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile&)            = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        // Logs and returns false when the file cannot be opened or mapped. Empty files cannot be mapped.
+        bool Open(const str& path);
+        void Close();
+
+        // Hints that a range is about to be read so the OS can start reading it ahead
+        void Prefetch(u64 offset, u64 size) const;
+        // Drops a range that has been consumed from the process's resident set. It stays mapped and is faulted back
+        // in from the page cache if touched again.
+        void Evict(u64 offset, u64 size) const;
+
+        const u8* GetData() const {
+            return _data;
+        }
+        u64 GetSize() const {
+            return _size;
+        }
+        bool IsOpen() const {
+            return _data != nullptr;
+        }
+
+    private:
+        const u8* _data {nullptr};
+        u64 _size {0};
+#if defined(ENGINE_PLATFORM_WINDOWS)
+        HANDLE _file {INVALID_HANDLE_VALUE};
+        HANDLE _mapping {nullptr};
+#endif
+    };
+
+}  // namespace X::Core
@@ -0,0 +1,236 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include "Memory.hpp"
+
+#include <new>
+
+namespace X::Core {
+    namespace {
+        size_t AlignUp(size_t value, size_t alignment) {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+        u8* AllocateAligned(size_t size, size_t alignment) {
+            return CAST<u8*>(::operator new(size, std::align_val_t {alignment}, std::nothrow));
+        }
+
+        void FreeAligned(void* pointer, size_t alignment) {
+            ::operator delete(pointer, std::align_val_t {alignment});
+        }
+
+        // Blocks and pages are aligned to a cache line so nothing allocated from them straddles one needlessly
+        constexpr size_t kBlockAlignment = 64;
+    }  // namespace
+
+    void AllocationCounters::Reset() {
+        const u64 inUse       = _stats.bytesInUse;
+        _stats                = {};
+        _stats.bytesInUse     = inUse;
+        _stats.peakBytesInUse = inUse;
+    }
+
+    LinearArena::LinearArena(size_t blockSize) : _blockSize(std::max<size_t>(blockSize, kBlockAlignment)) {}
+
+    LinearArena::~LinearArena() {
+        Release();
+    }
+
+    void* LinearArena::Allocate(size_t size, size_t alignment) {
+        const size_t before = _used;
+        if (_blocks.empty() && !NextBlock(size, alignment)) return nullptr;
+
+        const auto base = RCAST<uptr>(_blocks[_current].data);
+        size_t start    = AlignUp(base + _offset, alignment) - base;
+        if (start + size > _blocks[_current].size) {
+            if (!NextBlock(size, alignment)) return nullptr;
+            const auto next = RCAST<uptr>(_blocks[_current].data);
+            start           = AlignUp(next, alignment) - next;
+        }
+
+        _used += start + size - _offset;
+        _offset = start + size;
+        _counters.OnAllocate(_used - before);
+        return _blocks[_current].data + start;
+    }
+
+    bool LinearArena::NextBlock(size_t size, size_t alignment) {
+        // Blocks are cache line aligned, anything stricter needs room to pad
+        const size_t required = alignment > kBlockAlignment ? size + alignment : size;
+
+        // The unused tail of every block we move past counts as used until the next Reset or Rewind
+        const bool hasCurrent = !_blocks.empty();
+        const auto skip       = [this, hasCurrent](size_t next) {
+            if (hasCurrent) {
+                _used += _blocks[_current].size - _offset;
+                for (size_t i = _current + 1; i < next; ++i) {
+                    _used += _blocks[i].size;
+                }
+            }
+            _current = next;
+            _offset  = 0;
+        };
+
+        const size_t first = hasCurrent ? _current + 1 : 0;
+        for (size_t i = first; i < _blocks.size(); ++i) {
+            if (_blocks[i].size >= required) {
+                skip(i);
+                return true;
+            }
+        }
+
+        Block block;
+        block.size = std::max(_blockSize, AlignUp(required, kBlockAlignment));
+        block.data = AllocateAligned(block.size, kBlockAlignment);
+        if (!block.data) return false;
+        _counters.OnUpstreamAllocate();
+
+        _blocks.push_back(block);
+        skip(_blocks.size() - 1);
+        return true;
+    }
+
+    void LinearArena::Reset() {
+        _current = 0;
+        _offset  = 0;
+        _used    = 0;
+        _counters.OnRelease();
+    }
+
+    LinearArena::Marker LinearArena::GetMarker() const {
+        return {_current, _offset};
+    }
+
+    void LinearArena::Rewind(const Marker& marker) {
+        if (marker.block > _current || (marker.block == _current && marker.offset >= _offset)) return;
+
+        // Bytes between the marker and the head, counting whole blocks moved past since
+        size_t released = _offset;
+        for (size_t i = marker.block; i < _current; ++i) {
+            released += _blocks[i].size;
+        }
+        released -= marker.offset;
+
+        _used    = released > _used ? 0 : _used - released;
+
+        _current = marker.block;
+        _offset  = marker.offset;
+        _counters.OnDeallocate(released);
+    }
+
+    void LinearArena::Release() {
+        for (const Block& block : _blocks) {
+            FreeAligned(block.data, kBlockAlignment);
+        }
+        _blocks.clear();
+        Reset();
+    }
+
+    size_t LinearArena::GetCapacity() const {
+        size_t capacity = 0;
+        for (const Block& block : _blocks) {
+            capacity += block.size;
+        }
+        return capacity;
+    }
+
+    LinearArena& GetScratchArena() {
+        thread_local LinearArena arena(256 * 1024);
+        return arena;
+    }
+
+    PoolAllocator::PoolAllocator(size_t blockSize, size_t blocksPerPage, size_t alignment)
+        : _blockSize(AlignUp(std::max(blockSize, sizeof(FreeBlock)), std::max(alignment, alignof(FreeBlock)))),
+          _blocksPerPage(std::max<size_t>(blocksPerPage, 1)), _alignment(std::max(alignment, alignof(FreeBlock))) {}
+
+    PoolAllocator::~PoolAllocator() {
+        Release();
+    }
+
+    void* PoolAllocator::Allocate() {
+        if (!_freeList && !AddPage()) return nullptr;
+
+        FreeBlock* block = _freeList;
+        _freeList        = block->next;
+        _counters.OnAllocate(_blockSize);
+        return block;
+    }
+
+    void PoolAllocator::Free(void* block) {
+        if (!block) return;
+
+        auto* freeBlock = CAST<FreeBlock*>(block);
+        freeBlock->next = _freeList;
+        _freeList       = freeBlock;
+        _counters.OnDeallocate(_blockSize);
+    }
+
+    void PoolAllocator::Release() {
+        for (u8* page : _pages) {
+            FreeAligned(page, std::max(_alignment, kBlockAlignment));
+        }
+        _pages.clear();
+        _freeList = nullptr;
+        _counters.OnRelease();
+    }
+
+    bool PoolAllocator::Owns(const void* block) const {
+        const auto* bytes      = CAST<const u8*>(block);
+        const size_t pageBytes = _blockSize * _blocksPerPage;
+        for (const u8* page : _pages) {
+            if (bytes >= page && bytes < page + pageBytes) return true;
+        }
+        return false;
+    }
+
+    bool PoolAllocator::AddPage() {
+        u8* page = AllocateAligned(_blockSize * _blocksPerPage, std::max(_alignment, kBlockAlignment));
+        if (!page) return false;
+        _counters.OnUpstreamAllocate();
+        _pages.push_back(page);
+
+        // Thread the page onto the free list back to front so blocks are handed out in address order
+        for (size_t i = _blocksPerPage; i > 0; --i) {
+            auto* block = RCAST<FreeBlock*>(page + (i - 1) * _blockSize);
+            block->next = _freeList;
+            _freeList   = block;
+        }
+        return true;
+    }
+
+    void* ArenaResource::do_allocate(size_t bytes, size_t alignment) {
+        void* pointer = _arena.Allocate(bytes, alignment);
+        if (!pointer) throw std::bad_alloc();
+        return pointer;
+    }
+
+    bool ArenaResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+        return this == &other;
+    }
+
+    PoolResource::PoolResource(size_t blockSize, size_t blocksPerPage, std::pmr::memory_resource* upstream)
+        : _pool(blockSize, blocksPerPage), _upstream(upstream) {}
+
+    void* PoolResource::do_allocate(size_t bytes, size_t alignment) {
+        if (bytes > _pool.GetBlockSize() || alignment > _pool.GetAlignment()) {
+            return _upstream->allocate(bytes, alignment);
+        }
+
+        void* pointer = _pool.Allocate();
+        if (!pointer) throw std::bad_alloc();
+        return pointer;
+    }
+
+    void PoolResource::do_deallocate(void* pointer, size_t bytes, size_t alignment) {
+        if (bytes > _pool.GetBlockSize() || alignment > _pool.GetAlignment()) {
+            _upstream->deallocate(pointer, bytes, alignment);
+            return;
+        }
+        _pool.Free(pointer);
+    }
+
+    bool PoolResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+        return this == &other;
+    }
+}  // namespace X::Core
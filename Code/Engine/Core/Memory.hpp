@@ -0,0 +1,245 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#pragma once
+
+#include "EnginePCH.h"
+
+#include <memory_resource>
+
+namespace X::Core {
+
+    inline constexpr size_t kDefaultAlignment = alignof(std::max_align_t);
+
+    struct AllocationStats {
+        u64 allocations {0};
+        u64 deallocations {0};
+        u64 bytesAllocated {0};       // Total bytes handed out since the last Reset
+        u64 bytesInUse {0};           // Bytes currently handed out
+        u64 peakBytesInUse {0};       // High-water mark of bytesInUse
+        u64 upstreamAllocations {0};  // Calls that went to the system allocator (block or page growth)
+    };
+
+    // Counters kept by every allocator. The allocators are single-threaded, so these are plain integers and should
+    // be read from the owning thread (or once it is idle).
+    class AllocationCounters {
+    public:
+        void OnAllocate(size_t bytes) {
+            ++_stats.allocations;
+            _stats.bytesAllocated += bytes;
+            _stats.bytesInUse += bytes;
+            _stats.peakBytesInUse = std::max(_stats.peakBytesInUse, _stats.bytesInUse);
+        }
+        void OnDeallocate(size_t bytes) {
+            ++_stats.deallocations;
+            _stats.bytesInUse -= std::min<u64>(bytes, _stats.bytesInUse);
+        }
+        void OnUpstreamAllocate() {
+            ++_stats.upstreamAllocations;
+        }
+        // Arenas free everything at once
+        void OnRelease() {
+            _stats.bytesInUse = 0;
+        }
+
+        const AllocationStats& GetStats() const {
+            return _stats;
+        }
+        // Clears the running totals, keeping bytesInUse
+        void Reset();
+
+    private:
+        AllocationStats _stats;
+    };
+
+    // Bump allocator over a chain of blocks. Allocation is a pointer increment, individual frees do nothing and
+    // Reset releases everything at once while keeping the blocks for the next use. Not thread-safe, give each thread
+    // its own arena.
+    class LinearArena {
+    public:
+        // Position to rewind to, see GetMarker
+        struct Marker {
+            size_t block {0};
+            size_t offset {0};
+        };
+
+        explicit LinearArena(size_t blockSize = 64 * 1024);
+        ~LinearArena();
+
+        LinearArena(const LinearArena&)            = delete;
+        LinearArena& operator=(const LinearArena&) = delete;
+
+        void* Allocate(size_t size, size_t alignment = kDefaultAlignment);
+
+        template<typename T>
+        T* AllocateArray(size_t count) {
+            return CAST<T*>(Allocate(count * sizeof(T), alignof(T)));
+        }
+
+        // Destructors are never run, only use for trivially destructible types or call them yourself
+        template<typename T, typename... Args>
+        T* New(Args&&... args) {
+            return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        }
+
+        void Reset();
+        Marker GetMarker() const;
+        // Releases everything allocated after marker was taken
+        void Rewind(const Marker& marker);
+        // Frees every block, including the first
+        void Release();
+
+        size_t GetUsed() const {
+            return _used;
+        }
+        size_t GetCapacity() const;
+        const AllocationCounters& GetCounters() const {
+            return _counters;
+        }
+
+    private:
+        struct Block {
+            u8* data {nullptr};
+            size_t size {0};
+        };
+
+        bool NextBlock(size_t size, size_t alignment);
+
+        vector<Block> _blocks;
+        size_t _blockSize {0};
+        size_t _current {0};  // Index of the block being bumped
+        size_t _offset {0};   // Bytes used in the current block
+        size_t _used {0};     // Bytes used across all blocks, including alignment padding
+        AllocationCounters _counters;
+    };
+
+    // Rewinds an arena to where it was when the scope was entered
+    class ArenaScope {
+    public:
+        explicit ArenaScope(LinearArena& arena) : _arena(arena), _marker(arena.GetMarker()) {}
+        ~ArenaScope() {
+            _arena.Rewind(_marker);
+        }
+
+        ArenaScope(const ArenaScope&)            = delete;
+        ArenaScope& operator=(const ArenaScope&) = delete;
+
+    private:
+        LinearArena& _arena;
+        LinearArena::Marker _marker;
+    };
+
+    // Per-thread arena for short-lived job allocations. Jobs nest when a thread helps out inside JobSystem::Wait,
+    // so take an ArenaScope (or use ScratchScope) instead of resetting it.
+    LinearArena& GetScratchArena();
+
+    class ScratchScope : public ArenaScope {
+    public:
+        ScratchScope() : ArenaScope(GetScratchArena()) {}
+    };
+
+    // Fixed-size block allocator. Blocks come from pages of blocksPerPage and are recycled through an intrusive free
+    // list, so steady-state allocation never reaches malloc. Not thread-safe.
+    class PoolAllocator {
+    public:
+        PoolAllocator(size_t blockSize, size_t blocksPerPage = 256, size_t alignment = kDefaultAlignment);
+        ~PoolAllocator();
+
+        PoolAllocator(const PoolAllocator&)            = delete;
+        PoolAllocator& operator=(const PoolAllocator&) = delete;
+
+        void* Allocate();
+        void Free(void* block);
+        // Frees every page. Outstanding blocks become invalid.
+        void Release();
+
+        bool Owns(const void* block) const;
+
+        size_t GetBlockSize() const {
+            return _blockSize;
+        }
+        size_t GetAlignment() const {
+            return _alignment;
+        }
+        const AllocationCounters& GetCounters() const {
+            return _counters;
+        }
+
+    private:
+        struct FreeBlock {
+            FreeBlock* next;
+        };
+
+        bool AddPage();
+
+        vector<u8*> _pages;
+        FreeBlock* _freeList {nullptr};
+        size_t _blockSize {0};
+        size_t _blocksPerPage {0};
+        size_t _alignment {0};
+        AllocationCounters _counters;
+    };
+
+    // Pool of T that constructs and destroys in place
+    template<typename T>
+    class ObjectPool {
+    public:
+        explicit ObjectPool(size_t objectsPerPage = 256) : _pool(sizeof(T), objectsPerPage, alignof(T)) {}
+
+        template<typename... Args>
+        T* New(Args&&... args) {
+            void* block = _pool.Allocate();
+            return block ? new (block) T(std::forward<Args>(args)...) : nullptr;
+        }
+
+        void Delete(T* object) {
+            if (!object) return;
+            object->~T();
+            _pool.Free(object);
+        }
+
+        const AllocationCounters& GetCounters() const {
+            return _pool.GetCounters();
+        }
+
+    private:
+        PoolAllocator _pool;
+    };
+
+    // std::pmr adapter over a LinearArena, for std::pmr::vector and friends built fresh every frame. Deallocation is
+    // a no-op, memory comes back when the arena is reset.
+    class ArenaResource final : public std::pmr::memory_resource {
+    public:
+        explicit ArenaResource(LinearArena& arena) : _arena(arena) {}
+
+    private:
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void*, size_t, size_t) override {}
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+        LinearArena& _arena;
+    };
+
+    // std::pmr adapter over a PoolAllocator for node-based containers (list, map, unordered_map nodes). Requests
+    // that do not fit a block go to upstream.
+    class PoolResource final : public std::pmr::memory_resource {
+    public:
+        PoolResource(size_t blockSize,
+                     size_t blocksPerPage                = 256,
+                     std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+
+        const AllocationCounters& GetCounters() const {
+            return _pool.GetCounters();
+        }
+
+    private:
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void* pointer, size_t bytes, size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+        PoolAllocator _pool;
+        std::pmr::memory_resource* _upstream;
+    };
+
+}  // namespace X::Core
@@ -0,0 +1,255 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include "Profiler.hpp"
+#include "Log.hpp"
+
+#include <chrono>
+#include <mutex>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+#endif
+
+namespace X::Core {
+    std::atomic<bool> Profiler::_capturing {false};
+
+    // Every thread records into its own track, CreateTrack adds ones not tied to a thread
+    struct ProfileTrack {
+        u32 threadId {0};
+        str name;
+        unique_ptr<ProfileEvent[]> events;
+        // Owner thread writes, the exporter reads once the capture has ended
+        std::atomic<u32> count {0};
+        std::atomic<u64> generation {0};
+    };
+
+    namespace {
+
+        struct ProfilerState {
+            std::mutex mutex;  // Guards threads, taken once per thread and on capture boundaries
+            vector<unique_ptr<ProfileTrack>> threads;
+            std::atomic<u64> generation {0};
+            std::atomic<u64> dropped {0};
+            // Set at capture boundaries, read lock-free by the tick conversions
+            std::atomic<f64> nsPerTick {1.0};
+
+            u64 startTicks {0};
+            i64 startNs {0};
+        };
+
+        ProfilerState& GetState() {
+            static ProfilerState state;
+            return state;
+        }
+
+        i64 SteadyNanoseconds() {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                     std::chrono::steady_clock::now().time_since_epoch())
+              .count();
+        }
+
+        // The TSC rate is constant, so measuring it over a short spin once is enough to convert while capturing.
+        // EndCapture refines it over the whole capture for the export.
+        f64 CalibrateNsPerTick() {
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+            const u64 startTicks = Profiler::Now();
+            const i64 startNs    = SteadyNanoseconds();
+            i64 endNs            = startNs;
+            while (endNs - startNs < 10000000) {
+                endNs = SteadyNanoseconds();
+            }
+            const u64 endTicks = Profiler::Now();
+            if (endTicks <= startTicks) return 1.0;
+            return CAST<f64>(endNs - startNs) / CAST<f64>(endTicks - startTicks);
+#else
+            return 1.0;
+#endif
+        }
+
+        // Caller holds the state mutex
+        ProfileTrack* AddTrack(ProfilerState& state) {
+            state.threads.push_back(make_unique<ProfileTrack>());
+            ProfileTrack* track = state.threads.back().get();
+            track->threadId     = CAST<u32>(state.threads.size() - 1);
+            track->name         = fmt::format("Thread {}", track->threadId);
+            return track;
+        }
+
+        ProfileTrack& GetThreadTrack() {
+            thread_local ProfileTrack* buffer = nullptr;
+            if (!buffer) {
+                ProfilerState& state = GetState();
+                std::lock_guard lock(state.mutex);
+                buffer = AddTrack(state);
+            }
+            return *buffer;
+        }
+
+        void Append(ProfileTrack& buffer, const char* name, u64 start, u64 end) {
+            ProfilerState& state = GetState();
+
+            const u64 generation = state.generation.load(std::memory_order_acquire);
+            if (buffer.generation.load(std::memory_order_relaxed) != generation) {
+                if (!buffer.events) { buffer.events = make_unique<ProfileEvent[]>(Profiler::kEventsPerThread); }
+                buffer.count.store(0, std::memory_order_relaxed);
+                buffer.generation.store(generation, std::memory_order_release);
+            }
+
+            const u32 index = buffer.count.load(std::memory_order_relaxed);
+            if (index >= Profiler::kEventsPerThread) {
+                state.dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            buffer.events[index] = {name, start, end};
+            buffer.count.store(index + 1, std::memory_order_release);
+        }
+
+        void AppendEscaped(str& out, strview text) {
+            for (const char c : text) {
+                if (c == '"' || c == '\\') { out.push_back('\\'); }
+                out.push_back(c);
+            }
+        }
+    }  // namespace
+
+    void Profiler::BeginCapture() {
+        ProfilerState& state = GetState();
+        {
+            std::lock_guard lock(state.mutex);
+            static const f64 nsPerTick = CalibrateNsPerTick();
+            state.nsPerTick.store(nsPerTick, std::memory_order_relaxed);
+            state.startTicks = Now();
+            state.startNs    = SteadyNanoseconds();
+            state.dropped.store(0, std::memory_order_relaxed);
+        }
+
+        // Thread buffers notice the new generation and clear themselves on their next zone
+        state.generation.fetch_add(1, std::memory_order_release);
+        _capturing.store(true, std::memory_order_release);
+        Log::Info("Profiler capture started");
+    }
+
+    void Profiler::EndCapture() {
+        if (!_capturing.exchange(false, std::memory_order_acq_rel)) return;
+
+        ProfilerState& state = GetState();
+        std::lock_guard lock(state.mutex);
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+        const u64 endTicks = Now();
+        const i64 endNs    = SteadyNanoseconds();
+        if (endTicks > state.startTicks && endNs > state.startNs) {
+            state.nsPerTick.store(CAST<f64>(endNs - state.startNs) / CAST<f64>(endTicks - state.startTicks),
+                                  std::memory_order_relaxed);
+        }
+#endif
+        Log::Info("Profiler capture stopped");
+    }
+
+    void Profiler::Record(const char* name, u64 start, u64 end) {
+        Append(GetThreadTrack(), name, start, end);
+    }
+
+    ProfileTrack* Profiler::CreateTrack(const char* name) {
+        ProfilerState& state = GetState();
+        std::lock_guard lock(state.mutex);
+        ProfileTrack* track = AddTrack(state);
+        track->name         = name;
+        return track;
+    }
+
+    void Profiler::RecordOnTrack(ProfileTrack* track, const char* name, u64 start, u64 end) {
+        if (track) { Append(*track, name, start, end); }
+    }
+
+    void Profiler::SetThreadName(const char* name) {
+        ProfileTrack& buffer = GetThreadTrack();
+        std::lock_guard lock(GetState().mutex);
+        buffer.name = name;
+    }
+
+    u64 Profiler::Now() {
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return CAST<u64>(SteadyNanoseconds());
+#endif
+    }
+
+    f64 Profiler::TicksToNanoseconds(u64 ticks) {
+        return CAST<f64>(ticks) * GetState().nsPerTick.load(std::memory_order_relaxed);
+    }
+
+    u64 Profiler::NanosecondsToTicks(f64 nanoseconds) {
+        const f64 nsPerTick = GetState().nsPerTick.load(std::memory_order_relaxed);
+        return nsPerTick > 0.0 ? CAST<u64>(nanoseconds / nsPerTick) : 0;
+    }
+
+    u64 Profiler::GetDroppedEvents() {
+        return GetState().dropped.load(std::memory_order_relaxed);
+    }
+
+    bool Profiler::ExportChromeTrace(const str& path) {
+        if (IsCapturing()) {
+            Log::Error("Cannot export a profile while capturing");
+            return false;
+        }
+
+        ProfilerState& state = GetState();
+        std::lock_guard lock(state.mutex);
+
+        const u64 generation = state.generation.load(std::memory_order_acquire);
+        const f64 usPerTick  = state.nsPerTick.load(std::memory_order_relaxed) / 1.0e3;
+
+        str json;
+        json.reserve(1 << 20);
+        json += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+        bool first   = true;
+        size_t zones = 0;
+        for (const auto& buffer : state.threads) {
+            if (buffer->generation.load(std::memory_order_acquire) != generation) continue;
+
+            if (!first) { json += ','; }
+            first = false;
+            json += fmt::format(R"({{"name":"thread_name","ph":"M","pid":0,"tid":{},"args":{{"name":")",
+                                buffer->threadId);
+            AppendEscaped(json, buffer->name);
+            json += "\"}}";
+
+            const u32 count = buffer->count.load(std::memory_order_acquire);
+            for (u32 i = 0; i < count; ++i) {
+                const ProfileEvent& event = buffer->events[i];
+                const u64 offset          = std::max(event.start, state.startTicks) - state.startTicks;
+                const f64 start           = CAST<f64>(offset) * usPerTick;
+                const f64 duration        = CAST<f64>(event.end - event.start) * usPerTick;
+
+                json += R"(,{"name":")";
+                AppendEscaped(json, event.name);
+                json += fmt::format(R"(","ph":"X","pid":0,"tid":{},"ts":{:.3f},"dur":{:.3f}}})",
+                                    buffer->threadId,
+                                    start,
+                                    duration);
+            }
+            zones += count;
+        }
+        json += "]}";
+
+        std::ofstream file(path, std::ios::binary);
+        if (!file) {
+            Log::Error("Failed to open profile output '{}'", path);
+            return false;
+        }
+        file.write(json.data(), CAST<std::streamsize>(json.size()));
+
+        Log::Info("Exported {} profiler zones to {} ({} dropped)",
+                  zones,
+                  path,
+                  state.dropped.load(std::memory_order_relaxed));
+        return true;
+    }
+}  // namespace X::Core
@@ -0,0 +1,99 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#pragma once
+
+#include "EnginePCH.h"
+
+#include <atomic>
+
+namespace X::Core {
+
+    // Timestamps are raw ticks from Profiler::Now (TSC on x86, steady_clock nanoseconds elsewhere)
+    struct ProfileEvent {
+        const char* name;
+        u64 start;
+        u64 end;
+    };
+
+    struct ProfileTrack;
+
+    // Captures scoped CPU zones from any thread and exports them as a Chrome trace (chrome://tracing, Perfetto).
+    // Each thread records into its own fixed-size buffer with no locks; a zone costs two timestamps and one store.
+    // While no capture is running a zone is a single relaxed load and branch, and building without
+    // ENGINE_PROFILER_ENABLED removes the macros entirely.
+    class Profiler {
+    public:
+        // Events kept per thread and capture, later events are dropped and counted
+        static constexpr u32 kEventsPerThread = 1 << 16;
+
+        static bool IsCapturing() {
+            return _capturing.load(std::memory_order_relaxed);
+        }
+
+        // Starts a new capture, discarding the previous one
+        static void BeginCapture();
+        static void EndCapture();
+
+        // Writes the last capture as Chrome trace JSON. Call after EndCapture once the zones have closed.
+        static bool ExportChromeTrace(const str& path);
+
+        // Names the calling thread in exported traces. The string is copied.
+        static void SetThreadName(const char* name);
+
+        // Zone names must outlive the capture, use string literals
+        static void Record(const char* name, u64 start, u64 end);
+
+        // Tracks are timelines not tied to a thread, e.g. GPU queues. Each track must only be recorded to from one
+        // thread at a time. The profiler owns the track and keeps it for the life of the process, so callers hold
+        // on to the pointer and recording takes no lock.
+        static ProfileTrack* CreateTrack(const char* name);
+        static void RecordOnTrack(ProfileTrack* track, const char* name, u64 start, u64 end);
+
+        static u64 Now();
+        // Convert between tick differences and nanoseconds. The tick rate is measured by the first BeginCapture and
+        // refined over each capture by EndCapture. Lock-free.
+        static f64 TicksToNanoseconds(u64 ticks);
+        static u64 NanosecondsToTicks(f64 nanoseconds);
+        static u64 GetDroppedEvents();
+
+    private:
+        static std::atomic<bool> _capturing;
+    };
+
+    class ProfileZone {
+    public:
+        explicit ProfileZone(const char* name) {
+            if (Profiler::IsCapturing()) {
+                _name  = name;
+                _start = Profiler::Now();
+            }
+        }
+
+        ~ProfileZone() {
+            if (_name) { Profiler::Record(_name, _start, Profiler::Now()); }
+        }
+
+        ProfileZone(const ProfileZone&)            = delete;
+        ProfileZone& operator=(const ProfileZone&) = delete;
+
+    private:
+        const char* _name {nullptr};
+        u64 _start {0};
+    };
+
+}  // namespace X::Core
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#if defined(ENGINE_PROFILER_ENABLED)
+    #define PROFILE_SCOPE(name) ::X::Core::ProfileZone PROFILE_CONCAT(_profileZone, __LINE__)(name)
+    #define PROFILE_FUNCTION() PROFILE_SCOPE(__FUNCTION__)
+    #define PROFILE_THREAD(name) ::X::Core::Profiler::SetThreadName(name)
+#else
+    #define PROFILE_SCOPE(name)
+    #define PROFILE_FUNCTION()
+    #define PROFILE_THREAD(name)
+#endif
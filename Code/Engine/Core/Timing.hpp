@@ -0,0 +1,18 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#pragma once
+
+#include "EnginePCH.h"
+
+#include <chrono>
+
+namespace X::Core {
+    // Wall-clock timing for stats and benchmarks. Zones meant for traces go through Profiler instead.
+    using Clock = std::chrono::steady_clock;
+
+    inline f64 ElapsedMs(Clock::time_point start) {
+        return std::chrono::duration<f64, std::milli>(Clock::now() - start).count();
+    }
+}  // namespace X::Core
@@ -104,7 +104,8 @@ namespace X {
 
     namespace Core {
         class Application;
-    }
+        class JobSystem;
+    }  // namespace Core
 
     namespace Render {
         class Renderer;
@@ -116,10 +117,12 @@ namespace X {
 
     using Diligent::IBuffer;
     using Diligent::IBufferView;
+    using Diligent::ICommandList;
     using Diligent::IDeviceContext;
     using Diligent::IPipelineState;
     using Diligent::IRenderDevice;
     using Diligent::IShader;
+    using Diligent::IShaderResourceBinding;
     using Diligent::ISwapChain;
     using Diligent::ITexture;
     using Diligent::ITextureView;
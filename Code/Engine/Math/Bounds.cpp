@@ -0,0 +1,114 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include "Bounds.hpp"
+
+namespace X::Math {
+    Frustum Frustum::FromMatrix(const Mat4& viewProjection, bool zeroToOne) {
+        const Mat4& m = viewProjection;
+        const auto row = [&m](i32 r) { return Vec4(m[0][r], m[1][r], m[2][r], m[3][r]); };
+        const Vec4 r0 = row(0), r1 = row(1), r2 = row(2), r3 = row(3);
+
+        Frustum frustum;
+        frustum.planes[Left]   = r3 + r0;
+        frustum.planes[Right]  = r3 - r0;
+        frustum.planes[Bottom] = r3 + r1;
+        frustum.planes[Top]    = r3 - r1;
+        frustum.planes[Near]   = zeroToOne ? r2 : r3 + r2;
+        frustum.planes[Far]    = r3 - r2;
+
+        // Normalized so plane distances are in world units, which sphere radii are compared against
+        for (Vec4& plane : frustum.planes) {
+            const f32 length = glm::length(Vec3(plane));
+            if (length > 0.0f) { plane = plane * (1.0f / length); }
+        }
+        return frustum;
+    }
+
+    bool Frustum::Intersects(const Sphere& sphere) const {
+        for (const Vec4& plane : planes) {
+            if (glm::dot(Vec3(plane), sphere.center) + plane.w < -sphere.radius) return false;
+        }
+        return true;
+    }
+
+    bool Frustum::Intersects(const AABB& box) const {
+        const Vec3 center  = box.GetCenter();
+        const Vec3 extents = box.GetExtents();
+        for (const Vec4& plane : planes) {
+            const Vec3 normal = Vec3(plane);
+            const f32 radius  = glm::dot(glm::abs(normal), extents);
+            if (glm::dot(normal, center) + plane.w < -radius) return false;
+        }
+        return true;
+    }
+
+    void SphereSoA::Reserve(u32 count) {
+        for (auto* stream : {&x, &y, &z, &radius}) {
+            stream->reserve(count);
+        }
+    }
+
+    void SphereSoA::Resize(u32 count) {
+        for (auto* stream : {&x, &y, &z, &radius}) {
+            stream->resize(count);
+        }
+    }
+
+    void SphereSoA::Clear() {
+        for (auto* stream : {&x, &y, &z, &radius}) {
+            stream->clear();
+        }
+    }
+
+    void SphereSoA::Set(u32 index, const Sphere& sphere) {
+        x[index]      = sphere.center.x;
+        y[index]      = sphere.center.y;
+        z[index]      = sphere.center.z;
+        radius[index] = sphere.radius;
+    }
+
+    u32 SphereSoA::Add(const Sphere& sphere) {
+        const u32 index = GetCount();
+        Resize(index + 1);
+        Set(index, sphere);
+        return index;
+    }
+
+    void AABBSoA::Reserve(u32 count) {
+        for (auto* stream : {&centerX, &centerY, &centerZ, &extentX, &extentY, &extentZ}) {
+            stream->reserve(count);
+        }
+    }
+
+    void AABBSoA::Resize(u32 count) {
+        for (auto* stream : {&centerX, &centerY, &centerZ, &extentX, &extentY, &extentZ}) {
+            stream->resize(count);
+        }
+    }
+
+    void AABBSoA::Clear() {
+        for (auto* stream : {&centerX, &centerY, &centerZ, &extentX, &extentY, &extentZ}) {
+            stream->clear();
+        }
+    }
+
+    void AABBSoA::Set(u32 index, const AABB& box) {
+        const Vec3 center  = box.GetCenter();
+        const Vec3 extents = box.GetExtents();
+        centerX[index]     = center.x;
+        centerY[index]     = center.y;
+        centerZ[index]     = center.z;
+        extentX[index]     = extents.x;
+        extentY[index]     = extents.y;
+        extentZ[index]     = extents.z;
+    }
+
+    u32 AABBSoA::Add(const AABB& box) {
+        const u32 index = GetCount();
+        Resize(index + 1);
+        Set(index, box);
+        return index;
+    }
+}  // namespace X::Math
@@ -0,0 +1,78 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#pragma once
+
+#include "EnginePCH.h"
+
+namespace X::Math {
+
+    struct AABB {
+        Vec3 min {0.0f};
+        Vec3 max {0.0f};
+
+        Vec3 GetCenter() const {
+            return (min + max) * 0.5f;
+        }
+        Vec3 GetExtents() const {
+            return (max - min) * 0.5f;
+        }
+    };
+
+    struct Sphere {
+        Vec3 center {0.0f};
+        f32 radius {0.0f};
+    };
+
+    struct Ray {
+        Vec3 origin {0.0f};
+        Vec3 direction {0.0f, 0.0f, -1.0f};
+    };
+
+    // Six planes (normal.xyz, distance) with normals pointing inwards, so dot(normal, p) + distance >= 0 inside
+    struct Frustum {
+        enum Side : u8 { Left, Right, Bottom, Top, Near, Far, SideCount };
+
+        Vec4 planes[SideCount] {};
+
+        // Gribb-Hartmann extraction from a view-projection matrix. zeroToOne selects the clip-space depth range the
+        // projection was built for ([0, 1] for D3D, Vulkan and Metal, [-1, 1] for OpenGL).
+        static Frustum FromMatrix(const Mat4& viewProjection, bool zeroToOne);
+
+        bool Intersects(const Sphere& sphere) const;
+        bool Intersects(const AABB& box) const;
+    };
+
+    // Bounds stored as struct-of-arrays for the SIMD culling kernels, one float stream per component
+    struct SphereSoA {
+        vector<f32> x, y, z, radius;
+
+        void Reserve(u32 count);
+        void Resize(u32 count);
+        void Clear();
+        void Set(u32 index, const Sphere& sphere);
+        u32 Add(const Sphere& sphere);
+
+        u32 GetCount() const {
+            return CAST<u32>(x.size());
+        }
+    };
+
+    // Boxes as center and half extents, the form the plane test wants
+    struct AABBSoA {
+        vector<f32> centerX, centerY, centerZ;
+        vector<f32> extentX, extentY, extentZ;
+
+        void Reserve(u32 count);
+        void Resize(u32 count);
+        void Clear();
+        void Set(u32 index, const AABB& box);
+        u32 Add(const AABB& box);
+
+        u32 GetCount() const {
+            return CAST<u32>(centerX.size());
+        }
+    };
+
+}  // namespace X::Math
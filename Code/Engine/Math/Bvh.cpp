@@ -0,0 +1,453 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include "Bvh.hpp"
+
+#include <limits>
+
+namespace X::Math {
+    namespace {
+        constexpr u32 kBins = 16;
+
+        AABB EmptyBounds() {
+            constexpr f32 kMax = std::numeric_limits<f32>::max();
+            return {Vec3(kMax), Vec3(-kMax)};
+        }
+
+        u32 CeilLog2(u32 value) {
+            u32 log = 0;
+            while ((1ull << log) < value) {
+                ++log;
+            }
+            return log;
+        }
+    }  // namespace
+
+    f32 SurfaceArea(const AABB& box) {
+        const Vec3 size = box.max - box.min;
+        return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+    }
+
+    AABB Union(const AABB& a, const AABB& b) {
+        return {glm::min(a.min, b.min), glm::max(a.max, b.max)};
+    }
+
+    bool Overlaps(const AABB& a, const AABB& b) {
+        return a.min.x <= b.max.x && a.max.x >= b.min.x && a.min.y <= b.max.y && a.max.y >= b.min.y &&
+               a.min.z <= b.max.z && a.max.z >= b.min.z;
+    }
+
+    f32 IntersectRay(const AABB& box, const Vec3& origin, const Vec3& inverseDirection, f32 maxDistance) {
+        const Vec3 t1   = (box.min - origin) * inverseDirection;
+        const Vec3 t2   = (box.max - origin) * inverseDirection;
+        const Vec3 near = glm::min(t1, t2);
+        const Vec3 far  = glm::max(t1, t2);
+        const f32 enter = std::max(std::max(near.x, near.y), std::max(near.z, 0.0f));
+        const f32 exit  = std::min(std::min(far.x, far.y), std::min(far.z, maxDistance));
+        return enter <= exit ? enter : -1.0f;
+    }
+
+    BvhHandle Bvh::Insert(const AABB& bounds, u32 userData) {
+        BvhHandle handle;
+        if (!_freeProxies.empty()) {
+            handle = _freeProxies.back();
+            _freeProxies.pop_back();
+        } else {
+            handle = CAST<BvhHandle>(_proxies.size());
+            _proxies.emplace_back();
+        }
+
+        const u32 leaf   = AllocateNode();
+        _nodes[leaf]     = {bounds, kNull, handle};
+        _heights[leaf]   = 0;
+        _proxies[handle] = {bounds, leaf, userData};
+        ++_proxyCount;
+
+        InsertLeaf(leaf);
+        _ordered = false;
+        return handle;
+    }
+
+    void Bvh::Remove(BvhHandle handle) {
+        if (!IsValid(handle)) return;
+
+        const u32 leaf = _proxies[handle].node;
+        RemoveLeaf(leaf);
+        FreeNode(leaf);
+
+        _proxies[handle].node = kNull;
+        _freeProxies.push_back(handle);
+        --_proxyCount;
+        _ordered = false;
+    }
+
+    void Bvh::Update(BvhHandle handle, const AABB& bounds) {
+        Proxy& proxy              = _proxies[handle];
+        proxy.bounds              = bounds;
+        _nodes[proxy.node].bounds = bounds;
+    }
+
+    void Bvh::Refit() {
+        if (_root == kNull) return;
+
+        if (_ordered) {
+            // Depth-first order puts every child after its parent, so one backwards sweep sees children first
+            for (size_t i = _nodes.size(); i > 0; --i) {
+                Node& node = _nodes[i - 1];
+                if (!node.IsLeaf()) { node.bounds = Union(_nodes[node.left].bounds, _nodes[node.right].bounds); }
+            }
+        } else {
+            RefitRecursive(_root);
+        }
+    }
+
+    void Bvh::Rebuild() {
+        _buildItems.clear();
+        _buildItems.reserve(_proxyCount);
+        for (BvhHandle handle = 0; handle < _proxies.size(); ++handle) {
+            const Proxy& proxy = _proxies[handle];
+            if (proxy.node == kNull) continue;
+            _buildItems.push_back({proxy.bounds, proxy.bounds.GetCenter(), handle});
+        }
+
+        _nodes.clear();
+        _parents.clear();
+        _heights.clear();
+        _freeNodes.clear();
+        _root    = kNull;
+        _ordered = true;
+        if (_buildItems.empty()) return;
+
+        // Nodes are allocated in the order the recursion visits them, which is depth-first
+        const size_t nodeCount = 2 * _buildItems.size() - 1;
+        _nodes.reserve(nodeCount);
+        _parents.reserve(nodeCount);
+        _heights.reserve(nodeCount);
+        _root = BuildRecursive(0, CAST<u32>(_buildItems.size()), kNull, 0);
+    }
+
+    void Bvh::Clear() {
+        _nodes.clear();
+        _parents.clear();
+        _heights.clear();
+        _freeNodes.clear();
+        _root    = kNull;
+        _ordered = true;
+        _proxies.clear();
+        _freeProxies.clear();
+        _proxyCount = 0;
+    }
+
+    BvhStats Bvh::ComputeStats() const {
+        BvhStats stats;
+        stats.proxies = _proxyCount;
+        stats.nodes   = CAST<u32>(_nodes.size() - _freeNodes.size());
+        stats.ordered = _ordered;
+        if (_root == kNull) return stats;
+
+        stats.height = _heights[_root];
+        f64 area     = 0.0;
+        u32 stack[kStackSize];
+        u32 top      = 0;
+        stack[top++] = _root;
+        while (top > 0) {
+            const Node& node = _nodes[stack[--top]];
+            if (node.IsLeaf()) continue;
+            area += SurfaceArea(node.bounds);
+            stack[top++] = node.left;
+            stack[top++] = node.right;
+        }
+
+        const f32 rootArea = SurfaceArea(_nodes[_root].bounds);
+        stats.sahCost      = rootArea > 0.0f ? CAST<f32>(area / rootArea) : 0.0f;
+        return stats;
+    }
+
+    bool Bvh::RaycastClosest(const Ray& ray, f32 maxDistance, BvhHandle& handle, f32& distance) const {
+        handle = kInvalidBvhHandle;
+        Raycast(ray, maxDistance, [&handle, &distance](BvhHandle hit, f32 boxDistance) {
+            handle   = hit;
+            distance = boxDistance;
+            return boxDistance;
+        });
+        return handle != kInvalidBvhHandle;
+    }
+
+    u32 Bvh::AllocateNode() {
+        if (!_freeNodes.empty()) {
+            const u32 node = _freeNodes.back();
+            _freeNodes.pop_back();
+            return node;
+        }
+
+        _nodes.emplace_back();
+        _parents.push_back(kNull);
+        _heights.push_back(0);
+        return CAST<u32>(_nodes.size() - 1);
+    }
+
+    void Bvh::FreeNode(u32 node) {
+        _nodes[node] = {};
+        _freeNodes.push_back(node);
+    }
+
+    void Bvh::InsertLeaf(u32 leaf) {
+        if (_root == kNull) {
+            _root          = leaf;
+            _parents[leaf] = kNull;
+            return;
+        }
+
+        // Walk down towards the sibling that adds the least surface area, stopping when pairing with the current node
+        // is cheaper than the lowest possible cost of going further
+        const AABB bounds = _nodes[leaf].bounds;
+        u32 index         = _root;
+        while (!_nodes[index].IsLeaf()) {
+            const Node& node        = _nodes[index];
+            const f32 area          = SurfaceArea(node.bounds);
+            const f32 combinedArea  = SurfaceArea(Union(node.bounds, bounds));
+            const f32 cost          = 2.0f * combinedArea;
+            const f32 inheritedCost = 2.0f * (combinedArea - area);
+
+            const auto descendCost = [this, &bounds, inheritedCost](u32 child) {
+                const Node& node = _nodes[child];
+                const f32 merged = SurfaceArea(Union(node.bounds, bounds));
+                return (node.IsLeaf() ? merged : merged - SurfaceArea(node.bounds)) + inheritedCost;
+            };
+            const f32 leftCost  = descendCost(node.left);
+            const f32 rightCost = descendCost(node.right);
+            if (cost < leftCost && cost < rightCost) break;
+            index = leftCost < rightCost ? node.left : node.right;
+        }
+
+        const u32 sibling   = index;
+        const u32 oldParent = _parents[sibling];
+        const u32 newParent = AllocateNode();
+        _nodes[newParent]   = {Union(bounds, _nodes[sibling].bounds), sibling, leaf};
+        _parents[newParent] = oldParent;
+        _heights[newParent] = _heights[sibling] + 1;
+        _parents[sibling]   = newParent;
+        _parents[leaf]      = newParent;
+
+        if (oldParent == kNull) {
+            _root = newParent;
+        } else if (_nodes[oldParent].left == sibling) {
+            _nodes[oldParent].left = newParent;
+        } else {
+            _nodes[oldParent].right = newParent;
+        }
+
+        FixUpwards(_parents[leaf]);
+    }
+
+    void Bvh::RemoveLeaf(u32 leaf) {
+        if (leaf == _root) {
+            _root = kNull;
+            return;
+        }
+
+        const u32 parent      = _parents[leaf];
+        const u32 grandParent = _parents[parent];
+        const u32 sibling     = _nodes[parent].left == leaf ? _nodes[parent].right : _nodes[parent].left;
+
+        _parents[sibling] = grandParent;
+        FreeNode(parent);
+        if (grandParent == kNull) {
+            _root = sibling;
+            return;
+        }
+
+        if (_nodes[grandParent].left == parent) {
+            _nodes[grandParent].left = sibling;
+        } else {
+            _nodes[grandParent].right = sibling;
+        }
+        FixUpwards(grandParent);
+    }
+
+    void Bvh::FixUpwards(u32 node) {
+        while (node != kNull) {
+            node = Balance(node);
+
+            Node& current  = _nodes[node];
+            current.bounds = Union(_nodes[current.left].bounds, _nodes[current.right].bounds);
+            _heights[node] = 1 + std::max(_heights[current.left], _heights[current.right]);
+            node           = _parents[node];
+        }
+    }
+
+    // AVL rotation: when one child is more than one level taller, it takes a's place and a takes over its shorter
+    // child. Returns the node now at a's position.
+    u32 Bvh::Balance(u32 a) {
+        if (_nodes[a].IsLeaf() || _heights[a] < 2) return a;
+
+        const u32 b       = _nodes[a].left;
+        const u32 c       = _nodes[a].right;
+        const i32 balance = CAST<i32>(_heights[c]) - CAST<i32>(_heights[b]);
+        if (balance >= -1 && balance <= 1) return a;
+
+        // Promote the taller child. With b the other child of a, and f/g the promoted node's children.
+        const bool rotateRight = balance > 1;
+        const u32 up           = rotateRight ? c : b;
+        const u32 stay         = rotateRight ? b : c;
+        const u32 f            = _nodes[up].left;
+        const u32 g            = _nodes[up].right;
+
+        // up replaces a under a's parent
+        const u32 parent = _parents[a];
+        _parents[up]     = parent;
+        _parents[a]      = up;
+        if (parent == kNull) {
+            _root = up;
+        } else if (_nodes[parent].left == a) {
+            _nodes[parent].left = up;
+        } else {
+            _nodes[parent].right = up;
+        }
+
+        // up keeps its taller child and adopts a, a adopts up's shorter child in place of up
+        const bool keepF = _heights[f] > _heights[g];
+        const u32 kept   = keepF ? f : g;
+        const u32 moved  = keepF ? g : f;
+        _nodes[up].left  = a;
+        _nodes[up].right = kept;
+        _parents[moved]  = a;
+        if (rotateRight) {
+            _nodes[a].right = moved;
+        } else {
+            _nodes[a].left = moved;
+        }
+
+        _nodes[a].bounds  = Union(_nodes[stay].bounds, _nodes[moved].bounds);
+        _heights[a]       = 1 + std::max(_heights[stay], _heights[moved]);
+        _nodes[up].bounds = Union(_nodes[a].bounds, _nodes[kept].bounds);
+        _heights[up]      = 1 + std::max(_heights[a], _heights[kept]);
+        return up;
+    }
+
+    void Bvh::RefitRecursive(u32 node) {
+        Node& current = _nodes[node];
+        if (current.IsLeaf()) return;
+        RefitRecursive(current.left);
+        RefitRecursive(current.right);
+        current.bounds = Union(_nodes[current.left].bounds, _nodes[current.right].bounds);
+    }
+
+    u32 Bvh::BuildRecursive(u32 begin, u32 end, u32 parent, u32 depth) {
+        const u32 index = AllocateNode();
+        _parents[index] = parent;
+
+        if (end - begin == 1) {
+            const BuildItem& item     = _buildItems[begin];
+            _nodes[index]             = {item.bounds, kNull, item.proxy};
+            _proxies[item.proxy].node = index;
+            return index;
+        }
+
+        AABB bounds         = EmptyBounds();
+        AABB centroidBounds = EmptyBounds();
+        for (u32 i = begin; i < end; ++i) {
+            bounds             = Union(bounds, _buildItems[i].bounds);
+            centroidBounds.min = glm::min(centroidBounds.min, _buildItems[i].centroid);
+            centroidBounds.max = glm::max(centroidBounds.max, _buildItems[i].centroid);
+        }
+
+        // Near the depth limit, switch to median splits, which need exactly CeilLog2(count) more levels
+        u32 mid = begin;
+        if (depth + CeilLog2(end - begin) < kMaxDepth - 1) { mid = PartitionSAH(begin, end, centroidBounds); }
+        if (mid == begin || mid == end) {
+            const Vec3 extent = centroidBounds.max - centroidBounds.min;
+            const i32 axis    = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+            const auto less   = [axis](const BuildItem& a, const BuildItem& b) {
+                return a.centroid[axis] < b.centroid[axis];
+            };
+            mid = begin + (end - begin) / 2;
+            std::nth_element(_buildItems.begin() + begin, _buildItems.begin() + mid, _buildItems.begin() + end, less);
+        }
+
+        const u32 left  = BuildRecursive(begin, mid, index, depth + 1);
+        const u32 right = BuildRecursive(mid, end, index, depth + 1);
+        _nodes[index]   = {bounds, left, right};
+        _heights[index] = 1 + std::max(_heights[left], _heights[right]);
+        return index;
+    }
+
+    // Binned SAH over all three axes, filled in one pass over the items. Returns the split point, or begin when no bin
+    // boundary separates the items.
+    u32 Bvh::PartitionSAH(u32 begin, u32 end, const AABB& centroidBounds) {
+        struct Bin {
+            AABB bounds;
+            u32 count;
+        };
+
+        // Small ranges get fewer bins, which is most of the nodes near the leaves
+        const u32 binCount = std::min(kBins, end - begin);
+        Bin bins[3][kBins];
+        for (auto& axisBins : bins) {
+            for (u32 b = 0; b < binCount; ++b) {
+                axisBins[b] = {EmptyBounds(), 0};
+            }
+        }
+
+        // A flat axis gets scale 0, which puts everything in its first bin and leaves no split to pick
+        const Vec3 extent = centroidBounds.max - centroidBounds.min;
+        Vec3 scale;
+        for (i32 axis = 0; axis < 3; ++axis) {
+            scale[axis] = extent[axis] > 0.0f ? CAST<f32>(binCount) / extent[axis] : 0.0f;
+        }
+
+        for (u32 i = begin; i < end; ++i) {
+            const BuildItem& item = _buildItems[i];
+            for (i32 axis = 0; axis < 3; ++axis) {
+                const f32 offset = (item.centroid[axis] - centroidBounds.min[axis]) * scale[axis];
+                Bin& bin         = bins[axis][std::min(binCount - 1, CAST<u32>(offset))];
+                bin.bounds       = Union(bin.bounds, item.bounds);
+                ++bin.count;
+            }
+        }
+
+        f32 bestCost  = std::numeric_limits<f32>::max();
+        i32 bestAxis  = -1;
+        u32 bestSplit = 0;
+        for (i32 axis = 0; axis < 3; ++axis) {
+            // Area and count to the right of each split, then sweep from the left
+            f32 rightArea[kBins];
+            u32 rightCount[kBins];
+            AABB accumulated = EmptyBounds();
+            u32 count        = 0;
+            for (u32 b = binCount - 1; b > 0; --b) {
+                accumulated   = Union(accumulated, bins[axis][b].bounds);
+                count        += bins[axis][b].count;
+                rightArea[b]  = count > 0 ? SurfaceArea(accumulated) : 0.0f;
+                rightCount[b] = count;
+            }
+
+            accumulated = EmptyBounds();
+            count       = 0;
+            for (u32 split = 1; split < binCount; ++split) {
+                accumulated  = Union(accumulated, bins[axis][split - 1].bounds);
+                count       += bins[axis][split - 1].count;
+                if (count == 0 || rightCount[split] == 0) continue;
+
+                const f32 cost = SurfaceArea(accumulated) * count + rightArea[split] * rightCount[split];
+                if (cost < bestCost) {
+                    bestCost  = cost;
+                    bestAxis  = axis;
+                    bestSplit = split;
+                }
+            }
+        }
+        if (bestAxis < 0) return begin;
+
+        const f32 minimum   = centroidBounds.min[bestAxis];
+        const f32 axisScale = scale[bestAxis];
+        const auto middle   = std::partition(_buildItems.begin() + begin,
+                                             _buildItems.begin() + end,
+                                             [=](const BuildItem& item) {
+                                                 const f32 offset = (item.centroid[bestAxis] - minimum) * axisScale;
+                                                 return std::min(binCount - 1, CAST<u32>(offset)) < bestSplit;
+                                             });
+        return CAST<u32>(middle - _buildItems.begin());
+    }
+}  // namespace X::Math
@@ -0,0 +1,246 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#pragma once
+
+#include "EnginePCH.h"
+#include "Bounds.hpp"
+
+namespace X::Math {
+
+    using BvhHandle = u32;
+    inline constexpr BvhHandle kInvalidBvhHandle = ~0u;
+
+    struct BvhStats {
+        u32 proxies {0};
+        u32 nodes {0};
+        u32 height {0};
+        f32 sahCost {0.0f};    // Sum of internal node areas over the root's, lower means cheaper queries
+        bool ordered {false};  // Nodes are in depth-first order, as after Rebuild
+    };
+
+    // Dynamic bounding volume hierarchy with one object per leaf. Three ways to keep it up to date:
+    //   Insert/Remove  place or take out one leaf, picking the sibling with the lowest SAH cost and rebalancing with
+    //                  tree rotations on the way up. O(log n), for objects that appear and disappear.
+    //   Update+Refit   changes leaf bounds and recomputes ancestors in one bottom-up pass. O(n) for any number of
+    //                  moves, the topology is kept so quality slowly degrades as objects drift.
+    //   Rebuild        binned SAH build from scratch, laying nodes out depth-first so traversal walks memory mostly
+    //                  forwards. The best tree, and the most expensive update.
+    //
+    // A tree built by Insert alone has several times the SAH cost of a rebuilt one, so bulk loads (a level, a streamed
+    // cell) should Insert everything and Rebuild once.
+    //
+    // Nodes are 32 bytes (bounds plus two indices), two to a cache line. Parent links and heights, only needed when
+    // the tree changes, are kept in separate arrays. Queries are read-only and may run on several threads at once,
+    // but not during modification. Call Refit after Update before querying.
+    class Bvh {
+    public:
+        BvhHandle Insert(const AABB& bounds, u32 userData = 0);
+        void Remove(BvhHandle handle);
+        // Leaf bounds change immediately, ancestors at the next Refit
+        void Update(BvhHandle handle, const AABB& bounds);
+        void Refit();
+        void Rebuild();
+        void Clear();
+
+        bool IsValid(BvhHandle handle) const {
+            return handle < _proxies.size() && _proxies[handle].node != kNull;
+        }
+        const AABB& GetBounds(BvhHandle handle) const {
+            return _proxies[handle].bounds;
+        }
+        u32 GetUserData(BvhHandle handle) const {
+            return _proxies[handle].userData;
+        }
+        u32 GetCount() const {
+            return _proxyCount;
+        }
+        BvhStats ComputeStats() const;
+
+        // fn(BvhHandle) for every object whose bounds intersect the frustum. Subtrees entirely inside skip the plane
+        // tests, and planes a node is entirely inside of are not tested again below it.
+        template<typename F>
+        void QueryFrustum(const Frustum& frustum, F&& fn) const;
+
+        // fn(BvhHandle) for every object whose bounds overlap box
+        template<typename F>
+        void QueryOverlap(const AABB& box, F&& fn) const;
+
+        // Visits objects whose bounds the ray enters before maxDistance, nearer subtrees first. fn(BvhHandle, f32
+        // boxDistance) returns the new maximum distance: its exact hit distance to clip the search, maxDistance to
+        // continue unchanged, or 0 to stop.
+        template<typename F>
+        void Raycast(const Ray& ray, f32 maxDistance, F&& fn) const;
+
+        // Nearest object whose bounds the ray hits, testing bounds only
+        bool RaycastClosest(const Ray& ray, f32 maxDistance, BvhHandle& handle, f32& distance) const;
+
+    private:
+        static constexpr u32 kNull      = ~0u;
+        static constexpr u32 kMaxDepth  = 64;  // Rebuild and rotations keep the height below this
+        static constexpr u32 kStackSize = 2 * kMaxDepth;
+
+        // Internal nodes hold two child indices, leaves hold kNull and their proxy
+        struct alignas(32) Node {
+            AABB bounds;
+            u32 left {kNull};
+            u32 right {kNull};
+
+            bool IsLeaf() const {
+                return left == kNull;
+            }
+        };
+
+        struct Proxy {
+            AABB bounds;
+            u32 node {kNull};
+            u32 userData {0};
+        };
+
+        struct BuildItem {
+            AABB bounds;
+            Vec3 centroid;
+            BvhHandle proxy;
+        };
+
+        u32 AllocateNode();
+        void FreeNode(u32 node);
+        void InsertLeaf(u32 leaf);
+        void RemoveLeaf(u32 leaf);
+        u32 Balance(u32 node);
+        void FixUpwards(u32 node);
+        void RefitRecursive(u32 node);
+        u32 BuildRecursive(u32 begin, u32 end, u32 parent, u32 depth);
+        u32 PartitionSAH(u32 begin, u32 end, const AABB& centroidBounds);
+
+        vector<Node> _nodes;
+        vector<u32> _parents;
+        vector<u32> _heights;  // Leaves are 0
+        vector<u32> _freeNodes;
+        u32 _root {kNull};
+        bool _ordered {true};
+
+        vector<Proxy> _proxies;
+        vector<BvhHandle> _freeProxies;
+        u32 _proxyCount {0};
+
+        vector<BuildItem> _buildItems;
+    };
+
+    f32 SurfaceArea(const AABB& box);
+    AABB Union(const AABB& a, const AABB& b);
+    bool Overlaps(const AABB& a, const AABB& b);
+    // Distance along the ray to the box entry (0 when inside), or a negative value on a miss. inverseDirection is
+    // 1 / ray.direction per component.
+    f32 IntersectRay(const AABB& box, const Vec3& origin, const Vec3& inverseDirection, f32 maxDistance);
+
+    template<typename F>
+    void Bvh::QueryFrustum(const Frustum& frustum, F&& fn) const {
+        if (_root == kNull) return;
+
+        constexpr u8 kAllPlanes = (1 << Frustum::SideCount) - 1;
+        struct Entry {
+            u32 node;
+            u8 planes;  // Planes the node still straddles
+        };
+        Entry stack[kStackSize];
+        u32 top      = 0;
+        stack[top++] = {_root, kAllPlanes};
+
+        while (top > 0) {
+            const Entry entry = stack[--top];
+            const Node& node  = _nodes[entry.node];
+
+            u8 planes = entry.planes;
+            if (planes != 0) {
+                const Vec3 center  = node.bounds.GetCenter();
+                const Vec3 extents = node.bounds.GetExtents();
+                bool outside       = false;
+                for (u32 p = 0; p < Frustum::SideCount && !outside; ++p) {
+                    if (!(planes & (1 << p))) continue;
+                    const Vec4& plane = frustum.planes[p];
+                    const f32 distance = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w;
+                    const f32 radius = std::abs(plane.x) * extents.x + std::abs(plane.y) * extents.y +
+                                       std::abs(plane.z) * extents.z;
+                    if (distance + radius < 0.0f) {
+                        outside = true;
+                    } else if (distance - radius >= 0.0f) {
+                        planes &= ~(1 << p);
+                    }
+                }
+                if (outside) continue;
+            }
+
+            if (node.IsLeaf()) {
+                fn(CAST<BvhHandle>(node.right));
+            } else {
+                stack[top++] = {node.right, planes};
+                stack[top++] = {node.left, planes};
+            }
+        }
+    }
+
+    template<typename F>
+    void Bvh::QueryOverlap(const AABB& box, F&& fn) const {
+        if (_root == kNull) return;
+
+        u32 stack[kStackSize];
+        u32 top      = 0;
+        stack[top++] = _root;
+        while (top > 0) {
+            const Node& node = _nodes[stack[--top]];
+            if (!Overlaps(node.bounds, box)) continue;
+            if (node.IsLeaf()) {
+                fn(CAST<BvhHandle>(node.right));
+            } else {
+                stack[top++] = node.right;
+                stack[top++] = node.left;
+            }
+        }
+    }
+
+    template<typename F>
+    void Bvh::Raycast(const Ray& ray, f32 maxDistance, F&& fn) const {
+        if (_root == kNull) return;
+
+        const Vec3 inverse(1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z);
+        struct Entry {
+            u32 node;
+            f32 distance;  // Where the ray enters the node
+        };
+        Entry stack[kStackSize];
+        u32 top = 0;
+
+        const f32 rootDistance = IntersectRay(_nodes[_root].bounds, ray.origin, inverse, maxDistance);
+        if (rootDistance < 0.0f) return;
+        stack[top++] = {_root, rootDistance};
+
+        while (top > 0) {
+            const Entry entry = stack[--top];
+            // A closer hit may have been found since this node was pushed
+            if (entry.distance > maxDistance) continue;
+
+            const Node& node = _nodes[entry.node];
+            if (node.IsLeaf()) {
+                maxDistance = std::min(maxDistance, fn(CAST<BvhHandle>(node.right), entry.distance));
+                if (maxDistance <= 0.0f) return;
+                continue;
+            }
+
+            const f32 left  = IntersectRay(_nodes[node.left].bounds, ray.origin, inverse, maxDistance);
+            const f32 right = IntersectRay(_nodes[node.right].bounds, ray.origin, inverse, maxDistance);
+            // Push the farther child first so the nearer one is visited next
+            if (left >= 0.0f && right >= 0.0f) {
+                const bool leftFirst = left <= right;
+                stack[top++]         = leftFirst ? Entry {node.right, right} : Entry {node.left, left};
+                stack[top++]         = leftFirst ? Entry {node.left, left} : Entry {node.right, right};
+            } else if (left >= 0.0f) {
+                stack[top++] = {node.left, left};
+            } else if (right >= 0.0f) {
+                stack[top++] = {node.right, right};
+            }
+        }
+    }
+
+}  // namespace X::Math
@@ -0,0 +1,821 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include "Simd.hpp"
+
+#include <atomic>
+#include <cstddef>
+
+#if defined(ENGINE_SIMD_X86)
+    #include <immintrin.h>
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #endif
+#endif
+
+namespace X::Math::Simd {
+    static_assert(sizeof(Vec3) == 12 && sizeof(Mat4) == 64 && sizeof(Quat) == 16 && sizeof(AABB) == 24,
+                  "SIMD kernels expect tightly packed glm types");
+    static_assert(offsetof(Quat, x) == 0 && offsetof(Quat, w) == 12, "SIMD kernels expect xyzw quaternion storage");
+
+    namespace {
+        std::atomic<Level> gLevel {Level::Scalar};
+        std::atomic<bool> gLevelInitialized {false};
+
+        Level DetectLevel() {
+#if defined(ENGINE_SIMD_X86)
+    #if defined(_MSC_VER)
+            i32 info[4];
+            __cpuid(info, 0);
+            const i32 maxLeaf = info[0];
+
+            __cpuid(info, 1);
+            const bool sse41   = (info[2] & (1 << 19)) != 0;
+            const bool fma     = (info[2] & (1 << 12)) != 0;
+            const bool osxsave = (info[2] & (1 << 27)) != 0;
+            const bool avx     = (info[2] & (1 << 28)) != 0;
+            // The OS has to save the YMM registers on context switches
+            const bool ymmState = osxsave && avx && (_xgetbv(0) & 0x6) == 0x6;
+
+            bool avx2 = false;
+            if (maxLeaf >= 7) {
+                __cpuidex(info, 7, 0);
+                avx2 = (info[1] & (1 << 5)) != 0;
+            }
+
+            if (avx2 && fma && ymmState) return Level::AVX2;
+            if (sse41) return Level::SSE4;
+    #else
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return Level::AVX2;
+            if (__builtin_cpu_supports("sse4.1")) return Level::SSE4;
+    #endif
+#endif
+            return Level::Scalar;
+        }
+
+        Level CurrentLevel() {
+            if (!gLevelInitialized.load(std::memory_order_acquire)) {
+                gLevel.store(GetSupportedLevel(), std::memory_order_relaxed);
+                gLevelInitialized.store(true, std::memory_order_release);
+            }
+            return gLevel.load(std::memory_order_relaxed);
+        }
+
+        // Scalar glm, the fallback on every platform and the tail of every SIMD loop
+
+        void MultiplyMat4Scalar(const Mat4* a, size_t aStride, const Mat4* b, Mat4* out, size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                out[i] = a[i * aStride] * b[i];
+            }
+        }
+
+        void TransformPointsScalar(const Mat4& m, const Vec3* in, Vec3* out, size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                out[i] = Vec3(m * Vec4(in[i], 1.0f));
+            }
+        }
+
+        void TransformNormalsScalar(const Mat4& m, const Vec3* in, Vec3* out, size_t count) {
+            const Mat3 basis(m);
+            for (size_t i = 0; i < count; ++i) {
+                out[i] = glm::normalize(basis * in[i]);
+            }
+        }
+
+        void QuatToMat4Scalar(const Quat* in, Mat4* out, size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                out[i] = glm::mat4_cast(in[i]);
+            }
+        }
+
+        void TransformAABBsScalar(const Mat4& m, const AABB* in, AABB* out, size_t count) {
+            const Vec3 axisX = glm::abs(Vec3(m[0]));
+            const Vec3 axisY = glm::abs(Vec3(m[1]));
+            const Vec3 axisZ = glm::abs(Vec3(m[2]));
+            for (size_t i = 0; i < count; ++i) {
+                const Vec3 extents = in[i].GetExtents();
+                const Vec3 center  = Vec3(m * Vec4(in[i].GetCenter(), 1.0f));
+                const Vec3 radius  = axisX * extents.x + axisY * extents.y + axisZ * extents.z;
+                out[i]             = {center - radius, center + radius};
+            }
+        }
+
+        u32 CullSpheresScalar(const Frustum& frustum, const SphereSoA& spheres, u32 begin, u32 end, u32* visible) {
+            u32 written = 0;
+            for (u32 i = begin; i < end; ++i) {
+                bool inside = true;
+                for (const Vec4& plane : frustum.planes) {
+                    const f32 distance =
+                      plane.x * spheres.x[i] + plane.y * spheres.y[i] + plane.z * spheres.z[i] + plane.w;
+                    inside &= distance >= -spheres.radius[i];
+                }
+                // Written unconditionally and kept only when inside, avoiding a branch per volume
+                visible[written] = i;
+                written += inside;
+            }
+            return written;
+        }
+
+        u32 CullAABBsScalar(const Frustum& frustum, const AABBSoA& boxes, u32 begin, u32 end, u32* visible) {
+            u32 written = 0;
+            for (u32 i = begin; i < end; ++i) {
+                bool inside = true;
+                for (const Vec4& plane : frustum.planes) {
+                    const f32 distance =
+                      plane.x * boxes.centerX[i] + plane.y * boxes.centerY[i] + plane.z * boxes.centerZ[i] + plane.w;
+                    const f32 radius = std::abs(plane.x) * boxes.extentX[i] + std::abs(plane.y) * boxes.extentY[i] +
+                                       std::abs(plane.z) * boxes.extentZ[i];
+                    inside &= distance >= -radius;
+                }
+                visible[written] = i;
+                written += inside;
+            }
+            return written;
+        }
+
+#if defined(ENGINE_SIMD_X86)
+        // SSE4, 4 wide. Vec3 arrays are deinterleaved 4 at a time: 12 floats in 3 registers become x, y and z
+        // registers, and the same shuffles in reverse write them back.
+
+        SIMD_TARGET_SSE4 inline void LoadVec3x4(const f32* p, __m128& x, __m128& y, __m128& z) {
+            const __m128 m0 = _mm_loadu_ps(p);      // x0 y0 z0 x1
+            const __m128 m1 = _mm_loadu_ps(p + 4);  // y1 z1 x2 y2
+            const __m128 m2 = _mm_loadu_ps(p + 8);  // z2 x3 y3 z3
+
+            const __m128 xy = _mm_shuffle_ps(m1, m2, _MM_SHUFFLE(2, 1, 3, 2));
+            const __m128 yz = _mm_shuffle_ps(m0, m1, _MM_SHUFFLE(1, 0, 2, 1));
+            x               = _mm_shuffle_ps(m0, xy, _MM_SHUFFLE(2, 0, 3, 0));
+            y               = _mm_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+            z               = _mm_shuffle_ps(yz, m2, _MM_SHUFFLE(3, 0, 3, 1));
+        }
+
+        SIMD_TARGET_SSE4 inline void StoreVec3x4(f32* p, __m128 x, __m128 y, __m128 z) {
+            const __m128 rxy = _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 0, 2, 0));
+            const __m128 ryz = _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 1, 3, 1));
+            const __m128 rzx = _mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 1, 2, 0));
+
+            _mm_storeu_ps(p, _mm_shuffle_ps(rxy, rzx, _MM_SHUFFLE(2, 0, 2, 0)));
+            _mm_storeu_ps(p + 4, _mm_shuffle_ps(ryz, rxy, _MM_SHUFFLE(3, 1, 2, 0)));
+            _mm_storeu_ps(p + 8, _mm_shuffle_ps(rzx, ryz, _MM_SHUFFLE(3, 1, 3, 1)));
+        }
+
+        template<int Lane>
+        SIMD_TARGET_SSE4 inline __m128 Splat(__m128 v) {
+            return _mm_shuffle_ps(v, v, _MM_SHUFFLE(Lane, Lane, Lane, Lane));
+        }
+
+        SIMD_TARGET_SSE4 void MultiplyMat4SSE4(const Mat4* a, size_t aStride, const Mat4* b, Mat4* out, size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                const f32* pa = &a[i * aStride][0][0];
+                const f32* pb = &b[i][0][0];
+                const __m128 a0 = _mm_loadu_ps(pa);
+                const __m128 a1 = _mm_loadu_ps(pa + 4);
+                const __m128 a2 = _mm_loadu_ps(pa + 8);
+                const __m128 a3 = _mm_loadu_ps(pa + 12);
+
+                // All columns are computed before any store so out may alias a or b
+                __m128 columns[4];
+                for (i32 c = 0; c < 4; ++c) {
+                    const __m128 column = _mm_loadu_ps(pb + c * 4);
+                    const __m128 xy =
+                      _mm_add_ps(_mm_mul_ps(a0, Splat<0>(column)), _mm_mul_ps(a1, Splat<1>(column)));
+                    const __m128 zw =
+                      _mm_add_ps(_mm_mul_ps(a2, Splat<2>(column)), _mm_mul_ps(a3, Splat<3>(column)));
+                    columns[c]          = _mm_add_ps(xy, zw);
+                }
+
+                f32* po = &out[i][0][0];
+                for (i32 c = 0; c < 4; ++c) {
+                    _mm_storeu_ps(po + c * 4, columns[c]);
+                }
+            }
+        }
+
+        SIMD_TARGET_SSE4 void TransformPointsSSE4(const Mat4& m, const Vec3* in, Vec3* out, size_t count) {
+            __m128 r[4][3];  // r[column][row] broadcast
+            for (i32 c = 0; c < 4; ++c) {
+                for (i32 row = 0; row < 3; ++row) {
+                    r[c][row] = _mm_set1_ps(m[c][row]);
+                }
+            }
+
+            size_t i = 0;
+            for (; i + 4 <= count; i += 4) {
+                __m128 x, y, z;
+                LoadVec3x4(&in[i].x, x, y, z);
+
+                __m128 outXyz[3];
+                for (i32 row = 0; row < 3; ++row) {
+                    const __m128 xy = _mm_add_ps(_mm_mul_ps(r[0][row], x), _mm_mul_ps(r[1][row], y));
+                    outXyz[row]     = _mm_add_ps(_mm_add_ps(xy, _mm_mul_ps(r[2][row], z)), r[3][row]);
+                }
+                StoreVec3x4(&out[i].x, outXyz[0], outXyz[1], outXyz[2]);
+            }
+            TransformPointsScalar(m, in + i, out + i, count - i);
+        }
+
+        SIMD_TARGET_SSE4 void TransformNormalsSSE4(const Mat4& m, const Vec3* in, Vec3* out, size_t count) {
+            __m128 r[3][3];
+            for (i32 c = 0; c < 3; ++c) {
+                for (i32 row = 0; row < 3; ++row) {
+                    r[c][row] = _mm_set1_ps(m[c][row]);
+                }
+            }
+
+            const __m128 one = _mm_set1_ps(1.0f);
+            size_t i         = 0;
+            for (; i + 4 <= count; i += 4) {
+                __m128 x, y, z;
+                LoadVec3x4(&in[i].x, x, y, z);
+
+                __m128 n[3];
+                for (i32 row = 0; row < 3; ++row) {
+                    const __m128 xy = _mm_add_ps(_mm_mul_ps(r[0][row], x), _mm_mul_ps(r[1][row], y));
+                    n[row]          = _mm_add_ps(xy, _mm_mul_ps(r[2][row], z));
+                }
+
+                const __m128 lengthSq =
+                  _mm_add_ps(_mm_add_ps(_mm_mul_ps(n[0], n[0]), _mm_mul_ps(n[1], n[1])), _mm_mul_ps(n[2], n[2]));
+                const __m128 inverse = _mm_div_ps(one, _mm_sqrt_ps(lengthSq));
+                StoreVec3x4(&out[i].x, _mm_mul_ps(n[0], inverse), _mm_mul_ps(n[1], inverse), _mm_mul_ps(n[2], inverse));
+            }
+            TransformNormalsScalar(m, in + i, out + i, count - i);
+        }
+
+        // Matrix entries of 4 (or 8) quaternions held as x, y, z, w registers. Column c is (mc0, mc1, mc2, 0).
+        struct RotationEntries4 {
+            __m128 m00, m01, m02, m10, m11, m12, m20, m21, m22;
+        };
+
+        SIMD_TARGET_SSE4 inline RotationEntries4 QuatEntries(__m128 x, __m128 y, __m128 z, __m128 w) {
+            const __m128 one = _mm_set1_ps(1.0f);
+            const __m128 two = _mm_set1_ps(2.0f);
+            const __m128 xx = _mm_mul_ps(x, x), yy = _mm_mul_ps(y, y), zz = _mm_mul_ps(z, z);
+            const __m128 xy = _mm_mul_ps(x, y), xz = _mm_mul_ps(x, z), yz = _mm_mul_ps(y, z);
+            const __m128 wx = _mm_mul_ps(w, x), wy = _mm_mul_ps(w, y), wz = _mm_mul_ps(w, z);
+
+            RotationEntries4 e;
+            e.m00 = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz)));
+            e.m01 = _mm_mul_ps(two, _mm_add_ps(xy, wz));
+            e.m02 = _mm_mul_ps(two, _mm_sub_ps(xz, wy));
+            e.m10 = _mm_mul_ps(two, _mm_sub_ps(xy, wz));
+            e.m11 = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz)));
+            e.m12 = _mm_mul_ps(two, _mm_add_ps(yz, wx));
+            e.m20 = _mm_mul_ps(two, _mm_add_ps(xz, wy));
+            e.m21 = _mm_mul_ps(two, _mm_sub_ps(yz, wx));
+            e.m22 = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy)));
+            return e;
+        }
+
+        SIMD_TARGET_SSE4 void QuatToMat4SSE4(const Quat* in, Mat4* out, size_t count) {
+            const __m128 zero     = _mm_setzero_ps();
+            const __m128 lastUnit = _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f);
+
+            size_t i = 0;
+            for (; i + 4 <= count; i += 4) {
+                __m128 x = _mm_loadu_ps(&in[i].x);
+                __m128 y = _mm_loadu_ps(&in[i + 1].x);
+                __m128 z = _mm_loadu_ps(&in[i + 2].x);
+                __m128 w = _mm_loadu_ps(&in[i + 3].x);
+                _MM_TRANSPOSE4_PS(x, y, z, w);
+
+                const RotationEntries4 e = QuatEntries(x, y, z, w);
+                __m128 c0[4] = {e.m00, e.m01, e.m02, zero};
+                __m128 c1[4] = {e.m10, e.m11, e.m12, zero};
+                __m128 c2[4] = {e.m20, e.m21, e.m22, zero};
+                _MM_TRANSPOSE4_PS(c0[0], c0[1], c0[2], c0[3]);
+                _MM_TRANSPOSE4_PS(c1[0], c1[1], c1[2], c1[3]);
+                _MM_TRANSPOSE4_PS(c2[0], c2[1], c2[2], c2[3]);
+
+                for (i32 k = 0; k < 4; ++k) {
+                    f32* po = &out[i + k][0][0];
+                    _mm_storeu_ps(po, c0[k]);
+                    _mm_storeu_ps(po + 4, c1[k]);
+                    _mm_storeu_ps(po + 8, c2[k]);
+                    _mm_storeu_ps(po + 12, lastUnit);
+                }
+            }
+            QuatToMat4Scalar(in + i, out + i, count - i);
+        }
+
+        // An AABB array is a Vec3 array of alternating min and max. After deinterleaving, even lanes hold mins and odd
+        // lanes maxes, so swapping neighbours gives each lane its partner.
+        SIMD_TARGET_SSE4 void TransformAABBsSSE4(const Mat4& m, const AABB* in, AABB* out, size_t count) {
+            __m128 r[4][3];
+            __m128 a[3][3];  // |m|, for the extents
+            const __m128 signMask = _mm_set1_ps(-0.0f);
+            for (i32 c = 0; c < 4; ++c) {
+                for (i32 row = 0; row < 3; ++row) {
+                    r[c][row] = _mm_set1_ps(m[c][row]);
+                    if (c < 3) { a[c][row] = _mm_andnot_ps(signMask, r[c][row]); }
+                }
+            }
+
+            const __m128 half    = _mm_set1_ps(0.5f);
+            const __m128 minMax  = _mm_set_ps(1.0f, -1.0f, 1.0f, -1.0f);  // Subtract on min lanes, add on max lanes
+            size_t i             = 0;
+            for (; i + 2 <= count; i += 2) {
+                __m128 v[3];
+                LoadVec3x4(&in[i].min.x, v[0], v[1], v[2]);
+
+                __m128 center[3], extent[3];
+                for (i32 axis = 0; axis < 3; ++axis) {
+                    const __m128 partner = _mm_shuffle_ps(v[axis], v[axis], _MM_SHUFFLE(2, 3, 0, 1));
+                    center[axis]         = _mm_mul_ps(_mm_add_ps(v[axis], partner), half);
+                    extent[axis]         = _mm_andnot_ps(signMask, _mm_mul_ps(_mm_sub_ps(partner, v[axis]), half));
+                }
+
+                __m128 result[3];
+                for (i32 row = 0; row < 3; ++row) {
+                    const __m128 c  = _mm_add_ps(_mm_add_ps(_mm_mul_ps(r[0][row], center[0]),
+                                                            _mm_mul_ps(r[1][row], center[1])),
+                                                 _mm_add_ps(_mm_mul_ps(r[2][row], center[2]), r[3][row]));
+                    const __m128 e  = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a[0][row], extent[0]),
+                                                            _mm_mul_ps(a[1][row], extent[1])),
+                                                 _mm_mul_ps(a[2][row], extent[2]));
+                    result[row]     = _mm_add_ps(c, _mm_mul_ps(e, minMax));
+                }
+                StoreVec3x4(&out[i].min.x, result[0], result[1], result[2]);
+            }
+            TransformAABBsScalar(m, in + i, out + i, count - i);
+        }
+
+        // Culling keeps the frustum planes broadcast in registers, planes[p][0..3] = x, y, z, w
+        SIMD_TARGET_SSE4 inline void BroadcastPlanes(const Frustum& frustum, __m128 planes[6][4]) {
+            for (i32 p = 0; p < 6; ++p) {
+                for (i32 c = 0; c < 4; ++c) {
+                    planes[p][c] = _mm_set1_ps(frustum.planes[p][c]);
+                }
+            }
+        }
+
+        SIMD_TARGET_SSE4 inline u32 WriteVisible4(u32 mask, u32 first, u32* visible, u32 written) {
+            for (u32 lane = 0; lane < 4; ++lane) {
+                visible[written] = first + lane;
+                written += (mask >> lane) & 1;
+            }
+            return written;
+        }
+
+        SIMD_TARGET_SSE4 u32
+        CullSpheresSSE4(const Frustum& frustum, const SphereSoA& spheres, u32 begin, u32 end, u32* visible) {
+            __m128 planes[6][4];
+            BroadcastPlanes(frustum, planes);
+            const __m128 signMask = _mm_set1_ps(-0.0f);
+
+            u32 written = 0;
+            u32 i       = begin;
+            for (; i + 4 <= end; i += 4) {
+                const __m128 x         = _mm_loadu_ps(&spheres.x[i]);
+                const __m128 y         = _mm_loadu_ps(&spheres.y[i]);
+                const __m128 z         = _mm_loadu_ps(&spheres.z[i]);
+                const __m128 negRadius = _mm_xor_ps(_mm_loadu_ps(&spheres.radius[i]), signMask);
+
+                __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+                for (i32 p = 0; p < 6; ++p) {
+                    const __m128 distance = _mm_add_ps(
+                      _mm_add_ps(_mm_mul_ps(planes[p][0], x), _mm_mul_ps(planes[p][1], y)),
+                      _mm_add_ps(_mm_mul_ps(planes[p][2], z), planes[p][3]));
+                    inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, negRadius));
+                }
+                written = WriteVisible4(CAST<u32>(_mm_movemask_ps(inside)), i, visible, written);
+            }
+            return written + CullSpheresScalar(frustum, spheres, i, end, visible + written);
+        }
+
+        SIMD_TARGET_SSE4 u32
+        CullAABBsSSE4(const Frustum& frustum, const AABBSoA& boxes, u32 begin, u32 end, u32* visible) {
+            __m128 planes[6][4];
+            __m128 absPlanes[6][3];
+            BroadcastPlanes(frustum, planes);
+            const __m128 signMask = _mm_set1_ps(-0.0f);
+            for (i32 p = 0; p < 6; ++p) {
+                for (i32 c = 0; c < 3; ++c) {
+                    absPlanes[p][c] = _mm_andnot_ps(signMask, planes[p][c]);
+                }
+            }
+
+            u32 written = 0;
+            u32 i       = begin;
+            for (; i + 4 <= end; i += 4) {
+                const __m128 cx = _mm_loadu_ps(&boxes.centerX[i]);
+                const __m128 cy = _mm_loadu_ps(&boxes.centerY[i]);
+                const __m128 cz = _mm_loadu_ps(&boxes.centerZ[i]);
+                const __m128 ex = _mm_loadu_ps(&boxes.extentX[i]);
+                const __m128 ey = _mm_loadu_ps(&boxes.extentY[i]);
+                const __m128 ez = _mm_loadu_ps(&boxes.extentZ[i]);
+
+                __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+                for (i32 p = 0; p < 6; ++p) {
+                    const __m128 distance = _mm_add_ps(
+                      _mm_add_ps(_mm_mul_ps(planes[p][0], cx), _mm_mul_ps(planes[p][1], cy)),
+                      _mm_add_ps(_mm_mul_ps(planes[p][2], cz), planes[p][3]));
+                    const __m128 radius = _mm_add_ps(
+                      _mm_add_ps(_mm_mul_ps(absPlanes[p][0], ex), _mm_mul_ps(absPlanes[p][1], ey)),
+                      _mm_mul_ps(absPlanes[p][2], ez));
+                    inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(distance, radius), _mm_setzero_ps()));
+                }
+                written = WriteVisible4(CAST<u32>(_mm_movemask_ps(inside)), i, visible, written);
+            }
+            return written + CullAABBsScalar(frustum, boxes, i, end, visible + written);
+        }
+
+        // AVX2, 8 wide. 256-bit shuffles work within each 128-bit lane, so the SSE4 patterns apply unchanged with the
+        // second half of the batch loaded into the upper lane.
+
+        SIMD_TARGET_AVX2 inline void LoadVec3x8(const f32* p, __m256& x, __m256& y, __m256& z) {
+            const __m256 m03 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p)), _mm_loadu_ps(p + 12), 1);
+            const __m256 m14 =
+              _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 4)), _mm_loadu_ps(p + 16), 1);
+            const __m256 m25 =
+              _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 8)), _mm_loadu_ps(p + 20), 1);
+
+            const __m256 xy = _mm256_shuffle_ps(m14, m25, _MM_SHUFFLE(2, 1, 3, 2));
+            const __m256 yz = _mm256_shuffle_ps(m03, m14, _MM_SHUFFLE(1, 0, 2, 1));
+            x               = _mm256_shuffle_ps(m03, xy, _MM_SHUFFLE(2, 0, 3, 0));
+            y               = _mm256_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+            z               = _mm256_shuffle_ps(yz, m25, _MM_SHUFFLE(3, 0, 3, 1));
+        }
+
+        SIMD_TARGET_AVX2 inline void StoreVec3x8(f32* p, __m256 x, __m256 y, __m256 z) {
+            const __m256 rxy = _mm256_shuffle_ps(x, y, _MM_SHUFFLE(2, 0, 2, 0));
+            const __m256 ryz = _mm256_shuffle_ps(y, z, _MM_SHUFFLE(3, 1, 3, 1));
+            const __m256 rzx = _mm256_shuffle_ps(z, x, _MM_SHUFFLE(3, 1, 2, 0));
+
+            const __m256 r03 = _mm256_shuffle_ps(rxy, rzx, _MM_SHUFFLE(2, 0, 2, 0));
+            const __m256 r14 = _mm256_shuffle_ps(ryz, rxy, _MM_SHUFFLE(3, 1, 2, 0));
+            const __m256 r25 = _mm256_shuffle_ps(rzx, ryz, _MM_SHUFFLE(3, 1, 3, 1));
+
+            _mm_storeu_ps(p, _mm256_castps256_ps128(r03));
+            _mm_storeu_ps(p + 4, _mm256_castps256_ps128(r14));
+            _mm_storeu_ps(p + 8, _mm256_castps256_ps128(r25));
+            _mm_storeu_ps(p + 12, _mm256_extractf128_ps(r03, 1));
+            _mm_storeu_ps(p + 16, _mm256_extractf128_ps(r14, 1));
+            _mm_storeu_ps(p + 20, _mm256_extractf128_ps(r25, 1));
+        }
+
+        SIMD_TARGET_AVX2 void MultiplyMat4AVX2(const Mat4* a, size_t aStride, const Mat4* b, Mat4* out, size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                const f32* pa = &a[i * aStride][0][0];
+                const f32* pb = &b[i][0][0];
+                // Each column of a in both lanes, two columns of b per register
+                const __m256 a0 = _mm256_broadcast_ps(RCAST<const __m128*>(pa));
+                const __m256 a1 = _mm256_broadcast_ps(RCAST<const __m128*>(pa + 4));
+                const __m256 a2 = _mm256_broadcast_ps(RCAST<const __m128*>(pa + 8));
+                const __m256 a3 = _mm256_broadcast_ps(RCAST<const __m128*>(pa + 12));
+                const __m256 b01 = _mm256_loadu_ps(pb);
+                const __m256 b23 = _mm256_loadu_ps(pb + 8);
+
+                __m256 r01 = _mm256_mul_ps(a0, _mm256_permute_ps(b01, 0x00));
+                __m256 r23 = _mm256_mul_ps(a0, _mm256_permute_ps(b23, 0x00));
+                r01        = _mm256_fmadd_ps(a1, _mm256_permute_ps(b01, 0x55), r01);
+                r23        = _mm256_fmadd_ps(a1, _mm256_permute_ps(b23, 0x55), r23);
+                r01        = _mm256_fmadd_ps(a2, _mm256_permute_ps(b01, 0xAA), r01);
+                r23        = _mm256_fmadd_ps(a2, _mm256_permute_ps(b23, 0xAA), r23);
+                r01        = _mm256_fmadd_ps(a3, _mm256_permute_ps(b01, 0xFF), r01);
+                r23        = _mm256_fmadd_ps(a3, _mm256_permute_ps(b23, 0xFF), r23);
+
+                f32* po = &out[i][0][0];
+                _mm256_storeu_ps(po, r01);
+                _mm256_storeu_ps(po + 8, r23);
+            }
+        }
+
+        SIMD_TARGET_AVX2 void TransformPointsAVX2(const Mat4& m, const Vec3* in, Vec3* out, size_t count) {
+            __m256 r[4][3];
+            for (i32 c = 0; c < 4; ++c) {
+                for (i32 row = 0; row < 3; ++row) {
+                    r[c][row] = _mm256_set1_ps(m[c][row]);
+                }
+            }
+
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8) {
+                __m256 x, y, z;
+                LoadVec3x8(&in[i].x, x, y, z);
+
+                __m256 result[3];
+                for (i32 row = 0; row < 3; ++row) {
+                    result[row] = _mm256_fmadd_ps(
+                      r[0][row], x, _mm256_fmadd_ps(r[1][row], y, _mm256_fmadd_ps(r[2][row], z, r[3][row])));
+                }
+                StoreVec3x8(&out[i].x, result[0], result[1], result[2]);
+            }
+            TransformPointsSSE4(m, in + i, out + i, count - i);
+        }
+
+        SIMD_TARGET_AVX2 void TransformNormalsAVX2(const Mat4& m, const Vec3* in, Vec3* out, size_t count) {
+            __m256 r[3][3];
+            for (i32 c = 0; c < 3; ++c) {
+                for (i32 row = 0; row < 3; ++row) {
+                    r[c][row] = _mm256_set1_ps(m[c][row]);
+                }
+            }
+
+            const __m256 one = _mm256_set1_ps(1.0f);
+            size_t i         = 0;
+            for (; i + 8 <= count; i += 8) {
+                __m256 x, y, z;
+                LoadVec3x8(&in[i].x, x, y, z);
+
+                __m256 n[3];
+                for (i32 row = 0; row < 3; ++row) {
+                    n[row] = _mm256_fmadd_ps(r[0][row], x, _mm256_fmadd_ps(r[1][row], y, _mm256_mul_ps(r[2][row], z)));
+                }
+
+                const __m256 lengthSq =
+                  _mm256_fmadd_ps(n[0], n[0], _mm256_fmadd_ps(n[1], n[1], _mm256_mul_ps(n[2], n[2])));
+                const __m256 inverse = _mm256_div_ps(one, _mm256_sqrt_ps(lengthSq));
+                StoreVec3x8(&out[i].x,
+                            _mm256_mul_ps(n[0], inverse),
+                            _mm256_mul_ps(n[1], inverse),
+                            _mm256_mul_ps(n[2], inverse));
+            }
+            TransformNormalsSSE4(m, in + i, out + i, count - i);
+        }
+
+        SIMD_TARGET_AVX2 inline void Transpose4x8(__m256& r0, __m256& r1, __m256& r2, __m256& r3) {
+            const __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+            const __m256 t1 = _mm256_unpackhi_ps(r0, r1);
+            const __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+            const __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+            r0              = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+            r1              = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+            r2              = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+            r3              = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+        }
+
+        SIMD_TARGET_AVX2 void QuatToMat4AVX2(const Quat* in, Mat4* out, size_t count) {
+            const __m256 one  = _mm256_set1_ps(1.0f);
+            const __m256 two  = _mm256_set1_ps(2.0f);
+            const __m256 zero = _mm256_setzero_ps();
+            const __m128 unit = _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f);
+
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8) {
+                // Lane 0 holds quaternions 0, 2, 4, 6 and lane 1 holds 1, 3, 5, 7 after the transpose
+                __m256 x = _mm256_loadu_ps(&in[i].x);
+                __m256 y = _mm256_loadu_ps(&in[i + 2].x);
+                __m256 z = _mm256_loadu_ps(&in[i + 4].x);
+                __m256 w = _mm256_loadu_ps(&in[i + 6].x);
+                Transpose4x8(x, y, z, w);
+
+                const __m256 xx = _mm256_mul_ps(x, x), yy = _mm256_mul_ps(y, y), zz = _mm256_mul_ps(z, z);
+                const __m256 xy = _mm256_mul_ps(x, y), xz = _mm256_mul_ps(x, z), yz = _mm256_mul_ps(y, z);
+                const __m256 wx = _mm256_mul_ps(w, x), wy = _mm256_mul_ps(w, y), wz = _mm256_mul_ps(w, z);
+
+                __m256 c0[4] = {_mm256_fnmadd_ps(two, _mm256_add_ps(yy, zz), one),
+                                _mm256_mul_ps(two, _mm256_add_ps(xy, wz)),
+                                _mm256_mul_ps(two, _mm256_sub_ps(xz, wy)),
+                                zero};
+                __m256 c1[4] = {_mm256_mul_ps(two, _mm256_sub_ps(xy, wz)),
+                                _mm256_fnmadd_ps(two, _mm256_add_ps(xx, zz), one),
+                                _mm256_mul_ps(two, _mm256_add_ps(yz, wx)),
+                                zero};
+                __m256 c2[4] = {_mm256_mul_ps(two, _mm256_add_ps(xz, wy)),
+                                _mm256_mul_ps(two, _mm256_sub_ps(yz, wx)),
+                                _mm256_fnmadd_ps(two, _mm256_add_ps(xx, yy), one),
+                                zero};
+                Transpose4x8(c0[0], c0[1], c0[2], c0[3]);
+                Transpose4x8(c1[0], c1[1], c1[2], c1[3]);
+                Transpose4x8(c2[0], c2[1], c2[2], c2[3]);
+
+                // Register k holds a column of quaternion 2k in lane 0 and of 2k + 1 in lane 1
+                for (i32 k = 0; k < 4; ++k) {
+                    f32* even = &out[i + 2 * k][0][0];
+                    f32* odd  = &out[i + 2 * k + 1][0][0];
+                    _mm_storeu_ps(even, _mm256_castps256_ps128(c0[k]));
+                    _mm_storeu_ps(even + 4, _mm256_castps256_ps128(c1[k]));
+                    _mm_storeu_ps(even + 8, _mm256_castps256_ps128(c2[k]));
+                    _mm_storeu_ps(even + 12, unit);
+                    _mm_storeu_ps(odd, _mm256_extractf128_ps(c0[k], 1));
+                    _mm_storeu_ps(odd + 4, _mm256_extractf128_ps(c1[k], 1));
+                    _mm_storeu_ps(odd + 8, _mm256_extractf128_ps(c2[k], 1));
+                    _mm_storeu_ps(odd + 12, unit);
+                }
+            }
+            QuatToMat4SSE4(in + i, out + i, count - i);
+        }
+
+        SIMD_TARGET_AVX2 void TransformAABBsAVX2(const Mat4& m, const AABB* in, AABB* out, size_t count) {
+            __m256 r[4][3];
+            __m256 a[3][3];
+            const __m256 signMask = _mm256_set1_ps(-0.0f);
+            for (i32 c = 0; c < 4; ++c) {
+                for (i32 row = 0; row < 3; ++row) {
+                    r[c][row] = _mm256_set1_ps(m[c][row]);
+                    if (c < 3) { a[c][row] = _mm256_andnot_ps(signMask, r[c][row]); }
+                }
+            }
+
+            const __m256 half   = _mm256_set1_ps(0.5f);
+            const __m256 minMax = _mm256_set_ps(1.0f, -1.0f, 1.0f, -1.0f, 1.0f, -1.0f, 1.0f, -1.0f);
+            size_t i            = 0;
+            for (; i + 4 <= count; i += 4) {
+                __m256 v[3];
+                LoadVec3x8(&in[i].min.x, v[0], v[1], v[2]);
+
+                __m256 center[3], extent[3];
+                for (i32 axis = 0; axis < 3; ++axis) {
+                    const __m256 partner = _mm256_permute_ps(v[axis], _MM_SHUFFLE(2, 3, 0, 1));
+                    center[axis]         = _mm256_mul_ps(_mm256_add_ps(v[axis], partner), half);
+                    extent[axis] = _mm256_andnot_ps(signMask, _mm256_mul_ps(_mm256_sub_ps(partner, v[axis]), half));
+                }
+
+                __m256 result[3];
+                for (i32 row = 0; row < 3; ++row) {
+                    const __m256 c = _mm256_fmadd_ps(
+                      r[0][row],
+                      center[0],
+                      _mm256_fmadd_ps(r[1][row], center[1], _mm256_fmadd_ps(r[2][row], center[2], r[3][row])));
+                    const __m256 e = _mm256_fmadd_ps(
+                      a[0][row], extent[0], _mm256_fmadd_ps(a[1][row], extent[1], _mm256_mul_ps(a[2][row], extent[2])));
+                    result[row] = _mm256_fmadd_ps(e, minMax, c);
+                }
+                StoreVec3x8(&out[i].min.x, result[0], result[1], result[2]);
+            }
+            TransformAABBsSSE4(m, in + i, out + i, count - i);
+        }
+        // Lane permutations that pack the set lanes of an 8-bit mask to the front, one byte per lane, and the number
+        // of set lanes. Indexed by _mm256_movemask_ps.
+        struct CompactTable {
+            u64 lanes[256];
+            u8 counts[256];
+        };
+
+        constexpr CompactTable MakeCompactTable() {
+            CompactTable table {};
+            for (u32 mask = 0; mask < 256; ++mask) {
+                u32 count = 0;
+                for (u32 lane = 0; lane < 8; ++lane) {
+                    if ((mask >> lane) & 1) { table.lanes[mask] |= CAST<u64>(lane) << (8 * count++); }
+                }
+                table.counts[mask] = CAST<u8>(count);
+            }
+            return table;
+        }
+
+        constexpr CompactTable kCompactTable = MakeCompactTable();
+
+        // Stores all 8 lanes and advances by the visible count, so the lanes past it are overwritten by the next
+        // store. Never writes past the block being tested, which is why visible only needs end - begin entries.
+        SIMD_TARGET_AVX2 inline u32 WriteVisible8(u32 mask, __m256i indices, u32* visible, u32 written) {
+            const __m256i permutation =
+              _mm256_cvtepu8_epi32(_mm_loadl_epi64(RCAST<const __m128i*>(&kCompactTable.lanes[mask])));
+            _mm256_storeu_si256(RCAST<__m256i*>(visible + written), _mm256_permutevar8x32_epi32(indices, permutation));
+            return written + kCompactTable.counts[mask];
+        }
+
+        SIMD_TARGET_AVX2 u32
+        CullSpheresAVX2(const Frustum& frustum, const SphereSoA& spheres, u32 begin, u32 end, u32* visible) {
+            __m256 planes[6][4];
+            for (i32 p = 0; p < 6; ++p) {
+                for (i32 c = 0; c < 4; ++c) {
+                    planes[p][c] = _mm256_set1_ps(frustum.planes[p][c]);
+                }
+            }
+            const __m256 signMask = _mm256_set1_ps(-0.0f);
+            const __m256i step    = _mm256_set1_epi32(8);
+            __m256i indices =
+              _mm256_add_epi32(_mm256_set1_epi32(CAST<i32>(begin)), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+
+            u32 written = 0;
+            u32 i       = begin;
+            for (; i + 8 <= end; i += 8) {
+                const __m256 x         = _mm256_loadu_ps(&spheres.x[i]);
+                const __m256 y         = _mm256_loadu_ps(&spheres.y[i]);
+                const __m256 z         = _mm256_loadu_ps(&spheres.z[i]);
+                const __m256 negRadius = _mm256_xor_ps(_mm256_loadu_ps(&spheres.radius[i]), signMask);
+
+                __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+                for (i32 p = 0; p < 6; ++p) {
+                    __m256 distance = _mm256_fmadd_ps(planes[p][0], x, planes[p][3]);
+                    distance        = _mm256_fmadd_ps(planes[p][1], y, distance);
+                    distance        = _mm256_fmadd_ps(planes[p][2], z, distance);
+                    inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, negRadius, _CMP_GE_OQ));
+                }
+                written = WriteVisible8(CAST<u32>(_mm256_movemask_ps(inside)), indices, visible, written);
+                indices = _mm256_add_epi32(indices, step);
+            }
+            return written + CullSpheresScalar(frustum, spheres, i, end, visible + written);
+        }
+
+        SIMD_TARGET_AVX2 u32
+        CullAABBsAVX2(const Frustum& frustum, const AABBSoA& boxes, u32 begin, u32 end, u32* visible) {
+            __m256 planes[6][4];
+            __m256 absPlanes[6][3];
+            const __m256 signMask = _mm256_set1_ps(-0.0f);
+            for (i32 p = 0; p < 6; ++p) {
+                for (i32 c = 0; c < 4; ++c) {
+                    planes[p][c] = _mm256_set1_ps(frustum.planes[p][c]);
+                    if (c < 3) { absPlanes[p][c] = _mm256_andnot_ps(signMask, planes[p][c]); }
+                }
+            }
+            const __m256i step = _mm256_set1_epi32(8);
+            __m256i indices =
+              _mm256_add_epi32(_mm256_set1_epi32(CAST<i32>(begin)), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+
+            u32 written = 0;
+            u32 i       = begin;
+            for (; i + 8 <= end; i += 8) {
+                const __m256 cx = _mm256_loadu_ps(&boxes.centerX[i]);
+                const __m256 cy = _mm256_loadu_ps(&boxes.centerY[i]);
+                const __m256 cz = _mm256_loadu_ps(&boxes.centerZ[i]);
+                const __m256 ex = _mm256_loadu_ps(&boxes.extentX[i]);
+                const __m256 ey = _mm256_loadu_ps(&boxes.extentY[i]);
+                const __m256 ez = _mm256_loadu_ps(&boxes.extentZ[i]);
+
+                __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+                for (i32 p = 0; p < 6; ++p) {
+                    // distance + radius >= 0, with the radius of the box projected onto the plane normal
+                    __m256 reach = _mm256_fmadd_ps(planes[p][0], cx, planes[p][3]);
+                    reach        = _mm256_fmadd_ps(planes[p][1], cy, reach);
+                    reach        = _mm256_fmadd_ps(planes[p][2], cz, reach);
+                    reach        = _mm256_fmadd_ps(absPlanes[p][0], ex, reach);
+                    reach        = _mm256_fmadd_ps(absPlanes[p][1], ey, reach);
+                    reach        = _mm256_fmadd_ps(absPlanes[p][2], ez, reach);
+                    inside       = _mm256_and_ps(inside, _mm256_cmp_ps(reach, _mm256_setzero_ps(), _CMP_GE_OQ));
+                }
+                written = WriteVisible8(CAST<u32>(_mm256_movemask_ps(inside)), indices, visible, written);
+                indices = _mm256_add_epi32(indices, step);
+            }
+            return written + CullAABBsScalar(frustum, boxes, i, end, visible + written);
+        }
+#endif
+    }  // namespace
+
+    Level GetSupportedLevel() {
+        static const Level supported = DetectLevel();
+        return supported;
+    }
+
+    Level GetLevel() {
+        return CurrentLevel();
+    }
+
+    void SetLevel(Level level) {
+        gLevel.store(std::min(level, GetSupportedLevel()), std::memory_order_relaxed);
+        gLevelInitialized.store(true, std::memory_order_release);
+    }
+
+    const char* GetLevelName(Level level) {
+        switch (level) {
+            case Level::SSE4:
+                return "SSE4";
+            case Level::AVX2:
+                return "AVX2";
+            default:
+                return "Scalar";
+        }
+    }
+
+#if defined(ENGINE_SIMD_X86)
+    #define SIMD_DISPATCH(name, ...)                                                                                   \
+        switch (CurrentLevel()) {                                                                                      \
+            case Level::AVX2:                                                                                          \
+                return name##AVX2(__VA_ARGS__);                                                                        \
+            case Level::SSE4:                                                                                          \
+                return name##SSE4(__VA_ARGS__);                                                                        \
+            default:                                                                                                   \
+                return name##Scalar(__VA_ARGS__);                                                                      \
+        }
+#else
+    #define SIMD_DISPATCH(name, ...) return name##Scalar(__VA_ARGS__);
+#endif
+
+    void MultiplyMat4(const Mat4* a, const Mat4* b, Mat4* out, size_t count) {
+        SIMD_DISPATCH(MultiplyMat4, a, 1, b, out, count)
+    }
+
+    void MultiplyMat4(const Mat4& a, const Mat4* b, Mat4* out, size_t count) {
+        SIMD_DISPATCH(MultiplyMat4, &a, 0, b, out, count)
+    }
+
+    void TransformPoints(const Mat4& m, const Vec3* in, Vec3* out, size_t count) {
+        SIMD_DISPATCH(TransformPoints, m, in, out, count)
+    }
+
+    void TransformNormals(const Mat4& m, const Vec3* in, Vec3* out, size_t count) {
+        SIMD_DISPATCH(TransformNormals, m, in, out, count)
+    }
+
+    void QuatToMat4(const Quat* in, Mat4* out, size_t count) {
+        SIMD_DISPATCH(QuatToMat4, in, out, count)
+    }
+
+    void TransformAABBs(const Mat4& m, const AABB* in, AABB* out, size_t count) {
+        SIMD_DISPATCH(TransformAABBs, m, in, out, count)
+    }
+
+    u32 CullSpheres(const Frustum& frustum, const SphereSoA& spheres, u32 begin, u32 end, u32* visible) {
+        SIMD_DISPATCH(CullSpheres, frustum, spheres, begin, end, visible)
+    }
+
+    u32 CullAABBs(const Frustum& frustum, const AABBSoA& boxes, u32 begin, u32 end, u32* visible) {
+        SIMD_DISPATCH(CullAABBs, frustum, boxes, begin, end, visible)
+    }
+
+#undef SIMD_DISPATCH
+}  // namespace X::Math::Simd
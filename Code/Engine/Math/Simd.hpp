@@ -0,0 +1,63 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#pragma once
+
+#include "EnginePCH.h"
+#include "Bounds.hpp"
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+    #define ENGINE_SIMD_X86
+#endif
+
+// GCC and Clang only emit AVX2 and SSE4 instructions in functions compiled for them. MSVC allows intrinsics anywhere,
+// so the engine itself builds for baseline x86-64 and picks kernels at runtime. Files with their own kernels include
+// <immintrin.h> under ENGINE_SIMD_X86, mark them with these and switch on GetLevel().
+#if defined(ENGINE_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+    #define SIMD_TARGET_SSE4 __attribute__((target("sse4.1")))
+    #define SIMD_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#else
+    #define SIMD_TARGET_SSE4
+    #define SIMD_TARGET_AVX2
+#endif
+
+namespace X::Math::Simd {
+
+    enum class Level : u8 { Scalar, SSE4, AVX2 };
+
+    // Highest level supported by the CPU and OS, detected on first use
+    Level GetSupportedLevel();
+    // Level the batch functions dispatch to, the supported level unless overridden
+    Level GetLevel();
+    // Clamped to the supported level, mainly for benchmarks and comparing results
+    void SetLevel(Level level);
+    const char* GetLevelName(Level level);
+
+    // Batch operations on arrays of glm types. Each picks the widest kernel for the current level once per call, so
+    // they only pay off for arrays, not single values. Outputs may alias inputs element for element (out == in), but
+    // not partially overlap them. Vec3 arrays are tightly packed, 12 bytes per element.
+
+    // out[i] = a[i] * b[i]
+    void MultiplyMat4(const Mat4* a, const Mat4* b, Mat4* out, size_t count);
+    // out[i] = a * b[i], e.g. view-projection times each world matrix
+    void MultiplyMat4(const Mat4& a, const Mat4* b, Mat4* out, size_t count);
+
+    // out[i] = m * vec4(in[i], 1) without the perspective divide, m is expected to be affine
+    void TransformPoints(const Mat4& m, const Vec3* in, Vec3* out, size_t count);
+    // out[i] = normalize(mat3(m) * in[i]). Pass the inverse transpose when m has non-uniform scale.
+    void TransformNormals(const Mat4& m, const Vec3* in, Vec3* out, size_t count);
+
+    // Rotation matrices for unit quaternions
+    void QuatToMat4(const Quat* in, Mat4* out, size_t count);
+
+    // Smallest AABBs containing each box transformed by the affine matrix m (Arvo's method)
+    void TransformAABBs(const Mat4& m, const AABB* in, AABB* out, size_t count);
+
+    // Frustum culling over struct-of-arrays bounds. Tests volumes [begin, end) and writes the indices of those that
+    // intersect the frustum to visible in ascending order, which needs room for end - begin entries. Returns the number
+    // written.
+    u32 CullSpheres(const Frustum& frustum, const SphereSoA& spheres, u32 begin, u32 end, u32* visible);
+    u32 CullAABBs(const Frustum& frustum, const AABBSoA& boxes, u32 begin, u32 end, u32* visible);
+
+}  // namespace X::Math::Simd
@@ -3,7 +3,374 @@
 //
 
 #include "Transform.hpp"
+#include "Core/JobSystem.hpp"
+
+#include <atomic>
 
 namespace X {
-    namespace Math {}  // namespace Math
-}  // namespace X
\ No newline at end of file
+    namespace Math {
+        namespace {
+            // Columns of scale * rotation, the upper 3x3 of the local matrix
+            void RotationScale(const Quat& q, const Vec3& s, Vec4& c0, Vec4& c1, Vec4& c2) {
+                const f32 xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+                const f32 xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+                const f32 wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+                c0 = Vec4(1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy), 0.0f) * s.x;
+                c1 = Vec4(2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx), 0.0f) * s.y;
+                c2 = Vec4(2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy), 0.0f) * s.z;
+            }
+
+            // parent * TRS, treating both as affine so the bottom row is never multiplied
+            void ComposeWorld(const Mat4& parent, const Vec3& p, const Quat& q, const Vec3& s, Mat4& out) {
+                Vec4 c0, c1, c2;
+                RotationScale(q, s, c0, c1, c2);
+
+                out[0] = parent[0] * c0.x + parent[1] * c0.y + parent[2] * c0.z;
+                out[1] = parent[0] * c1.x + parent[1] * c1.y + parent[2] * c1.z;
+                out[2] = parent[0] * c2.x + parent[1] * c2.y + parent[2] * c2.z;
+                out[3] = parent[0] * p.x + parent[1] * p.y + parent[2] * p.z + parent[3];
+            }
+
+            void ComposeLocal(const Vec3& p, const Quat& q, const Vec3& s, Mat4& out) {
+                RotationScale(q, s, out[0], out[1], out[2]);
+                out[3] = Vec4(p, 1.0f);
+            }
+        }  // namespace
+
+        Mat4 Transform::ToMatrix() const {
+            Mat4 result;
+            ComposeLocal(position, rotation, scale, result);
+            return result;
+        }
+
+        void TransformHierarchy::Reserve(u32 count) {
+            _positions.reserve(count);
+            _rotations.reserve(count);
+            _scales.reserve(count);
+            _worlds.reserve(count);
+            _parents.reserve(count);
+            _flags.reserve(count);
+            _taskOf.reserve(count);
+            _indexToHandle.reserve(count);
+            _handleToIndex.reserve(count);
+        }
+
+        void TransformHierarchy::Clear() {
+            _positions.clear();
+            _rotations.clear();
+            _scales.clear();
+            _worlds.clear();
+            _parents.clear();
+            _flags.clear();
+            _taskOf.clear();
+            _indexToHandle.clear();
+            _handleToIndex.clear();
+            _freeHandles.clear();
+            _spine.clear();
+            _tasks.clear();
+            _taskDirty.clear();
+            _orderDirty = false;
+            _stats      = {};
+        }
+
+        TransformHandle TransformHierarchy::Create(const Transform& local, TransformHandle parent) {
+            const u32 index       = GetCount();
+            const u32 parentIndex = IsValid(parent) ? _handleToIndex[parent] : kNone;
+
+            TransformHandle handle;
+            if (!_freeHandles.empty()) {
+                handle = _freeHandles.back();
+                _freeHandles.pop_back();
+                _handleToIndex[handle] = index;
+            } else {
+                handle = CAST<TransformHandle>(_handleToIndex.size());
+                _handleToIndex.push_back(index);
+            }
+
+            _positions.push_back(local.position);
+            _rotations.push_back(local.rotation);
+            _scales.push_back(local.scale);
+            _worlds.emplace_back(1.0f);
+            _parents.push_back(parentIndex);
+            _flags.push_back(kDirty);
+            _taskOf.push_back(kNone);
+            _indexToHandle.push_back(handle);
+
+            if (parentIndex != kNone) {
+                // Has to be moved next to its parent
+                _orderDirty = true;
+            } else if (!_orderDirty) {
+                // A new root is already in depth-first order at the end, add it to the last root task if it fits
+                if (_tasks.empty() || _tasks.back().parent != kNone || _tasks.back().end != index ||
+                    _tasks.back().end - _tasks.back().begin >= kTaskSize) {
+                    _tasks.push_back({index, index, kNone});
+                    _taskDirty.push_back(0);
+                }
+                ++_tasks.back().end;
+                _taskOf[index]    = CAST<u32>(_tasks.size() - 1);
+                _taskDirty.back() = 1;
+            }
+
+            return handle;
+        }
+
+        void TransformHierarchy::Destroy(TransformHandle handle) {
+            if (!IsValid(handle)) return;
+            _flags[_handleToIndex[handle]] |= kRemoved;
+            _orderDirty = true;
+        }
+
+        bool TransformHierarchy::IsValid(TransformHandle handle) const {
+            if (handle >= _handleToIndex.size()) return false;
+            const u32 index = _handleToIndex[handle];
+            return index != kNone && !(_flags[index] & kRemoved);
+        }
+
+        bool TransformHierarchy::SetParent(TransformHandle handle, TransformHandle parent) {
+            if (!IsValid(handle)) return false;
+
+            const u32 index       = _handleToIndex[handle];
+            const u32 parentIndex = IsValid(parent) ? _handleToIndex[parent] : kNone;
+            if (_parents[index] == parentIndex) return true;
+
+            for (u32 ancestor = parentIndex; ancestor != kNone; ancestor = _parents[ancestor]) {
+                if (ancestor == index) return false;
+            }
+
+            _parents[index] = parentIndex;
+            _orderDirty     = true;
+            MarkDirty(index);
+            return true;
+        }
+
+        TransformHandle TransformHierarchy::GetParent(TransformHandle handle) const {
+            const u32 parent = _parents[_handleToIndex[handle]];
+            return parent != kNone ? _indexToHandle[parent] : kInvalidTransform;
+        }
+
+        void TransformHierarchy::SetLocal(TransformHandle handle, const Transform& local) {
+            const u32 index   = _handleToIndex[handle];
+            _positions[index] = local.position;
+            _rotations[index] = local.rotation;
+            _scales[index]    = local.scale;
+            MarkDirty(index);
+        }
+
+        void TransformHierarchy::SetPosition(TransformHandle handle, const Vec3& position) {
+            const u32 index   = _handleToIndex[handle];
+            _positions[index] = position;
+            MarkDirty(index);
+        }
+
+        void TransformHierarchy::SetRotation(TransformHandle handle, const Quat& rotation) {
+            const u32 index   = _handleToIndex[handle];
+            _rotations[index] = rotation;
+            MarkDirty(index);
+        }
+
+        void TransformHierarchy::SetScale(TransformHandle handle, const Vec3& scale) {
+            const u32 index = _handleToIndex[handle];
+            _scales[index]  = scale;
+            MarkDirty(index);
+        }
+
+        Transform TransformHierarchy::GetLocal(TransformHandle handle) const {
+            const u32 index = _handleToIndex[handle];
+            return {_positions[index], _rotations[index], _scales[index]};
+        }
+
+        void TransformHierarchy::MarkDirty(u32 index) {
+            _flags[index] |= kDirty;
+            // While a reorder is pending the task layout is stale, Reorder rebuilds the dirty tasks from the flags
+            if (!_orderDirty && _taskOf[index] != kNone) { _taskDirty[_taskOf[index]] = 1; }
+        }
+
+        void TransformHierarchy::Update(Core::JobSystem* jobs) {
+            _stats           = {};
+            _stats.reordered = _orderDirty;
+            if (_orderDirty) { Reorder(); }
+
+            // The spine is a few hundred transforms at most and always walked, so its changed flags are current
+            u32 updated = 0;
+            for (const u32 index : _spine) {
+                updated += UpdateTransform(index) ? 1 : 0;
+            }
+
+            _runTasks.clear();
+            for (u32 t = 0; t < CAST<u32>(_tasks.size()); ++t) {
+                const Task& task         = _tasks[t];
+                const bool parentChanged = task.parent != kNone && (_flags[task.parent] & kChanged);
+                if (_taskDirty[t] || parentChanged) {
+                    _runTasks.push_back(t);
+                    _taskDirty[t] = 0;
+                }
+            }
+
+            const u32 runCount = CAST<u32>(_runTasks.size());
+            if (jobs && runCount > 1) {
+                std::atomic<u32> parallelUpdated {0};
+                const u32 batchSize = std::max(1u, runCount / (jobs->GetThreadCount() * 4));
+                jobs->ParallelFor(runCount, batchSize, [this, &parallelUpdated](u32 begin, u32 end) {
+                    u32 batchUpdated = 0;
+                    for (u32 i = begin; i < end; ++i) {
+                        const Task& task = _tasks[_runTasks[i]];
+                        batchUpdated += UpdateRange(task.begin, task.end);
+                    }
+                    parallelUpdated.fetch_add(batchUpdated, std::memory_order_relaxed);
+                });
+                updated += parallelUpdated.load(std::memory_order_relaxed);
+            } else {
+                for (const u32 t : _runTasks) {
+                    updated += UpdateRange(_tasks[t].begin, _tasks[t].end);
+                }
+            }
+
+            _stats.count        = GetCount();
+            _stats.updated      = updated;
+            _stats.tasks        = CAST<u32>(_tasks.size());
+            _stats.skippedTasks = _stats.tasks - runCount;
+        }
+
+        u32 TransformHierarchy::UpdateRange(u32 begin, u32 end) {
+            u32 updated = 0;
+            for (u32 i = begin; i < end; ++i) {
+                updated += UpdateTransform(i) ? 1 : 0;
+            }
+            return updated;
+        }
+
+        bool TransformHierarchy::UpdateTransform(u32 index) {
+            const u32 parent         = _parents[index];
+            const bool parentChanged = parent != kNone && (_flags[parent] & kChanged);
+
+            u8 flags = _flags[index];
+            if (!(flags & kDirty) && !parentChanged) {
+                _flags[index] = flags & ~kChanged;
+                return false;
+            }
+
+            if (parent != kNone) {
+                ComposeWorld(_worlds[parent], _positions[index], _rotations[index], _scales[index], _worlds[index]);
+            } else {
+                ComposeLocal(_positions[index], _rotations[index], _scales[index], _worlds[index]);
+            }
+            _flags[index] = (flags & ~kDirty) | kChanged;
+            return true;
+        }
+
+        void TransformHierarchy::Reorder() {
+            const u32 count = GetCount();
+
+            // Children of each transform in the current order, as offsets into one array
+            vector<u32> childStart(count + 1, 0);
+            vector<u32> children(count);
+            for (u32 i = 0; i < count; ++i) {
+                if (_parents[i] != kNone) { ++childStart[_parents[i] + 1]; }
+            }
+            for (u32 i = 0; i < count; ++i) {
+                childStart[i + 1] += childStart[i];
+            }
+            {
+                vector<u32> cursor(childStart.begin(), childStart.end() - 1);
+                for (u32 i = 0; i < count; ++i) {
+                    if (_parents[i] != kNone) { children[cursor[_parents[i]]++] = i; }
+                }
+            }
+
+            // Depth-first from each root, in the current order so untouched hierarchies keep their layout. Removed
+            // transforms are never pushed, which drops their whole subtree.
+            vector<u32> newToOld;
+            vector<u32> oldToNew(count, kNone);
+            vector<u32> stack;
+            newToOld.reserve(count);
+            for (u32 root = 0; root < count; ++root) {
+                if (_parents[root] != kNone || (_flags[root] & kRemoved)) continue;
+
+                stack.push_back(root);
+                while (!stack.empty()) {
+                    const u32 index = stack.back();
+                    stack.pop_back();
+                    oldToNew[index] = CAST<u32>(newToOld.size());
+                    newToOld.push_back(index);
+
+                    for (u32 c = childStart[index + 1]; c > childStart[index]; --c) {
+                        const u32 child = children[c - 1];
+                        if (!(_flags[child] & kRemoved)) { stack.push_back(child); }
+                    }
+                }
+            }
+
+            for (u32 i = 0; i < count; ++i) {
+                if (oldToNew[i] == kNone) {
+                    _handleToIndex[_indexToHandle[i]] = kNone;
+                    _freeHandles.push_back(_indexToHandle[i]);
+                }
+            }
+
+            const u32 newCount = CAST<u32>(newToOld.size());
+            const auto permute = [&newToOld, newCount](auto& values) {
+                std::remove_reference_t<decltype(values)> sorted(newCount);
+                for (u32 i = 0; i < newCount; ++i) {
+                    sorted[i] = values[newToOld[i]];
+                }
+                values.swap(sorted);
+            };
+            permute(_positions);
+            permute(_rotations);
+            permute(_scales);
+            permute(_worlds);
+            permute(_flags);
+            permute(_indexToHandle);
+
+            vector<u32> parents(newCount);
+            for (u32 i = 0; i < newCount; ++i) {
+                const u32 parent = _parents[newToOld[i]];
+                parents[i]       = parent != kNone ? oldToNew[parent] : kNone;
+            }
+            _parents.swap(parents);
+            for (u32 i = 0; i < newCount; ++i) {
+                _handleToIndex[_indexToHandle[i]] = i;
+            }
+
+            // Subtree sizes, children always come after their parent
+            vector<u32> subtreeSize(newCount, 1);
+            for (u32 i = newCount; i-- > 0;) {
+                if (_parents[i] != kNone) { subtreeSize[_parents[i]] += subtreeSize[i]; }
+            }
+
+            // Descend through subtrees that are too large, they form the spine. Everything below is cut into tasks of
+            // adjacent sibling subtrees, so each task only depends on one transform outside it.
+            _spine.clear();
+            _tasks.clear();
+            _taskDirty.clear();
+            _taskOf.assign(newCount, kNone);
+            for (u32 i = 0; i < newCount;) {
+                if (subtreeSize[i] > kTaskSize) {
+                    _spine.push_back(i++);
+                    continue;
+                }
+
+                const u32 parent = _parents[i];
+                const u32 begin  = i;
+                u32 end          = i + subtreeSize[i];
+                while (end < newCount && _parents[end] == parent && end - begin + subtreeSize[end] <= kTaskSize) {
+                    end += subtreeSize[end];
+                }
+
+                const u32 task = CAST<u32>(_tasks.size());
+                u8 dirty       = 0;
+                for (u32 k = begin; k < end; ++k) {
+                    _taskOf[k] = task;
+                    dirty |= _flags[k] & kDirty;
+                }
+                _tasks.push_back({begin, end, parent});
+                _taskDirty.push_back(dirty);
+                i = end;
+            }
+
+            _orderDirty = false;
+        }
+
+    }  // namespace Math
+}  // namespace X
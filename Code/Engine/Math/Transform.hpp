@@ -4,10 +4,118 @@
 
 #pragma once
 
+#include "EnginePCH.h"
+
 namespace X {
     namespace Math {
 
-        class Transform {};
+        // Local translation, rotation and scale, applied as scale, then rotation, then translation
+        struct Transform {
+            Vec3 position {0.0f};
+            Quat rotation {1.0f, 0.0f, 0.0f, 0.0f};
+            Vec3 scale {1.0f};
+
+            Mat4 ToMatrix() const;
+        };
+
+        using TransformHandle = u32;
+        constexpr TransformHandle kInvalidTransform = ~0u;
+
+        struct TransformStats {
+            u32 count {0};
+            u32 updated {0};       // World matrices recomputed by the last Update
+            u32 tasks {0};         // Subtree ranges the hierarchy is split into
+            u32 skippedTasks {0};  // Ranges with nothing dirty, skipped without touching their transforms
+            bool reordered {false};
+        };
+
+        // Stores local transforms as structure-of-arrays, sorted depth-first so every parent comes before its
+        // children and every subtree is one contiguous range. Update walks the arrays once, recomputing world matrices
+        // only for transforms that were changed or whose parent's world changed. The order is split into subtree
+        // ranges of up to kTaskSize transforms; ranges with nothing dirty are skipped outright, so static objects cost
+        // nothing, and the rest are updated in parallel when a job system is passed in.
+        //
+        // Handles stay valid while the arrays are reordered. Structural changes (parenting a transform, destroying one)
+        // are applied by re-sorting at the next Update. Not thread-safe, mutate from one thread outside Update.
+        class TransformHierarchy {
+        public:
+            static constexpr u32 kTaskSize = 4096;
+
+            void Reserve(u32 count);
+            void Clear();
+
+            TransformHandle Create(const Transform& local = {}, TransformHandle parent = kInvalidTransform);
+            // Destroys the transform and, at the next Update, all of its descendants
+            void Destroy(TransformHandle handle);
+            bool IsValid(TransformHandle handle) const;
+
+            // Fails when parent is the transform itself or one of its descendants
+            bool SetParent(TransformHandle handle, TransformHandle parent);
+            TransformHandle GetParent(TransformHandle handle) const;
+
+            void SetLocal(TransformHandle handle, const Transform& local);
+            void SetPosition(TransformHandle handle, const Vec3& position);
+            void SetRotation(TransformHandle handle, const Quat& rotation);
+            void SetScale(TransformHandle handle, const Vec3& scale);
+            Transform GetLocal(TransformHandle handle) const;
+
+            // As of the last Update
+            const Mat4& GetWorld(TransformHandle handle) const {
+                return _worlds[_handleToIndex[handle]];
+            }
+
+            void Update(Core::JobSystem* jobs = nullptr);
+
+            u32 GetCount() const {
+                return CAST<u32>(_positions.size());
+            }
+            const TransformStats& GetStats() const {
+                return _stats;
+            }
+
+        private:
+            static constexpr u32 kNone = ~0u;
+
+            enum Flags : u8 {
+                kDirty   = 1 << 0,
+                kChanged = 1 << 1,  // World was recomputed this Update, read by children
+                kRemoved = 1 << 2,
+            };
+
+            // A contiguous run of sibling subtrees sharing one parent
+            struct Task {
+                u32 begin;
+                u32 end;
+                u32 parent;
+            };
+
+            void MarkDirty(u32 index);
+            void Reorder();
+            // Return the number of world matrices recomputed
+            u32 UpdateRange(u32 begin, u32 end);
+            bool UpdateTransform(u32 index);
+
+            // Dense, in hierarchy order
+            vector<Vec3> _positions;
+            vector<Quat> _rotations;
+            vector<Vec3> _scales;
+            vector<Mat4> _worlds;
+            vector<u32> _parents;  // Index, kNone for roots
+            vector<u8> _flags;
+            vector<u32> _taskOf;  // Task index, kNone for transforms on the spine
+            vector<TransformHandle> _indexToHandle;
+
+            vector<u32> _handleToIndex;
+            vector<TransformHandle> _freeHandles;
+
+            // Transforms whose subtrees are too large for one task, updated serially before the tasks
+            vector<u32> _spine;
+            vector<Task> _tasks;
+            vector<u8> _taskDirty;
+            vector<u32> _runTasks;
+            bool _orderDirty {false};
+            TransformStats _stats;
+        };
 
     }  // namespace Math
 }  // namespace X
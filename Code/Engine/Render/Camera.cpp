@@ -5,5 +5,100 @@
 #include "Camera.hpp"
 
 namespace X {
-    namespace Render {}  // namespace Render
-}  // namespace X
\ No newline at end of file
+    namespace Render {
+        f32 GetPixelsPerUnit(const Mat4& projection, f32 distance, u32 viewportHeight) {
+            // Clip w of a point distance units in front of a right-handed view, 1 for orthographic projections
+            const f32 w = std::max(projection[3][3] - projection[2][3] * distance, 1.0e-6f);
+            return projection[1][1] * 0.5f * CAST<f32>(viewportHeight) / w;
+        }
+
+        Camera::Camera() {
+            UpdateView();
+            UpdateProjection();
+        }
+
+        void Camera::SetPerspective(f32 fovY, f32 aspect, f32 nearZ, f32 farZ) {
+            _projectionType = Projection::Perspective;
+            _fovY           = fovY;
+            _aspect         = aspect;
+            _near           = nearZ;
+            _far            = farZ;
+            UpdateProjection();
+        }
+
+        void Camera::SetOrthographic(f32 width, f32 height, f32 nearZ, f32 farZ) {
+            _projectionType = Projection::Orthographic;
+            _width          = width;
+            _height         = height;
+            _aspect         = width / height;
+            _near           = nearZ;
+            _far            = farZ;
+            UpdateProjection();
+        }
+
+        void Camera::SetAspect(f32 aspect) {
+            if (_projectionType == Projection::Orthographic) { _width = _height * aspect; }
+            _aspect = aspect;
+            UpdateProjection();
+        }
+
+        void Camera::SetDepthZeroToOne(bool zeroToOne) {
+            _zeroToOne = zeroToOne;
+            UpdateProjection();
+        }
+
+        void Camera::SetPosition(const Vec3& position) {
+            _position = position;
+            UpdateView();
+        }
+
+        void Camera::SetRotation(const Quat& rotation) {
+            _rotation = glm::normalize(rotation);
+            UpdateView();
+        }
+
+        void Camera::LookAt(const Vec3& target, const Vec3& up) {
+            // The camera's rotation is the inverse of the view matrix's
+            _rotation = glm::conjugate(glm::quat_cast(glm::lookAtRH(_position, target, up)));
+            UpdateView();
+        }
+
+        Vec3 Camera::GetForward() const {
+            return _rotation * Vec3(0.0f, 0.0f, -1.0f);
+        }
+
+        Vec3 Camera::GetRight() const {
+            return _rotation * Vec3(1.0f, 0.0f, 0.0f);
+        }
+
+        Vec3 Camera::GetUp() const {
+            return _rotation * Vec3(0.0f, 1.0f, 0.0f);
+        }
+
+        void Camera::UpdateView() {
+            // Inverse of translate * rotate, without a general matrix inverse
+            const Mat4 inverseRotation = glm::mat4_cast(glm::conjugate(_rotation));
+            _view                      = glm::translate(inverseRotation, -_position);
+            UpdateViewProjection();
+        }
+
+        void Camera::UpdateProjection() {
+            if (_projectionType == Projection::Perspective) {
+                _projection = _zeroToOne ? glm::perspectiveRH_ZO(_fovY, _aspect, _near, _far)
+                                         : glm::perspectiveRH_NO(_fovY, _aspect, _near, _far);
+            } else {
+                const f32 halfWidth  = _width * 0.5f;
+                const f32 halfHeight = _height * 0.5f;
+                _projection          = _zeroToOne
+                                         ? glm::orthoRH_ZO(-halfWidth, halfWidth, -halfHeight, halfHeight, _near, _far)
+                                         : glm::orthoRH_NO(-halfWidth, halfWidth, -halfHeight, halfHeight, _near, _far);
+            }
+            UpdateViewProjection();
+        }
+
+        void Camera::UpdateViewProjection() {
+            _viewProjection = _projection * _view;
+            _frustum        = Math::Frustum::FromMatrix(_viewProjection, _zeroToOne);
+        }
+    }  // namespace Render
+}  // namespace X
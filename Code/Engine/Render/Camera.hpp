@@ -4,8 +4,103 @@
 
 #pragma once
 
+#include "EnginePCH.h"
+#include "Math/Bounds.hpp"
+
 namespace X::Render {
 
-    class Camera {};
+    enum class Projection : u8 { Perspective, Orthographic };
+
+    // Screen pixels spanned by one world unit at a view-space distance under a projection matrix, for screen-space
+    // error metrics. Orthographic projections ignore the distance.
+    f32 GetPixelsPerUnit(const Mat4& projection, f32 distance, u32 viewportHeight);
+
+    // Right-handed camera looking down -Z in view space. Matrices and the frustum are rebuilt whenever a setter
+    // changes them, so the getters are plain reads.
+    class Camera {
+    public:
+        Camera();
+
+        // fovY in radians
+        void SetPerspective(f32 fovY, f32 aspect, f32 nearZ, f32 farZ);
+        // Width and height of the view volume in world units
+        void SetOrthographic(f32 width, f32 height, f32 nearZ, f32 farZ);
+        void SetAspect(f32 aspect);
+        // Clip-space depth range of the backend, [0, 1] for D3D, Vulkan and Metal, [-1, 1] for OpenGL. Take it from
+        // the device's NDC attributes (MinZ == 0).
+        void SetDepthZeroToOne(bool zeroToOne);
+
+        void SetPosition(const Vec3& position);
+        void SetRotation(const Quat& rotation);
+        void LookAt(const Vec3& target, const Vec3& up = Vec3(0.0f, 1.0f, 0.0f));
+
+        const Vec3& GetPosition() const {
+            return _position;
+        }
+        const Quat& GetRotation() const {
+            return _rotation;
+        }
+        Vec3 GetForward() const;
+        Vec3 GetRight() const;
+        Vec3 GetUp() const;
+
+        Projection GetProjectionType() const {
+            return _projectionType;
+        }
+        f32 GetFovY() const {
+            return _fovY;
+        }
+        f32 GetAspect() const {
+            return _aspect;
+        }
+        f32 GetNear() const {
+            return _near;
+        }
+        f32 GetFar() const {
+            return _far;
+        }
+        bool GetDepthZeroToOne() const {
+            return _zeroToOne;
+        }
+
+        const Mat4& GetView() const {
+            return _view;
+        }
+        const Mat4& GetProjection() const {
+            return _projection;
+        }
+        const Mat4& GetViewProjection() const {
+            return _viewProjection;
+        }
+        // World-space planes of the view volume
+        const Math::Frustum& GetFrustum() const {
+            return _frustum;
+        }
+        f32 GetPixelsPerUnit(f32 distance, u32 viewportHeight) const {
+            return Render::GetPixelsPerUnit(_projection, distance, viewportHeight);
+        }
+
+    private:
+        void UpdateView();
+        void UpdateProjection();
+        void UpdateViewProjection();
+
+        Projection _projectionType {Projection::Perspective};
+        f32 _fovY {glm::radians(60.0f)};
+        f32 _aspect {16.0f / 9.0f};
+        f32 _width {10.0f};  // Orthographic view volume
+        f32 _height {10.0f};
+        f32 _near {0.1f};
+        f32 _far {1000.0f};
+        bool _zeroToOne {false};
+
+        Vec3 _position {0.0f};
+        Quat _rotation {1.0f, 0.0f, 0.0f, 0.0f};
+
+        Mat4 _view {1.0f};
+        Mat4 _projection {1.0f};
+        Mat4 _viewProjection {1.0f};
+        Math::Frustum _frustum;
+    };
 
-}  // namespace X::Render
\ No newline at end of file
+}  // namespace X::Render
@@ -0,0 +1,71 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include "Culling.hpp"
+#include "Core/JobSystem.hpp"
+#include "Core/Profiler.hpp"
+#include "Math/Simd.hpp"
+
+namespace X::Render {
+    void FrustumCuller::Cull(const Math::Frustum& frustum, const Math::SphereSoA& spheres, Core::JobSystem* jobs) {
+        PROFILE_SCOPE("CullSpheres");
+        Run(spheres.GetCount(), jobs, [&frustum, &spheres](u32 begin, u32 end, u32* visible) {
+            return Math::Simd::CullSpheres(frustum, spheres, begin, end, visible);
+        });
+    }
+
+    void FrustumCuller::Cull(const Math::Frustum& frustum, const Math::AABBSoA& boxes, Core::JobSystem* jobs) {
+        PROFILE_SCOPE("CullAABBs");
+        Run(boxes.GetCount(), jobs, [&frustum, &boxes](u32 begin, u32 end, u32* visible) {
+            return Math::Simd::CullAABBs(frustum, boxes, begin, end, visible);
+        });
+    }
+
+    void FrustumCuller::Cull(const Math::Frustum& frustum, const Math::Bvh& bvh) {
+        PROFILE_SCOPE("CullBvh");
+        const u32 count = bvh.GetCount();
+        if (_visible.size() < count) { _visible.resize(count); }
+
+        u32 visible = 0;
+        bvh.QueryFrustum(frustum, [this, &bvh, &visible](Math::BvhHandle handle) {
+            _visible[visible++] = bvh.GetUserData(handle);
+        });
+        _stats = {count, visible, 1};
+    }
+
+    template<typename Kernel>
+    void FrustumCuller::Run(u32 count, Core::JobSystem* jobs, const Kernel& kernel) {
+        // Grown only, so steady-state frames neither allocate nor clear the list
+        if (_visible.size() < count) { _visible.resize(count); }
+
+        const u32 batches = (count + kBatchSize - 1) / kBatchSize;
+        _batchCounts.resize(batches);
+        _stats = {count, 0, batches};
+        if (count == 0) return;
+
+        // Each batch compacts into its own slice of the list, starting where its bounds start
+        const auto cullBatches = [this, count, &kernel](u32 first, u32 last) {
+            for (u32 batch = first; batch < last; ++batch) {
+                const u32 begin     = batch * kBatchSize;
+                const u32 end       = std::min(begin + kBatchSize, count);
+                _batchCounts[batch] = kernel(begin, end, _visible.data() + begin);
+            }
+        };
+        if (jobs && batches > 1) {
+            jobs->ParallelFor(batches, 1, cullBatches);
+        } else {
+            cullBatches(0, batches);
+        }
+
+        // Close the gaps between slices. Every slice moves down, never past the next one's start, so going in order
+        // never overwrites results that have not been moved yet.
+        u32 visible = _batchCounts[0];
+        for (u32 batch = 1; batch < batches; ++batch) {
+            const u32 survivors = _batchCounts[batch];
+            std::memmove(_visible.data() + visible, _visible.data() + batch * kBatchSize, survivors * sizeof(u32));
+            visible += survivors;
+        }
+        _stats.visible = visible;
+    }
+}  // namespace X::Render
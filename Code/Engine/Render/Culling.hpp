@@ -0,0 +1,52 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#pragma once
+
+#include "EnginePCH.h"
+#include "Math/Bounds.hpp"
+#include "Math/Bvh.hpp"
+
+namespace X::Render {
+
+    struct CullStats {
+        u32 tested {0};
+        u32 visible {0};
+        u32 batches {0};  // Jobs the bounds were split into
+    };
+
+    // Frustum culling stage. Tests struct-of-arrays bounds with the widest SIMD kernel the CPU supports (8 at a time on
+    // AVX2), splits the array across the job system in batches of kBatchSize, and compacts the survivors into one
+    // ascending list of indices, ready to be looked up and submitted to the render queue. The list is owned by the
+    // culler and reused between frames, it stays valid until the next Cull.
+    class FrustumCuller {
+    public:
+        static constexpr u32 kBatchSize = 16 * 1024;
+
+        void Cull(const Math::Frustum& frustum, const Math::SphereSoA& spheres, Core::JobSystem* jobs = nullptr);
+        void Cull(const Math::Frustum& frustum, const Math::AABBSoA& boxes, Core::JobSystem* jobs = nullptr);
+        // Hierarchical path for large, sparse scenes: walks the tree instead of testing every bound, and lists the
+        // visible objects' user data in traversal order rather than ascending. stats.tested counts proxies.
+        void Cull(const Math::Frustum& frustum, const Math::Bvh& bvh);
+
+        const u32* GetVisible() const {
+            return _visible.data();
+        }
+        u32 GetVisibleCount() const {
+            return _stats.visible;
+        }
+        const CullStats& GetStats() const {
+            return _stats;
+        }
+
+    private:
+        template<typename Kernel>
+        void Run(u32 count, Core::JobSystem* jobs, const Kernel& kernel);
+
+        vector<u32> _visible;  // Sized to the largest input seen, only the first _stats.visible entries are valid
+        vector<u32> _batchCounts;
+        CullStats _stats;
+    };
+
+}  // namespace X::Render
@@ -0,0 +1,22 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#pragma once
+
+#include "EnginePCH.h"
+
+namespace X::Render {
+
+    // Renderer settings written by the simulation and consumed when the frame is rendered. Copied into each
+    // FramePacket so the render thread never reads state the simulation is still mutating.
+    struct FrameState {
+        Vec4 clearColor {0.1f, 0.1f, 0.2f, 1.0f};
+        Mat4 view {1.0f};
+        Mat4 projection {1.0f};
+        Vec3 cameraPosition {0.0f};
+        // Largest on-screen error, in pixels, a mesh LOD may introduce. 0 draws every mesh at full detail.
+        f32 lodPixelError {1.0f};
+    };
+
+}  // namespace X::Render
@@ -0,0 +1,172 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include "GpuProfiler.hpp"
+#include "Core/Log.hpp"
+#include "Core/Profiler.hpp"
+
+namespace X::Render {
+    using namespace X::Core;
+
+    bool GpuProfiler::Initialize(IRenderDevice* device, u32 latency) {
+        Shutdown();
+        _device = device;
+
+        const auto& features = device->GetDeviceInfo().Features;
+        _timestamps          = features.TimestampQueries != Diligent::DEVICE_FEATURE_STATE_DISABLED;
+        _pipelineStatistics  = features.PipelineStatisticsQueries != Diligent::DEVICE_FEATURE_STATE_DISABLED;
+
+        if (!_timestamps) {
+            Log::Warn("Timestamp queries are not supported, GPU timings are disabled");
+            return false;
+        }
+
+        _frames.resize(std::max(latency, 2u));
+        _track = Profiler::CreateTrack("GPU");
+
+        Log::Info("GPU profiler initialized ({} frames latency{})",
+                  _frames.size(),
+                  _pipelineStatistics ? ", pipeline statistics" : "");
+        return true;
+    }
+
+    void GpuProfiler::Shutdown() {
+        _frames.clear();
+        _current            = nullptr;
+        _passOpen           = false;
+        _timestamps         = false;
+        _pipelineStatistics = false;
+        _device             = nullptr;
+    }
+
+    void GpuProfiler::BeginFrame(IDeviceContext* context, u64 frameIndex) {
+        if (!_timestamps) return;
+
+        Frame& frame = _frames[frameIndex % _frames.size()];
+        if (frame.pending && !Resolve(frame)) {
+            // Still in flight after a full round of frames, reusing the queries now would stall
+            Discard(frame);
+            ++_droppedFrames;
+        }
+
+        frame.frameIndex = frameIndex;
+        frame.cpuStart   = Profiler::Now();
+        frame.passCount  = 0;
+        frame.pending    = true;
+
+        if (_pipelineStatistics) {
+            if (!frame.pipelineStats) { frame.pipelineStats = CreateQuery(Diligent::QUERY_TYPE_PIPELINE_STATISTICS); }
+            if (frame.pipelineStats) { context->BeginQuery(frame.pipelineStats); }
+        }
+        _current = &frame;
+    }
+
+    void GpuProfiler::EndFrame(IDeviceContext* context) {
+        if (!_current) return;
+
+        EndPass(context);
+        if (_current->pipelineStats) { context->EndQuery(_current->pipelineStats); }
+        _current = nullptr;
+    }
+
+    void GpuProfiler::BeginPass(IDeviceContext* context, const char* name) {
+        if (!_current) return;
+
+        EndPass(context);
+        if (_current->passCount >= kMaxPassesPerFrame) return;
+
+        Pass& pass = _current->passes[_current->passCount];
+        if (!pass.begin) { pass.begin = CreateQuery(Diligent::QUERY_TYPE_TIMESTAMP); }
+        if (!pass.end) { pass.end = CreateQuery(Diligent::QUERY_TYPE_TIMESTAMP); }
+        if (!pass.begin || !pass.end) return;
+
+        // Timestamp queries are only ever ended
+        pass.name = name;
+        context->EndQuery(pass.begin);
+        _passOpen = true;
+    }
+
+    void GpuProfiler::EndPass(IDeviceContext* context) {
+        if (!_current || !_passOpen) return;
+
+        context->EndQuery(_current->passes[_current->passCount].end);
+        ++_current->passCount;
+        _passOpen = false;
+    }
+
+    RefCntAutoPtr<Diligent::IQuery> GpuProfiler::CreateQuery(Diligent::QUERY_TYPE type) const {
+        Diligent::QueryDesc desc;
+        desc.Name = "GPU profiler query";
+        desc.Type = type;
+
+        RefCntAutoPtr<Diligent::IQuery> query;
+        _device->CreateQuery(desc, &query);
+        return query;
+    }
+
+    bool GpuProfiler::Resolve(Frame& frame) {
+        if (frame.passCount == 0) {
+            Discard(frame);
+            return true;
+        }
+
+        // Peek without invalidating so a partially ready frame can be retried or dropped as a whole
+        array<Diligent::QueryDataTimestamp, kMaxPassesPerFrame> begins;
+        array<Diligent::QueryDataTimestamp, kMaxPassesPerFrame> ends;
+        for (u32 i = 0; i < frame.passCount; ++i) {
+            if (!frame.passes[i].begin->GetData(&begins[i], sizeof(begins[i]), false)) return false;
+            if (!frame.passes[i].end->GetData(&ends[i], sizeof(ends[i]), false)) return false;
+        }
+
+        Diligent::QueryDataPipelineStatistics pipeline;
+        const bool hasPipelineStats =
+          frame.pipelineStats && frame.pipelineStats->GetData(&pipeline, sizeof(pipeline), false);
+
+        const u64 frequency  = std::max<u64>(begins[0].Frequency, 1);
+        const auto toMs      = [frequency](u64 ticks) { return CAST<f64>(ticks) * 1000.0 / CAST<f64>(frequency); };
+        const u64 frameStart = begins[0].Counter;
+
+        GpuFrameStats stats;
+        stats.frameIndex = frame.frameIndex;
+        stats.passes.reserve(frame.passCount);
+        for (u32 i = 0; i < frame.passCount; ++i) {
+            const u64 begin = begins[i].Counter;
+            const u64 end   = std::max(ends[i].Counter, begin);
+            stats.passes.push_back({frame.passes[i].name, toMs(end - begin)});
+
+            // GPU and CPU clocks are not synchronized, so GPU zones are placed relative to the CPU time the frame
+            // started recording. They line up with the frame that issued them, not with exact wall time.
+            if (Profiler::IsCapturing()) {
+                const u64 start = frame.cpuStart + Profiler::NanosecondsToTicks(toMs(begin - frameStart) * 1.0e6);
+                const u64 stop  = start + Profiler::NanosecondsToTicks(toMs(end - begin) * 1.0e6);
+                Profiler::RecordOnTrack(_track, frame.passes[i].name, start, stop);
+            }
+        }
+        stats.frameMilliseconds = toMs(std::max(ends[frame.passCount - 1].Counter, frameStart) - frameStart);
+
+        if (hasPipelineStats) {
+            stats.hasPipelineStats             = true;
+            stats.pipeline.inputVertices       = pipeline.InputVertices;
+            stats.pipeline.inputPrimitives     = pipeline.InputPrimitives;
+            stats.pipeline.vertexInvocations   = pipeline.VSInvocations;
+            stats.pipeline.clippingInvocations = pipeline.ClippingInvocations;
+            stats.pipeline.clippingPrimitives  = pipeline.ClippingPrimitives;
+            stats.pipeline.pixelInvocations    = pipeline.PSInvocations;
+        }
+
+        _stats = std::move(stats);
+        Discard(frame);
+        return true;
+    }
+
+    void GpuProfiler::Discard(Frame& frame) {
+        for (u32 i = 0; i < frame.passCount; ++i) {
+            frame.passes[i].begin->Invalidate();
+            frame.passes[i].end->Invalidate();
+        }
+        if (frame.pipelineStats) { frame.pipelineStats->Invalidate(); }
+        frame.passCount = 0;
+        frame.pending   = false;
+    }
+}  // namespace X::Render
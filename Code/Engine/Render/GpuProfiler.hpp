@@ -0,0 +1,96 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#pragma once
+
+#include "EnginePCH.h"
+#include "Core/Profiler.hpp"
+
+namespace X::Render {
+
+    struct GpuPassTiming {
+        const char* name {nullptr};
+        f64 milliseconds {0.0};
+    };
+
+    struct GpuPipelineStats {
+        u64 inputVertices {0};
+        u64 inputPrimitives {0};
+        u64 vertexInvocations {0};
+        u64 clippingInvocations {0};
+        u64 clippingPrimitives {0};
+        u64 pixelInvocations {0};
+    };
+
+    // GPU results for one frame, available a few frames after it was submitted
+    struct GpuFrameStats {
+        u64 frameIndex {0};
+        f64 frameMilliseconds {0.0};  // First pass start to last pass end
+        vector<GpuPassTiming> passes;
+        GpuPipelineStats pipeline;
+        bool hasPipelineStats {false};
+    };
+
+    // Times named passes with timestamp queries and counts the whole frame with a pipeline statistics query. Each
+    // frame uses its own set of queries, read back latency frames later with GetData, so the CPU never waits on the
+    // GPU. Results that are still not ready by then are dropped. Immediate context only.
+    class GpuProfiler {
+    public:
+        static constexpr u32 kMaxPassesPerFrame = 32;
+
+        bool Initialize(IRenderDevice* device, u32 latency);
+        void Shutdown();
+
+        bool IsSupported() const {
+            return _timestamps;
+        }
+
+        // Reads back the oldest frame and starts recording into its queries
+        void BeginFrame(IDeviceContext* context, u64 frameIndex);
+        void EndFrame(IDeviceContext* context);
+
+        // Pass names must outlive the profiler, use string literals. Passes do not nest.
+        void BeginPass(IDeviceContext* context, const char* name);
+        void EndPass(IDeviceContext* context);
+
+        // Latest frame whose results have come back
+        const GpuFrameStats& GetStats() const {
+            return _stats;
+        }
+        u64 GetDroppedFrames() const {
+            return _droppedFrames;
+        }
+
+    private:
+        struct Pass {
+            const char* name {nullptr};
+            RefCntAutoPtr<Diligent::IQuery> begin;
+            RefCntAutoPtr<Diligent::IQuery> end;
+        };
+
+        struct Frame {
+            u64 frameIndex {0};
+            u64 cpuStart {0};  // Profiler ticks at BeginFrame, used to place GPU zones on the CPU timeline
+            bool pending {false};
+            u32 passCount {0};
+            array<Pass, kMaxPassesPerFrame> passes;
+            RefCntAutoPtr<Diligent::IQuery> pipelineStats;
+        };
+
+        RefCntAutoPtr<Diligent::IQuery> CreateQuery(Diligent::QUERY_TYPE type) const;
+        bool Resolve(Frame& frame);
+        void Discard(Frame& frame);
+
+        IRenderDevice* _device {nullptr};
+        vector<Frame> _frames;
+        Frame* _current {nullptr};
+        bool _passOpen {false};
+        bool _timestamps {false};
+        bool _pipelineStatistics {false};
+        Core::ProfileTrack* _track {nullptr};
+        GpuFrameStats _stats;
+        u64 _droppedFrames {0};
+    };
+
+}  // namespace X::Render
@@ -0,0 +1,222 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include "GpuRingBuffer.hpp"
+#include "Core/Log.hpp"
+
+namespace X::Render {
+    using namespace X::Core;
+
+    namespace {
+        u64 AlignUp(u64 value, u64 alignment) {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+    }  // namespace
+
+    GpuRingBuffer::~GpuRingBuffer() {
+        Shutdown();
+    }
+
+    bool GpuRingBuffer::Initialize(IRenderDevice* device,
+                                   IDeviceContext* context,
+                                   const char* name,
+                                   Diligent::BIND_FLAGS bindFlags,
+                                   u64 frameSize,
+                                   u32 framesInFlight) {
+        Shutdown();
+
+        const auto& adapter = device->GetAdapterInfo();
+        _minAlignment       = 16;
+        if (bindFlags & Diligent::BIND_UNIFORM_BUFFER) {
+            _minAlignment = std::max<u64>(adapter.Buffer.ConstantBufferOffsetAlignment, 16);
+        }
+
+        framesInFlight = std::max(framesInFlight, 1u);
+        _frameSize     = AlignUp(frameSize, _minAlignment);
+        _readState     = (bindFlags & Diligent::BIND_UNIFORM_BUFFER) ? Diligent::RESOURCE_STATE_CONSTANT_BUFFER
+                                                                     : Diligent::RESOURCE_STATE_VERTEX_BUFFER;
+
+        const bool cpuWritable = (adapter.Memory.UnifiedMemoryCPUAccess & Diligent::CPU_ACCESS_WRITE) != 0;
+        if (cpuWritable && adapter.Memory.UnifiedMemory >= _frameSize * framesInFlight) {
+            _mode = Mode::Unified;
+        } else {
+            _mode = device->GetDeviceInfo().IsGLDevice() ? Mode::Update : Mode::Staging;
+        }
+
+        Diligent::BufferDesc desc;
+        desc.Name      = name;
+        desc.BindFlags = bindFlags;
+        desc.Size      = _frameSize;
+        if (_mode == Mode::Unified) {
+            desc.Usage          = Diligent::USAGE_UNIFIED;
+            desc.CPUAccessFlags = Diligent::CPU_ACCESS_WRITE;
+        } else {
+            desc.Usage = Diligent::USAGE_DEFAULT;
+        }
+
+        Diligent::BufferDesc stagingDesc;
+        stagingDesc.Name           = name;
+        stagingDesc.Size           = _frameSize;
+        stagingDesc.Usage          = Diligent::USAGE_STAGING;
+        stagingDesc.CPUAccessFlags = Diligent::CPU_ACCESS_WRITE;
+
+        _frames.resize(framesInFlight);
+        for (Frame& frame : _frames) {
+            device->CreateBuffer(desc, nullptr, &frame.buffer);
+            if (_mode == Mode::Staging) { device->CreateBuffer(stagingDesc, nullptr, &frame.staging); }
+            if (!frame.buffer || (_mode == Mode::Staging && !frame.staging)) {
+                Log::Error("Failed to create {} ({} bytes)", name, _frameSize);
+                Shutdown();
+                return false;
+            }
+
+            if (_mode != Mode::Update) {
+                // Unified and staging buffers stay mapped for their whole lifetime
+                IBuffer* mappable = _mode == Mode::Unified ? frame.buffer : frame.staging;
+                void* data        = nullptr;
+                context->MapBuffer(mappable, Diligent::MAP_WRITE, Diligent::MAP_FLAG_NONE, data);
+                frame.mapped = CAST<u8*>(data);
+                if (!frame.mapped) {
+                    Log::Error("Failed to map {}", name);
+                    Shutdown();
+                    return false;
+                }
+            }
+        }
+
+        Diligent::FenceDesc fenceDesc;
+        fenceDesc.Name = name;
+        fenceDesc.Type = Diligent::FENCE_TYPE_CPU_WAIT_ONLY;
+        device->CreateFence(fenceDesc, &_fence);
+        if (!_fence) {
+            Log::Error("Failed to create fence for {}", name);
+            Shutdown();
+            return false;
+        }
+
+        if (_mode == Mode::Update) { _shadow.resize(_frameSize); }
+
+        // Start on the last region so the first BeginFrame lands on region 0
+        _frameIndex = CAST<u32>(_frames.size()) - 1;
+
+        constexpr const char* kModeNames[] = {"persistently mapped", "staged", "updated"};
+        Log::Info("Created {}: {} KB x {} ({})", name, _frameSize / 1024, _frames.size(), kModeNames[CAST<u32>(_mode)]);
+        return true;
+    }
+
+    void GpuRingBuffer::Shutdown() {
+        // Mapped buffers are released directly, the device unmaps them on destruction
+        _frames.clear();
+        _shadow.clear();
+        _shadow.shrink_to_fit();
+        _fence.Release();
+        _fenceValue = 0;
+        _head.store(0, std::memory_order_relaxed);
+        _flushed = 0;
+    }
+
+    void GpuRingBuffer::BeginFrame() {
+        if (_frames.empty()) return;
+
+        _peak       = std::max(_peak, _head.load(std::memory_order_relaxed));
+        _frameIndex = (_frameIndex + 1) % CAST<u32>(_frames.size());
+
+        Frame& frame = _frames[_frameIndex];
+        if (_fence && frame.fenceValue > _fence->GetCompletedValue()) {
+            _fence->Wait(frame.fenceValue);
+            ++_fenceWaits;
+        }
+
+        _head.store(0, std::memory_order_relaxed);
+        _flushed = 0;
+    }
+
+    void GpuRingBuffer::Flush(IDeviceContext* context) {
+        if (_frames.empty()) return;
+
+        const u64 head = std::min(_head.load(std::memory_order_acquire), _frameSize);
+        if (head <= _flushed) return;
+
+        Frame& frame = _frames[_frameIndex];
+        switch (_mode) {
+            case Mode::Unified:
+                // No-op on coherent memory
+                frame.buffer->FlushMappedRange(_flushed, head - _flushed);
+                break;
+            case Mode::Staging:
+                frame.staging->FlushMappedRange(_flushed, head - _flushed);
+                context->CopyBuffer(frame.staging,
+                                    _flushed,
+                                    Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                                    frame.buffer,
+                                    _flushed,
+                                    head - _flushed,
+                                    Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+                break;
+            case Mode::Update:
+                context->UpdateBuffer(frame.buffer,
+                                      _flushed,
+                                      head - _flushed,
+                                      _shadow.data() + _flushed,
+                                      Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+                break;
+        }
+
+        if (_mode != Mode::Unified) {
+            // Deferred contexts only verify states, so hand the buffer back in the state its draws expect
+            const Diligent::StateTransitionDesc barrier(frame.buffer,
+                                                        Diligent::RESOURCE_STATE_UNKNOWN,
+                                                        _readState,
+                                                        Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE);
+            context->TransitionResourceStates(1, &barrier);
+        }
+        _flushed = head;
+    }
+
+    void GpuRingBuffer::EndFrame(IDeviceContext* context) {
+        if (!_fence) return;
+
+        Frame& frame     = _frames[_frameIndex];
+        frame.fenceValue = ++_fenceValue;
+        context->EnqueueSignal(_fence, frame.fenceValue);
+    }
+
+    GpuAllocation GpuRingBuffer::Allocate(u64 size, u64 alignment) {
+        if (_frames.empty() || size == 0) return {};
+
+        alignment  = std::max(alignment, _minAlignment);
+        u64 head   = _head.load(std::memory_order_relaxed);
+        u64 offset = 0;
+        do {
+            offset = AlignUp(head, alignment);
+            if (offset + size > _frameSize) {
+                _failedAllocations.fetch_add(1, std::memory_order_relaxed);
+                return {};
+            }
+        } while (!_head.compare_exchange_weak(head, offset + size, std::memory_order_acq_rel));
+
+        GpuAllocation allocation;
+        allocation.buffer = _frames[_frameIndex].buffer;
+        allocation.offset = offset;
+        allocation.size   = size;
+        allocation.data   = GetCurrentBase() + offset;
+        return allocation;
+    }
+
+    u64 GpuRingBuffer::GetAvailable(u64 alignment) const {
+        alignment         = std::max(alignment, _minAlignment);
+        const u64 aligned = AlignUp(_head.load(std::memory_order_relaxed), alignment);
+        return aligned < _frameSize ? _frameSize - aligned : 0;
+    }
+
+    GpuRingStats GpuRingBuffer::GetStats() const {
+        GpuRingStats stats;
+        stats.capacity          = _frameSize;
+        stats.used              = _head.load(std::memory_order_relaxed);
+        stats.peak              = std::max(_peak, stats.used);
+        stats.failedAllocations = _failedAllocations.load(std::memory_order_relaxed);
+        stats.fenceWaits        = _fenceWaits;
+        return stats;
+    }
+}  // namespace X::Render
@@ -0,0 +1,121 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#pragma once
+
+#include "EnginePCH.h"
+
+#include <atomic>
+
+namespace X::Render {
+
+    // A sub-range of a ring buffer valid until the end of the frame it was allocated in. Write through data, then
+    // bind buffer at offset (SetVertexBuffers offset, or SetBufferRange for constant buffers).
+    struct GpuAllocation {
+        IBuffer* buffer {nullptr};
+        u64 offset {0};
+        u64 size {0};
+        void* data {nullptr};
+
+        explicit operator bool() const {
+            return data != nullptr;
+        }
+    };
+
+    struct GpuRingStats {
+        u64 capacity {0};           // Bytes per frame
+        u64 used {0};               // Bytes allocated in the current frame
+        u64 peak {0};               // Highest per-frame usage seen
+        u64 failedAllocations {0};  // Allocations that did not fit
+        u64 fenceWaits {0};         // Times BeginFrame blocked on the GPU
+    };
+
+    // Frame-lifetime allocator for dynamic GPU data. Each frame in flight owns one region that is sub-allocated with
+    // an atomic bump pointer, so any thread can allocate, and a fence keeps the CPU from reusing a region the GPU is
+    // still reading. How writes reach the region depends on the adapter:
+    //   Unified  CPU-writable unified memory: the regions are persistently mapped buffers read by the GPU directly.
+    //   Staging  Everything else but GL: each region is a default-usage buffer filled by Flush from a persistently
+    //            mapped staging buffer of its own, copying only what was allocated since the last Flush.
+    //   Update   GL, which cannot copy out of a mapped buffer: writes land in a CPU shadow copy and Flush uploads the
+    //            new range with UpdateBuffer.
+    // No mode goes through the dynamic heap, so the region's buffer binds on deferred contexts as well.
+    class GpuRingBuffer {
+    public:
+        GpuRingBuffer() = default;
+        ~GpuRingBuffer();
+
+        GpuRingBuffer(const GpuRingBuffer&)            = delete;
+        GpuRingBuffer& operator=(const GpuRingBuffer&) = delete;
+
+        bool Initialize(IRenderDevice* device,
+                        IDeviceContext* context,
+                        const char* name,
+                        Diligent::BIND_FLAGS bindFlags,
+                        u64 frameSize,
+                        u32 framesInFlight);
+        void Shutdown();
+
+        // Moves to the next frame's region, waiting for the GPU if it is still in use, and resets the bump pointer
+        void BeginFrame();
+        // Makes everything allocated since the last call visible to the GPU and leaves the region's buffer in its
+        // read state. Call on the immediate context before recording the draws that read it, including command lists
+        // executed later; allocating and flushing again later in the frame is fine.
+        void Flush(IDeviceContext* context);
+        // Signals the region's fence once the GPU has consumed the frame
+        void EndFrame(IDeviceContext* context);
+
+        // Alignment is raised to the buffer's minimum (the constant buffer offset alignment for uniform rings).
+        // Returns an empty allocation when the frame's region is exhausted.
+        GpuAllocation Allocate(u64 size, u64 alignment = 16);
+
+        template<typename T>
+        T* Allocate(u32 count, GpuAllocation& allocation) {
+            allocation = Allocate(CAST<u64>(count) * sizeof(T), alignof(T));
+            return CAST<T*>(allocation.data);
+        }
+
+        // Bytes still available this frame for an allocation with the given alignment
+        u64 GetAvailable(u64 alignment = 16) const;
+
+        enum class Mode { Unified, Staging, Update };
+
+        Mode GetMode() const {
+            return _mode;
+        }
+        u64 GetMinAlignment() const {
+            return _minAlignment;
+        }
+        GpuRingStats GetStats() const;
+
+    private:
+        struct Frame {
+            RefCntAutoPtr<IBuffer> buffer;   // Bound by draws
+            RefCntAutoPtr<IBuffer> staging;  // Staging mode only
+            u8* mapped {nullptr};            // The unified or staging buffer, mapped for its whole lifetime
+            u64 fenceValue {0};
+        };
+
+        u8* GetCurrentBase() {
+            return _mode == Mode::Update ? _shadow.data() : _frames[_frameIndex].mapped;
+        }
+
+        vector<Frame> _frames;
+        vector<u8> _shadow;
+        RefCntAutoPtr<Diligent::IFence> _fence;
+        u64 _fenceValue {0};
+        u32 _frameIndex {0};
+        u64 _frameSize {0};
+        u64 _minAlignment {16};
+        Mode _mode {Mode::Unified};
+        Diligent::RESOURCE_STATE _readState {Diligent::RESOURCE_STATE_UNKNOWN};
+
+        std::atomic<u64> _head {0};
+        u64 _flushed {0};
+
+        u64 _peak {0};
+        std::atomic<u64> _failedAllocations {0};
+        u64 _fenceWaits {0};
+    };
+
+}  // namespace X::Render
@@ -0,0 +1,34 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include "InstanceData.hpp"
+
+namespace X::Render {
+    void InstanceData::AppendLayoutElements(vector<Diligent::LayoutElement>& layout,
+                                            u32 firstAttribute,
+                                            u32 bufferSlot,
+                                            bool materialIndex) {
+        // The stride is spelled out, layouts that skip the material index would otherwise infer a shorter one
+        for (u32 column = 0; column < 4; ++column) {
+            layout.emplace_back(firstAttribute + column,
+                                bufferSlot,
+                                4u,
+                                Diligent::VT_FLOAT32,
+                                false,
+                                CAST<u32>(offsetof(InstanceData, world) + column * sizeof(Vec4)),
+                                CAST<u32>(sizeof(InstanceData)),
+                                Diligent::INPUT_ELEMENT_FREQUENCY_PER_INSTANCE);
+        }
+        if (materialIndex) {
+            layout.emplace_back(firstAttribute + 4,
+                                bufferSlot,
+                                1u,
+                                Diligent::VT_UINT32,
+                                false,
+                                CAST<u32>(offsetof(InstanceData, material)),
+                                CAST<u32>(sizeof(InstanceData)),
+                                Diligent::INPUT_ELEMENT_FREQUENCY_PER_INSTANCE);
+        }
+    }
+}  // namespace X::Render
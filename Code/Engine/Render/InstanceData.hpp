@@ -0,0 +1,29 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#pragma once
+
+#include "EnginePCH.h"
+
+namespace X::Render {
+
+    // Per-instance vertex stream read by every material. The world matrix arrives as four float4 attributes,
+    // followed by the material's index into its template's parameter buffer, which bindless materials read to find
+    // their textures and constants. The render queue writes it into the device's vertex ring each frame and binds it
+    // in the slot after the mesh's vertex streams, kBufferSlot for an interleaved mesh.
+    struct InstanceData {
+        static constexpr u32 kBufferSlot = 1;
+
+        // Appends the per-instance world matrix attributes, starting at firstAttribute, to a material's input layout.
+        // With materialIndex the index follows as a uint attribute at firstAttribute + 4.
+        static void AppendLayoutElements(vector<Diligent::LayoutElement>& layout,
+                                         u32 firstAttribute,
+                                         u32 bufferSlot     = kBufferSlot,
+                                         bool materialIndex = false);
+
+        Mat4 world;
+        u32 material {0};
+    };
+
+}  // namespace X::Render
@@ -3,7 +3,624 @@
 //
 
 #include "Material.hpp"
+#include "PipelineCache.hpp"
+#include "RenderDevice.hpp"
+#include "Core/Log.hpp"
+#include "Core/Profiler.hpp"
 
-namespace X {
-    namespace Render {}  // namespace Render
-}  // namespace X
\ No newline at end of file
+#include <mutex>
+
+namespace X::Render {
+    using namespace X::Core;
+
+    namespace {
+        constexpr u32 kMaxPipelineIds         = 0xFFF;  // Width of the render queue's pipeline field
+        constexpr const char* kTexturesName   = "MaterialTextures";
+        constexpr const char* kParametersName = "MaterialParameters";
+
+        u32 AlignTo16(u32 size) {
+            return (size + 15) & ~15u;
+        }
+
+        // Pipeline ids by pipeline state, and the material ids handed out under each pipeline id
+        struct IdRegistry {
+            std::mutex lock;
+            unordered_map<IPipelineState*, u32> pipelines;
+            vector<u32> nextMaterial;           // By pipeline id
+            vector<vector<u32>> freeMaterials;  // By pipeline id
+        };
+
+        IdRegistry& GetIdRegistry() {
+            static IdRegistry registry;
+            return registry;
+        }
+
+        u32 RegisterPipeline(IPipelineState* pipelineState) {
+            if (!pipelineState) return 0;
+
+            IdRegistry& registry = GetIdRegistry();
+            std::lock_guard guard(registry.lock);
+            const auto [it, inserted] =
+              registry.pipelines.try_emplace(pipelineState, CAST<u32>(registry.pipelines.size() + 1));
+            if (inserted && it->second == kMaxPipelineIds + 1) {
+                Log::Warn("More than {} pipeline states, render queue sort keys will alias", kMaxPipelineIds);
+            }
+            return it->second;
+        }
+
+        u32 AllocateMaterialId(u32 pipelineId) {
+            IdRegistry& registry = GetIdRegistry();
+            std::lock_guard guard(registry.lock);
+            if (pipelineId >= registry.nextMaterial.size()) {
+                registry.nextMaterial.resize(pipelineId + 1, 1);
+                registry.freeMaterials.resize(pipelineId + 1);
+            }
+
+            vector<u32>& freeIds = registry.freeMaterials[pipelineId];
+            if (freeIds.empty()) return registry.nextMaterial[pipelineId]++;
+            const u32 id = freeIds.back();
+            freeIds.pop_back();
+            return id;
+        }
+
+        void FreeMaterialId(u32 pipelineId, u32 id) {
+            IdRegistry& registry = GetIdRegistry();
+            std::lock_guard guard(registry.lock);
+            if (pipelineId < registry.freeMaterials.size()) { registry.freeMaterials[pipelineId].push_back(id); }
+        }
+
+        // Merged variables answer to either stage
+        Diligent::IShaderResourceVariable* FindVariable(IShaderResourceBinding* binding, const str& name) {
+            for (const Diligent::SHADER_TYPE stage : {Diligent::SHADER_TYPE_PIXEL, Diligent::SHADER_TYPE_VERTEX}) {
+                if (auto* variable = binding->GetVariableByName(stage, name.c_str())) return variable;
+            }
+            return nullptr;
+        }
+    }  // namespace
+
+    Material::Material(RefCntAutoPtr<IPipelineState> pipelineState,
+                       RefCntAutoPtr<IShaderResourceBinding> resourceBinding)
+        : _pipelineState(std::move(pipelineState)), _resourceBinding(std::move(resourceBinding)),
+          _pipelineId(RegisterPipeline(_pipelineState)), _id(AllocateMaterialId(_pipelineId)) {}
+
+    size_t MaterialDescHash::operator()(const MaterialDesc& desc) const {
+        // FNV-1a over the features, each resource's name and object, then the constants
+        u64 hash         = 0xCBF29CE484222325ull;
+        const auto bytes = [&hash](const void* data, size_t size) {
+            for (size_t i = 0; i < size; ++i) {
+                hash ^= CAST<const u8*>(data)[i];
+                hash *= 0x100000001B3ull;
+            }
+        };
+
+        bytes(&desc.features, sizeof(desc.features));
+        for (const MaterialResource& resource : desc.resources) {
+            bytes(resource.name.data(), resource.name.size() + 1);
+            bytes(&resource.object, sizeof(resource.object));
+        }
+        bytes(desc.constants.data(), desc.constants.size());
+        return CAST<size_t>(hash);
+    }
+
+    MaterialTemplate::~MaterialTemplate() {
+        Shutdown();
+    }
+
+    bool MaterialTemplate::Initialize(RenderDevice& device, MaterialTemplateDesc desc) {
+        if (!device.GetPipelineCache()) {
+            Log::Error("Material template {} requires an initialized render device", desc.name);
+            return false;
+        }
+        if (desc.vertexShader.empty() || desc.pixelShader.empty()) {
+            Log::Error("Material template {} is missing a shader", desc.name);
+            return false;
+        }
+        if (desc.features.size() > 32) {
+            Log::Error("Material template {} has {} features, at most 32 are supported",
+                       desc.name,
+                       desc.features.size());
+            return false;
+        }
+
+        _device               = &device;
+        _desc                 = std::move(desc);
+        _desc.maxPermutations = std::max(_desc.maxPermutations, 1u);
+        _desc.bindingBatch    = std::max(_desc.bindingBatch, 1u);
+        _featureMask          = _desc.features.size() == 32 ? ~0u : (1u << _desc.features.size()) - 1;
+        _textureCount         = std::to_string(std::max(_desc.textureCapacity, 1u));
+
+        if (_desc.bindless && !device.SupportsBindless()) {
+            Log::Info("Material template {} binds per material, {} has no bindless support",
+                      _desc.name,
+                      device.GetAPIName());
+        }
+        _bindless = _desc.bindless && device.SupportsBindless();
+        if (_bindless && !InitializeBindless()) {
+            Shutdown();
+            return false;
+        }
+        _stats.bindless = _bindless;
+        return true;
+    }
+
+    void MaterialTemplate::Shutdown() {
+        if (!_device) return;
+
+        if (!_materials.empty()) {
+            Log::Warn("Material template {} shut down with {} materials still acquired", _desc.name, _materials.size());
+        }
+        for (const auto& [desc, material] : _materials) {
+            if (!material->_bindless) { FreeMaterialId(material->_pipelineId, material->_id); }
+        }
+        for (const auto& [features, permutation] : _permutations) {
+            if (permutation.sharedId != 0) { FreeMaterialId(permutation.pipelineId, permutation.sharedId); }
+        }
+        _materials.clear();
+        _permutations.clear();
+
+        _bindless = false;
+        _parameters.Release();
+        _freeRecords.clear();
+        _defaultTexture = {};
+        _textureTable.clear();
+        _textureSlots.clear();
+        _freeTextureSlots.clear();
+        _tableVersion = 0;
+
+        _stats  = {};
+        _device = nullptr;
+    }
+
+    u32 MaterialTemplate::GetFeature(strview name) const {
+        for (u32 bit = 0; bit < CAST<u32>(_desc.features.size()); ++bit) {
+            if (_desc.features[bit] == name) return 1u << bit;
+        }
+        Log::Warn("Material template {} has no feature {}", _desc.name, name);
+        return 0;
+    }
+
+    bool MaterialTemplate::Prewarm(const vector<u32>& features) {
+        if (!_device) return false;
+
+        PROFILE_SCOPE("MaterialTemplate::Prewarm");
+        bool built = true;
+        for (const u32 mask : features) {
+            if (!GetPermutation(mask & _featureMask)) { built = false; }
+        }
+        return built;
+    }
+
+    const Material* MaterialTemplate::Acquire(const MaterialDesc& desc) {
+        if (!_device) {
+            Log::Error("Material template {} is not initialized", _desc.name);
+            return nullptr;
+        }
+
+        MaterialDesc key = desc;
+        key.features &= _featureMask;
+        if (const auto it = _materials.find(key); it != _materials.end()) {
+            ++it->second->_references;
+            ++_stats.sharedMaterials;
+            return it->second.get();
+        }
+
+        Permutation* permutation = GetPermutation(key.features);
+        if (!permutation) return nullptr;
+
+        unique_ptr<Material> material;
+        if (_bindless) {
+            material                   = make_unique<Material>();
+            material->_pipelineState   = permutation->pipeline;
+            material->_resourceBinding = permutation->sharedBinding;
+            material->_pipelineId      = permutation->pipelineId;
+            material->_id              = permutation->sharedId;
+            material->_template        = this;
+            material->_features        = key.features;
+            if (!WriteParameters(*material, key)) return nullptr;
+        } else {
+            RefCntAutoPtr<IShaderResourceBinding> binding = AllocateBinding(*permutation);
+            if (!binding) return nullptr;
+
+            material            = make_unique<Material>(permutation->pipeline, std::move(binding));
+            material->_template = this;
+            material->_features = key.features;
+            if (!BindResources(*material, key)) {
+                RetireBinding(*permutation, *material, key);
+                return nullptr;
+            }
+        }
+
+        const auto [it, inserted] = _materials.emplace(std::move(key), std::move(material));
+        Material& created         = *it->second;
+        created._desc             = &it->first;
+        created._references       = 1;
+        ++_stats.materials;
+        return &created;
+    }
+
+    void MaterialTemplate::Release(const Material* material) {
+        if (!material) return;
+        if (material->_template != this) {
+            Log::Error("Material released to template {}, which does not own it", _desc.name);
+            return;
+        }
+
+        Material& owned = *CCAST<Material*>(material);
+        if (--owned._references > 0) return;
+
+        const auto it = _materials.find(*owned._desc);
+        if (owned._bindless) {
+            // The record is only rewritten through UpdateBuffer, which the GPU sees after every earlier draw
+            for (const MaterialResource& resource : it->first.resources) {
+                ReleaseTexture(resource.object);
+            }
+            _freeRecords.push_back(owned._parameterIndex);
+        } else {
+            RetireBinding(_permutations.at(owned._features), owned, it->first);
+        }
+        _materials.erase(it);
+        --_stats.materials;
+    }
+
+    void MaterialTemplate::Update() {
+        if (!_bindless) return;
+
+        bool rebuilt = false;
+        for (auto& [features, permutation] : _permutations) {
+            if (permutation.tableVersion == _tableVersion) continue;
+
+            RefCntAutoPtr<IShaderResourceBinding> binding = CreateSharedBinding(permutation);
+            if (!binding) continue;
+
+            // Frames in flight may still draw with the old binding, it is reused once they have retired
+            RetiredBinding retired;
+            retired.binding = std::move(permutation.sharedBinding);
+            retired.frame   = _device->GetPresentedFrames();
+            permutation.retiredBindings.push_back(std::move(retired));
+            ++_stats.pooledBindings;
+
+            permutation.sharedBinding = std::move(binding);
+            rebuilt                   = true;
+        }
+        if (!rebuilt) return;
+
+        ++_stats.tableUpdates;
+        for (const auto& [desc, material] : _materials) {
+            material->_resourceBinding = _permutations.at(material->_features).sharedBinding;
+        }
+    }
+
+    MaterialTemplate::Permutation* MaterialTemplate::GetPermutation(u32 features) {
+        if (const auto it = _permutations.find(features); it != _permutations.end()) return &it->second;
+
+        if (_permutations.size() >= _desc.maxPermutations) {
+            ++_stats.rejectedPermutations;
+            Log::Error("Material template {} is at its limit of {} permutations, cannot add features {:#x}",
+                       _desc.name,
+                       _desc.maxPermutations,
+                       features);
+            return nullptr;
+        }
+
+        PROFILE_SCOPE("MaterialTemplate::GetPermutation");
+        const RefCntAutoPtr<IShader> vertex =
+          CreateShader(Diligent::SHADER_TYPE_VERTEX, _desc.vertexShader, features & _desc.vertexFeatures);
+        const RefCntAutoPtr<IShader> pixel = CreateShader(Diligent::SHADER_TYPE_PIXEL, _desc.pixelShader, features);
+        if (!vertex || !pixel) return nullptr;
+
+        vector<Diligent::ShaderResourceVariableDesc> variables;
+        for (const MaterialVariable& variable : _desc.variables) {
+            variables.push_back({variable.stages, variable.name.c_str(), variable.type});
+        }
+        vector<Diligent::ImmutableSamplerDesc> samplers;
+        for (const MaterialSampler& sampler : _desc.samplers) {
+            samplers.push_back({sampler.stages, sampler.texture.c_str(), sampler.desc});
+        }
+
+        const str name = fmt::format("{} {:#x}", _desc.name, features);
+        Diligent::GraphicsPipelineStateCreateInfo createInfo;
+        createInfo.PSODesc.Name                     = name.c_str();
+        createInfo.PSODesc.SRBAllocationGranularity = _desc.bindingBatch;
+        createInfo.pVS                              = vertex;
+        createInfo.pPS                              = pixel;
+
+        Diligent::PipelineResourceLayoutDesc& layout = createInfo.PSODesc.ResourceLayout;
+        layout.DefaultVariableType                   = Diligent::SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE;
+        layout.DefaultVariableMergeStages            = Diligent::SHADER_TYPE_VS_PS;
+        layout.Variables                             = variables.data();
+        layout.NumVariables                          = CAST<u32>(variables.size());
+        layout.ImmutableSamplers                     = samplers.data();
+        layout.NumImmutableSamplers                  = CAST<u32>(samplers.size());
+
+        Diligent::GraphicsPipelineDesc& graphics = createInfo.GraphicsPipeline;
+        graphics.NumRenderTargets                = 1;
+        graphics.RTVFormats[0]                   = _desc.colorFormat;
+        graphics.DSVFormat                       = _desc.depthFormat;
+        graphics.PrimitiveTopology               = Diligent::PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+        graphics.BlendDesc                       = _desc.blend;
+        graphics.RasterizerDesc                  = _desc.rasterizer;
+        graphics.DepthStencilDesc                = _desc.depthStencil;
+        graphics.InputLayout.LayoutElements      = _desc.inputLayout.data();
+        graphics.InputLayout.NumElements         = CAST<u32>(_desc.inputLayout.size());
+
+        RefCntAutoPtr<IPipelineState> pipeline = _device->GetPipelineCache()->CreateGraphicsPipeline(createInfo);
+        if (!pipeline) return nullptr;
+
+        Permutation permutation;
+        permutation.pipelineId = RegisterPipeline(pipeline);
+        permutation.pipeline   = std::move(pipeline);
+        if (_bindless) {
+            permutation.sharedBinding = CreateSharedBinding(permutation);
+            if (!permutation.sharedBinding) return nullptr;
+            permutation.sharedId = AllocateMaterialId(permutation.pipelineId);
+        }
+
+        ++_stats.permutations;
+        return &_permutations.emplace(features, std::move(permutation)).first->second;
+    }
+
+    RefCntAutoPtr<IShader>
+    MaterialTemplate::CreateShader(Diligent::SHADER_TYPE type, const str& source, u32 features) {
+        // Every feature is defined, so shaders test them with #if rather than #ifdef
+        vector<Diligent::ShaderMacro> macros;
+        macros.reserve(_desc.features.size() + 2);
+        for (u32 bit = 0; bit < CAST<u32>(_desc.features.size()); ++bit) {
+            macros.push_back({_desc.features[bit].c_str(), (features & (1u << bit)) != 0 ? "1" : "0"});
+        }
+        macros.push_back({"BINDLESS", _bindless ? "1" : "0"});
+        macros.push_back({"MATERIAL_TEXTURE_COUNT", _textureCount.c_str()});
+
+        const char* stage = type == Diligent::SHADER_TYPE_VERTEX ? "VS" : "PS";
+        const str name    = fmt::format("{} {} {:#x}", _desc.name, stage, features);
+        Diligent::ShaderCreateInfo createInfo;
+        createInfo.Source                          = source.c_str();
+        createInfo.SourceLength                    = source.size();
+        createInfo.SourceLanguage                  = Diligent::SHADER_SOURCE_LANGUAGE_HLSL;
+        createInfo.Desc.ShaderType                 = type;
+        createInfo.Desc.Name                       = name.c_str();
+        createInfo.Desc.UseCombinedTextureSamplers = true;
+        createInfo.Macros                          = {macros.data(), CAST<u32>(macros.size())};
+        return _device->GetPipelineCache()->CreateShader(createInfo);
+    }
+
+    RefCntAutoPtr<IShaderResourceBinding> MaterialTemplate::AllocateBinding(Permutation& permutation) {
+        // Released bindings come back once no frame in flight can still read them
+        const u64 retired = _device->GetPresentedFrames();
+        const u64 latency = _device->GetFramesInFlight() + 2;
+        while (!permutation.retiredBindings.empty() && permutation.retiredBindings.front().frame + latency <= retired) {
+            RetiredBinding& binding = permutation.retiredBindings.front();
+            for (const str& name : binding.variables) {
+                if (auto* variable = FindVariable(binding.binding, name)) {
+                    variable->Set(nullptr, Diligent::SET_SHADER_RESOURCE_FLAG_ALLOW_OVERWRITE);
+                }
+            }
+            permutation.freeBindings.push_back(std::move(binding.binding));
+            permutation.retiredBindings.pop_front();
+        }
+
+        // Diligent allocates the descriptor memory of SRBAllocationGranularity bindings at once, create a full batch
+        // to use it
+        if (permutation.freeBindings.empty()) {
+            ++_stats.bindingBatches;
+            for (u32 i = 0; i < _desc.bindingBatch; ++i) {
+                RefCntAutoPtr<IShaderResourceBinding> binding;
+                permutation.pipeline->CreateShaderResourceBinding(&binding, true);
+                if (!binding) break;
+                permutation.freeBindings.push_back(std::move(binding));
+                ++_stats.bindings;
+                ++_stats.pooledBindings;
+            }
+            if (permutation.freeBindings.empty()) {
+                Log::Error("Failed to create resource bindings for material template {}", _desc.name);
+                return {};
+            }
+        }
+
+        RefCntAutoPtr<IShaderResourceBinding> binding = std::move(permutation.freeBindings.back());
+        permutation.freeBindings.pop_back();
+        --_stats.pooledBindings;
+        return binding;
+    }
+
+    void MaterialTemplate::RetireBinding(Permutation& permutation, Material& material, const MaterialDesc& desc) {
+        RetiredBinding retired;
+        retired.binding = std::move(material._resourceBinding);
+        retired.frame   = _device->GetPresentedFrames();
+        for (const MaterialResource& resource : desc.resources) {
+            retired.variables.push_back(resource.name);
+        }
+        if (material._constants) { retired.variables.push_back(_desc.constantsName); }
+
+        permutation.retiredBindings.push_back(std::move(retired));
+        ++_stats.pooledBindings;
+        FreeMaterialId(material._pipelineId, material._id);
+    }
+
+    bool MaterialTemplate::BindResources(Material& material, const MaterialDesc& desc) {
+        IShaderResourceBinding* binding = material._resourceBinding;
+        for (const MaterialResource& resource : desc.resources) {
+            Diligent::IShaderResourceVariable* variable = FindVariable(binding, resource.name);
+            if (!variable) {
+                Log::Error("Material template {} has no mutable or dynamic variable {}", _desc.name, resource.name);
+                return false;
+            }
+            // Pooled bindings were drawn with before, their variables are overwritten rather than set once
+            variable->Set(resource.object, Diligent::SET_SHADER_RESOURCE_FLAG_ALLOW_OVERWRITE);
+        }
+
+        if (desc.constants.empty()) return true;
+
+        Diligent::IShaderResourceVariable* variable = FindVariable(binding, _desc.constantsName);
+        if (!variable) {
+            Log::Error("Material template {} has constants but no variable {}", _desc.name, _desc.constantsName);
+            return false;
+        }
+
+        // Constant buffers are sized in whole float4s
+        vector<u8> constants((desc.constants.size() + 15) & ~size_t {15}, 0);
+        std::memcpy(constants.data(), desc.constants.data(), desc.constants.size());
+
+        Diligent::BufferDesc bufferDesc;
+        bufferDesc.Name      = "Material constants";
+        bufferDesc.Usage     = Diligent::USAGE_IMMUTABLE;
+        bufferDesc.BindFlags = Diligent::BIND_UNIFORM_BUFFER;
+        bufferDesc.Size      = constants.size();
+
+        Diligent::BufferData initialData;
+        initialData.pData    = constants.data();
+        initialData.DataSize = constants.size();
+
+        _device->GetDevice()->CreateBuffer(bufferDesc, &initialData, &material._constants);
+        if (!material._constants) {
+            Log::Error("Failed to create constants for a material of template {}", _desc.name);
+            return false;
+        }
+        variable->Set(material._constants, Diligent::SET_SHADER_RESOURCE_FLAG_ALLOW_OVERWRITE);
+        return true;
+    }
+
+    bool MaterialTemplate::InitializeBindless() {
+        if (_desc.textures.size() >= _desc.textureCapacity) {
+            Log::Error("Material template {} names {} textures, more than its table of {} holds",
+                       _desc.name,
+                       _desc.textures.size(),
+                       _desc.textureCapacity);
+            return false;
+        }
+
+        _constantsOffset = AlignTo16(CAST<u32>(_desc.textures.size() * sizeof(u32)));
+        _recordStride    = std::max(AlignTo16(_constantsOffset + _desc.constantsSize), 16u);
+        // Bindings are only replaced when new textures arrive, one at a time is plenty
+        _desc.bindingBatch = 1;
+
+        Diligent::BufferDesc bufferDesc;
+        bufferDesc.Name              = "Material parameters";
+        bufferDesc.Usage             = Diligent::USAGE_DEFAULT;
+        bufferDesc.BindFlags         = Diligent::BIND_SHADER_RESOURCE;
+        bufferDesc.Mode              = Diligent::BUFFER_MODE_STRUCTURED;
+        bufferDesc.ElementByteStride = _recordStride;
+        bufferDesc.Size              = CAST<u64>(_recordStride) * std::max(_desc.materialCapacity, 1u);
+        _device->GetDevice()->CreateBuffer(bufferDesc, nullptr, &_parameters);
+        if (!_parameters) {
+            Log::Error("Failed to create the parameter buffer of material template {}", _desc.name);
+            return false;
+        }
+
+        const u8 white[] = {255, 255, 255, 255};
+        const TextureSubresource subresource {white, sizeof(white), sizeof(white)};
+        TextureImage image;
+        image.subresources     = &subresource;
+        image.subresourceCount = 1;
+        image.layout.width     = 1;
+        image.layout.height    = 1;
+        if (!_defaultTexture.Create(_device->GetDevice(), image, "Material default texture")) return false;
+
+        _textureTable.assign(_desc.textureCapacity, _defaultTexture.GetShaderResourceView());
+        for (u32 slot = _desc.textureCapacity - 1; slot > 0; --slot) {
+            _freeTextureSlots.push_back(slot);
+        }
+        for (u32 record = std::max(_desc.materialCapacity, 1u); record > 0; --record) {
+            _freeRecords.push_back(record - 1);
+        }
+        _stats.textures = 1;
+        return true;
+    }
+
+    RefCntAutoPtr<IShaderResourceBinding> MaterialTemplate::CreateSharedBinding(Permutation& permutation) {
+        // A reused binding still holds the table it was last filled from, every slot is overwritten here
+        RefCntAutoPtr<IShaderResourceBinding> binding = AllocateBinding(permutation);
+        if (!binding) return {};
+
+        Diligent::IShaderResourceVariable* textures   = FindVariable(binding, kTexturesName);
+        Diligent::IShaderResourceVariable* parameters = FindVariable(binding, kParametersName);
+        if (!textures || !parameters) {
+            Log::Error("Material template {} is bindless but its shaders do not read {} and {}",
+                       _desc.name,
+                       kTexturesName,
+                       kParametersName);
+            permutation.freeBindings.push_back(std::move(binding));
+            ++_stats.pooledBindings;
+            return {};
+        }
+
+        textures->SetArray(_textureTable.data(),
+                           0,
+                           CAST<u32>(_textureTable.size()),
+                           Diligent::SET_SHADER_RESOURCE_FLAG_ALLOW_OVERWRITE);
+        parameters->Set(_parameters->GetDefaultView(Diligent::BUFFER_VIEW_SHADER_RESOURCE),
+                        Diligent::SET_SHADER_RESOURCE_FLAG_ALLOW_OVERWRITE);
+        permutation.tableVersion = _tableVersion;
+        return binding;
+    }
+
+    bool MaterialTemplate::WriteParameters(Material& material, const MaterialDesc& desc) {
+        if (desc.constants.size() > _desc.constantsSize) {
+            Log::Error("Material of template {} has {} bytes of constants, its records hold {}",
+                       _desc.name,
+                       desc.constants.size(),
+                       _desc.constantsSize);
+            return false;
+        }
+        if (_freeRecords.empty()) {
+            Log::Error("Material template {} is at its limit of {} materials", _desc.name, _desc.materialCapacity);
+            return false;
+        }
+
+        // Check everything before taking any slot, so failing leaves nothing to undo
+        u32 newTextures = 0;
+        for (const MaterialResource& resource : desc.resources) {
+            const auto name = std::find(_desc.textures.begin(), _desc.textures.end(), resource.name);
+            if (name == _desc.textures.end() || !resource.object) {
+                Log::Error("Material template {} has no bindless texture {}", _desc.name, resource.name);
+                return false;
+            }
+            if (!_textureSlots.contains(resource.object)) { ++newTextures; }
+        }
+        if (newTextures > _freeTextureSlots.size()) {
+            Log::Error("Material template {} is at its limit of {} textures", _desc.name, _desc.textureCapacity);
+            return false;
+        }
+
+        // Textures the material does not set read slot 0, the default texture
+        vector<u8> record(_recordStride, 0);
+        for (const MaterialResource& resource : desc.resources) {
+            auto [it, inserted] = _textureSlots.try_emplace(resource.object);
+            if (inserted) {
+                it->second.slot = _freeTextureSlots.back();
+                _freeTextureSlots.pop_back();
+                _textureTable[it->second.slot] = resource.object;
+                ++_tableVersion;
+                ++_stats.textures;
+            }
+            ++it->second.references;
+
+            const size_t index = std::find(_desc.textures.begin(), _desc.textures.end(), resource.name) -
+                                 _desc.textures.begin();
+            std::memcpy(record.data() + index * sizeof(u32), &it->second.slot, sizeof(u32));
+        }
+        if (!desc.constants.empty()) {
+            std::memcpy(record.data() + _constantsOffset, desc.constants.data(), desc.constants.size());
+        }
+
+        material._bindless       = true;
+        material._parameterIndex = _freeRecords.back();
+        _freeRecords.pop_back();
+        _device->GetImmediateContext()->UpdateBuffer(_parameters,
+                                                     CAST<u64>(material._parameterIndex) * _recordStride,
+                                                     _recordStride,
+                                                     record.data(),
+                                                     Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        return true;
+    }
+
+    void MaterialTemplate::ReleaseTexture(Diligent::IDeviceObject* texture) {
+        const auto it = _textureSlots.find(texture);
+        if (it == _textureSlots.end() || --it->second.references > 0) return;
+
+        // Bindings keep the texture until the table is next rebuilt, no material can reach its slot meanwhile
+        _textureTable[it->second.slot] = _defaultTexture.GetShaderResourceView();
+        _freeTextureSlots.push_back(it->second.slot);
+        _textureSlots.erase(it);
+        --_stats.textures;
+    }
+}  // namespace X::Render
@@ -4,8 +4,246 @@
 
 #pragma once
 
+#include "EnginePCH.h"
+#include "Texture.hpp"
+
+#include <deque>
+
 namespace X::Render {
 
-    class Material {};
+    class MaterialTemplate;
+    struct MaterialDesc;
+
+    class Material {
+    public:
+        Material() = default;
+        Material(RefCntAutoPtr<IPipelineState> pipelineState, RefCntAutoPtr<IShaderResourceBinding> resourceBinding);
+
+        IPipelineState* GetPipelineState() const {
+            return _pipelineState;
+        }
+        IShaderResourceBinding* GetResourceBinding() const {
+            return _resourceBinding;
+        }
+
+        // Compact ids used to build render queue sort keys. Materials sharing a pipeline state share a pipeline id,
+        // and material ids are handed out per pipeline from 1 up, reusing those of released template materials, so
+        // both stay dense enough for the queue's key fields.
+        u32 GetPipelineId() const {
+            return _pipelineId;
+        }
+        u32 GetId() const {
+            return _id;
+        }
+
+        // Null for materials built directly from a pipeline state and binding
+        const MaterialTemplate* GetTemplate() const {
+            return _template;
+        }
+        u32 GetFeatures() const {
+            return _features;
+        }
+        // Bindless materials share their permutation's binding and pipeline/material ids, and are told apart by the
+        // index of their record in the template's parameter buffer, which the render queue passes per instance
+        bool IsBindless() const {
+            return _bindless;
+        }
+        u32 GetParameterIndex() const {
+            return _parameterIndex;
+        }
+
+    private:
+        friend class MaterialTemplate;
+
+        RefCntAutoPtr<IPipelineState> _pipelineState;
+        RefCntAutoPtr<IShaderResourceBinding> _resourceBinding;
+        u32 _pipelineId {0};
+        u32 _id {0};
+        MaterialTemplate* _template {nullptr};
+        u32 _features {0};
+        u32 _references {0};                  // Acquires not yet released, template materials only
+        RefCntAutoPtr<IBuffer> _constants;    // MaterialDesc::constants
+        const MaterialDesc* _desc {nullptr};  // Key in the template's material map
+        bool _bindless {false};
+        u32 _parameterIndex {0};
+    };
+
+    // A shader resource of a template listed with a type other than mutable, the default
+    struct MaterialVariable {
+        str name;
+        Diligent::SHADER_TYPE stages {Diligent::SHADER_TYPE_PIXEL};
+        Diligent::SHADER_RESOURCE_VARIABLE_TYPE type {Diligent::SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC};
+    };
+
+    // Immutable sampler for a texture, with combined texture samplers
+    struct MaterialSampler {
+        str texture;
+        Diligent::SHADER_TYPE stages {Diligent::SHADER_TYPE_PIXEL};
+        Diligent::SamplerDesc desc;
+    };
+
+    // Everything a template's permutations share. Feature bit i defines features[i] as 1 or 0 in both shaders.
+    struct MaterialTemplateDesc {
+        str name {"Material"};
+        str vertexShader;  // HLSL source
+        str pixelShader;
+        vector<str> features;    // At most 32
+        u32 vertexFeatures {0};  // Features the vertex shader reads, permutations that differ only elsewhere share it
+        vector<Diligent::LayoutElement> inputLayout;
+        Diligent::TEXTURE_FORMAT colorFormat {Diligent::TEX_FORMAT_RGBA8_UNORM_SRGB};
+        Diligent::TEXTURE_FORMAT depthFormat {Diligent::TEX_FORMAT_D32_FLOAT};
+        Diligent::BlendStateDesc blend;
+        Diligent::RasterizerStateDesc rasterizer;
+        Diligent::DepthStencilStateDesc depthStencil;
+        vector<MaterialVariable> variables;
+        vector<MaterialSampler> samplers;
+        str constantsName {"MaterialConstants"};  // Constant buffer that receives MaterialDesc::constants
+        u32 maxPermutations {32};
+        u32 bindingBatch {16};  // Resource bindings created at once when a permutation's pool runs dry
+
+        // Draw every material of a permutation through one binding where the device supports it (see
+        // RenderDevice::SupportsBindless). Textures then live in the MaterialTextures array, MATERIAL_TEXTURE_COUNT
+        // long, and each material's record in the MaterialParameters structured buffer, indexed by the uint
+        // InstanceData::material attribute. A record holds one uint slot per entry of textures, padded to 16 bytes,
+        // then constantsSize bytes of constants, padded to 16 bytes, so a shader struct of uint4/float4 members matches
+        // it. Shaders see BINDLESS defined as 1 or 0 and must provide both paths; with 0 each material binds textures
+        // by name and its constants through constantsName, as without this flag.
+        bool bindless {false};
+        vector<str> textures;
+        u32 constantsSize {0};
+        u32 textureCapacity {1024};
+        u32 materialCapacity {4096};
+    };
+
+    struct MaterialResource {
+        str name;
+        Diligent::IDeviceObject* object {nullptr};  // Texture view or buffer, the caller keeps it alive
+
+        bool operator==(const MaterialResource&) const = default;
+    };
+
+    // What makes one material of a template differ from another. Equal descs share one material.
+    struct MaterialDesc {
+        u32 features {0};  // Bits past the template's feature count are ignored
+        vector<MaterialResource> resources;
+        vector<u8> constants;
+
+        bool operator==(const MaterialDesc&) const = default;
+    };
+
+    struct MaterialDescHash {
+        size_t operator()(const MaterialDesc& desc) const;
+    };
+
+    struct MaterialStats {
+        u32 permutations {0};          // Compiled so far, never more than maxPermutations
+        u32 rejectedPermutations {0};  // Acquires refused because the template was at its limit
+        u32 materials {0};             // Live
+        u32 sharedMaterials {0};       // Acquires answered with a live material
+        u32 bindings {0};              // Resource bindings created
+        u32 bindingBatches {0};        // Times a pool was refilled
+        u32 pooledBindings {0};        // Bindings waiting in the pools, including released ones the GPU may still read
+        bool bindless {false};         // Materials share their permutation's binding
+        u32 textures {0};              // Bindless texture slots in use, the default texture's included
+        u32 tableUpdates {0};          // Times the permutations' bindings were rebuilt for new textures
+    };
+
+    // A shader pair with feature bits, compiled into one pipeline per feature mask a material actually uses rather
+    // than every combination. Shaders and pipelines come from the device's PipelineCache, so identical permutations
+    // of different templates share a pipeline state and a pipeline id. Each permutation keeps a pool of shader
+    // resource bindings, refilled a batch at a time and fed by released materials, and materials with equal descs
+    // share one binding, so the render queue sees as few distinct pipelines and bindings as the content allows.
+    //
+    // Materials are owned by the template and stay valid until released as often as they were acquired. A released
+    // binding is only reused, and its resources let go, once every frame that could have drawn it has retired. Not
+    // thread safe, create and release materials on the render thread.
+    class MaterialTemplate {
+    public:
+        MaterialTemplate() = default;
+        ~MaterialTemplate();
+
+        MaterialTemplate(const MaterialTemplate&)            = delete;
+        MaterialTemplate& operator=(const MaterialTemplate&) = delete;
+
+        bool Initialize(RenderDevice& device, MaterialTemplateDesc desc);
+        // Every material must have been released
+        void Shutdown();
+
+        // Feature bit for a name, 0 after logging when the template has no such feature
+        u32 GetFeature(strview name) const;
+
+        // Compiles permutations ahead of their first material, e.g. the masks a level is known to use. Returns false
+        // if any could not be built.
+        bool Prewarm(const vector<u32>& features);
+
+        // The material for desc, created on first use along with its permutation. nullptr after logging when the
+        // permutation cannot be built, the template is at maxPermutations or a resource has no shader variable.
+        const Material* Acquire(const MaterialDesc& desc);
+        void Release(const Material* material);
+
+        // Bindless templates only: hands textures added since the last call to the permutations' bindings. Call once
+        // per frame, after acquiring materials and before submitting them.
+        void Update();
+
+        const MaterialTemplateDesc& GetDesc() const {
+            return _desc;
+        }
+        const MaterialStats& GetStats() const {
+            return _stats;
+        }
+
+    private:
+        struct RetiredBinding {
+            RefCntAutoPtr<IShaderResourceBinding> binding;
+            vector<str> variables;  // Bound by the last material, unbound before reuse
+            u64 frame {0};          // Presented frame count at release
+        };
+
+        struct Permutation {
+            RefCntAutoPtr<IPipelineState> pipeline;
+            u32 pipelineId {0};
+            vector<RefCntAutoPtr<IShaderResourceBinding>> freeBindings;
+            std::deque<RetiredBinding> retiredBindings;  // Oldest first
+            // Bindless only, the binding and material id every material of the permutation shares
+            RefCntAutoPtr<IShaderResourceBinding> sharedBinding;
+            u32 sharedId {0};
+            u64 tableVersion {0};  // Of the texture table sharedBinding was filled from
+        };
+
+        struct TextureSlot {
+            u32 slot {0};
+            u32 references {0};
+        };
+
+        Permutation* GetPermutation(u32 features);
+        RefCntAutoPtr<IShader> CreateShader(Diligent::SHADER_TYPE type, const str& source, u32 features);
+        RefCntAutoPtr<IShaderResourceBinding> AllocateBinding(Permutation& permutation);
+        void RetireBinding(Permutation& permutation, Material& material, const MaterialDesc& desc);
+        bool BindResources(Material& material, const MaterialDesc& desc);
+        bool InitializeBindless();
+        RefCntAutoPtr<IShaderResourceBinding> CreateSharedBinding(Permutation& permutation);
+        bool WriteParameters(Material& material, const MaterialDesc& desc);
+        void ReleaseTexture(Diligent::IDeviceObject* texture);
+
+        RenderDevice* _device {nullptr};
+        MaterialTemplateDesc _desc;
+        u32 _featureMask {0};
+        str _textureCount;  // MATERIAL_TEXTURE_COUNT
+        unordered_map<u32, Permutation> _permutations;
+        unordered_map<MaterialDesc, unique_ptr<Material>, MaterialDescHash> _materials;
+        MaterialStats _stats;
+
+        // Bindless state
+        bool _bindless {false};
+        u32 _recordStride {0};
+        u32 _constantsOffset {0};
+        RefCntAutoPtr<IBuffer> _parameters;
+        vector<u32> _freeRecords;
+        Texture _defaultTexture;                         // Slot 0, and every slot not in use
+        vector<Diligent::IDeviceObject*> _textureTable;  // By slot
+        unordered_map<Diligent::IDeviceObject*, TextureSlot> _textureSlots;
+        vector<u32> _freeTextureSlots;
+        u64 _tableVersion {0};
+    };
 
-}  // namespace X::Render
\ No newline at end of file
+}  // namespace X::Render
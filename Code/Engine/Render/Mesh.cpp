@@ -3,5 +3,317 @@
 //
 
 #include "Mesh.hpp"
+#include "Core/Log.hpp"
 
-namespace X::Render {}
\ No newline at end of file
+#include <atomic>
+
+namespace X::Render {
+    using namespace X::Core;
+
+    namespace {
+        std::atomic<u32> gNextMeshId {1};
+
+        // 0xFFFF is left out so a primitive restart index can never collide with a real vertex
+        constexpr u32 kMaxShortIndexVertices = 0xFFFF;
+
+        constexpr u32 kAttributeComponents[Mesh::AttributeCount] = {3, 3, 4, 2};
+
+        // Where each attribute lives for a given set of attributes and stream split
+        struct VertexFormat {
+            u32 stream[Mesh::AttributeCount] {};
+            u32 offset[Mesh::AttributeCount] {};
+            u32 stride[Mesh::kMaxStreams] {};
+            u32 streamCount {0};
+        };
+
+        VertexFormat GetVertexFormat(u32 attributes, VertexStreams streams) {
+            VertexFormat format;
+            for (u32 attribute = 0; attribute < Mesh::AttributeCount; ++attribute) {
+                if (!(attributes & (1u << attribute))) continue;
+                // A split mesh with positions only still has a single stream
+                const u32 stream         = streams == VertexStreams::Split && attribute != Mesh::Position ? 1 : 0;
+                format.stream[attribute] = stream;
+                format.offset[attribute] = format.stride[stream];
+                format.streamCount       = std::max(format.streamCount, stream + 1);
+                format.stride[stream] += kAttributeComponents[attribute] * CAST<u32>(sizeof(f32));
+            }
+            return format;
+        }
+
+        const f32* GetAttributeData(const MeshData& data, u32 attribute) {
+            switch (attribute) {
+                case Mesh::Position:
+                    return &data.positions[0].x;
+                case Mesh::Normal:
+                    return &data.normals[0].x;
+                case Mesh::Tangent:
+                    return &data.tangents[0].x;
+                default:
+                    return &data.uvs[0].x;
+            }
+        }
+
+        RefCntAutoPtr<IBuffer> CreateImmutableBuffer(IRenderDevice* device,
+                                                     const str& name,
+                                                     Diligent::BIND_FLAGS bindFlags,
+                                                     const void* data,
+                                                     u64 size) {
+            Diligent::BufferDesc desc;
+            desc.Name      = name.c_str();
+            desc.Usage     = Diligent::USAGE_IMMUTABLE;
+            desc.BindFlags = bindFlags;
+            desc.Size      = size;
+
+            Diligent::BufferData initialData;
+            initialData.pData    = data;
+            initialData.DataSize = size;
+
+            RefCntAutoPtr<IBuffer> buffer;
+            device->CreateBuffer(desc, &initialData, &buffer);
+            if (!buffer) { Log::Error("Failed to create {} ({} bytes)", name, size); }
+            return buffer;
+        }
+    }  // namespace
+
+    Mesh::Mesh(RefCntAutoPtr<IBuffer> vertexBuffer,
+               RefCntAutoPtr<IBuffer> indexBuffer,
+               u32 elementCount,
+               Diligent::VALUE_TYPE indexType)
+        : _indexBuffer(std::move(indexBuffer)), _elementCount(elementCount), _indexType(indexType),
+          _id(gNextMeshId.fetch_add(1, std::memory_order_relaxed)) {
+        _vertexBuffers[0] = std::move(vertexBuffer);
+        _lods[0]          = {0, elementCount, 0.0f};
+    }
+
+    MeshImage PackedMesh::GetImage() const {
+        MeshImage image;
+        image.layout = layout;
+        for (u32 stream = 0; stream < kMaxVertexStreams; ++stream) {
+            image.vertexData[stream]     = vertexData[stream].data();
+            image.vertexDataSize[stream] = vertexData[stream].size();
+        }
+        image.indexData     = indexData.data();
+        image.indexDataSize = indexData.size();
+        image.lods          = lods.data();
+        return image;
+    }
+
+    bool Mesh::Pack(const MeshData& data, const MeshDesc& desc, PackedMesh& packed) {
+        const u32 vertexCount = data.GetVertexCount();
+        if (vertexCount == 0 || data.indices.empty() || data.indices.size() % 3 != 0) {
+            Log::Error("Mesh {} needs vertices and a triangle list, got {} vertices and {} indices",
+                       desc.name,
+                       vertexCount,
+                       data.indices.size());
+            return false;
+        }
+
+        u32 attributes                = 1u << Position;
+        const size_t attributeSizes[] = {data.normals.size(), data.tangents.size(), data.uvs.size()};
+        for (u32 attribute = Normal; attribute < AttributeCount; ++attribute) {
+            const size_t size = attributeSizes[attribute - Normal];
+            if (size == 0) continue;
+            if (size != vertexCount) {
+                Log::Error("Mesh {} has {} positions but {} entries for attribute {}",
+                           desc.name,
+                           vertexCount,
+                           size,
+                           attribute);
+                return false;
+            }
+            attributes |= 1u << attribute;
+        }
+        for (const u32 index : data.indices) {
+            if (index >= vertexCount) {
+                Log::Error("Mesh {} references vertex {} of {}", desc.name, index, vertexCount);
+                return false;
+            }
+        }
+        if (data.lods.size() > kMaxLods) {
+            Log::Error("Mesh {} has {} LODs, at most {} are supported", desc.name, data.lods.size(), kMaxLods);
+            return false;
+        }
+        for (const MeshLod& lod : data.lods) {
+            if (lod.indexCount == 0 || lod.indexCount % 3 != 0 || lod.firstIndex % 3 != 0 ||
+                CAST<size_t>(lod.firstIndex) + lod.indexCount > data.indices.size()) {
+                Log::Error("Mesh {} has a LOD outside its triangle list", desc.name);
+                return false;
+            }
+        }
+
+        // Work on a copy when anything is generated or reordered
+        const bool generateLods = data.lods.empty() && !desc.lodOptions.ratios.empty();
+        MeshData prepared;
+        const MeshData* source = &data;
+        if (generateLods || desc.optimize) {
+            prepared = data;
+            source   = &prepared;
+        }
+        if (generateLods) {
+            MeshLodOptions lodOptions = desc.lodOptions;
+            if (lodOptions.ratios.size() >= kMaxLods) { lodOptions.ratios.resize(kMaxLods - 1); }
+            GenerateLods(prepared, lodOptions);
+        }
+
+        MeshOptimizeReport report;
+        if (desc.optimize) {
+            report = OptimizeMesh(prepared, desc.optimizeOptions);
+        } else {
+            const u32 fullDetailCount = source->lods.empty() ? CAST<u32>(source->indices.size())
+                                                              : source->lods[0].indexCount;
+            const u32 fullDetailFirst = source->lods.empty() ? 0 : source->lods[0].firstIndex;
+            report.before             = AnalyzeVertexCache(source->indices.data() + fullDetailFirst,
+                                                           fullDetailCount,
+                                                           vertexCount,
+                                                           desc.optimizeOptions.cacheSize);
+            report.after              = report.before;
+        }
+
+        // Pack the attributes into their streams
+        const VertexFormat format = GetVertexFormat(attributes, desc.streams);
+        const u32 packedCount     = source->GetVertexCount();
+        for (u32 stream = 0; stream < kMaxStreams; ++stream) {
+            packed.vertexData[stream].assign(CAST<size_t>(format.stride[stream]) * packedCount, 0);
+        }
+        for (u32 attribute = 0; attribute < AttributeCount; ++attribute) {
+            if (!(attributes & (1u << attribute))) continue;
+            const u32 size   = kAttributeComponents[attribute] * CAST<u32>(sizeof(f32));
+            const u32 stride = format.stride[format.stream[attribute]];
+            const f32* input = GetAttributeData(*source, attribute);
+            u8* output       = packed.vertexData[format.stream[attribute]].data() + format.offset[attribute];
+            for (u32 vertex = 0; vertex < packedCount; ++vertex) {
+                const f32* element = input + CAST<size_t>(vertex) * kAttributeComponents[attribute];
+                std::memcpy(output + CAST<size_t>(vertex) * stride, element, size);
+            }
+        }
+
+        const bool shortIndices = packedCount <= kMaxShortIndexVertices;
+        if (shortIndices) {
+            const vector<u16> indices(source->indices.begin(), source->indices.end());
+            packed.indexData.resize(indices.size() * sizeof(u16));
+            std::memcpy(packed.indexData.data(), indices.data(), packed.indexData.size());
+        } else {
+            packed.indexData.resize(source->indices.size() * sizeof(u32));
+            std::memcpy(packed.indexData.data(), source->indices.data(), packed.indexData.size());
+        }
+
+        // Without LODs the whole buffer is the only one
+        packed.lods = source->lods;
+        if (packed.lods.empty()) { packed.lods.push_back({0, CAST<u32>(source->indices.size()), 0.0f}); }
+
+        MeshLayout& layout = packed.layout;
+        layout.vertexCount = packedCount;
+        layout.indexCount  = CAST<u32>(source->indices.size());
+        layout.attributes  = attributes;
+        layout.streams     = desc.streams;
+        layout.indexType   = shortIndices ? Diligent::VT_UINT16 : Diligent::VT_UINT32;
+        layout.lodCount    = CAST<u32>(packed.lods.size());
+        layout.bounds      = {source->positions[0], source->positions[0]};
+        f32 radiusSquared  = 0.0f;
+        for (const Vec3& position : source->positions) {
+            layout.bounds.min = glm::min(layout.bounds.min, position);
+            layout.bounds.max = glm::max(layout.bounds.max, position);
+            radiusSquared     = std::max(radiusSquared, glm::dot(position, position));
+        }
+        layout.radius = std::sqrt(radiusSquared);
+        packed.report = report;
+        return true;
+    }
+
+    bool Mesh::Create(IRenderDevice* device, const MeshData& data, const MeshDesc& desc) {
+        PackedMesh packed;
+        if (!Pack(data, desc, packed) || !Create(device, packed.GetImage(), desc.name)) return false;
+        _cacheReport = packed.report;
+
+        Log::Debug("Mesh {}: {} triangles, {} vertices, ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f} ({:.2f} ms)",
+                   desc.name,
+                   _lods[0].indexCount / 3,
+                   _vertexCount,
+                   _cacheReport.before.acmr,
+                   _cacheReport.after.acmr,
+                   _cacheReport.before.atvr,
+                   _cacheReport.after.atvr,
+                   _cacheReport.milliseconds);
+        for (u32 lod = 1; lod < _lodCount; ++lod) {
+            Log::Debug("Mesh {}: LOD {} has {} triangles, error {:.4f}",
+                       desc.name,
+                       lod,
+                       _lods[lod].indexCount / 3,
+                       _lods[lod].error);
+        }
+        return true;
+    }
+
+    bool Mesh::Create(IRenderDevice* device, const MeshImage& image, const char* name) {
+        // Images may come from files, so check they describe buffers of the sizes they hold
+        const MeshLayout& layout  = image.layout;
+        const VertexFormat format = GetVertexFormat(layout.attributes, layout.streams);
+        const bool shortIndices   = layout.indexType == Diligent::VT_UINT16;
+        const u32 indexSize       = shortIndices ? 2 : 4;
+
+        bool valid = (shortIndices || layout.indexType == Diligent::VT_UINT32) && layout.vertexCount > 0 &&
+                     (layout.attributes & (1u << Position)) && layout.attributes < (1u << AttributeCount) &&
+                     layout.lodCount > 0 && layout.lodCount <= kMaxLods && image.lods && image.indexData &&
+                     image.indexDataSize == CAST<u64>(layout.indexCount) * indexSize;
+        for (u32 stream = 0; valid && stream < format.streamCount; ++stream) {
+            valid = image.vertexData[stream] &&
+                    image.vertexDataSize[stream] == CAST<u64>(format.stride[stream]) * layout.vertexCount;
+        }
+        for (u32 lod = 0; valid && lod < layout.lodCount; ++lod) {
+            valid = CAST<u64>(image.lods[lod].firstIndex) + image.lods[lod].indexCount <= layout.indexCount;
+        }
+        if (!valid) {
+            Log::Error("Mesh {} image is inconsistent with its layout", name);
+            return false;
+        }
+
+        RefCntAutoPtr<IBuffer> vertexBuffers[kMaxStreams];
+        for (u32 stream = 0; stream < format.streamCount; ++stream) {
+            vertexBuffers[stream] = CreateImmutableBuffer(device,
+                                                          fmt::format("{} vertex stream {}", name, stream),
+                                                          Diligent::BIND_VERTEX_BUFFER,
+                                                          image.vertexData[stream],
+                                                          image.vertexDataSize[stream]);
+            if (!vertexBuffers[stream]) return false;
+        }
+        RefCntAutoPtr<IBuffer> indexBuffer = CreateImmutableBuffer(device,
+                                                                   fmt::format("{} indices", name),
+                                                                   Diligent::BIND_INDEX_BUFFER,
+                                                                   image.indexData,
+                                                                   image.indexDataSize);
+        if (!indexBuffer) return false;
+
+        for (u32 stream = 0; stream < kMaxStreams; ++stream) {
+            _vertexBuffers[stream] = std::move(vertexBuffers[stream]);
+        }
+        _indexBuffer  = std::move(indexBuffer);
+        _streamCount  = format.streamCount;
+        _elementCount = layout.indexCount;
+        _vertexCount  = layout.vertexCount;
+        _indexType    = layout.indexType;
+        _attributes   = layout.attributes;
+        _streams      = layout.streams;
+        _cacheReport  = {};
+        _lodCount     = layout.lodCount;
+        _bounds       = layout.bounds;
+        _radius       = layout.radius;
+        std::copy(image.lods, image.lods + layout.lodCount, _lods);
+        if (_id == 0) { _id = gNextMeshId.fetch_add(1, std::memory_order_relaxed); }
+        return true;
+    }
+
+    void Mesh::AppendLayoutElements(vector<Diligent::LayoutElement>& layout) const {
+        const VertexFormat format = GetVertexFormat(_attributes, _streams);
+        for (u32 attribute = 0; attribute < AttributeCount; ++attribute) {
+            if (!HasAttribute(CAST<Attribute>(attribute))) continue;
+            layout.emplace_back(attribute,
+                                format.stream[attribute],
+                                kAttributeComponents[attribute],
+                                Diligent::VT_FLOAT32,
+                                false,
+                                format.offset[attribute],
+                                format.stride[format.stream[attribute]],
+                                Diligent::INPUT_ELEMENT_FREQUENCY_PER_VERTEX);
+        }
+    }
+}  // namespace X::Render
@@ -4,10 +4,166 @@
 
 #pragma once
 
+#include "EnginePCH.h"
+#include "MeshOptimizer.hpp"
+#include "MeshSimplifier.hpp"
+#include "Math/Bounds.hpp"
+
 namespace X {
     namespace Render {
 
-        class Mesh {};
+        enum class VertexStreams : u8 {
+            Interleaved,  // One buffer holding every attribute of a vertex together
+            Split,        // Positions alone in the first buffer, the rest interleaved in a second. Depth-only and
+                          // shadow passes then fetch 12 bytes per vertex instead of the full vertex.
+        };
+
+        struct MeshDesc {
+            const char* name {"Mesh"};
+            VertexStreams streams {VertexStreams::Interleaved};
+            // Reorders for the post-transform cache, overdraw and fetch locality before upload. Only worth skipping
+            // for data that was optimised offline.
+            bool optimize {true};
+            MeshOptimizeOptions optimizeOptions;
+            // Simplified LODs generated from the full detail mesh, at most kMaxLods - 1. Ignored when the data
+            // already has LODs.
+            MeshLodOptions lodOptions;
+        };
+
+        inline constexpr u32 kMaxVertexStreams = 2;
+
+        // Everything about a mesh's GPU buffers besides their contents. Plain data, so asset archives store it as is.
+        struct MeshLayout {
+            u32 vertexCount {0};
+            u32 indexCount {0};  // Of every LOD
+            u32 attributes {0};  // Bit per Mesh::Attribute
+            VertexStreams streams {VertexStreams::Interleaved};
+            Diligent::VALUE_TYPE indexType {Diligent::VT_UINT32};
+            u32 lodCount {0};
+            Math::AABB bounds;
+            f32 radius {0.0f};  // Distance from the object space origin to the farthest vertex
+        };
+
+        // A mesh laid out exactly as its GPU buffers hold it. Nothing is owned, so an image can point straight into a
+        // mapped asset archive.
+        struct MeshImage {
+            MeshLayout layout;
+            const void* vertexData[kMaxVertexStreams] {};
+            u64 vertexDataSize[kMaxVertexStreams] {};
+            const void* indexData {nullptr};
+            u64 indexDataSize {0};
+            const MeshLod* lods {nullptr};  // layout.lodCount of them
+        };
+
+        // Storage for an image packed from MeshData
+        struct PackedMesh {
+            MeshLayout layout;
+            vector<u8> vertexData[kMaxVertexStreams];
+            vector<u8> indexData;
+            vector<MeshLod> lods;
+            MeshOptimizeReport report;
+
+            MeshImage GetImage() const;
+        };
+
+        class Mesh {
+        public:
+            static constexpr u32 kMaxStreams = kMaxVertexStreams;
+            static constexpr u32 kMaxLods    = 8;
+
+            // Shader input numbers are fixed whichever optional attributes a mesh has. Per-instance attributes start
+            // at AttributeCount.
+            enum Attribute : u32 { Position = 0, Normal = 1, Tangent = 2, TexCoord = 3, AttributeCount = 4 };
+
+            Mesh() = default;
+            Mesh(RefCntAutoPtr<IBuffer> vertexBuffer,
+                 RefCntAutoPtr<IBuffer> indexBuffer,
+                 u32 elementCount,
+                 Diligent::VALUE_TYPE indexType = Diligent::VT_UINT32);
+
+            // Uploads data into immutable buffers, after generating LODs for and optimising a copy of it as desc
+            // asks. Every LOD shares the vertex buffers and has its own range of the index buffer. Indices are 16-bit
+            // when every vertex is addressable with them. Logs and returns false on invalid data or when a buffer
+            // cannot be created, leaving the mesh unchanged.
+            bool Create(IRenderDevice* device, const MeshData& data, const MeshDesc& desc = {});
+            // Uploads an already packed image without touching its contents on the CPU
+            bool Create(IRenderDevice* device, const MeshImage& image, const char* name = "Mesh");
+
+            // The CPU half of Create: validates, generates LODs, optimises and interleaves data into GPU layout. Used
+            // by the asset packer to bake meshes offline. Logs and returns false on invalid data.
+            static bool Pack(const MeshData& data, const MeshDesc& desc, PackedMesh& packed);
+
+            // Input layout for this mesh's vertex format, for the pipelines that draw it. Pass GetStreamCount() as the
+            // instance stream's buffer slot.
+            void AppendLayoutElements(vector<Diligent::LayoutElement>& layout) const;
+
+            IBuffer* GetVertexBuffer(u32 stream = 0) const {
+                return _vertexBuffers[stream];
+            }
+            // Vertex buffers occupy slots 0 to GetStreamCount() - 1
+            u32 GetStreamCount() const {
+                return _streamCount;
+            }
+            IBuffer* GetIndexBuffer() const {
+                return _indexBuffer;
+            }
+            // Index count of every LOD for indexed meshes, vertex count otherwise
+            u32 GetElementCount() const {
+                return _elementCount;
+            }
+            // LOD 0 is full detail and covers the whole buffer for meshes built from existing buffers
+            const MeshLod& GetLod(u32 lod) const {
+                return _lods[lod];
+            }
+            u32 GetLodCount() const {
+                return _lodCount;
+            }
+            // Coarsest LOD whose error spans at most maxPixelError pixels, where one mesh unit spans pixelsPerUnit
+            u32 SelectLod(f32 pixelsPerUnit, f32 maxPixelError) const {
+                return Render::SelectLod(_lods, _lodCount, pixelsPerUnit, maxPixelError);
+            }
+            // Object space, empty for meshes built from existing buffers
+            const Math::AABB& GetBounds() const {
+                return _bounds;
+            }
+            // Distance from the object space origin to the farthest vertex
+            f32 GetRadius() const {
+                return _radius;
+            }
+            Diligent::VALUE_TYPE GetIndexType() const {
+                return _indexType;
+            }
+            u32 GetVertexCount() const {
+                return _vertexCount;
+            }
+            bool HasAttribute(Attribute attribute) const {
+                return (_attributes & (1u << attribute)) != 0;
+            }
+            // Vertex cache behaviour before and after optimisation, both the same when it was skipped. Empty for
+            // meshes built from existing buffers.
+            const MeshOptimizeReport& GetCacheReport() const {
+                return _cacheReport;
+            }
+            u32 GetId() const {
+                return _id;
+            }
+
+        private:
+            RefCntAutoPtr<IBuffer> _vertexBuffers[kMaxStreams];
+            RefCntAutoPtr<IBuffer> _indexBuffer;
+            u32 _streamCount {1};
+            MeshLod _lods[kMaxLods];
+            u32 _lodCount {1};
+            Math::AABB _bounds;
+            f32 _radius {0.0f};
+            u32 _elementCount {0};
+            u32 _vertexCount {0};
+            Diligent::VALUE_TYPE _indexType {Diligent::VT_UINT32};
+            u32 _attributes {0};  // Bit per Attribute
+            VertexStreams _streams {VertexStreams::Interleaved};
+            MeshOptimizeReport _cacheReport;
+            u32 _id {0};
+        };
 
     }  // namespace Render
 }  // namespace X
@@ -0,0 +1,385 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include "MeshOptimizer.hpp"
+#include "Core/Profiler.hpp"
+
+#include <chrono>
+
+namespace X::Render {
+    namespace {
+        constexpr u32 kInvalid = ~0u;
+
+        // Forsyth's scoring. The cache modelled while reordering is an LRU larger than any real FIFO so the order
+        // stays good across hardware.
+        constexpr u32 kScoreCacheSize  = 32;
+        constexpr u32 kMaxValence      = 32;
+        constexpr f32 kCacheDecayPower = 1.5f;
+        constexpr f32 kLastTriangle    = 0.75f;
+        constexpr f32 kValenceScale    = 2.0f;
+        constexpr f32 kValencePower    = 0.5f;
+
+        struct ScoreTables {
+            f32 cache[kScoreCacheSize];
+            f32 valence[kMaxValence + 1];
+
+            ScoreTables() {
+                for (u32 position = 0; position < kScoreCacheSize; ++position) {
+                    if (position < 3) {
+                        // The last triangle's vertices, scored lower so the next triangle does not just repeat it
+                        cache[position] = kLastTriangle;
+                    } else {
+                        const f32 scaler = 1.0f / CAST<f32>(kScoreCacheSize - 3);
+                        cache[position]  = std::pow(1.0f - CAST<f32>(position - 3) * scaler, kCacheDecayPower);
+                    }
+                }
+                valence[0] = 0.0f;
+                for (u32 count = 1; count <= kMaxValence; ++count) {
+                    valence[count] = kValenceScale * std::pow(CAST<f32>(count), -kValencePower);
+                }
+            }
+        };
+
+        const ScoreTables& GetScoreTables() {
+            static const ScoreTables tables;
+            return tables;
+        }
+
+        // Vertices with no triangles left score 0 so they stop attracting the search
+        f32 VertexScore(const ScoreTables& tables, u32 cachePosition, u32 liveTriangles) {
+            if (liveTriangles == 0) return 0.0f;
+            const f32 cache = cachePosition < kScoreCacheSize ? tables.cache[cachePosition] : 0.0f;
+            return cache + tables.valence[std::min(liveTriangles, kMaxValence)];
+        }
+
+        // FIFO post-transform cache. Entries older than the cache size are gone; advancing the clock past the size
+        // flushes everything.
+        class FifoCache {
+        public:
+            FifoCache(u32 vertexCount, u32 size) : _stamps(vertexCount, 0), _size(size), _time(size + 1) {}
+
+            // Returns true on a miss
+            bool Access(u32 vertex) {
+                if (_time - _stamps[vertex] <= _size) return false;
+                _stamps[vertex] = _time++;
+                return true;
+            }
+            void Flush() {
+                _time += _size + 1;
+            }
+
+        private:
+            vector<u32> _stamps;
+            u32 _size;
+            u32 _time;
+        };
+
+        u32 TriangleMisses(FifoCache& cache, const u32* triangle) {
+            return CAST<u32>(cache.Access(triangle[0])) + CAST<u32>(cache.Access(triangle[1])) +
+                   CAST<u32>(cache.Access(triangle[2]));
+        }
+    }  // namespace
+
+    VertexCacheStats AnalyzeVertexCache(const u32* indices, u32 indexCount, u32 vertexCount, u32 cacheSize) {
+        VertexCacheStats stats;
+        stats.triangles = indexCount / 3;
+        if (stats.triangles == 0 || vertexCount == 0) return stats;
+
+        FifoCache cache(vertexCount, std::max(cacheSize, 3u));
+        vector<u8> referenced(vertexCount, 0);
+        for (u32 i = 0; i < stats.triangles * 3; ++i) {
+            stats.misses += CAST<u32>(cache.Access(indices[i]));
+            if (!referenced[indices[i]]) {
+                referenced[indices[i]] = 1;
+                ++stats.vertices;
+            }
+        }
+
+        stats.acmr = CAST<f32>(stats.misses) / CAST<f32>(stats.triangles);
+        stats.atvr = CAST<f32>(stats.misses) / CAST<f32>(stats.vertices);
+        return stats;
+    }
+
+    void OptimizeVertexCache(u32* indices, u32 indexCount, u32 vertexCount) {
+        PROFILE_SCOPE("OptimizeVertexCache");
+
+        const u32 triangleCount = indexCount / 3;
+        if (triangleCount == 0 || vertexCount == 0) return;
+        const ScoreTables& tables = GetScoreTables();
+
+        // Triangles using each vertex, packed. The first liveTriangles[v] entries of a vertex's range are the ones
+        // not emitted yet.
+        vector<u32> liveTriangles(vertexCount, 0);
+        for (u32 i = 0; i < triangleCount * 3; ++i) {
+            ++liveTriangles[indices[i]];
+        }
+        vector<u32> offsets(vertexCount + 1, 0);
+        for (u32 vertex = 0; vertex < vertexCount; ++vertex) {
+            offsets[vertex + 1] = offsets[vertex] + liveTriangles[vertex];
+        }
+        vector<u32> adjacency(triangleCount * 3);
+        {
+            vector<u32> cursor(offsets.begin(), offsets.end() - 1);
+            for (u32 i = 0; i < triangleCount * 3; ++i) {
+                adjacency[cursor[indices[i]]++] = i / 3;
+            }
+        }
+
+        vector<f32> vertexScores(vertexCount);
+        for (u32 vertex = 0; vertex < vertexCount; ++vertex) {
+            vertexScores[vertex] = VertexScore(tables, kInvalid, liveTriangles[vertex]);
+        }
+        vector<f32> triangleScores(triangleCount);
+        for (u32 triangle = 0; triangle < triangleCount; ++triangle) {
+            const u32* corners       = indices + triangle * 3;
+            triangleScores[triangle] = vertexScores[corners[0]] + vertexScores[corners[1]] + vertexScores[corners[2]];
+        }
+
+        // The output is written to a copy since triangles are read by index until the end
+        const vector<u32> source(indices, indices + triangleCount * 3);
+        vector<u8> emitted(triangleCount, 0);
+
+        // Three extra slots for the vertices pushed by the newest triangle before the oldest fall out
+        u32 cache[kScoreCacheSize + 3];
+        u32 newCache[kScoreCacheSize + 3];
+        u32 cacheCount = 0;
+
+        u32 best        = 0;
+        u32 deadEndScan = 0;
+        for (u32 output = 0; output < triangleCount; ++output) {
+            if (best == kInvalid) {
+                // Nothing in the cache has triangles left. Restart at the next triangle in input order, which keeps
+                // the locality the source mesh already had.
+                while (emitted[deadEndScan]) {
+                    ++deadEndScan;
+                }
+                best = deadEndScan;
+            }
+
+            const u32* corners = source.data() + best * 3;
+            std::copy(corners, corners + 3, indices + output * 3);
+            emitted[best] = 1;
+
+            for (u32 corner = 0; corner < 3; ++corner) {
+                const u32 vertex = corners[corner];
+                u32* begin       = adjacency.data() + offsets[vertex];
+                u32* end         = begin + liveTriangles[vertex];
+                u32* found       = std::find(begin, end, best);
+                std::swap(*found, *(end - 1));
+                --liveTriangles[vertex];
+            }
+
+            // Move the triangle's vertices to the front, keeping the others in order behind them
+            u32 newCount = 0;
+            for (u32 corner = 0; corner < 3; ++corner) {
+                if (std::find(newCache, newCache + newCount, corners[corner]) == newCache + newCount) {
+                    newCache[newCount++] = corners[corner];
+                }
+            }
+            for (u32 i = 0; i < cacheCount; ++i) {
+                const u32 vertex = cache[i];
+                if (vertex != corners[0] && vertex != corners[1] && vertex != corners[2]) {
+                    newCache[newCount++] = vertex;
+                }
+            }
+
+            // Rescore every vertex that was or is in the cache and pick the best triangle among their neighbours.
+            // Vertices past kScoreCacheSize just fell out and lose their cache score.
+            best          = kInvalid;
+            f32 bestScore = -1.0f;
+            for (u32 position = 0; position < newCount; ++position) {
+                const u32 vertex     = newCache[position];
+                const f32 score      = VertexScore(tables, position, liveTriangles[vertex]);
+                const f32 delta      = score - vertexScores[vertex];
+                vertexScores[vertex] = score;
+
+                const u32* triangles = adjacency.data() + offsets[vertex];
+                for (u32 i = 0; i < liveTriangles[vertex]; ++i) {
+                    const u32 triangle = triangles[i];
+                    triangleScores[triangle] += delta;
+                    if (position < kScoreCacheSize && triangleScores[triangle] > bestScore) {
+                        bestScore = triangleScores[triangle];
+                        best      = triangle;
+                    }
+                }
+            }
+
+            cacheCount = std::min(newCount, kScoreCacheSize);
+            std::copy(newCache, newCache + cacheCount, cache);
+        }
+    }
+
+    void OptimizeOverdraw(u32* indices,
+                          u32 indexCount,
+                          const Vec3* positions,
+                          u32 vertexCount,
+                          u32 cacheSize,
+                          f32 threshold) {
+        PROFILE_SCOPE("OptimizeOverdraw");
+
+        const u32 triangleCount = indexCount / 3;
+        if (triangleCount == 0 || vertexCount == 0 || threshold <= 1.0f) return;
+        cacheSize = std::max(cacheSize, 3u);
+
+        // Hard boundaries are where the cache-optimised order starts over, a triangle missing all three vertices.
+        // Reordering there costs nothing.
+        vector<u32> hardClusters = {0};
+        {
+            FifoCache cache(vertexCount, cacheSize);
+            TriangleMisses(cache, indices);
+            for (u32 triangle = 1; triangle < triangleCount; ++triangle) {
+                if (TriangleMisses(cache, indices + triangle * 3) == 3) { hardClusters.push_back(triangle); }
+            }
+            hardClusters.push_back(triangleCount);
+        }
+
+        // Soft boundaries split a hard cluster further as soon as the piece so far, drawn from a cold cache, is
+        // within threshold of the whole cluster's ACMR
+        vector<u32> clusters;
+        {
+            FifoCache cache(vertexCount, cacheSize);
+            for (size_t hard = 0; hard + 1 < hardClusters.size(); ++hard) {
+                const u32 begin = hardClusters[hard];
+                const u32 end   = hardClusters[hard + 1];
+
+                cache.Flush();
+                u32 hardMisses = 0;
+                for (u32 triangle = begin; triangle < end; ++triangle) {
+                    hardMisses += TriangleMisses(cache, indices + triangle * 3);
+                }
+                const f32 limit = threshold * CAST<f32>(hardMisses) / CAST<f32>(end - begin);
+
+                cache.Flush();
+                u32 start  = begin;
+                u32 misses = 0;
+                clusters.push_back(begin);
+                for (u32 triangle = begin; triangle + 1 < end; ++triangle) {
+                    misses += TriangleMisses(cache, indices + triangle * 3);
+                    if (CAST<f32>(misses) <= limit * CAST<f32>(triangle + 1 - start)) {
+                        start  = triangle + 1;
+                        misses = 0;
+                        clusters.push_back(start);
+                        cache.Flush();
+                    }
+                }
+            }
+            clusters.push_back(triangleCount);
+        }
+        const u32 clusterCount = CAST<u32>(clusters.size() - 1);
+        if (clusterCount < 2) return;
+
+        // Area-weighted centroids and normals. Sorting by how far a cluster lies out along its own normal draws the
+        // outward-facing shell first.
+        vector<Vec3> centroids(clusterCount, Vec3(0.0f));
+        vector<Vec3> normals(clusterCount, Vec3(0.0f));
+        vector<f32> areas(clusterCount, 0.0f);
+        Vec3 meshCentroid(0.0f);
+        f32 meshArea = 0.0f;
+        for (u32 cluster = 0; cluster < clusterCount; ++cluster) {
+            for (u32 triangle = clusters[cluster]; triangle < clusters[cluster + 1]; ++triangle) {
+                const Vec3& a     = positions[indices[triangle * 3 + 0]];
+                const Vec3& b     = positions[indices[triangle * 3 + 1]];
+                const Vec3& c     = positions[indices[triangle * 3 + 2]];
+                const Vec3 normal = glm::cross(b - a, c - a);
+                const f32 area    = glm::length(normal);
+                centroids[cluster] += (a + b + c) * (area / 3.0f);
+                normals[cluster] += normal;
+                areas[cluster] += area;
+            }
+            meshCentroid += centroids[cluster];
+            meshArea += areas[cluster];
+        }
+        if (meshArea <= 0.0f) return;
+        meshCentroid = meshCentroid / meshArea;
+
+        vector<f32> keys(clusterCount, 0.0f);
+        for (u32 cluster = 0; cluster < clusterCount; ++cluster) {
+            const f32 length = glm::length(normals[cluster]);
+            if (areas[cluster] <= 0.0f || length <= 0.0f) continue;
+            const Vec3 centroid = centroids[cluster] / areas[cluster];
+            keys[cluster]       = glm::dot(centroid - meshCentroid, normals[cluster] / length);
+        }
+
+        vector<u32> order(clusterCount);
+        for (u32 cluster = 0; cluster < clusterCount; ++cluster) {
+            order[cluster] = cluster;
+        }
+        std::stable_sort(order.begin(), order.end(), [&](u32 a, u32 b) { return keys[a] > keys[b]; });
+
+        const vector<u32> source(indices, indices + triangleCount * 3);
+        u32* output = indices;
+        for (const u32 cluster : order) {
+            const u32* begin = source.data() + clusters[cluster] * 3;
+            const u32* end   = source.data() + clusters[cluster + 1] * 3;
+            output           = std::copy(begin, end, output);
+        }
+    }
+
+    u32 OptimizeVertexFetch(u32* indices, u32 indexCount, u32 vertexCount, vector<u32>& remap) {
+        remap.assign(vertexCount, kInvalid);
+        u32 next = 0;
+        for (u32 i = 0; i < indexCount; ++i) {
+            u32& mapped = remap[indices[i]];
+            if (mapped == kInvalid) { mapped = next++; }
+            indices[i] = mapped;
+        }
+        return next;
+    }
+
+    namespace {
+        template<typename T>
+        void RemapAttribute(vector<T>& attribute, const vector<u32>& remap, u32 newCount) {
+            if (attribute.empty()) return;
+            vector<T> remapped(newCount);
+            for (size_t vertex = 0; vertex < remap.size(); ++vertex) {
+                if (remap[vertex] != kInvalid) { remapped[remap[vertex]] = attribute[vertex]; }
+            }
+            attribute = std::move(remapped);
+        }
+    }  // namespace
+
+    MeshOptimizeReport OptimizeMesh(MeshData& data, const MeshOptimizeOptions& options) {
+        const auto start = std::chrono::steady_clock::now();
+
+        MeshOptimizeReport report;
+        const u32 indexCount  = CAST<u32>(data.indices.size());
+        const u32 vertexCount = data.GetVertexCount();
+        const MeshLod first   = data.lods.empty() ? MeshLod {0, indexCount, 0.0f} : data.lods[0];
+        report.before =
+          AnalyzeVertexCache(data.indices.data() + first.firstIndex, first.indexCount, vertexCount, options.cacheSize);
+
+        const auto optimizeRange = [&](const MeshLod& lod) {
+            u32* indices = data.indices.data() + lod.firstIndex;
+            OptimizeVertexCache(indices, lod.indexCount, vertexCount);
+            OptimizeOverdraw(indices,
+                             lod.indexCount,
+                             data.positions.data(),
+                             vertexCount,
+                             options.cacheSize,
+                             options.overdrawThreshold);
+        };
+        if (data.lods.empty()) {
+            optimizeRange(first);
+        } else {
+            for (const MeshLod& lod : data.lods) {
+                optimizeRange(lod);
+            }
+        }
+
+        // Simplified LODs only use vertices of the first, so numbering by first use keeps every LOD's fetch in order
+        vector<u32> remap;
+        const u32 newCount = OptimizeVertexFetch(data.indices.data(), indexCount, vertexCount, remap);
+        RemapAttribute(data.positions, remap, newCount);
+        RemapAttribute(data.normals, remap, newCount);
+        RemapAttribute(data.tangents, remap, newCount);
+        RemapAttribute(data.uvs, remap, newCount);
+        report.removedVertices = vertexCount - newCount;
+
+        report.after =
+          AnalyzeVertexCache(data.indices.data() + first.firstIndex, first.indexCount, newCount, options.cacheSize);
+        report.milliseconds = std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return report;
+    }
+
+}  // namespace X::Render
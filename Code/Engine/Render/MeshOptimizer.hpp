@@ -0,0 +1,82 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#pragma once
+
+#include "EnginePCH.h"
+
+namespace X::Render {
+
+    // A range of a mesh's indices drawn at one level of detail
+    struct MeshLod {
+        u32 firstIndex {0};
+        u32 indexCount {0};
+        f32 error {0.0f};  // Largest distance from the full detail surface, in mesh units
+    };
+
+    // A mesh as imported, before upload. Optional attributes are either empty or hold one entry per position.
+    struct MeshData {
+        vector<Vec3> positions;
+        vector<Vec3> normals;
+        vector<Vec4> tangents;  // w is the bitangent sign
+        vector<Vec2> uvs;
+        vector<u32> indices;  // Triangle list
+        // Most detailed first, all indexing the same vertices. Empty when indices is a single level.
+        vector<MeshLod> lods;
+
+        u32 GetVertexCount() const {
+            return CAST<u32>(positions.size());
+        }
+        u32 GetTriangleCount() const {
+            return CAST<u32>(indices.size() / 3);
+        }
+    };
+
+    // Post-transform cache behaviour of an index buffer on a simulated FIFO cache
+    struct VertexCacheStats {
+        u32 triangles {0};
+        u32 vertices {0};  // Referenced by at least one triangle
+        u32 misses {0};    // Vertex shader invocations
+        f32 acmr {0.0f};   // Misses per triangle. 0.5 is the limit for a regular grid, 3 is no reuse at all.
+        f32 atvr {0.0f};   // Misses per vertex. 1 is ideal.
+    };
+
+    struct MeshOptimizeOptions {
+        u32 cacheSize {16};  // FIFO entries of the modelled post-transform cache
+        // Overdraw reordering may raise the ACMR by at most this factor. 1 disables it.
+        f32 overdrawThreshold {1.05f};
+    };
+
+    struct MeshOptimizeReport {
+        VertexCacheStats before;
+        VertexCacheStats after;
+        u32 removedVertices {0};  // Not referenced by any triangle
+        f64 milliseconds {0.0};
+    };
+
+    VertexCacheStats AnalyzeVertexCache(const u32* indices, u32 indexCount, u32 vertexCount, u32 cacheSize = 16);
+
+    // Reorders triangles so consecutive ones share vertices, greedily emitting the triangle whose vertices score
+    // highest (recently used, few remaining triangles) after Forsyth. Roughly linear in the triangle count.
+    void OptimizeVertexCache(u32* indices, u32 indexCount, u32 vertexCount);
+
+    // Reorders the clusters of an already cache-optimised index buffer so the ones facing away from the mesh center
+    // come first, which is view independent and lets them occlude the rest (Sander et al., Fast Triangle Reordering
+    // for Vertex Locality and Reduced Overdraw). Clusters are split only where the ACMR stays within threshold.
+    void OptimizeOverdraw(u32* indices,
+                          u32 indexCount,
+                          const Vec3* positions,
+                          u32 vertexCount,
+                          u32 cacheSize,
+                          f32 threshold);
+
+    // Renumbers vertices in the order the indices first reference them so the vertex fetch walks memory forwards, and
+    // drops unreferenced ones. Returns the new vertex count and fills remap (old index to new, ~0u when dropped).
+    u32 OptimizeVertexFetch(u32* indices, u32 indexCount, u32 vertexCount, vector<u32>& remap);
+
+    // All three passes in order, applied to every attribute. Each LOD is reordered on its own, the report covers the
+    // most detailed one.
+    MeshOptimizeReport OptimizeMesh(MeshData& data, const MeshOptimizeOptions& options = {});
+
+}  // namespace X::Render
@@ -0,0 +1,455 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include "MeshSimplifier.hpp"
+#include "Core/Profiler.hpp"
+
+namespace X::Render {
+    namespace {
+        constexpr u32 kInvalid      = ~0u;
+        constexpr u32 kMaxPasses    = 64;
+        constexpr f32 kBorderWeight = 10.0f;
+        // Collapses may turn a triangle by at most about 75 degrees
+        constexpr f32 kMinNormalDot = 0.25f;
+        // GenerateLods stops once a LOD keeps more than this share of the previous one's triangles
+        constexpr f32 kMinReduction = 0.9f;
+
+        enum class VertexKind : u8 {
+            Manifold,  // Free to collapse onto any neighbour
+            Border,    // On an open edge, only collapses along it
+            Locked,    // On an attribute seam or a non-manifold edge
+        };
+
+        // Sum of squared distances to a set of weighted planes, as the symmetric matrix A, vector b and constant c of
+        // p'Ap + 2b'p + c
+        struct Quadric {
+            f32 a00 {0.0f}, a11 {0.0f}, a22 {0.0f};
+            f32 a01 {0.0f}, a02 {0.0f}, a12 {0.0f};
+            f32 b0 {0.0f}, b1 {0.0f}, b2 {0.0f};
+            f32 c {0.0f};
+            f32 weight {0.0f};
+        };
+
+        void AddPlane(Quadric& q, const Vec3& normal, f32 distance, f32 weight) {
+            q.a00 += weight * normal.x * normal.x;
+            q.a11 += weight * normal.y * normal.y;
+            q.a22 += weight * normal.z * normal.z;
+            q.a01 += weight * normal.x * normal.y;
+            q.a02 += weight * normal.x * normal.z;
+            q.a12 += weight * normal.y * normal.z;
+            q.b0 += weight * normal.x * distance;
+            q.b1 += weight * normal.y * distance;
+            q.b2 += weight * normal.z * distance;
+            q.c += weight * distance * distance;
+            q.weight += weight;
+        }
+
+        void AddQuadric(Quadric& q, const Quadric& other) {
+            q.a00 += other.a00;
+            q.a11 += other.a11;
+            q.a22 += other.a22;
+            q.a01 += other.a01;
+            q.a02 += other.a02;
+            q.a12 += other.a12;
+            q.b0 += other.b0;
+            q.b1 += other.b1;
+            q.b2 += other.b2;
+            q.c += other.c;
+            q.weight += other.weight;
+        }
+
+        f32 Evaluate(const Quadric& q, const Vec3& p) {
+            const f32 x = q.a00 * p.x + q.a01 * p.y + q.a02 * p.z;
+            const f32 y = q.a01 * p.x + q.a11 * p.y + q.a12 * p.z;
+            const f32 z = q.a02 * p.x + q.a12 * p.y + q.a22 * p.z;
+            const f32 value =
+              p.x * x + p.y * y + p.z * z + 2.0f * (q.b0 * p.x + q.b1 * p.y + q.b2 * p.z) + q.c;
+            return std::max(value, 0.0f);
+        }
+
+        // Weighted mean squared distance from p to the planes of both quadrics
+        f32 CollapseError(const Quadric& from, const Quadric& to, const Vec3& p) {
+            const f32 weight = from.weight + to.weight;
+            return weight > 0.0f ? (Evaluate(from, p) + Evaluate(to, p)) / weight : 0.0f;
+        }
+
+        u64 EdgeKey(u32 a, u32 b) {
+            return a < b ? CAST<u64>(a) << 32 | b : CAST<u64>(b) << 32 | a;
+        }
+
+        struct Collapse {
+            u32 from;
+            u32 to;
+            f32 error;
+        };
+
+        // Per-pass vertex to triangle lists over the welded vertices
+        struct Adjacency {
+            vector<u32> offsets;
+            vector<u32> triangles;
+
+            void Build(const vector<u32>& indices, const vector<u32>& welded, u32 vertexCount) {
+                offsets.assign(vertexCount + 1, 0);
+                for (const u32 index : indices) {
+                    ++offsets[welded[index] + 1];
+                }
+                for (u32 vertex = 0; vertex < vertexCount; ++vertex) {
+                    offsets[vertex + 1] += offsets[vertex];
+                }
+                triangles.resize(indices.size());
+                vector<u32> cursor(offsets.begin(), offsets.end() - 1);
+                for (u32 i = 0; i < CAST<u32>(indices.size()); ++i) {
+                    triangles[cursor[welded[indices[i]]]++] = i / 3;
+                }
+            }
+        };
+
+        class Simplifier {
+        public:
+            Simplifier(const u32* indices, u32 indexCount, const Vec3* positions, u32 vertexCount);
+
+            u32 Run(u32* destination, u32 targetIndexCount, f32 maxError, f32& error);
+
+        private:
+            void Weld(const Vec3* positions);
+            void Classify();
+            bool IsBorderEdge(u32 a, u32 b) const;
+            bool CanCollapse(u32 from, u32 to) const;
+            u32 Resolve(u32 index) const;
+            bool TryCollapse(const Collapse& collapse, u32& removedTriangles);
+            void RemoveDegenerates();
+
+            u32 _vertexCount;
+            f32 _scale {1.0f};          // Positions are normalised to a unit box so errors are comparable
+            vector<Vec3> _points;       // Normalised positions
+            vector<u32> _welded;        // Lowest vertex index at the same position
+            vector<u32> _wedges;        // Vertices sharing each welded vertex's position
+            vector<VertexKind> _kinds;  // Per welded vertex
+            vector<Quadric> _quadrics;  // Per welded vertex
+            vector<u32> _indices;       // Current triangles, unwelded
+            vector<u32> _targets;       // Vertex a welded vertex collapsed onto this pass
+            vector<u8> _touched;        // Welded vertices already changed this pass
+            vector<u64> _sourceEdges;   // Sorted edge keys of the source mesh, for border classification
+            Adjacency _adjacency;
+        };
+
+        Simplifier::Simplifier(const u32* indices, u32 indexCount, const Vec3* positions, u32 vertexCount)
+            : _vertexCount(vertexCount), _indices(indices, indices + indexCount / 3 * 3) {
+            Vec3 low  = positions[0];
+            Vec3 high = positions[0];
+            for (u32 vertex = 1; vertex < vertexCount; ++vertex) {
+                low  = glm::min(low, positions[vertex]);
+                high = glm::max(high, positions[vertex]);
+            }
+            const Vec3 size  = high - low;
+            const f32 extent = std::max(std::max(size.x, size.y), size.z);
+            _scale           = extent > 0.0f ? 1.0f / extent : 1.0f;
+
+            _points.resize(vertexCount);
+            for (u32 vertex = 0; vertex < vertexCount; ++vertex) {
+                _points[vertex] = (positions[vertex] - low) * _scale;
+            }
+
+            _targets.assign(vertexCount, kInvalid);
+            _touched.assign(vertexCount, 0);
+            Weld(positions);
+            RemoveDegenerates();
+            Classify();
+        }
+
+        void Simplifier::Weld(const Vec3* positions) {
+            vector<u32> order(_vertexCount);
+            for (u32 vertex = 0; vertex < _vertexCount; ++vertex) {
+                order[vertex] = vertex;
+            }
+            std::sort(order.begin(), order.end(), [&](u32 a, u32 b) {
+                const Vec3& pa = positions[a];
+                const Vec3& pb = positions[b];
+                if (pa.x != pb.x) return pa.x < pb.x;
+                if (pa.y != pb.y) return pa.y < pb.y;
+                if (pa.z != pb.z) return pa.z < pb.z;
+                return a < b;
+            });
+
+            _welded.resize(_vertexCount);
+            _wedges.assign(_vertexCount, 0);
+            for (u32 begin = 0; begin < _vertexCount;) {
+                const Vec3& p = positions[order[begin]];
+                u32 end       = begin + 1;
+                while (end < _vertexCount && positions[order[end]].x == p.x && positions[order[end]].y == p.y &&
+                       positions[order[end]].z == p.z) {
+                    ++end;
+                }
+                // Sorted by index within the group, so the first is the lowest
+                for (u32 i = begin; i < end; ++i) {
+                    _welded[order[i]] = order[begin];
+                }
+                _wedges[order[begin]] = end - begin;
+                begin                 = end;
+            }
+        }
+
+        void Simplifier::Classify() {
+            const u32 triangleCount = CAST<u32>(_indices.size() / 3);
+            _sourceEdges.clear();
+            _sourceEdges.reserve(_indices.size());
+            for (u32 triangle = 0; triangle < triangleCount; ++triangle) {
+                for (u32 corner = 0; corner < 3; ++corner) {
+                    const u32 a = _welded[_indices[triangle * 3 + corner]];
+                    const u32 b = _welded[_indices[triangle * 3 + (corner + 1) % 3]];
+                    _sourceEdges.push_back(EdgeKey(a, b));
+                }
+            }
+            std::sort(_sourceEdges.begin(), _sourceEdges.end());
+
+            _kinds.assign(_vertexCount, VertexKind::Manifold);
+            _quadrics.assign(_vertexCount, {});
+            for (u32 vertex = 0; vertex < _vertexCount; ++vertex) {
+                if (_wedges[vertex] > 1) { _kinds[vertex] = VertexKind::Locked; }
+            }
+
+            for (u32 triangle = 0; triangle < triangleCount; ++triangle) {
+                const u32 corners[3] = {_welded[_indices[triangle * 3 + 0]],
+                                        _welded[_indices[triangle * 3 + 1]],
+                                        _welded[_indices[triangle * 3 + 2]]};
+                const Vec3& p0       = _points[corners[0]];
+                Vec3 normal          = glm::cross(_points[corners[1]] - p0, _points[corners[2]] - p0);
+                const f32 length     = glm::length(normal);
+                if (length <= 0.0f) continue;
+                normal = normal / length;
+
+                for (const u32 corner : corners) {
+                    AddPlane(_quadrics[corner], normal, -glm::dot(normal, p0), length * 0.5f);
+                }
+
+                for (u32 edge = 0; edge < 3; ++edge) {
+                    const u32 a      = corners[edge];
+                    const u32 b      = corners[(edge + 1) % 3];
+                    const auto range = std::equal_range(_sourceEdges.begin(), _sourceEdges.end(), EdgeKey(a, b));
+                    const auto count = range.second - range.first;
+                    if (count > 2) {
+                        _kinds[a] = VertexKind::Locked;
+                        _kinds[b] = VertexKind::Locked;
+                    } else if (count == 1) {
+                        // A plane through the open edge, perpendicular to its triangle, holds the border in place
+                        const Vec3 direction   = _points[b] - _points[a];
+                        Vec3 border            = glm::cross(direction, normal);
+                        const f32 borderLength = glm::length(border);
+                        if (borderLength <= 0.0f) continue;
+                        border             = border / borderLength;
+                        const f32 distance = -glm::dot(border, _points[a]);
+                        const f32 weight   = glm::dot(direction, direction) * kBorderWeight;
+                        AddPlane(_quadrics[a], border, distance, weight);
+                        AddPlane(_quadrics[b], border, distance, weight);
+                        if (_kinds[a] == VertexKind::Manifold) { _kinds[a] = VertexKind::Border; }
+                        if (_kinds[b] == VertexKind::Manifold) { _kinds[b] = VertexKind::Border; }
+                    }
+                }
+            }
+        }
+
+        bool Simplifier::IsBorderEdge(u32 a, u32 b) const {
+            u32 count = 0;
+            for (u32 i = _adjacency.offsets[a]; i < _adjacency.offsets[a + 1]; ++i) {
+                const u32* corners = _indices.data() + _adjacency.triangles[i] * 3;
+                if (_welded[corners[0]] == b || _welded[corners[1]] == b || _welded[corners[2]] == b) { ++count; }
+            }
+            return count == 1;
+        }
+
+        bool Simplifier::CanCollapse(u32 from, u32 to) const {
+            switch (_kinds[from]) {
+                case VertexKind::Manifold:
+                    return true;
+                case VertexKind::Border:
+                    return _kinds[to] != VertexKind::Manifold && IsBorderEdge(from, to);
+                default:
+                    return false;
+            }
+        }
+
+        // Where a vertex ends up after this pass's collapses so far, welded
+        u32 Simplifier::Resolve(u32 index) const {
+            const u32 welded = _welded[index];
+            return _targets[welded] != kInvalid ? _welded[_targets[welded]] : welded;
+        }
+
+        bool Simplifier::TryCollapse(const Collapse& collapse, u32& removedTriangles) {
+            const Vec3& destination = _points[collapse.to];
+            u32 wedge               = kInvalid;
+            u32 removed             = 0;
+
+            for (u32 i = _adjacency.offsets[collapse.from]; i < _adjacency.offsets[collapse.from + 1]; ++i) {
+                const u32* corners  = _indices.data() + _adjacency.triangles[i] * 3;
+                const u32 welded[3] = {Resolve(corners[0]), Resolve(corners[1]), Resolve(corners[2])};
+                // Already collapsed away by an earlier collapse this pass
+                if (welded[0] == welded[1] || welded[1] == welded[2] || welded[0] == welded[2]) continue;
+
+                u32 toCorner = 3;
+                for (u32 corner = 0; corner < 3; ++corner) {
+                    if (welded[corner] == collapse.to) { toCorner = corner; }
+                }
+                if (toCorner < 3) {
+                    // Triangles on the edge disappear. Any of them gives the destination's vertex, since the edge is
+                    // not a seam.
+                    wedge = corners[toCorner];
+                    ++removed;
+                    continue;
+                }
+
+                Vec3 before[3];
+                Vec3 after[3];
+                for (u32 corner = 0; corner < 3; ++corner) {
+                    before[corner] = _points[welded[corner]];
+                    after[corner]  = welded[corner] == collapse.from ? destination : before[corner];
+                }
+                const Vec3 normalBefore = glm::cross(before[1] - before[0], before[2] - before[0]);
+                const Vec3 normalAfter  = glm::cross(after[1] - after[0], after[2] - after[0]);
+                const f32 lengths       = glm::length(normalBefore) * glm::length(normalAfter);
+                if (glm::dot(normalBefore, normalAfter) <= kMinNormalDot * lengths) return false;
+            }
+            if (wedge == kInvalid) return false;
+
+            _targets[collapse.from] = wedge;
+            _touched[collapse.from] = 1;
+            _touched[collapse.to]   = 1;
+            AddQuadric(_quadrics[collapse.to], _quadrics[collapse.from]);
+            removedTriangles += removed;
+            return true;
+        }
+
+        void Simplifier::RemoveDegenerates() {
+            u32 write = 0;
+            for (u32 read = 0; read < CAST<u32>(_indices.size()); read += 3) {
+                u32 corners[3];
+                for (u32 corner = 0; corner < 3; ++corner) {
+                    const u32 index  = _indices[read + corner];
+                    const u32 target = _targets[_welded[index]];
+                    corners[corner]  = target != kInvalid ? target : index;
+                }
+                const u32 a = _welded[corners[0]];
+                const u32 b = _welded[corners[1]];
+                const u32 c = _welded[corners[2]];
+                if (a == b || b == c || a == c) continue;
+                _indices[write++] = corners[0];
+                _indices[write++] = corners[1];
+                _indices[write++] = corners[2];
+            }
+            _indices.resize(write);
+        }
+
+        u32 Simplifier::Run(u32* destination, u32 targetIndexCount, f32 maxError, f32& error) {
+            const f32 errorLimit = maxError * _scale * maxError * _scale;
+            f32 largest          = 0.0f;
+            vector<Collapse> collapses;
+
+            for (u32 pass = 0; pass < kMaxPasses && _indices.size() > targetIndexCount; ++pass) {
+                _adjacency.Build(_indices, _welded, _vertexCount);
+
+                // Each edge is seen from both of its triangles. The duplicate is skipped once either end is touched.
+                collapses.clear();
+                for (u32 i = 0; i < CAST<u32>(_indices.size()); ++i) {
+                    const u32 a = _welded[_indices[i]];
+                    const u32 b = _welded[_indices[i % 3 == 2 ? i - 2 : i + 1]];
+                    // Negative when the direction is not allowed
+                    f32 forward  = -1.0f;
+                    f32 backward = -1.0f;
+                    if (CanCollapse(a, b)) { forward = CollapseError(_quadrics[a], _quadrics[b], _points[b]); }
+                    if (CanCollapse(b, a)) { backward = CollapseError(_quadrics[b], _quadrics[a], _points[a]); }
+                    if (forward >= 0.0f && (backward < 0.0f || forward <= backward)) {
+                        collapses.push_back({a, b, forward});
+                    } else if (backward >= 0.0f) {
+                        collapses.push_back({b, a, backward});
+                    }
+                }
+                std::sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b) {
+                    return a.error < b.error;
+                });
+
+                const u32 triangleCount   = CAST<u32>(_indices.size() / 3);
+                const u32 targetTriangles = targetIndexCount / 3;
+                u32 removed               = 0;
+                u32 performed             = 0;
+                for (const Collapse& collapse : collapses) {
+                    if (triangleCount - removed <= targetTriangles || collapse.error > errorLimit) break;
+                    if (_touched[collapse.from] || _touched[collapse.to]) continue;
+                    if (TryCollapse(collapse, removed)) {
+                        largest = std::max(largest, collapse.error);
+                        ++performed;
+                    }
+                }
+                if (performed == 0) break;
+
+                RemoveDegenerates();
+                std::fill(_targets.begin(), _targets.end(), kInvalid);
+                std::fill(_touched.begin(), _touched.end(), 0);
+            }
+
+            std::copy(_indices.begin(), _indices.end(), destination);
+            error = std::sqrt(largest) / _scale;
+            return CAST<u32>(_indices.size());
+        }
+    }  // namespace
+
+    u32 SimplifyMesh(u32* destination,
+                     const u32* indices,
+                     u32 indexCount,
+                     const Vec3* positions,
+                     u32 vertexCount,
+                     u32 targetIndexCount,
+                     f32 maxError,
+                     f32& error) {
+        PROFILE_SCOPE("SimplifyMesh");
+
+        error = 0.0f;
+        if (indexCount < 3 || vertexCount == 0) return 0;
+        Simplifier simplifier(indices, indexCount, positions, vertexCount);
+        return simplifier.Run(destination, targetIndexCount, maxError, error);
+    }
+
+    u32 GenerateLods(MeshData& data, const MeshLodOptions& options) {
+        if (data.lods.empty()) { data.lods.push_back({0, CAST<u32>(data.indices.size()), 0.0f}); }
+        if (options.ratios.empty() || data.positions.empty()) return CAST<u32>(data.lods.size());
+
+        Vec3 low  = data.positions[0];
+        Vec3 high = data.positions[0];
+        for (const Vec3& position : data.positions) {
+            low  = glm::min(low, position);
+            high = glm::max(high, position);
+        }
+        const Vec3 size    = high - low;
+        const f32 maxError = options.maxError * std::max(std::max(size.x, size.y), size.z);
+        const MeshLod base = data.lods[0];
+        vector<u32> indices(base.indexCount);
+
+        for (const f32 ratio : options.ratios) {
+            const u32 target = CAST<u32>(CAST<f32>(base.indexCount / 3) * ratio) * 3;
+            f32 error        = 0.0f;
+            const u32 count  = SimplifyMesh(indices.data(),
+                                           data.indices.data() + base.firstIndex,
+                                           base.indexCount,
+                                           data.positions.data(),
+                                           data.GetVertexCount(),
+                                           target,
+                                           maxError,
+                                           error);
+
+            const MeshLod previous = data.lods.back();
+            if (count == 0 || CAST<f32>(count) > CAST<f32>(previous.indexCount) * kMinReduction) break;
+
+            data.lods.push_back({CAST<u32>(data.indices.size()), count, std::max(error, previous.error)});
+            data.indices.insert(data.indices.end(), indices.begin(), indices.begin() + count);
+        }
+        return CAST<u32>(data.lods.size());
+    }
+
+    u32 SelectLod(const MeshLod* lods, u32 lodCount, f32 pixelsPerUnit, f32 maxPixelError) {
+        u32 lod = 0;
+        while (lod + 1 < lodCount && lods[lod + 1].error * pixelsPerUnit <= maxPixelError) {
+            ++lod;
+        }
+        return lod;
+    }
+
+}  // namespace X::Render
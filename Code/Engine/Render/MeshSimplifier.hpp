@@ -0,0 +1,45 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#pragma once
+
+#include "EnginePCH.h"
+#include "MeshOptimizer.hpp"
+
+namespace X::Render {
+
+    struct MeshLodOptions {
+        // Fraction of the full detail triangle count each further LOD aims for, decreasing. Empty for no LODs.
+        vector<f32> ratios;
+        // Largest distance a LOD may stray from the full detail surface, as a fraction of the mesh's largest
+        // dimension. LODs stop short of their ratio rather than exceed it.
+        f32 maxError {0.05f};
+    };
+
+    // Quadric error edge collapse (Garland and Heckbert). Each collapse moves one vertex onto a neighbour, cheapest
+    // first by the summed squared distance to the planes of the triangles merged into it. No vertices are moved or
+    // created, so the result indexes the same vertex buffer as the source. Collapses that would flip a triangle are
+    // skipped. Open borders only collapse along themselves, and vertices shared by several attribute seams
+    // (positions with more than one vertex) never move, so UV islands and hard edges do not tear.
+    //
+    // Stops at targetIndexCount or before the first collapse further than maxError (mesh units) from the source.
+    // Writes the indices to destination, which may be indices, and returns their count. error receives the largest
+    // distance introduced.
+    u32 SimplifyMesh(u32* destination,
+                     const u32* indices,
+                     u32 indexCount,
+                     const Vec3* positions,
+                     u32 vertexCount,
+                     u32 targetIndexCount,
+                     f32 maxError,
+                     f32& error);
+
+    // Appends a LOD per ratio to data.indices and data.lods, each simplified from the full detail mesh. Stops early
+    // once a LOD no longer removes a meaningful share of the previous one's triangles. Returns the LOD count.
+    u32 GenerateLods(MeshData& data, const MeshLodOptions& options);
+
+    // Coarsest LOD whose error stays within maxPixelError on screen, where one mesh unit spans pixelsPerUnit pixels
+    u32 SelectLod(const MeshLod* lods, u32 lodCount, f32 pixelsPerUnit, f32 maxPixelError);
+
+}  // namespace X::Render
@@ -0,0 +1,568 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include "Occlusion.hpp"
+#include "Core/JobSystem.hpp"
+#include "Core/Profiler.hpp"
+#include "Math/Simd.hpp"
+
+#if defined(ENGINE_SIMD_X86)
+    #include <immintrin.h>
+#endif
+
+namespace X::Render {
+    namespace {
+        using Detail::OcclusionTriangle;
+
+        // Occluders are clipped at the near plane and at this many screens from the center in x and y. Bounding the
+        // screen coordinates keeps the float edge functions precise.
+        constexpr f32 kGuardBand       = 4.0f;
+        constexpr u32 kClipPlaneCount  = 5;
+        constexpr u32 kMaxClipVertices = 3 + kClipPlaneCount;
+
+        // Signed distance to the near plane in clip space, negative in front of it
+        f32 NearDistance(const Vec4& clip, bool zeroToOne) {
+            return zeroToOne ? clip.z : clip.z + clip.w;
+        }
+
+        // Near plane, then the guard band's left, right, bottom and top, negative outside
+        f32 ClipDistance(const Vec4& clip, u32 plane, bool zeroToOne) {
+            switch (plane) {
+                case 1:
+                    return clip.x + kGuardBand * clip.w;
+                case 2:
+                    return kGuardBand * clip.w - clip.x;
+                case 3:
+                    return clip.y + kGuardBand * clip.w;
+                case 4:
+                    return kGuardBand * clip.w - clip.y;
+                default:
+                    return NearDistance(clip, zeroToOne);
+            }
+        }
+
+        struct ScreenTransform {
+            const Mat4& viewProjection;
+            f32 width;
+            f32 height;
+            bool zeroToOne;
+        };
+
+        struct ScreenRect {
+            f32 minX, minY, maxX, maxY;
+            f32 nearest;  // [0, 1] depth of the closest corner
+        };
+
+        // Projects the eight corners of box and returns false if any is on or behind the near plane. The corners are
+        // the min corner's clip position plus the matrix columns scaled by the box size, which is cheaper than eight
+        // full transforms.
+        bool ProjectBoxScalar(const ScreenTransform& transform, const Math::AABB& box, ScreenRect& rect) {
+            const Mat4& m    = transform.viewProjection;
+            const Vec3 size  = box.max - box.min;
+            const Vec4 base  = m * Vec4(box.min, 1.0f);
+            const Vec4 axes[3] = {m[0] * size.x, m[1] * size.y, m[2] * size.z};
+
+            rect = {std::numeric_limits<f32>::max(),
+                    std::numeric_limits<f32>::max(),
+                    -std::numeric_limits<f32>::max(),
+                    -std::numeric_limits<f32>::max(),
+                    1.0f};
+            for (u32 corner = 0; corner < 8; ++corner) {
+                Vec4 clip = base;
+                if (corner & 1) { clip += axes[0]; }
+                if (corner & 2) { clip += axes[1]; }
+                if (corner & 4) { clip += axes[2]; }
+                if (NearDistance(clip, transform.zeroToOne) < 0.0f || clip.w <= 0.0f) return false;
+
+                const f32 inverseW = 1.0f / clip.w;
+                const f32 x        = (clip.x * inverseW * 0.5f + 0.5f) * transform.width;
+                const f32 y        = (0.5f - clip.y * inverseW * 0.5f) * transform.height;
+                const f32 z        = transform.zeroToOne ? clip.z * inverseW : clip.z * inverseW * 0.5f + 0.5f;
+                rect.minX          = std::min(rect.minX, x);
+                rect.minY          = std::min(rect.minY, y);
+                rect.maxX          = std::max(rect.maxX, x);
+                rect.maxY          = std::max(rect.maxY, y);
+                rect.nearest       = std::min(rect.nearest, z);
+            }
+            return true;
+        }
+
+        // Span kernels fill rows [minY, maxY] of one tile, keeping the nearest depth. x runs from minX rounded down to
+        // the vector width, which stays inside the tile because tiles start on a multiple of it.
+        void
+        RasterizeScalar(const OcclusionTriangle& t, f32* depth, u32 stride, i32 minX, i32 minY, i32 maxX, i32 maxY) {
+            for (i32 y = minY; y <= maxY; ++y) {
+                f32* row = depth + CAST<size_t>(y) * stride;
+                for (i32 x = minX; x <= maxX; ++x) {
+                    const f32 fx = CAST<f32>(x);
+                    const f32 fy = CAST<f32>(y);
+                    const f32 e0 = t.edgeA[0] * fx + t.edgeB[0] * fy + t.edgeC[0];
+                    const f32 e1 = t.edgeA[1] * fx + t.edgeB[1] * fy + t.edgeC[1];
+                    const f32 e2 = t.edgeA[2] * fx + t.edgeB[2] * fy + t.edgeC[2];
+                    if (e0 < 0.0f || e1 < 0.0f || e2 < 0.0f) continue;
+                    row[x] = std::min(row[x], t.depthA * fx + t.depthB * fy + t.depthC);
+                }
+            }
+        }
+
+#if defined(ENGINE_SIMD_X86)
+        SIMD_TARGET_SSE4 void
+        RasterizeSSE4(const OcclusionTriangle& t, f32* depth, u32 stride, i32 minX, i32 minY, i32 maxX, i32 maxY) {
+            const __m128 lanes  = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+            const __m128 a0     = _mm_set1_ps(t.edgeA[0]);
+            const __m128 a1     = _mm_set1_ps(t.edgeA[1]);
+            const __m128 a2     = _mm_set1_ps(t.edgeA[2]);
+            const __m128 depthA = _mm_set1_ps(t.depthA);
+            const i32 startX    = minX & ~3;
+
+            for (i32 y = minY; y <= maxY; ++y) {
+                const f32 fy    = CAST<f32>(y);
+                const __m128 r0 = _mm_set1_ps(t.edgeB[0] * fy + t.edgeC[0]);
+                const __m128 r1 = _mm_set1_ps(t.edgeB[1] * fy + t.edgeC[1]);
+                const __m128 r2 = _mm_set1_ps(t.edgeB[2] * fy + t.edgeC[2]);
+                const __m128 rz = _mm_set1_ps(t.depthB * fy + t.depthC);
+                f32* row        = depth + CAST<size_t>(y) * stride;
+                for (i32 x = startX; x <= maxX; x += 4) {
+                    const __m128 xs = _mm_add_ps(_mm_set1_ps(CAST<f32>(x)), lanes);
+                    const __m128 e0 = _mm_add_ps(_mm_mul_ps(a0, xs), r0);
+                    const __m128 e1 = _mm_add_ps(_mm_mul_ps(a1, xs), r1);
+                    const __m128 e2 = _mm_add_ps(_mm_mul_ps(a2, xs), r2);
+                    // Sign bit set in any edge means outside, blendv keeps the old depth there
+                    const __m128 outside = _mm_or_ps(e0, _mm_or_ps(e1, e2));
+                    const __m128 z       = _mm_add_ps(_mm_mul_ps(depthA, xs), rz);
+                    const __m128 current = _mm_loadu_ps(row + x);
+                    _mm_storeu_ps(row + x, _mm_blendv_ps(_mm_min_ps(current, z), current, outside));
+                }
+            }
+        }
+
+        SIMD_TARGET_AVX2 void
+        RasterizeAVX2(const OcclusionTriangle& t, f32* depth, u32 stride, i32 minX, i32 minY, i32 maxX, i32 maxY) {
+            const __m256 lanes  = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+            const __m256 a0     = _mm256_set1_ps(t.edgeA[0]);
+            const __m256 a1     = _mm256_set1_ps(t.edgeA[1]);
+            const __m256 a2     = _mm256_set1_ps(t.edgeA[2]);
+            const __m256 depthA = _mm256_set1_ps(t.depthA);
+            const i32 startX    = minX & ~7;
+
+            for (i32 y = minY; y <= maxY; ++y) {
+                const f32 fy    = CAST<f32>(y);
+                const __m256 r0 = _mm256_set1_ps(t.edgeB[0] * fy + t.edgeC[0]);
+                const __m256 r1 = _mm256_set1_ps(t.edgeB[1] * fy + t.edgeC[1]);
+                const __m256 r2 = _mm256_set1_ps(t.edgeB[2] * fy + t.edgeC[2]);
+                const __m256 rz = _mm256_set1_ps(t.depthB * fy + t.depthC);
+                f32* row        = depth + CAST<size_t>(y) * stride;
+                for (i32 x = startX; x <= maxX; x += 8) {
+                    const __m256 xs      = _mm256_add_ps(_mm256_set1_ps(CAST<f32>(x)), lanes);
+                    const __m256 e0      = _mm256_fmadd_ps(a0, xs, r0);
+                    const __m256 e1      = _mm256_fmadd_ps(a1, xs, r1);
+                    const __m256 e2      = _mm256_fmadd_ps(a2, xs, r2);
+                    const __m256 outside = _mm256_or_ps(e0, _mm256_or_ps(e1, e2));
+                    const __m256 z       = _mm256_fmadd_ps(depthA, xs, rz);
+                    const __m256 current = _mm256_loadu_ps(row + x);
+                    _mm256_storeu_ps(row + x, _mm256_blendv_ps(_mm256_min_ps(current, z), current, outside));
+                }
+            }
+        }
+
+        // Corner k of the box takes max on axis i when bit i of k is set, these are the per-lane bits
+        alignas(32) constexpr f32 kCornerX[8] = {0.0f, 1.0f, 0.0f, 1.0f, 0.0f, 1.0f, 0.0f, 1.0f};
+        alignas(32) constexpr f32 kCornerY[8] = {0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f};
+        alignas(32) constexpr f32 kCornerZ[8] = {0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f};
+
+        SIMD_TARGET_SSE4 f32 HorizontalMin(__m128 v) {
+            v = _mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+            v = _mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+            return _mm_cvtss_f32(v);
+        }
+
+        SIMD_TARGET_SSE4 f32 HorizontalMax(__m128 v) {
+            v = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+            v = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+            return _mm_cvtss_f32(v);
+        }
+
+        SIMD_TARGET_AVX2 f32 HorizontalMin(__m256 v) {
+            return HorizontalMin(_mm_min_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1)));
+        }
+
+        SIMD_TARGET_AVX2 f32 HorizontalMax(__m256 v) {
+            return HorizontalMax(_mm_max_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1)));
+        }
+
+        // Four corners at a time, lanes [first, first + 4) of the corner tables
+        SIMD_TARGET_SSE4 bool
+        ProjectCornersSSE4(const ScreenTransform& transform, const Math::AABB& box, u32 first, __m128 out[3]) {
+            const Mat4& m   = transform.viewProjection;
+            const __m128 x  = _mm_add_ps(_mm_set1_ps(box.min.x),
+                                        _mm_mul_ps(_mm_set1_ps(box.max.x - box.min.x), _mm_load_ps(kCornerX + first)));
+            const __m128 y  = _mm_add_ps(_mm_set1_ps(box.min.y),
+                                        _mm_mul_ps(_mm_set1_ps(box.max.y - box.min.y), _mm_load_ps(kCornerY + first)));
+            const __m128 z  = _mm_add_ps(_mm_set1_ps(box.min.z),
+                                        _mm_mul_ps(_mm_set1_ps(box.max.z - box.min.z), _mm_load_ps(kCornerZ + first)));
+            __m128 clip[4];
+            for (i32 row = 0; row < 4; ++row) {
+                clip[row] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(m[0][row]), x),
+                                                  _mm_mul_ps(_mm_set1_ps(m[1][row]), y)),
+                                       _mm_add_ps(_mm_mul_ps(_mm_set1_ps(m[2][row]), z), _mm_set1_ps(m[3][row])));
+            }
+
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 near = transform.zeroToOne ? clip[2] : _mm_add_ps(clip[2], clip[3]);
+            if (_mm_movemask_ps(_mm_or_ps(_mm_cmplt_ps(near, zero), _mm_cmple_ps(clip[3], zero)))) return false;
+
+            const __m128 half     = _mm_set1_ps(0.5f);
+            const __m128 inverseW = _mm_div_ps(_mm_set1_ps(1.0f), clip[3]);
+            const __m128 depth    = _mm_mul_ps(clip[2], inverseW);
+            out[0] = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_mul_ps(clip[0], inverseW), half), half),
+                                _mm_set1_ps(transform.width));
+            out[1] = _mm_mul_ps(_mm_sub_ps(half, _mm_mul_ps(_mm_mul_ps(clip[1], inverseW), half)),
+                                _mm_set1_ps(transform.height));
+            out[2] = transform.zeroToOne ? depth : _mm_add_ps(_mm_mul_ps(depth, half), half);
+            return true;
+        }
+
+        SIMD_TARGET_SSE4 bool
+        ProjectBoxSSE4(const ScreenTransform& transform, const Math::AABB& box, ScreenRect& rect) {
+            __m128 low[3];
+            __m128 high[3];
+            if (!ProjectCornersSSE4(transform, box, 0, low) || !ProjectCornersSSE4(transform, box, 4, high)) {
+                return false;
+            }
+            rect.minX    = HorizontalMin(_mm_min_ps(low[0], high[0]));
+            rect.minY    = HorizontalMin(_mm_min_ps(low[1], high[1]));
+            rect.maxX    = HorizontalMax(_mm_max_ps(low[0], high[0]));
+            rect.maxY    = HorizontalMax(_mm_max_ps(low[1], high[1]));
+            rect.nearest = std::min(1.0f, HorizontalMin(_mm_min_ps(low[2], high[2])));
+            return true;
+        }
+
+        // All eight corners in one register per component
+        SIMD_TARGET_AVX2 bool
+        ProjectBoxAVX2(const ScreenTransform& transform, const Math::AABB& box, ScreenRect& rect) {
+            const Mat4& m  = transform.viewProjection;
+            const __m256 x = _mm256_fmadd_ps(
+              _mm256_set1_ps(box.max.x - box.min.x), _mm256_load_ps(kCornerX), _mm256_set1_ps(box.min.x));
+            const __m256 y = _mm256_fmadd_ps(
+              _mm256_set1_ps(box.max.y - box.min.y), _mm256_load_ps(kCornerY), _mm256_set1_ps(box.min.y));
+            const __m256 z = _mm256_fmadd_ps(
+              _mm256_set1_ps(box.max.z - box.min.z), _mm256_load_ps(kCornerZ), _mm256_set1_ps(box.min.z));
+            __m256 clip[4];
+            for (i32 row = 0; row < 4; ++row) {
+                clip[row] = _mm256_fmadd_ps(
+                  _mm256_set1_ps(m[0][row]),
+                  x,
+                  _mm256_fmadd_ps(_mm256_set1_ps(m[1][row]),
+                                  y,
+                                  _mm256_fmadd_ps(_mm256_set1_ps(m[2][row]), z, _mm256_set1_ps(m[3][row]))));
+            }
+
+            const __m256 zero = _mm256_setzero_ps();
+            const __m256 near = transform.zeroToOne ? clip[2] : _mm256_add_ps(clip[2], clip[3]);
+            const __m256 behind =
+              _mm256_or_ps(_mm256_cmp_ps(near, zero, _CMP_LT_OQ), _mm256_cmp_ps(clip[3], zero, _CMP_LE_OQ));
+            if (_mm256_movemask_ps(behind)) return false;
+
+            const __m256 half     = _mm256_set1_ps(0.5f);
+            const __m256 inverseW = _mm256_div_ps(_mm256_set1_ps(1.0f), clip[3]);
+            const __m256 depth    = _mm256_mul_ps(clip[2], inverseW);
+            const __m256 sx       = _mm256_mul_ps(_mm256_fmadd_ps(_mm256_mul_ps(clip[0], inverseW), half, half),
+                                            _mm256_set1_ps(transform.width));
+            const __m256 sy       = _mm256_mul_ps(_mm256_fnmadd_ps(_mm256_mul_ps(clip[1], inverseW), half, half),
+                                            _mm256_set1_ps(transform.height));
+            const __m256 sz       = transform.zeroToOne ? depth : _mm256_fmadd_ps(depth, half, half);
+
+            rect.minX    = HorizontalMin(sx);
+            rect.minY    = HorizontalMin(sy);
+            rect.maxX    = HorizontalMax(sx);
+            rect.maxY    = HorizontalMax(sy);
+            rect.nearest = std::min(1.0f, HorizontalMin(sz));
+            return true;
+        }
+#endif
+    }  // namespace
+
+    OcclusionCuller::OcclusionCuller() {
+        Resize(256, 128);
+    }
+
+    void OcclusionCuller::Resize(u32 width, u32 height) {
+        _tilesX = std::max(1u, (width + kTileSize - 1) / kTileSize);
+        _tilesY = std::max(1u, (height + kTileSize - 1) / kTileSize);
+        _width  = _tilesX * kTileSize;
+        _height = _tilesY * kTileSize;
+
+        _depth.assign(CAST<size_t>(_width) * _height, 1.0f);
+        _blockDepth.assign(CAST<size_t>(_width / kBlockSize) * (_height / kBlockSize), 1.0f);
+        _tileBins.resize(CAST<size_t>(_tilesX) * _tilesY);
+        for (auto& bin : _tileBins) {
+            bin.clear();
+        }
+        _triangles.clear();
+    }
+
+    void OcclusionCuller::Begin(const Mat4& viewProjection, bool zeroToOne) {
+        _viewProjection = viewProjection;
+        _zeroToOne      = zeroToOne;
+        _stats          = {};
+        _triangles.clear();
+        for (auto& bin : _tileBins) {
+            bin.clear();
+        }
+    }
+
+    void OcclusionCuller::AddOccluder(
+      const Vec3* positions, u32 vertexCount, const u32* indices, u32 indexCount, const Mat4& world) {
+        const Mat4 worldViewProjection = _viewProjection * world;
+        _clipVertices.resize(vertexCount);
+        for (u32 i = 0; i < vertexCount; ++i) {
+            _clipVertices[i] = worldViewProjection * Vec4(positions[i], 1.0f);
+        }
+
+        ++_stats.occluders;
+        _stats.triangles += indexCount / 3;
+        for (u32 i = 0; i + 2 < indexCount; i += 3) {
+            Vec4 polygon[2][kMaxClipVertices];
+            polygon[0][0] = _clipVertices[indices[i]];
+            polygon[0][1] = _clipVertices[indices[i + 1]];
+            polygon[0][2] = _clipVertices[indices[i + 2]];
+
+            // Sutherland-Hodgman against each plane the triangle crosses. Each one adds at most one vertex.
+            u32 count   = 3;
+            u32 current = 0;
+            for (u32 plane = 0; plane < kClipPlaneCount && count > 0; ++plane) {
+                const Vec4* in = polygon[current];
+                f32 distance[kMaxClipVertices];
+                u32 inside = 0;
+                for (u32 k = 0; k < count; ++k) {
+                    distance[k] = ClipDistance(in[k], plane, _zeroToOne);
+                    inside += distance[k] >= 0.0f;
+                }
+                if (inside == count) continue;
+                if (inside == 0) {
+                    count = 0;
+                    break;
+                }
+
+                Vec4* out    = polygon[current ^ 1];
+                u32 outCount = 0;
+                for (u32 k = 0; k < count; ++k) {
+                    const u32 next = (k + 1) % count;
+                    if (distance[k] >= 0.0f) { out[outCount++] = in[k]; }
+                    if ((distance[k] >= 0.0f) != (distance[next] >= 0.0f)) {
+                        const f32 t     = distance[k] / (distance[k] - distance[next]);
+                        out[outCount++] = in[k] + (in[next] - in[k]) * t;
+                    }
+                }
+                count   = outCount;
+                current ^= 1;
+            }
+
+            for (u32 k = 1; k + 1 < count; ++k) {
+                SetupTriangle(polygon[current][0], polygon[current][k], polygon[current][k + 1]);
+            }
+        }
+    }
+
+    Vec3 OcclusionCuller::ToScreen(const Vec4& clip) const {
+        const f32 inverseW = 1.0f / clip.w;
+        const f32 z        = clip.z * inverseW;
+        return {(clip.x * inverseW * 0.5f + 0.5f) * CAST<f32>(_width),
+                (0.5f - clip.y * inverseW * 0.5f) * CAST<f32>(_height),
+                _zeroToOne ? z : z * 0.5f + 0.5f};
+    }
+
+    void OcclusionCuller::SetupTriangle(const Vec4& a, const Vec4& b, const Vec4& c) {
+        if (a.w <= 0.0f || b.w <= 0.0f || c.w <= 0.0f) return;
+
+        Vec3 p[3] = {ToScreen(a), ToScreen(b), ToScreen(c)};
+        f32 area  = (p[1].x - p[0].x) * (p[2].y - p[0].y) - (p[2].x - p[0].x) * (p[1].y - p[0].y);
+        if (std::abs(area) < 1.0e-6f) return;
+        if (area < 0.0f) {
+            std::swap(p[1], p[2]);
+            area = -area;
+        }
+
+        // Pixel x is covered when its center x + 0.5 is inside
+        OcclusionTriangle t;
+        t.minX = std::max(0, CAST<i32>(std::ceil(std::min({p[0].x, p[1].x, p[2].x}) - 0.5f)));
+        t.minY = std::max(0, CAST<i32>(std::ceil(std::min({p[0].y, p[1].y, p[2].y}) - 0.5f)));
+        t.maxX = std::min(CAST<i32>(_width) - 1, CAST<i32>(std::floor(std::max({p[0].x, p[1].x, p[2].x}) - 0.5f)));
+        t.maxY = std::min(CAST<i32>(_height) - 1, CAST<i32>(std::floor(std::max({p[0].y, p[1].y, p[2].y}) - 0.5f)));
+        if (t.minX > t.maxX || t.minY > t.maxY) return;
+
+        // Edge k runs from p[k] to p[k + 1] and is positive on the side of the third vertex. The half-pixel offset
+        // to centers is folded into C.
+        for (u32 k = 0; k < 3; ++k) {
+            const Vec3& from = p[k];
+            const Vec3& to   = p[(k + 1) % 3];
+            t.edgeA[k]       = from.y - to.y;
+            t.edgeB[k]       = to.x - from.x;
+            t.edgeC[k]       = -(t.edgeA[k] * from.x + t.edgeB[k] * from.y) + 0.5f * (t.edgeA[k] + t.edgeB[k]);
+        }
+
+        const f32 dzdx = ((p[1].z - p[0].z) * (p[2].y - p[0].y) - (p[2].z - p[0].z) * (p[1].y - p[0].y)) / area;
+        const f32 dzdy = ((p[2].z - p[0].z) * (p[1].x - p[0].x) - (p[1].z - p[0].z) * (p[2].x - p[0].x)) / area;
+        t.depthA       = dzdx;
+        t.depthB       = dzdy;
+        t.depthC       = p[0].z - dzdx * (p[0].x - 0.5f) - dzdy * (p[0].y - 0.5f);
+
+        const u32 index = CAST<u32>(_triangles.size());
+        _triangles.push_back(t);
+        for (u32 ty = CAST<u32>(t.minY) / kTileSize; ty <= CAST<u32>(t.maxY) / kTileSize; ++ty) {
+            for (u32 tx = CAST<u32>(t.minX) / kTileSize; tx <= CAST<u32>(t.maxX) / kTileSize; ++tx) {
+                _tileBins[ty * _tilesX + tx].push_back(index);
+            }
+        }
+    }
+
+    void OcclusionCuller::Rasterize(Core::JobSystem* jobs) {
+        PROFILE_SCOPE("OcclusionRasterize");
+        _stats.rasterizedTriangles = CAST<u32>(_triangles.size());
+
+        const u32 tileCount       = _tilesX * _tilesY;
+        const auto rasterizeTiles = [this](u32 begin, u32 end) {
+            for (u32 tile = begin; tile < end; ++tile) {
+                RasterizeTile(tile);
+            }
+        };
+        if (jobs && tileCount > 1) {
+            jobs->ParallelFor(tileCount, 1, rasterizeTiles);
+        } else {
+            rasterizeTiles(0, tileCount);
+        }
+    }
+
+    void OcclusionCuller::RasterizeTile(u32 tile) {
+        const i32 tileX = CAST<i32>((tile % _tilesX) * kTileSize);
+        const i32 tileY = CAST<i32>((tile / _tilesX) * kTileSize);
+        for (u32 y = 0; y < kTileSize; ++y) {
+            f32* row = _depth.data() + CAST<size_t>(tileY + y) * _width + tileX;
+            std::fill(row, row + kTileSize, 1.0f);
+        }
+
+        const Math::Simd::Level level = Math::Simd::GetLevel();
+        for (const u32 index : _tileBins[tile]) {
+            const OcclusionTriangle& t = _triangles[index];
+            const i32 minX             = std::max(t.minX, tileX);
+            const i32 minY             = std::max(t.minY, tileY);
+            const i32 maxX             = std::min(t.maxX, tileX + CAST<i32>(kTileSize) - 1);
+            const i32 maxY             = std::min(t.maxY, tileY + CAST<i32>(kTileSize) - 1);
+            switch (level) {
+#if defined(ENGINE_SIMD_X86)
+                case Math::Simd::Level::AVX2:
+                    RasterizeAVX2(t, _depth.data(), _width, minX, minY, maxX, maxY);
+                    break;
+                case Math::Simd::Level::SSE4:
+                    RasterizeSSE4(t, _depth.data(), _width, minX, minY, maxX, maxY);
+                    break;
+#endif
+                default:
+                    RasterizeScalar(t, _depth.data(), _width, minX, minY, maxX, maxY);
+                    break;
+            }
+        }
+
+        // Farthest depth of each block, so one comparison can reject a box behind all of it
+        const u32 blocksPerRow = _width / kBlockSize;
+        for (u32 by = 0; by < kTileSize; by += kBlockSize) {
+            for (u32 bx = 0; bx < kTileSize; bx += kBlockSize) {
+                f32 farthest = 0.0f;
+                for (u32 y = 0; y < kBlockSize; ++y) {
+                    const f32* row = _depth.data() + CAST<size_t>(tileY + by + y) * _width + tileX + bx;
+                    for (u32 x = 0; x < kBlockSize; ++x) {
+                        farthest = std::max(farthest, row[x]);
+                    }
+                }
+                _blockDepth[((tileY + by) / kBlockSize) * blocksPerRow + (tileX + bx) / kBlockSize] = farthest;
+            }
+        }
+    }
+
+    bool OcclusionCuller::IsVisible(const Math::AABB& box) const {
+        ScreenRect rect;
+        bool inFront;
+        const ScreenTransform transform {_viewProjection, CAST<f32>(_width), CAST<f32>(_height), _zeroToOne};
+        switch (Math::Simd::GetLevel()) {
+#if defined(ENGINE_SIMD_X86)
+            case Math::Simd::Level::AVX2:
+                inFront = ProjectBoxAVX2(transform, box, rect);
+                break;
+            case Math::Simd::Level::SSE4:
+                inFront = ProjectBoxSSE4(transform, box, rect);
+                break;
+#endif
+            default:
+                inFront = ProjectBoxScalar(transform, box, rect);
+                break;
+        }
+        // Boxes through the near plane are too close to be hidden
+        if (!inFront) return true;
+
+        const f32 minX    = rect.minX;
+        const f32 minY    = rect.minY;
+        const f32 maxX    = rect.maxX;
+        const f32 maxY    = rect.maxY;
+        const f32 nearest = rect.nearest;
+
+        // Off screen is the frustum culler's call
+        const f32 width  = CAST<f32>(_width);
+        const f32 height = CAST<f32>(_height);
+        if (maxX < 0.0f || maxY < 0.0f || minX >= width || minY >= height) return true;
+
+        // Every pixel the rectangle touches, not just those whose centers it covers
+        const i32 x0 = CAST<i32>(std::max(minX, 0.0f));
+        const i32 y0 = CAST<i32>(std::max(minY, 0.0f));
+        const i32 x1 = CAST<i32>(std::min(maxX, width - 1.0f));
+        const i32 y1 = CAST<i32>(std::min(maxY, height - 1.0f));
+
+        const i32 blockSize    = CAST<i32>(kBlockSize);
+        const u32 blocksPerRow = _width / kBlockSize;
+        for (i32 by = y0 / blockSize; by <= y1 / blockSize; ++by) {
+            for (i32 bx = x0 / blockSize; bx <= x1 / blockSize; ++bx) {
+                if (nearest > _blockDepth[by * blocksPerRow + bx]) continue;
+
+                // Some pixel in this block is at least as far as the box, find out if it is one the box covers
+                const i32 px0 = std::max(x0, bx * blockSize);
+                const i32 py0 = std::max(y0, by * blockSize);
+                const i32 px1 = std::min(x1, bx * blockSize + blockSize - 1);
+                const i32 py1 = std::min(y1, by * blockSize + blockSize - 1);
+                for (i32 y = py0; y <= py1; ++y) {
+                    const f32* row = _depth.data() + CAST<size_t>(y) * _width;
+                    for (i32 x = px0; x <= px1; ++x) {
+                        if (nearest <= row[x]) return true;
+                    }
+                }
+            }
+        }
+        return false;
+    }
+
+    u32 OcclusionCuller::Filter(const Math::AABBSoA& boxes, u32* indices, u32 count, Core::JobSystem* jobs) {
+        PROFILE_SCOPE("OcclusionFilter");
+        _visibleFlags.resize(count);
+
+        const auto testBoxes = [this, &boxes, indices](u32 begin, u32 end) {
+            for (u32 i = begin; i < end; ++i) {
+                const u32 index = indices[i];
+                const Vec3 center(boxes.centerX[index], boxes.centerY[index], boxes.centerZ[index]);
+                const Vec3 extent(boxes.extentX[index], boxes.extentY[index], boxes.extentZ[index]);
+                _visibleFlags[i] = IsVisible({center - extent, center + extent});
+            }
+        };
+        if (jobs && count > kFilterBatch) {
+            jobs->ParallelFor(count, kFilterBatch, testBoxes);
+        } else {
+            testBoxes(0, count);
+        }
+
+        u32 visible = 0;
+        for (u32 i = 0; i < count; ++i) {
+            if (_visibleFlags[i]) { indices[visible++] = indices[i]; }
+        }
+        _stats.tested += count;
+        _stats.occluded += count - visible;
+        return visible;
+    }
+}  // namespace X::Render
@@ -0,0 +1,109 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#pragma once
+
+#include "EnginePCH.h"
+#include "Math/Bounds.hpp"
+
+namespace X::Render {
+
+    namespace Detail {
+        // Edge functions are A * x + B * y + C at pixel centers, positive inside. Depth is a plane in screen space.
+        struct OcclusionTriangle {
+            f32 edgeA[3];
+            f32 edgeB[3];
+            f32 edgeC[3];
+            f32 depthA, depthB, depthC;
+            i32 minX, minY, maxX, maxY;  // Inclusive pixel bounds, clamped to the buffer
+        };
+    }  // namespace Detail
+
+    struct OcclusionStats {
+        u32 occluders {0};
+        u32 triangles {0};            // Occluder triangles submitted
+        u32 rasterizedTriangles {0};  // Left after near clipping and screen rejection, clipped pieces count separately
+        u32 tested {0};
+        u32 occluded {0};
+
+        f32 GetRejectedPercent() const {
+            return tested > 0 ? 100.0f * CAST<f32>(occluded) / CAST<f32>(tested) : 0.0f;
+        }
+    };
+
+    // Software occlusion culling. A few large occluders (walls, floors, terrain hulls, simplified to tens of triangles
+    // each) are rasterized on the CPU into a small depth buffer, and occludee bounds are then tested against it so
+    // hidden objects never reach the render queue. Run it after frustum culling, on the frustum culler's visible list.
+    //
+    // Per frame:
+    //   Begin(viewProjection)  clears the occluder list
+    //   AddOccluder(...)       transforms, near-clips and bins triangles into 32x32 pixel tiles
+    //   Rasterize(jobs)        fills the tiles in parallel, 8 pixels at a time on AVX2 (4 on SSE4), keeping the
+    //                          nearest depth per pixel, then reduces each 8x8 block to its farthest depth
+    //   Filter / IsVisible     project each box to a screen rectangle and its nearest depth. The box is hidden when
+    //                          it is behind every block it covers, or failing that every pixel.
+    //
+    // The buffer holds [0, 1] depth whatever the projection's range. Occluders are drawn double-sided, so winding does
+    // not matter. Pixels count as covered when their center is, so an occluder can hide up to half a pixel more than it
+    // really does at its edges. Author occluder meshes slightly inside the surfaces they stand for. Tests are read-only
+    // and may run on several threads once Rasterize returns.
+    class OcclusionCuller {
+    public:
+        static constexpr u32 kTileSize  = 32;
+        static constexpr u32 kBlockSize = 8;  // Pixels per side of a hierarchical depth entry
+
+        OcclusionCuller();
+
+        // Rounded up to whole tiles. Each pixel costs 4 bytes, 256x128 is typical.
+        void Resize(u32 width, u32 height);
+        void Begin(const Mat4& viewProjection, bool zeroToOne);
+
+        // positions are in object space, indices a triangle list. Nothing is kept after the call returns.
+        void AddOccluder(const Vec3* positions, u32 vertexCount, const u32* indices, u32 indexCount, const Mat4& world);
+        void Rasterize(Core::JobSystem* jobs = nullptr);
+
+        // Not counted in the stats
+        bool IsVisible(const Math::AABB& box) const;
+        // Removes the occluded entries from indices (into boxes) in place, keeping the order of the rest. Returns the
+        // new count.
+        u32 Filter(const Math::AABBSoA& boxes, u32* indices, u32 count, Core::JobSystem* jobs = nullptr);
+
+        u32 GetWidth() const {
+            return _width;
+        }
+        u32 GetHeight() const {
+            return _height;
+        }
+        // Row-major nearest depth, 1 where nothing was drawn. For debug views.
+        const f32* GetDepth() const {
+            return _depth.data();
+        }
+        const OcclusionStats& GetStats() const {
+            return _stats;
+        }
+
+    private:
+        static constexpr u32 kFilterBatch = 1024;
+
+        Vec3 ToScreen(const Vec4& clip) const;
+        void SetupTriangle(const Vec4& a, const Vec4& b, const Vec4& c);
+        void RasterizeTile(u32 tile);
+
+        u32 _width {0};
+        u32 _height {0};
+        u32 _tilesX {0};
+        u32 _tilesY {0};
+        Mat4 _viewProjection {1.0f};
+        bool _zeroToOne {true};
+
+        vector<f32> _depth;
+        vector<f32> _blockDepth;  // Farthest depth in each kBlockSize square
+        vector<Detail::OcclusionTriangle> _triangles;
+        vector<vector<u32>> _tileBins;
+        vector<Vec4> _clipVertices;
+        vector<u8> _visibleFlags;
+        OcclusionStats _stats;
+    };
+
+}  // namespace X::Render
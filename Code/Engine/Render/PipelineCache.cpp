@@ -0,0 +1,563 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include "PipelineCache.hpp"
+#include "Core/Log.hpp"
+#include "Core/Profiler.hpp"
+#include "Core/Timing.hpp"
+
+#include <filesystem>
+
+namespace X::Render {
+    using namespace X::Core;
+
+    namespace {
+        namespace fs = std::filesystem;
+
+        constexpr u32 kShaderCacheMagic   = 0x48535843;  // 'XCSH'
+        constexpr u32 kShaderCacheVersion = 1;
+
+        struct ShaderCacheHeader {
+            u32 magic {kShaderCacheMagic};
+            u32 version {kShaderCacheVersion};
+            u32 api {0};
+            u32 count {0};
+        };
+
+        struct ShaderCacheEntry {
+            u64 key {0};
+            u64 size {0};  // Bytecode follows
+        };
+
+        const char* GetBackendName(GraphicsAPI api) {
+            switch (api) {
+                case GraphicsAPI::D3D11:
+                    return "d3d11";
+                case GraphicsAPI::D3D12:
+                    return "d3d12";
+                case GraphicsAPI::Vulkan:
+                    return "vk";
+                case GraphicsAPI::OpenGL:
+                    return "gl";
+                case GraphicsAPI::Metal:
+                    return "mtl";
+                default:
+                    return "unknown";
+            }
+        }
+
+        // FNV-1a, fed field by field so struct padding never reaches the hash
+        class Hasher {
+        public:
+            void AddBytes(const void* data, size_t size) {
+                const u8* bytes = CAST<const u8*>(data);
+                for (size_t i = 0; i < size; ++i) {
+                    _value ^= bytes[i];
+                    _value *= 0x100000001B3ull;
+                }
+            }
+
+            template<typename T>
+                requires std::is_arithmetic_v<T> || std::is_enum_v<T>
+            void Add(T value) {
+                AddBytes(&value, sizeof(T));
+            }
+
+            // Null and empty hash differently
+            void AddString(const char* text) {
+                Add(text != nullptr);
+                if (text) { AddBytes(text, std::strlen(text) + 1); }
+            }
+
+            void AddPointer(const void* pointer) {
+                Add(RCAST<uptr>(pointer));
+            }
+
+            u64 GetValue() const {
+                return _value;
+            }
+
+        private:
+            u64 _value {0xCBF29CE484222325ull};
+        };
+
+        u64 HashShader(const Diligent::ShaderCreateInfo& info, GraphicsAPI api) {
+            Hasher hasher;
+            hasher.Add(api);
+            const size_t length = info.SourceLength > 0 ? info.SourceLength : std::strlen(info.Source);
+            hasher.Add(length);
+            hasher.AddBytes(info.Source, length);
+            hasher.AddString(info.EntryPoint);
+            hasher.Add(info.Desc.ShaderType);
+            hasher.Add(info.Desc.UseCombinedTextureSamplers);
+            hasher.AddString(info.Desc.CombinedSamplerSuffix);
+            hasher.Add(info.SourceLanguage);
+            hasher.Add(info.ShaderCompiler);
+            hasher.Add(info.CompileFlags);
+            hasher.Add(info.HLSLVersion.Major);
+            hasher.Add(info.HLSLVersion.Minor);
+            hasher.Add(info.Macros.Count);
+            for (u32 i = 0; i < info.Macros.Count; ++i) {
+                hasher.AddString(info.Macros.Elements[i].Name);
+                hasher.AddString(info.Macros.Elements[i].Definition);
+            }
+            return hasher.GetValue();
+        }
+
+        void HashSampler(Hasher& hasher, const Diligent::SamplerDesc& desc) {
+            hasher.Add(desc.MinFilter);
+            hasher.Add(desc.MagFilter);
+            hasher.Add(desc.MipFilter);
+            hasher.Add(desc.AddressU);
+            hasher.Add(desc.AddressV);
+            hasher.Add(desc.AddressW);
+            hasher.Add(desc.Flags);
+            hasher.Add(desc.UnnormalizedCoords);
+            hasher.Add(desc.MipLODBias);
+            hasher.Add(desc.MaxAnisotropy);
+            hasher.Add(desc.ComparisonFunc);
+            for (const f32 channel : desc.BorderColor) {
+                hasher.Add(channel);
+            }
+            hasher.Add(desc.MinLOD);
+            hasher.Add(desc.MaxLOD);
+        }
+
+        void HashResourceLayout(Hasher& hasher, const Diligent::PipelineResourceLayoutDesc& layout) {
+            hasher.Add(layout.DefaultVariableType);
+            hasher.Add(layout.DefaultVariableMergeStages);
+            hasher.Add(layout.NumVariables);
+            for (u32 i = 0; i < layout.NumVariables; ++i) {
+                const Diligent::ShaderResourceVariableDesc& variable = layout.Variables[i];
+                hasher.Add(variable.ShaderStages);
+                hasher.AddString(variable.Name);
+                hasher.Add(variable.Type);
+                hasher.Add(variable.Flags);
+            }
+            hasher.Add(layout.NumImmutableSamplers);
+            for (u32 i = 0; i < layout.NumImmutableSamplers; ++i) {
+                const Diligent::ImmutableSamplerDesc& sampler = layout.ImmutableSamplers[i];
+                hasher.Add(sampler.ShaderStages);
+                hasher.AddString(sampler.SamplerOrTextureName);
+                HashSampler(hasher, sampler.Desc);
+            }
+        }
+
+        void HashGraphicsState(Hasher& hasher, const Diligent::GraphicsPipelineDesc& desc) {
+            const Diligent::BlendStateDesc& blend = desc.BlendDesc;
+            hasher.Add(blend.AlphaToCoverageEnable);
+            hasher.Add(blend.IndependentBlendEnable);
+            for (const Diligent::RenderTargetBlendDesc& target : blend.RenderTargets) {
+                hasher.Add(target.BlendEnable);
+                hasher.Add(target.LogicOperationEnable);
+                hasher.Add(target.SrcBlend);
+                hasher.Add(target.DestBlend);
+                hasher.Add(target.BlendOp);
+                hasher.Add(target.SrcBlendAlpha);
+                hasher.Add(target.DestBlendAlpha);
+                hasher.Add(target.BlendOpAlpha);
+                hasher.Add(target.LogicOp);
+                hasher.Add(target.RenderTargetWriteMask);
+            }
+            hasher.Add(desc.SampleMask);
+
+            const Diligent::RasterizerStateDesc& rasterizer = desc.RasterizerDesc;
+            hasher.Add(rasterizer.FillMode);
+            hasher.Add(rasterizer.CullMode);
+            hasher.Add(rasterizer.FrontCounterClockwise);
+            hasher.Add(rasterizer.DepthClipEnable);
+            hasher.Add(rasterizer.ScissorEnable);
+            hasher.Add(rasterizer.AntialiasedLineEnable);
+            hasher.Add(rasterizer.DepthBias);
+            hasher.Add(rasterizer.DepthBiasClamp);
+            hasher.Add(rasterizer.SlopeScaledDepthBias);
+
+            const Diligent::DepthStencilStateDesc& depth = desc.DepthStencilDesc;
+            hasher.Add(depth.DepthEnable);
+            hasher.Add(depth.DepthWriteEnable);
+            hasher.Add(depth.DepthFunc);
+            hasher.Add(depth.StencilEnable);
+            hasher.Add(depth.StencilReadMask);
+            hasher.Add(depth.StencilWriteMask);
+            for (const Diligent::StencilOpDesc* face : {&depth.FrontFace, &depth.BackFace}) {
+                hasher.Add(face->StencilFailOp);
+                hasher.Add(face->StencilDepthFailOp);
+                hasher.Add(face->StencilPassOp);
+                hasher.Add(face->StencilFunc);
+            }
+
+            hasher.Add(desc.InputLayout.NumElements);
+            for (u32 i = 0; i < desc.InputLayout.NumElements; ++i) {
+                const Diligent::LayoutElement& element = desc.InputLayout.LayoutElements[i];
+                hasher.AddString(element.HLSLSemantic);
+                hasher.Add(element.InputIndex);
+                hasher.Add(element.BufferSlot);
+                hasher.Add(element.NumComponents);
+                hasher.Add(element.ValueType);
+                hasher.Add(element.IsNormalized);
+                hasher.Add(element.RelativeOffset);
+                hasher.Add(element.Stride);
+                hasher.Add(element.Frequency);
+                hasher.Add(element.InstanceDataStepRate);
+            }
+
+            hasher.Add(desc.PrimitiveTopology);
+            hasher.Add(desc.NumViewports);
+            hasher.Add(desc.NumRenderTargets);
+            hasher.Add(desc.SubpassIndex);
+            hasher.Add(desc.ShadingRateFlags);
+            for (u32 i = 0; i < desc.NumRenderTargets; ++i) {
+                hasher.Add(desc.RTVFormats[i]);
+            }
+            hasher.Add(desc.DSVFormat);
+            hasher.Add(desc.ReadOnlyDSV);
+            hasher.Add(desc.SmplDesc.Count);
+            hasher.Add(desc.SmplDesc.Quality);
+        }
+    }  // namespace
+
+    PipelineCache::~PipelineCache() {
+        Shutdown();
+    }
+
+    bool PipelineCache::Initialize(IRenderDevice* device, GraphicsAPI api, const str& directory) {
+        if (!device) {
+            Log::Error("PipelineCache requires a device");
+            return false;
+        }
+        _device    = device;
+        _api       = api;
+        _directory = directory;
+
+        if (!_directory.empty()) {
+            std::error_code error;
+            fs::create_directories(_directory, error);
+            if (error) {
+                Log::Warn("Cannot create pipeline cache directory {}: {}", _directory, error.message());
+                _directory.clear();
+            }
+        }
+
+        if (!_directory.empty()) { LoadShaders(); }
+        LoadPipelines();
+        _stats.driverCache = _driverCache != nullptr;
+
+        Log::Info("Pipeline cache: {} shaders from disk{}, {}",
+                  _bytecode.size(),
+                  _directory.empty() ? " (memory only)" : "",
+                  _stats.driverCache ? "driver pipeline cache enabled" : "no driver pipeline cache on this backend");
+        return true;
+    }
+
+    void PipelineCache::Shutdown() {
+        if (!_device) return;
+        Save();
+
+        std::lock_guard guard(_lock);
+        _pipelines.clear();
+        _shaders.clear();
+        _shaderKeys.clear();
+        _bytecode.clear();
+        _driverCache.Release();
+        _device = nullptr;
+    }
+
+    bool PipelineCache::Save() {
+        if (!_device || _directory.empty()) return true;
+
+        std::lock_guard guard(_lock);
+        const bool saved = SaveShaders() && SavePipelines();
+        if (saved) { _bytecodeChanged = false; }
+        return saved;
+    }
+
+    RefCntAutoPtr<IShader> PipelineCache::CreateShader(const Diligent::ShaderCreateInfo& createInfo) {
+        PROFILE_SCOPE("PipelineCache::CreateShader");
+        const auto start = Clock::now();
+        const char* name = createInfo.Desc.Name ? createInfo.Desc.Name : "unnamed";
+
+        // Files and #includes are read through the factory and never reach the key, so caching them would hand back
+        // stale bytecode after an edit
+        if (!createInfo.Source || createInfo.pShaderSourceStreamFactory || createInfo.FilePath) {
+            RefCntAutoPtr<IShader> shader;
+            _device->CreateShader(createInfo, &shader);
+            if (!shader) {
+                Log::Error("Failed to compile shader {}", name);
+                return {};
+            }
+            std::lock_guard guard(_lock);
+            ++_stats.shadersCompiled;
+            _stats.shaderMs += ElapsedMs(start);
+            return shader;
+        }
+
+        const u64 key = HashShader(createInfo, _api);
+        const vector<u8>* bytecode = nullptr;
+        {
+            std::lock_guard guard(_lock);
+            if (const auto it = _shaders.find(key); it != _shaders.end()) {
+                ++_stats.shaderHits;
+                return it->second;
+            }
+            // Entries are never erased or replaced while the cache is running, so the pointer stays valid unlocked
+            if (const auto it = _bytecode.find(key); it != _bytecode.end()) { bytecode = &it->second; }
+        }
+
+        // Compiling can take a while, other threads keep going. Two threads racing on one key compile twice and the
+        // first to finish wins.
+        RefCntAutoPtr<IShader> shader;
+        bool loaded = false;
+        if (bytecode) {
+            Diligent::ShaderCreateInfo binaryInfo = createInfo;
+            binaryInfo.Source                     = nullptr;
+            binaryInfo.FilePath                   = nullptr;
+            binaryInfo.pShaderSourceStreamFactory = nullptr;
+            binaryInfo.Macros                     = {};
+            binaryInfo.ByteCode                   = bytecode->data();
+            binaryInfo.ByteCodeSize               = bytecode->size();
+            _device->CreateShader(binaryInfo, &shader);
+            loaded = shader != nullptr;
+            if (!loaded) { Log::Warn("Cached bytecode for shader {} was rejected, recompiling", name); }
+        }
+        if (!shader) { _device->CreateShader(createInfo, &shader); }
+        if (!shader) {
+            Log::Error("Failed to compile shader {}", name);
+            return {};
+        }
+
+        // Backends that take source only report no bytecode
+        vector<u8> compiled;
+        if (!loaded) {
+            const void* data = nullptr;
+            u64 size         = 0;
+            shader->GetBytecode(&data, size);
+            if (data && size > 0) { compiled.assign(CAST<const u8*>(data), CAST<const u8*>(data) + size); }
+        }
+
+        std::lock_guard guard(_lock);
+        const auto [it, inserted] = _shaders.try_emplace(key, shader);
+        if (!inserted) {
+            ++_stats.shaderHits;
+            return it->second;
+        }
+        _shaderKeys.emplace(shader.RawPtr(), key);
+        if (loaded) {
+            ++_stats.shadersLoaded;
+        } else {
+            ++_stats.shadersCompiled;
+            if (!compiled.empty() && _bytecode.try_emplace(key, std::move(compiled)).second) {
+                _bytecodeChanged = true;
+            }
+        }
+        _stats.shaderMs += ElapsedMs(start);
+        return shader;
+    }
+
+    RefCntAutoPtr<IPipelineState>
+    PipelineCache::CreateGraphicsPipeline(const Diligent::GraphicsPipelineStateCreateInfo& createInfo) {
+        PROFILE_SCOPE("PipelineCache::CreateGraphicsPipeline");
+        const auto start = Clock::now();
+
+        Diligent::GraphicsPipelineStateCreateInfo cachedInfo = createInfo;
+        if (_driverCache && !cachedInfo.pPSOCache) { cachedInfo.pPSOCache = _driverCache; }
+
+        // Shader keys stand in for the shaders, so pipelines built from separately created but identical shaders
+        // share a key. The key is only meaningful within this run: resource signatures are hashed by identity, and
+        // nothing keyed by it is saved.
+        Hasher hasher;
+        bool shareable = createInfo.GraphicsPipeline.pRenderPass == nullptr;
+        {
+            std::lock_guard guard(_lock);
+            for (IShader* shader : {createInfo.pVS,
+                                    createInfo.pPS,
+                                    createInfo.pDS,
+                                    createInfo.pHS,
+                                    createInfo.pGS,
+                                    createInfo.pAS,
+                                    createInfo.pMS}) {
+                if (!shader) {
+                    hasher.Add(u64 {0});
+                    continue;
+                }
+                const auto it = _shaderKeys.find(shader);
+                if (it == _shaderKeys.end()) {
+                    shareable = false;
+                    break;
+                }
+                hasher.Add(it->second);
+            }
+        }
+
+        u64 key = 0;
+        if (shareable) {
+            hasher.Add(createInfo.PSODesc.PipelineType);
+            hasher.Add(createInfo.Flags);
+            HashResourceLayout(hasher, createInfo.PSODesc.ResourceLayout);
+            // Signatures are long-lived device objects, identity is enough within a run
+            hasher.Add(createInfo.ResourceSignaturesCount);
+            for (u32 i = 0; i < createInfo.ResourceSignaturesCount; ++i) {
+                hasher.AddPointer(createInfo.ppResourceSignatures[i]);
+            }
+            HashGraphicsState(hasher, createInfo.GraphicsPipeline);
+            key = hasher.GetValue();
+
+            std::lock_guard guard(_lock);
+            if (const auto it = _pipelines.find(key); it != _pipelines.end()) {
+                ++_stats.pipelineHits;
+                return it->second;
+            }
+        }
+
+        RefCntAutoPtr<IPipelineState> pipeline;
+        _device->CreateGraphicsPipelineState(cachedInfo, &pipeline);
+        if (!pipeline) {
+            Log::Error("Failed to create pipeline {}", createInfo.PSODesc.Name ? createInfo.PSODesc.Name : "unnamed");
+            return {};
+        }
+
+        std::lock_guard guard(_lock);
+        if (shareable) {
+            const auto [it, inserted] = _pipelines.try_emplace(key, pipeline);
+            if (!inserted) {
+                ++_stats.pipelineHits;
+                return it->second;
+            }
+        }
+        ++_stats.pipelinesCreated;
+        _stats.pipelineMs += ElapsedMs(start);
+        return pipeline;
+    }
+
+    PipelineCacheStats PipelineCache::GetStats() const {
+        std::lock_guard guard(_lock);
+        return _stats;
+    }
+
+    str PipelineCache::GetPath(const char* name) const {
+        return (fs::path(_directory) / fmt::format("{}.{}.bin", name, GetBackendName(_api))).string();
+    }
+
+    void PipelineCache::LoadShaders() {
+        std::ifstream file(GetPath("Shaders"), std::ios::binary);
+        if (!file) return;
+
+        ShaderCacheHeader header;
+        file.read(RCAST<char*>(&header), sizeof(header));
+        if (!file || header.magic != kShaderCacheMagic || header.version != kShaderCacheVersion ||
+            header.api != CAST<u32>(_api)) {
+            Log::Warn("Ignoring stale shader cache {}", GetPath("Shaders"));
+            return;
+        }
+
+        for (u32 i = 0; i < header.count; ++i) {
+            ShaderCacheEntry entry;
+            file.read(RCAST<char*>(&entry), sizeof(entry));
+            if (!file || entry.size == 0 || entry.size > (256ull << 20)) break;
+
+            vector<u8> bytecode(CAST<size_t>(entry.size));
+            file.read(RCAST<char*>(bytecode.data()), CAST<std::streamsize>(entry.size));
+            if (!file) break;
+            _bytecode.try_emplace(entry.key, std::move(bytecode));
+        }
+        if (_bytecode.size() < header.count) {
+            Log::Warn("Shader cache {} is truncated, kept {} of {} shaders",
+                      GetPath("Shaders"),
+                      _bytecode.size(),
+                      header.count);
+            _bytecodeChanged = true;
+        }
+        _stats.warm = !_bytecode.empty();
+    }
+
+    void PipelineCache::LoadPipelines() {
+        // Diligent implements pipeline state caches on the explicit APIs only
+        if (_api != GraphicsAPI::Vulkan && _api != GraphicsAPI::D3D12) return;
+
+        vector<u8> data;
+        if (!_directory.empty()) {
+            std::ifstream file(GetPath("Pipelines"), std::ios::binary | std::ios::ate);
+            if (file) {
+                data.resize(CAST<size_t>(file.tellg()));
+                file.seekg(0);
+                file.read(RCAST<char*>(data.data()), CAST<std::streamsize>(data.size()));
+                if (!file) { data.clear(); }
+            }
+        }
+
+        Diligent::PipelineStateCacheCreateInfo cacheInfo;
+        cacheInfo.Desc.Name     = "Pipeline state cache";
+        cacheInfo.Desc.Mode     = Diligent::PSO_CACHE_MODE_LOAD_STORE;
+        cacheInfo.pCacheData    = data.empty() ? nullptr : data.data();
+        cacheInfo.CacheDataSize = CAST<Diligent::Uint32>(data.size());
+        _device->CreatePipelineStateCache(cacheInfo, &_driverCache);
+
+        // The driver validates its blob against the device and build, a mismatch starts empty instead
+        if (!_driverCache && !data.empty()) {
+            Log::Warn("Driver rejected pipeline cache {}, starting empty", GetPath("Pipelines"));
+            cacheInfo.pCacheData    = nullptr;
+            cacheInfo.CacheDataSize = 0;
+            _device->CreatePipelineStateCache(cacheInfo, &_driverCache);
+        }
+        _stats.warm = _stats.warm || (_driverCache && !data.empty());
+    }
+
+    bool PipelineCache::SaveShaders() const {
+        if (!_bytecodeChanged) return true;
+
+        // Written aside and renamed over the old file, so a crash mid-write never leaves a torn cache behind
+        const str path      = GetPath("Shaders");
+        const str temporary = path + ".tmp";
+        {
+            std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+            ShaderCacheHeader header;
+            header.api   = CAST<u32>(_api);
+            header.count = CAST<u32>(_bytecode.size());
+            file.write(RCAST<const char*>(&header), sizeof(header));
+            for (const auto& [key, bytecode] : _bytecode) {
+                const ShaderCacheEntry entry {key, bytecode.size()};
+                file.write(RCAST<const char*>(&entry), sizeof(entry));
+                file.write(RCAST<const char*>(bytecode.data()), CAST<std::streamsize>(bytecode.size()));
+            }
+            if (!file) {
+                Log::Error("Failed to write shader cache {}", temporary);
+                return false;
+            }
+        }
+
+        std::error_code error;
+        fs::rename(temporary, path, error);
+        if (error) {
+            Log::Error("Failed to replace shader cache {}: {}", path, error.message());
+            return false;
+        }
+        return true;
+    }
+
+    bool PipelineCache::SavePipelines() const {
+        if (!_driverCache) return true;
+
+        RefCntAutoPtr<Diligent::IDataBlob> blob;
+        _driverCache->GetData(&blob);
+        if (!blob || blob->GetSize() == 0) return true;
+
+        const str path      = GetPath("Pipelines");
+        const str temporary = path + ".tmp";
+        {
+            std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+            file.write(CAST<const char*>(blob->GetConstDataPtr()), CAST<std::streamsize>(blob->GetSize()));
+            if (!file) {
+                Log::Error("Failed to write pipeline cache {}", temporary);
+                return false;
+            }
+        }
+
+        std::error_code error;
+        fs::rename(temporary, path, error);
+        if (error) {
+            Log::Error("Failed to replace pipeline cache {}: {}", path, error.message());
+            return false;
+        }
+        return true;
+    }
+}  // namespace X::Render
@@ -0,0 +1,83 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#pragma once
+
+#include "EnginePCH.h"
+#include "RenderDevice.hpp"
+
+#include <mutex>
+
+namespace X::Render {
+
+    struct PipelineCacheStats {
+        u32 shadersCompiled {0};   // Built from source
+        u32 shadersLoaded {0};     // Created from bytecode saved by an earlier run
+        u32 shaderHits {0};        // Shared with an earlier request this run
+        u32 pipelinesCreated {0};
+        u32 pipelineHits {0};
+        f64 shaderMs {0.0};        // Creating shaders, compiled or loaded
+        f64 pipelineMs {0.0};      // Creating pipelines
+        bool warm {false};         // Started from files an earlier run saved
+        bool driverCache {false};  // Pipelines are created through a Diligent pipeline state cache
+    };
+
+    // Creates shaders and graphics pipelines once per unique description and keeps them across runs. Shaders are keyed
+    // by a hash of their source, entry point, type, language, compiler and macros, and their compiled bytecode is
+    // saved per backend, so a warm start skips the HLSL/GLSL front end entirely. Pipelines are keyed by their shaders
+    // and the state that affects compilation (render target and depth formats, input layout, blend, rasterizer and
+    // depth state, resource layout) and are shared between callers asking for the same one. On Vulkan and D3D12 they
+    // also go through Diligent's pipeline state cache, whose driver blob is saved alongside the bytecode.
+    //
+    // OpenGL takes shaders as source only, so there it only deduplicates within a run and leaves reuse across runs to
+    // the driver's own shader cache. Safe to call from any thread.
+    class PipelineCache {
+    public:
+        PipelineCache() = default;
+        ~PipelineCache();
+
+        PipelineCache(const PipelineCache&)            = delete;
+        PipelineCache& operator=(const PipelineCache&) = delete;
+
+        // Loads what an earlier run saved in directory for this backend. An empty directory keeps everything in
+        // memory. Missing, stale or corrupt files only mean a cold start.
+        bool Initialize(IRenderDevice* device, GraphicsAPI api, const str& directory);
+        // Saves, then releases every shader and pipeline
+        void Shutdown();
+        // Writes the bytecode and pipeline cache files. Logs and returns false when they cannot be written.
+        bool Save();
+
+        // Only shaders given entirely as inline Source are cached. Any with a FilePath or a source stream factory,
+        // which could pull in #include files the key does not cover, are compiled on every call. nullptr after
+        // logging when compilation fails.
+        RefCntAutoPtr<IShader> CreateShader(const Diligent::ShaderCreateInfo& createInfo);
+        // Every shader must come from CreateShader to be shared, others are passed through uncached. Pipelines with
+        // an explicit render pass are not shared either. nullptr after logging when creation fails.
+        RefCntAutoPtr<IPipelineState>
+        CreateGraphicsPipeline(const Diligent::GraphicsPipelineStateCreateInfo& createInfo);
+
+        PipelineCacheStats GetStats() const;
+
+    private:
+        str GetPath(const char* name) const;
+        void LoadShaders();
+        void LoadPipelines();
+        bool SaveShaders() const;
+        bool SavePipelines() const;
+
+        IRenderDevice* _device {nullptr};
+        GraphicsAPI _api {GraphicsAPI::Auto};
+        str _directory;
+        RefCntAutoPtr<Diligent::IPipelineStateCache> _driverCache;
+
+        mutable std::mutex _lock;
+        unordered_map<u64, vector<u8>> _bytecode;  // By shader key, loaded from disk or taken from compiled shaders
+        unordered_map<u64, RefCntAutoPtr<IShader>> _shaders;
+        unordered_map<IShader*, u64> _shaderKeys;
+        unordered_map<u64, RefCntAutoPtr<IPipelineState>> _pipelines;
+        bool _bytecodeChanged {false};
+        PipelineCacheStats _stats;
+    };
+
+}  // namespace X::Render
@@ -3,11 +3,47 @@
 //
 
 #include "RenderDevice.hpp"
+#include "PipelineCache.hpp"
 #include "Core/Log.hpp"
+#include "Core/Profiler.hpp"
 
 namespace X::Render {
     using namespace X::Core;
 
+    namespace {
+        Diligent::NativeWindow GetNativeWindow(GLFWwindow* window) {
+            Diligent::NativeWindow nativeWindow;
+#if defined(ENGINE_PLATFORM_WINDOWS)
+            nativeWindow.hWnd = glfwGetWin32Window(window);
+#elif defined(ENGINE_PLATFORM_LINUX)
+            nativeWindow.WindowId = glfwGetX11Window(window);
+            nativeWindow.pDisplay = glfwGetX11Display();
+#endif
+            return nativeWindow;
+        }
+
+        // Query features used by the GPU profiler and bindless materials, the device is still created when they are
+        // unavailable
+        void RequestOptionalFeatures(Diligent::EngineCreateInfo& EngineCI) {
+            EngineCI.Features.TimestampQueries          = Diligent::DEVICE_FEATURE_STATE_OPTIONAL;
+            EngineCI.Features.PipelineStatisticsQueries = Diligent::DEVICE_FEATURE_STATE_OPTIONAL;
+            EngineCI.Features.BindlessResources         = Diligent::DEVICE_FEATURE_STATE_OPTIONAL;
+        }
+
+        const char* GetPresentModeName(PresentMode mode) {
+            switch (mode) {
+                case PresentMode::Fifo:
+                    return "FIFO";
+                case PresentMode::Mailbox:
+                    return "mailbox";
+                case PresentMode::Immediate:
+                    return "immediate";
+                default:
+                    return "unknown";
+            }
+        }
+    }  // namespace
+
     RenderDevice::RenderDevice() {
         Log::Debug("RenderDevice created");
     }
@@ -17,12 +53,23 @@ namespace X::Render {
         Log::Debug("RenderDevice destroyed");
     }
 
-    bool RenderDevice::Initialize(GLFWwindow* window, uint32_t width, uint32_t height, GraphicsAPI api) {
+    bool RenderDevice::Initialize(GLFWwindow* window,
+                                  uint32_t width,
+                                  uint32_t height,
+                                  const RenderDeviceConfig& config) {
         Log::Info("Initializing RenderDevice");
 
         _width  = width;
         _height = height;
 
+        if (!window && !config.headless) {
+            Log::Error("RenderDevice requires a window unless running headless");
+            return false;
+        }
+        if (config.headless) { window = nullptr; }
+        _config = config;
+
+        GraphicsAPI api = config.api;
         // Select API if auto
         if (api == GraphicsAPI::Auto) { api = SelectBestAPI(); }
         _currentAPI = api;
@@ -67,41 +114,95 @@ namespace X::Render {
             return false;
         }
 
-        CreateBackBufferViews();
+        if (!CreateDynamicRings()) {
+            Log::Error("Failed to create dynamic data rings");
+            return false;
+        }
+
+        // Not fatal, shaders and pipelines are still created without it
+        _pipelineCache = make_unique<PipelineCache>();
+        _pipelineCache->Initialize(_device, _currentAPI, _config.pipelineCacheDirectory);
+
+        if (!window) {
+            CreateOffscreenTargets();
+            if (!_backBufferRTV || !_depthBufferDSV) {
+                Log::Error("Failed to create offscreen render targets");
+                return false;
+            }
+            Log::Info("RenderDevice initialized successfully with {} (headless)", GetAPIName());
+            return true;
+        }
 
-        Log::Info("RenderDevice initialized successfully with {}", GetAPIName());
+        Log::Info("RenderDevice initialized successfully with {} ({} present, {} buffers)",
+                  GetAPIName(),
+                  GetPresentModeName(GetPresentMode()),
+                  _swapChain->GetDesc().BufferCount);
         return true;
     }
 
     void RenderDevice::Shutdown() {
+        // Saves to disk, and its pipelines must go before the device
+        _pipelineCache.reset();
+        _constantRing.Shutdown();
+        _vertexRing.Shutdown();
         _backBufferRTV.Release();
         _depthBufferDSV.Release();
+        _offscreenColor.Release();
+        _offscreenDepth.Release();
         _swapChain.Release();
+        _deferredContexts.clear();
         _immediateContext.Release();
         _device.Release();
     }
 
+    void RenderDevice::BeginFrame() {
+        _constantRing.BeginFrame();
+        _vertexRing.BeginFrame();
+    }
+
+    void RenderDevice::FlushDynamicData() {
+        if (!_immediateContext) return;
+
+        _constantRing.Flush(_immediateContext);
+        _vertexRing.Flush(_immediateContext);
+    }
+
     void RenderDevice::Present() {
-        if (_swapChain) { _swapChain->Present(); }
+        PROFILE_SCOPE("Present");
+
+        if (_immediateContext) {
+            _constantRing.EndFrame(_immediateContext);
+            _vertexRing.EndFrame(_immediateContext);
+        }
+
+        if (_swapChain) {
+            // A sync interval of 0 lets Diligent choose mailbox or immediate presentation
+            _swapChain->Present(GetPresentMode() == PresentMode::Fifo ? 1 : 0);
+        } else if (_immediateContext) {
+            // Without a swap chain nothing ends the frame for us, submit and let the context release stale resources
+            _immediateContext->Flush();
+            _immediateContext->FinishFrame();
+        }
+        ++_presentedFrames;
     }
 
     void RenderDevice::OnWindowResize(uint32_t width, uint32_t height) {
-        if (!_swapChain || (width == 0 || height == 0)) return;
+        if (!_device || (width == 0 || height == 0)) return;
 
         Log::Debug("RenderDevice handling resize: {}x{}", width, height);
 
         _width  = width;
         _height = height;
 
-        // Release old views
-        _backBufferRTV.Release();
-        _depthBufferDSV.Release();
+        if (!_swapChain) {
+            _backBufferRTV.Release();
+            _depthBufferDSV.Release();
+            CreateOffscreenTargets();
+            return;
+        }
 
         // Resize swap chain
         _swapChain->Resize(width, height);
-
-        // Recreate views
-        CreateBackBufferViews();
     }
 
     GraphicsAPI RenderDevice::SelectBestAPI() {
@@ -146,37 +247,49 @@ namespace X::Render {
                 return "OpenGL";
             case GraphicsAPI::Metal:
                 return "Metal";
+            case GraphicsAPI::Null:
+                return "Null";
             default:
                 return "Unknown";
         }
     }
 
+    bool RenderDevice::SupportsBindless() const {
+        if (!_config.bindless || !_device || _currentAPI != GraphicsAPI::Vulkan) return false;
+        return _device->GetDeviceInfo().Features.BindlessResources == Diligent::DEVICE_FEATURE_STATE_ENABLED;
+    }
+
 #if defined(ENGINE_D3D11_SUPPORTED)
     bool RenderDevice::InitializeD3D11(GLFWwindow* window, uint32_t width, uint32_t height) {
         auto* pFactoryD3D11 = Diligent::GetEngineFactoryD3D11();
 
         Diligent::EngineD3D11CreateInfo EngineCI;
-        pFactoryD3D11->CreateDeviceAndContextsD3D11(EngineCI, &_device, &_immediateContext);
+        EngineCI.NumDeferredContexts = _config.deferredContexts;
+        RequestOptionalFeatures(EngineCI);
+
+        vector<IDeviceContext*> contexts(1 + EngineCI.NumDeferredContexts, nullptr);
+        pFactoryD3D11->CreateDeviceAndContextsD3D11(EngineCI, &_device, contexts.data());
+        AdoptContexts(contexts);
 
         if (!_device) {
             Log::Error("Failed to create D3D11 device");
             return false;
         }
 
-    #if defined(ENGINE_PLATFORM_WINDOWS)
-        HWND hWnd = glfwGetWin32Window(window);
-        Diligent::Win32NativeWindow Window {hWnd};
+        if (!window) return true;
 
-        Diligent::SwapChainDesc SCDesc;
-        SCDesc.Width             = width;
-        SCDesc.Height            = height;
-        SCDesc.ColorBufferFormat = Diligent::TEX_FORMAT_RGBA8_UNORM_SRGB;
-        SCDesc.DepthBufferFormat = Diligent::TEX_FORMAT_D32_FLOAT;
+    #if defined(ENGINE_PLATFORM_WINDOWS)
+        Diligent::SwapChainDesc SCDesc = CreateSwapChainDesc(width, height);
 
         Diligent::FullScreenModeDesc FSDesc;
         FSDesc.Fullscreen = false;
 
-        pFactoryD3D11->CreateSwapChainD3D11(_device, _immediateContext, SCDesc, FSDesc, Window, &_swapChain);
+        pFactoryD3D11->CreateSwapChainD3D11(_device,
+                                            _immediateContext,
+                                            SCDesc,
+                                            FSDesc,
+                                            GetNativeWindow(window),
+                                            &_swapChain);
     #endif
 
         return _swapChain != nullptr;
@@ -192,28 +305,152 @@ namespace X::Render {
         return false;
     }
 
+#if defined(ENGINE_VULKAN_SUPPORTED)
     bool RenderDevice::InitializeVulkan(GLFWwindow* window, uint32_t width, uint32_t height) {
-        Log::Error("Vulkan initialization not implemented yet");
+        auto* pFactoryVk = Diligent::GetEngineFactoryVk();
+
+        // Without a window this also runs on software implementations such as llvmpipe/lavapipe
+        Diligent::EngineVkCreateInfo EngineCI;
+        EngineCI.NumDeferredContexts = _config.deferredContexts;
+        RequestOptionalFeatures(EngineCI);
+
+        vector<IDeviceContext*> contexts(1 + EngineCI.NumDeferredContexts, nullptr);
+        pFactoryVk->CreateDeviceAndContextsVk(EngineCI, &_device, contexts.data());
+        AdoptContexts(contexts);
+
+        if (!_device) {
+            Log::Error("Failed to create Vulkan device");
+            return false;
+        }
+
+        if (!window) return true;
+
+        Diligent::SwapChainDesc SCDesc = CreateSwapChainDesc(width, height);
+        pFactoryVk->CreateSwapChainVk(_device, _immediateContext, SCDesc, GetNativeWindow(window), &_swapChain);
+
+        if (!_swapChain) {
+            Log::Error("Failed to create Vulkan swap chain");
+            return false;
+        }
+
+        return true;
+    }
+#else
+    bool RenderDevice::InitializeVulkan(GLFWwindow* window, uint32_t width, uint32_t height) {
+        Log::Error("Vulkan support not compiled in");
         return false;
     }
+#endif
 
+#if defined(ENGINE_GL_SUPPORTED)
     bool RenderDevice::InitializeOpenGL(GLFWwindow* window, uint32_t width, uint32_t height) {
-        Log::Error("OpenGL initialization not implemented yet");
+        if (!window) {
+            Log::Error("OpenGL needs a window for its context, headless mode is not supported");
+            return false;
+        }
+
+        // Diligent attaches to the context GLFW created with the window, so it has to be current here
+        glfwMakeContextCurrent(window);
+
+        auto* pFactoryGL = Diligent::GetEngineFactoryOpenGL();
+
+        Diligent::EngineGLCreateInfo EngineCI;
+        EngineCI.Window = GetNativeWindow(window);
+        RequestOptionalFeatures(EngineCI);
+
+        Diligent::SwapChainDesc SCDesc = CreateSwapChainDesc(width, height);
+        // GL has no deferred contexts, the Renderer records on the immediate context instead
+        pFactoryGL->CreateDeviceAndSwapChainGL(EngineCI, &_device, &_immediateContext, SCDesc, &_swapChain);
+
+        if (!_device || !_swapChain) {
+            Log::Error("Failed to create OpenGL device");
+            return false;
+        }
+
+        return true;
+    }
+#else
+    bool RenderDevice::InitializeOpenGL(GLFWwindow* window, uint32_t width, uint32_t height) {
+        Log::Error("OpenGL support not compiled in");
         return false;
     }
+#endif
 
     bool RenderDevice::InitializeMetal(GLFWwindow* window, uint32_t width, uint32_t height) {
         Log::Error("Metal initialization not implemented yet");
         return false;
     }
 
-    void RenderDevice::CreateBackBufferViews() {
-        if (!_swapChain) return;
+    void RenderDevice::CreateOffscreenTargets() {
+        _offscreenColor.Release();
+        _offscreenDepth.Release();
+
+        Diligent::TextureDesc ColorDesc;
+        ColorDesc.Name      = "Offscreen color buffer";
+        ColorDesc.Type      = Diligent::RESOURCE_DIM_TEX_2D;
+        ColorDesc.Width     = _width;
+        ColorDesc.Height    = _height;
+        ColorDesc.Format    = Diligent::TEX_FORMAT_RGBA8_UNORM_SRGB;
+        ColorDesc.BindFlags = Diligent::BIND_RENDER_TARGET | Diligent::BIND_SHADER_RESOURCE;
+        _device->CreateTexture(ColorDesc, nullptr, &_offscreenColor);
+
+        Diligent::TextureDesc DepthDesc;
+        DepthDesc.Name      = "Offscreen depth buffer";
+        DepthDesc.Type      = Diligent::RESOURCE_DIM_TEX_2D;
+        DepthDesc.Width     = _width;
+        DepthDesc.Height    = _height;
+        DepthDesc.Format    = Diligent::TEX_FORMAT_D32_FLOAT;
+        DepthDesc.BindFlags = Diligent::BIND_DEPTH_STENCIL;
+        _device->CreateTexture(DepthDesc, nullptr, &_offscreenDepth);
+
+        if (_offscreenColor) {
+            _backBufferRTV = _offscreenColor->GetDefaultView(Diligent::TEXTURE_VIEW_RENDER_TARGET);
+        }
+        if (_offscreenDepth) {
+            _depthBufferDSV = _offscreenDepth->GetDefaultView(Diligent::TEXTURE_VIEW_DEPTH_STENCIL);
+        }
+    }
+
+    void RenderDevice::AdoptContexts(const vector<IDeviceContext*>& contexts) {
+        // The factory hands back contexts with a reference already added
+        _immediateContext.Attach(contexts[0]);
+
+        _deferredContexts.clear();
+        for (size_t i = 1; i < contexts.size(); ++i) {
+            if (!contexts[i]) continue;
+            RefCntAutoPtr<IDeviceContext> context;
+            context.Attach(contexts[i]);
+            _deferredContexts.push_back(std::move(context));
+        }
+
+        if (!_deferredContexts.empty()) { Log::Info("Created {} deferred contexts", _deferredContexts.size()); }
+    }
 
-        auto* pBackBuffer = _swapChain->GetCurrentBackBufferRTV();
-        _backBufferRTV    = RefCntAutoPtr<ITextureView>(pBackBuffer, Diligent::IID_TextureView);
+    bool RenderDevice::CreateDynamicRings() {
+        const u32 frames = GetFramesInFlight();
+        if (!_constantRing.Initialize(_device,
+                                      _immediateContext,
+                                      "Constant ring",
+                                      Diligent::BIND_UNIFORM_BUFFER,
+                                      _config.constantRingSize,
+                                      frames)) {
+            return false;
+        }
+        return _vertexRing.Initialize(_device,
+                                      _immediateContext,
+                                      "Vertex ring",
+                                      Diligent::BIND_VERTEX_BUFFER,
+                                      _config.vertexRingSize,
+                                      frames);
+    }
 
-        auto* pDepthBuffer = _swapChain->GetDepthBufferDSV();
-        _depthBufferDSV    = RefCntAutoPtr<ITextureView>(pDepthBuffer, Diligent::IID_TextureView);
+    Diligent::SwapChainDesc RenderDevice::CreateSwapChainDesc(uint32_t width, uint32_t height) const {
+        Diligent::SwapChainDesc SCDesc;
+        SCDesc.Width             = width;
+        SCDesc.Height            = height;
+        SCDesc.ColorBufferFormat = Diligent::TEX_FORMAT_RGBA8_UNORM_SRGB;
+        SCDesc.DepthBufferFormat = Diligent::TEX_FORMAT_D32_FLOAT;
+        SCDesc.BufferCount       = std::max(_config.framesInFlight, 2u);
+        return SCDesc;
     }
 }  // namespace X::Render
\ No newline at end of file
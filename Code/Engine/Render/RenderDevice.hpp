@@ -5,19 +5,44 @@
 #pragma once
 
 #include "EnginePCH.h"
+#include "GpuRingBuffer.hpp"
 
 namespace X::Render {
 
-    enum class GraphicsAPI { Auto, D3D11, D3D12, Vulkan, OpenGL, Metal };
+    class PipelineCache;
+
+    // Null runs the frame loop without creating a device at all
+    enum class GraphicsAPI { Auto, D3D11, D3D12, Vulkan, OpenGL, Metal, Null };
+
+    // Fifo waits for vblank. Mailbox and Immediate both present without waiting, Diligent picks mailbox when the
+    // surface supports it and falls back to immediate otherwise.
+    enum class PresentMode { Fifo, Mailbox, Immediate };
+
+    struct RenderDeviceConfig {
+        GraphicsAPI api {GraphicsAPI::Auto};
+        bool headless {false};                           // Create the device without a swap chain, render offscreen
+        bool vsync {true};                               // Forces PresentMode::Fifo
+        PresentMode presentMode {PresentMode::Mailbox};  // Used when vsync is off
+        u32 framesInFlight {2};                          // Swap chain buffer count
+        u32 deferredContexts {0};                        // Contexts for multithreaded recording, ignored on GL
+        u64 constantRingSize {4ull << 20};               // Per-frame bytes for dynamic constant buffers
+        u64 vertexRingSize {16ull << 20};                // Per-frame bytes for dynamic vertex/instance streams
+        str pipelineCacheDirectory {"Cache"};            // Shaders and pipelines kept between runs, empty = off
+        bool bindless {true};                            // Let material templates that ask for it draw bindless
+    };
 
     class RenderDevice {
     public:
         RenderDevice();
         ~RenderDevice();
 
-        bool Initialize(GLFWwindow* window, uint32_t width, uint32_t height, GraphicsAPI api = GraphicsAPI::Auto);
+        bool Initialize(GLFWwindow* window, uint32_t width, uint32_t height, const RenderDeviceConfig& config = {});
         void Shutdown();
 
+        // Advances the dynamic data rings, waiting for the GPU to release the region this frame reuses
+        void BeginFrame();
+        // Uploads everything allocated from the rings since the last call, call before recording draws that read it
+        void FlushDynamicData();
         void Present();
         void OnWindowResize(uint32_t width, uint32_t height);
 
@@ -28,20 +53,59 @@ namespace X::Render {
         IDeviceContext* GetImmediateContext() const {
             return _immediateContext;
         }
+        // Deferred contexts record command lists on worker threads, one thread per context at a time
+        IDeviceContext* GetDeferredContext(u32 index) const {
+            return _deferredContexts[index];
+        }
+        u32 GetDeferredContextCount() const {
+            return CAST<u32>(_deferredContexts.size());
+        }
+        // Frame-lifetime allocators for per-frame dynamic data, valid between BeginFrame and Present
+        GpuRingBuffer& GetConstantRing() {
+            return _constantRing;
+        }
+        GpuRingBuffer& GetVertexRing() {
+            return _vertexRing;
+        }
+        // Create shaders and pipelines through this so they are shared and persisted across runs
+        PipelineCache* GetPipelineCache() const {
+            return _pipelineCache.get();
+        }
         ISwapChain* GetSwapChain() const {
             return _swapChain;
         }
+        // Swap chains that rotate images (Vulkan, D3D12) return a different view every frame
         ITextureView* GetBackBufferRTV() const {
-            return _backBufferRTV;
+            return _swapChain ? _swapChain->GetCurrentBackBufferRTV() : _backBufferRTV.RawPtr();
         }
         ITextureView* GetDepthBufferDSV() const {
-            return _depthBufferDSV;
+            return _swapChain ? _swapChain->GetDepthBufferDSV() : _depthBufferDSV.RawPtr();
         }
 
         GraphicsAPI GetAPI() const {
             return _currentAPI;
         }
+        bool IsHeadless() const {
+            return _swapChain == nullptr;
+        }
+        PresentMode GetPresentMode() const {
+            return _config.vsync ? PresentMode::Fifo : _config.presentMode;
+        }
+        u32 GetFramesInFlight() const {
+            return std::max(_config.framesInFlight, 1u);
+        }
+        // Frames presented so far. GPU work recorded before frame N is certainly retired once this passes
+        // N + GetFramesInFlight() + 2.
+        u64 GetPresentedFrames() const {
+            return _presentedFrames;
+        }
         const char* GetAPIName() const;
+        // Material templates may keep textures in descriptor arrays indexed per instance. Vulkan only, on devices
+        // with descriptor indexing, and only when the config allows it.
+        bool SupportsBindless() const;
+
+        // Resolves GraphicsAPI::Auto to the preferred API for this platform
+        static GraphicsAPI SelectBestAPI();
 
     private:
         bool InitializeD3D11(GLFWwindow* window, uint32_t width, uint32_t height);
@@ -50,19 +114,29 @@ namespace X::Render {
         bool InitializeOpenGL(GLFWwindow* window, uint32_t width, uint32_t height);
         bool InitializeMetal(GLFWwindow* window, uint32_t width, uint32_t height);
 
-        void CreateBackBufferViews();
-        GraphicsAPI SelectBestAPI();
+        void CreateOffscreenTargets();
+        Diligent::SwapChainDesc CreateSwapChainDesc(uint32_t width, uint32_t height) const;
+        void AdoptContexts(const vector<IDeviceContext*>& contexts);
+        bool CreateDynamicRings();
 
     private:
         RefCntAutoPtr<IRenderDevice> _device;
         RefCntAutoPtr<IDeviceContext> _immediateContext;
+        vector<RefCntAutoPtr<IDeviceContext>> _deferredContexts;
         RefCntAutoPtr<ISwapChain> _swapChain;
         RefCntAutoPtr<ITextureView> _backBufferRTV;
         RefCntAutoPtr<ITextureView> _depthBufferDSV;
+        RefCntAutoPtr<ITexture> _offscreenColor;
+        RefCntAutoPtr<ITexture> _offscreenDepth;
+        GpuRingBuffer _constantRing;
+        GpuRingBuffer _vertexRing;
+        unique_ptr<PipelineCache> _pipelineCache;
 
+        RenderDeviceConfig _config;
         GraphicsAPI _currentAPI = GraphicsAPI::Auto;
         uint32_t _width         = 0;
         uint32_t _height        = 0;
+        u64 _presentedFrames    = 0;
     };
 
 }  // namespace X::Render
\ No newline at end of file
@@ -0,0 +1,313 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include "RenderQueue.hpp"
+#include "Material.hpp"
+#include "Mesh.hpp"
+
+namespace X::Render {
+    namespace {
+        constexpr u32 kRadixBits   = 11;
+        constexpr u32 kRadixSize   = 1u << kRadixBits;
+        constexpr u32 kRadixMask   = kRadixSize - 1;
+        constexpr u32 kRadixPasses = (64 + kRadixBits - 1) / kRadixBits;
+
+        // Positive IEEE floats order the same as their bit patterns
+        u32 DepthBits(f32 depth) {
+            depth    = std::max(depth, 0.0f);
+            u32 bits = 0;
+            std::memcpy(&bits, &depth, sizeof(bits));
+            return bits;
+        }
+    }  // namespace
+
+    const char* GetRenderPassName(RenderPass pass) {
+        switch (pass) {
+            case RenderPass::Opaque:
+                return "Opaque";
+            case RenderPass::AlphaTest:
+                return "AlphaTest";
+            case RenderPass::Transparent:
+                return "Transparent";
+            case RenderPass::Overlay:
+                return "Overlay";
+            default:
+                return "Unknown";
+        }
+    }
+
+    u64 RenderQueue::MakeSortKey(RenderPass pass, u32 pipelineId, u32 materialId, u32 meshId, u32 lod, f32 depth) {
+        const u64 passBits     = CAST<u64>(pass) & 0xF;
+        const u64 pipelineBits = pipelineId & 0xFFF;
+        const u64 materialBits = materialId & 0xFFFF;
+        const u64 meshBits     = meshId & 0xFFFF;
+        const u64 lodBits      = lod & 0x7;
+        const u64 depthBits    = DepthBits(depth);
+
+        if (pass == RenderPass::Transparent) {
+            return passBits << 60 | (~depthBits & 0xFFFFFFFF) << 28 | pipelineBits << 16 | materialBits;
+        }
+        // Sign, exponent and the top mantissa bits are plenty for coarse front-to-back ordering
+        return passBits << 60 | pipelineBits << 48 | materialBits << 32 | meshBits << 16 | lodBits << 13 |
+               depthBits >> 19;
+    }
+
+    void RenderQueue::Reset() {
+        _packets.clear();
+        _transforms.clear();
+        _entries.clear();
+    }
+
+    u32 RenderQueue::AddTransform(const Mat4& world) {
+        _transforms.push_back(world);
+        return CAST<u32>(_transforms.size() - 1);
+    }
+
+    void RenderQueue::Submit(const DrawPacket& packet) {
+        if (!packet.mesh || !packet.material) return;
+
+        const u64 key = MakeSortKey(packet.pass,
+                                    packet.material->GetPipelineId(),
+                                    packet.material->GetId(),
+                                    packet.mesh->GetId(),
+                                    packet.lod,
+                                    packet.depth);
+        _entries.push_back({key, CAST<u32>(_packets.size())});
+        _packets.push_back(packet);
+    }
+
+    void RenderQueue::Sort() {
+        const size_t count = _entries.size();
+        if (count < 2) return;
+
+        // LSD radix sort, stable, so equal keys keep submission order
+        _scratch.resize(count);
+        SortEntry* src = _entries.data();
+        SortEntry* dst = _scratch.data();
+
+        array<u32, kRadixSize> histogram;
+        for (u32 pass = 0; pass < kRadixPasses; ++pass) {
+            const u32 shift = pass * kRadixBits;
+
+            histogram.fill(0);
+            for (size_t i = 0; i < count; ++i) {
+                ++histogram[(src[i].key >> shift) & kRadixMask];
+            }
+
+            // Every key shares this digit, nothing to reorder
+            if (histogram[(src[0].key >> shift) & kRadixMask] == count) continue;
+
+            u32 offset = 0;
+            for (u32& bucket : histogram) {
+                const u32 size = bucket;
+                bucket         = offset;
+                offset += size;
+            }
+
+            for (size_t i = 0; i < count; ++i) {
+                dst[histogram[(src[i].key >> shift) & kRadixMask]++] = src[i];
+            }
+            std::swap(src, dst);
+        }
+
+        if (src != _entries.data()) { _entries.swap(_scratch); }
+    }
+
+    void RenderQueue::Prepare(GpuRingBuffer& ring, RenderStats& stats) {
+        _preparedBatches = 0;
+        _instances       = {};
+        if (_entries.empty()) return;
+
+        // A batch never holds more instances than the ring can take in one frame
+        const u64 available = ring.GetAvailable(alignof(InstanceData)) / sizeof(InstanceData);
+        BuildBatches(CAST<u32>(available));
+
+        u32 instanceCount = 0;
+        while (_preparedBatches < _batches.size() && instanceCount + _batches[_preparedBatches].count <= available) {
+            instanceCount += _batches[_preparedBatches++].count;
+        }
+        stats.droppedPackets += CAST<u32>(_entries.size()) - instanceCount;
+        if (instanceCount == 0) return;
+
+        InstanceData* data = ring.Allocate<InstanceData>(instanceCount, _instances);
+        if (!data) {
+            stats.droppedPackets += instanceCount;
+            _preparedBatches = 0;
+            return;
+        }
+
+        u32 written = 0;
+        for (u32 i = 0; i < _preparedBatches; ++i) {
+            const Batch& batch = _batches[i];
+            for (u32 e = 0; e < batch.count; ++e) {
+                const DrawPacket& packet = _packets[_entries[batch.firstEntry + e].packet];
+                data[written].world      = _transforms[packet.transformIndex];
+                data[written].material   = packet.material->GetParameterIndex();
+                ++written;
+            }
+        }
+    }
+
+    void RenderQueue::Execute(IDeviceContext* context, RenderStats& stats, GpuProfiler* profiler) {
+        if (_preparedBatches == 0) return;
+
+        _boundPipeline     = nullptr;
+        _boundResources    = nullptr;
+        _boundVertexBuffer = nullptr;
+        _boundIndexBuffer  = nullptr;
+
+        // Batches are sorted by pass, so each pass is one contiguous run
+        u32 firstInstance = 0;
+        for (u32 i = 0; i < _preparedBatches; ++i) {
+            if (profiler) {
+                const RenderPass pass = _packets[_entries[_batches[i].firstEntry].packet].pass;
+                if (i == 0 || pass != _packets[_entries[_batches[i - 1].firstEntry].packet].pass) {
+                    profiler->BeginPass(context, GetRenderPassName(pass));
+                }
+            }
+            DrawBatch(context, _batches[i], firstInstance, stats);
+            firstInstance += _batches[i].count;
+        }
+        stats.perMaterialResourceBinds += FlushRunMaterials();
+        if (profiler) { profiler->EndPass(context); }
+    }
+
+    void RenderQueue::BuildBatches(u32 maxInstances) {
+        _batches.clear();
+        if (maxInstances == 0) return;
+
+        for (u32 i = 0; i < CAST<u32>(_entries.size()); ++i) {
+            const DrawPacket& packet = _packets[_entries[i].packet];
+            if (!_batches.empty()) {
+                Batch& batch            = _batches.back();
+                const DrawPacket& first = _packets[_entries[batch.firstEntry].packet];
+                const bool sameDraw =
+                  first.mesh == packet.mesh && first.pass == packet.pass && first.lod == packet.lod &&
+                  first.material->GetPipelineState() == packet.material->GetPipelineState() &&
+                  first.material->GetResourceBinding() == packet.material->GetResourceBinding();
+                if (sameDraw && batch.count < maxInstances) {
+                    ++batch.count;
+                    continue;
+                }
+            }
+            _batches.push_back({i, 1});
+        }
+    }
+
+    void RenderQueue::DrawBatch(IDeviceContext* context, const Batch& batch, u32 firstInstance, RenderStats& stats) {
+        const DrawPacket& packet = _packets[_entries[batch.firstEntry].packet];
+        const Mesh& mesh         = *packet.mesh;
+        const Material& material = *packet.material;
+        stats.packets += batch.count;
+
+        IPipelineState* pipeline = material.GetPipelineState();
+        if (pipeline != _boundPipeline) {
+            context->SetPipelineState(pipeline);
+            _boundPipeline  = pipeline;
+            _boundResources = nullptr;
+            ++stats.pipelineBinds;
+        } else {
+            ++stats.skippedBinds;
+        }
+
+        IShaderResourceBinding* resources = material.GetResourceBinding();
+        if (resources != _boundResources) {
+            context->CommitShaderResources(resources, Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+            _boundResources = resources;
+            ++stats.resourceBinds;
+            stats.perMaterialResourceBinds += FlushRunMaterials();
+        } else {
+            ++stats.skippedBinds;
+        }
+
+        // Without bindless every material in the batch would be a draw of its own, and every material since the
+        // last bind a bind of its own
+        if (material.IsBindless()) {
+            stats.bindlessPackets += batch.count;
+            _batchMaterials.clear();
+            for (u32 e = 0; e < batch.count; ++e) {
+                _batchMaterials.push_back(_packets[_entries[batch.firstEntry + e].packet].material);
+            }
+            std::sort(_batchMaterials.begin(), _batchMaterials.end());
+            const auto last = std::unique(_batchMaterials.begin(), _batchMaterials.end());
+            stats.perMaterialDrawCalls += CAST<u32>(last - _batchMaterials.begin());
+            _runMaterials.insert(_runMaterials.end(), _batchMaterials.begin(), last);
+        } else {
+            ++stats.perMaterialDrawCalls;
+            _runMaterials.push_back(&material);
+        }
+
+        // Mesh streams go first and the instance stream in the slot after them. A mesh's streams are created together,
+        // so the first one identifies the set.
+        IBuffer* vertexBuffer = mesh.GetVertexBuffer();
+        if (vertexBuffer != _boundVertexBuffer) {
+            const u32 streamCount                   = mesh.GetStreamCount();
+            IBuffer* buffers[Mesh::kMaxStreams + 1] = {};
+            u64 offsets[Mesh::kMaxStreams + 1]      = {};
+            for (u32 stream = 0; stream < streamCount; ++stream) {
+                buffers[stream] = mesh.GetVertexBuffer(stream);
+            }
+            buffers[streamCount] = _instances.buffer;
+            offsets[streamCount] = _instances.offset;
+            context->SetVertexBuffers(0,
+                                      streamCount + 1,
+                                      buffers,
+                                      offsets,
+                                      Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                                      Diligent::SET_VERTEX_BUFFERS_FLAG_RESET);
+            _boundVertexBuffer = vertexBuffer;
+            ++stats.vertexBufferBinds;
+        } else {
+            ++stats.skippedBinds;
+        }
+
+        IBuffer* indexBuffer = mesh.GetIndexBuffer();
+        if (indexBuffer && indexBuffer != _boundIndexBuffer) {
+            context->SetIndexBuffer(indexBuffer, 0, Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+            _boundIndexBuffer = indexBuffer;
+            ++stats.indexBufferBinds;
+        } else if (indexBuffer) {
+            ++stats.skippedBinds;
+        }
+
+        if (indexBuffer) {
+            const MeshLod& lod = mesh.GetLod(packet.lod);
+            stats.triangles += lod.indexCount / 3 * batch.count;
+            stats.fullDetailTriangles += mesh.GetLod(0).indexCount / 3 * batch.count;
+            if (packet.lod > 0) { stats.reducedPackets += batch.count; }
+
+            Diligent::DrawIndexedAttribs attribs;
+            attribs.NumIndices            = lod.indexCount;
+            attribs.FirstIndexLocation    = lod.firstIndex;
+            attribs.IndexType             = mesh.GetIndexType();
+            attribs.NumInstances          = batch.count;
+            attribs.FirstInstanceLocation = firstInstance;
+            attribs.Flags                 = Diligent::DRAW_FLAG_VERIFY_ALL;
+            context->DrawIndexed(attribs);
+        } else {
+            stats.triangles += mesh.GetElementCount() / 3 * batch.count;
+            stats.fullDetailTriangles += mesh.GetElementCount() / 3 * batch.count;
+
+            Diligent::DrawAttribs attribs;
+            attribs.NumVertices           = mesh.GetElementCount();
+            attribs.NumInstances          = batch.count;
+            attribs.FirstInstanceLocation = firstInstance;
+            attribs.Flags                 = Diligent::DRAW_FLAG_VERIFY_ALL;
+            context->Draw(attribs);
+        }
+
+        ++stats.drawCalls;
+        if (batch.count > 1) {
+            ++stats.instancedDraws;
+            stats.mergedPackets += batch.count - 1;
+        }
+    }
+
+    u32 RenderQueue::FlushRunMaterials() {
+        std::sort(_runMaterials.begin(), _runMaterials.end());
+        const u32 count = CAST<u32>(std::unique(_runMaterials.begin(), _runMaterials.end()) - _runMaterials.begin());
+        _runMaterials.clear();
+        return count;
+    }
+}  // namespace X::Render
@@ -0,0 +1,129 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#pragma once
+
+#include "EnginePCH.h"
+#include "GpuRingBuffer.hpp"
+#include "InstanceData.hpp"
+#include "GpuProfiler.hpp"
+
+namespace X::Render {
+
+    // Passes execute in enum order. Transparent draws sort back to front ahead of any state grouping.
+    enum class RenderPass : u8 { Opaque = 0, AlphaTest = 1, Transparent = 2, Overlay = 3 };
+
+    const char* GetRenderPassName(RenderPass pass);
+
+    struct DrawPacket {
+        const Mesh* mesh {nullptr};
+        const Material* material {nullptr};
+        u32 transformIndex {0};
+        f32 depth {0.0f};  // View-space distance, only used for ordering
+        RenderPass pass {RenderPass::Opaque};
+        u8 lod {0};  // Index into the mesh's LODs
+    };
+
+    struct RenderStats {
+        u32 packets {0};
+        u32 drawCalls {0};
+        u32 instancedDraws {0};  // Draws that merged more than one packet
+        u32 mergedPackets {0};   // Packets folded into another packet's draw, packets - drawCalls
+        u32 droppedPackets {0};  // Packets whose instance data did not fit in the vertex ring
+        u32 pipelineBinds {0};
+        u32 resourceBinds {0};
+        u32 vertexBufferBinds {0};
+        u32 indexBufferBinds {0};
+        // Binds a naive one-draw-one-bind-set loop would have issued that the sorted queue skipped
+        u32 skippedBinds {0};
+        u32 triangles {0};            // Drawn, at the selected LODs
+        u32 fullDetailTriangles {0};  // The same packets drawn at LOD 0
+        u32 reducedPackets {0};       // Packets drawn below full detail
+        u32 bindlessPackets {0};      // Packets whose material reads its resources through descriptor arrays
+        // The same packets with every material bound and drawn on its own, for comparison with bindless
+        u32 perMaterialResourceBinds {0};
+        u32 perMaterialDrawCalls {0};
+
+        f32 GetTriangleSavingsPercent() const {
+            return fullDetailTriangles > 0
+                     ? 100.0f * (1.0f - CAST<f32>(triangles) / CAST<f32>(fullDetailTriangles))
+                     : 0.0f;
+        }
+        f32 GetResourceBindSavingsPercent() const {
+            return perMaterialResourceBinds > 0
+                     ? 100.0f * (1.0f - CAST<f32>(resourceBinds) / CAST<f32>(perMaterialResourceBinds))
+                     : 0.0f;
+        }
+    };
+
+    class RenderQueue {
+    public:
+        // 64-bit key, most significant first:
+        //   opaque:      pass:4 | pipeline:12 | material:16 | mesh:16 | lod:3 | depth:13 (front to back)
+        //   transparent: pass:4 | depth:32 (back to front) | pipeline:12 | material:16
+        // Opaque keys place the mesh and LOD above depth so every copy of a mesh/material pair at the same LOD ends
+        // up adjacent and can be drawn as one instanced call. Bindless materials of one permutation share a material
+        // id, so their packets sort by mesh across materials.
+        static u64 MakeSortKey(RenderPass pass, u32 pipelineId, u32 materialId, u32 meshId, u32 lod, f32 depth);
+
+        void Reset();
+
+        // Returns the index to reference from DrawPacket::transformIndex
+        u32 AddTransform(const Mat4& world);
+        void Submit(const DrawPacket& packet);
+
+        // Radix sorts the submitted packets by key
+        void Sort();
+
+        // Groups adjacent packets with the same mesh, pipeline, resource binding and pass into instanced draws and
+        // writes their world matrices and material parameter indices into one allocation from the ring. Bindless
+        // materials of one permutation share a binding, so their packets merge across materials. Sort must have been
+        // called, and the ring flushed before Execute.
+        void Prepare(GpuRingBuffer& ring, RenderStats& stats);
+
+        // Issues the prepared draws, skipping binds that match the previous draw. With a profiler each RenderPass is
+        // timed as its own GPU pass.
+        void Execute(IDeviceContext* context, RenderStats& stats, GpuProfiler* profiler = nullptr);
+
+        u32 GetPacketCount() const {
+            return CAST<u32>(_packets.size());
+        }
+        const vector<Mat4>& GetTransforms() const {
+            return _transforms;
+        }
+
+    private:
+        struct SortEntry {
+            u64 key;
+            u32 packet;
+        };
+
+        struct Batch {
+            u32 firstEntry;
+            u32 count;
+        };
+
+        void BuildBatches(u32 maxInstances);
+        void DrawBatch(IDeviceContext* context, const Batch& batch, u32 firstInstance, RenderStats& stats);
+        // Distinct materials in _runMaterials, which it clears
+        u32 FlushRunMaterials();
+
+        vector<DrawPacket> _packets;
+        vector<Mat4> _transforms;
+        vector<SortEntry> _entries;
+        vector<SortEntry> _scratch;
+        vector<Batch> _batches;
+        u32 _preparedBatches {0};
+        GpuAllocation _instances;
+
+        // Bind cache, reset at the start of Execute
+        IPipelineState* _boundPipeline {nullptr};
+        IShaderResourceBinding* _boundResources {nullptr};
+        IBuffer* _boundVertexBuffer {nullptr};
+        IBuffer* _boundIndexBuffer {nullptr};
+        vector<const Material*> _runMaterials;  // Drawn since the last resource bind
+        vector<const Material*> _batchMaterials;
+    };
+
+}  // namespace X::Render
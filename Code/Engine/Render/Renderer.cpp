@@ -6,7 +6,11 @@
 
 #include "EnginePCH.h"
 #include "RenderDevice.hpp"
+#include "Camera.hpp"
+#include "Mesh.hpp"
+#include "Core/JobSystem.hpp"
 #include "Core/Log.hpp"
+#include "Core/Profiler.hpp"
 
 namespace X::Render {
     using namespace X::Core;
@@ -20,34 +24,61 @@ namespace X::Render {
         Log::Debug("Renderer destroyed");
     }
 
-    bool Renderer::Initialize(GLFWwindow* window, u32 width, u32 height) {
+    bool Renderer::Initialize(GLFWwindow* window, u32 width, u32 height, const RenderDeviceConfig& config) {
         Log::Info("Initializing Renderer");
 
         _width  = width;
         _height = height;
 
         _device = make_shared<RenderDevice>();
-        if (!_device->Initialize(window, width, height)) {
+        if (!_device->Initialize(window, width, height, config)) {
             Log::Error("Failed to initialize render device");
             return false;
         }
 
         Log::Info("Initialized render device");
+
+        // Queries are read back once the frame has certainly retired, two frames past the swap chain's latency
+        _gpuProfiler.Initialize(_device->GetDevice(), _device->GetFramesInFlight() + 2);
         return true;
     }
 
     void Renderer::Shutdown() {
+        _queue.Reset();
+        _cameraConstants = {};
+        _gpuProfiler.Shutdown();
+
         if (_device) {
             _device->Shutdown();
             _device.reset();
         }
     }
 
-    void Renderer::BeginFrame() const {
+    void Renderer::BeginFrame(const FrameState& state) {
         if (!_device) return;
 
-        const float clearColor[] = {_clearColor.r, _clearColor.g, _clearColor.b, _clearColor.a};
-        auto* context            = _device->GetImmediateContext();
+        _queue.Reset();
+        _frameStats    = {};
+        _lodProjection = state.projection;
+        _lodPixelError = state.lodPixelError;
+        _device->BeginFrame();
+
+        auto* context = _device->GetImmediateContext();
+        _gpuProfiler.BeginFrame(context, _frameIndex++);
+        _gpuProfiler.BeginPass(context, "Clear");
+
+        CameraConstants* camera = _device->GetConstantRing().Allocate<CameraConstants>(1, _cameraConstants);
+        if (camera) {
+            camera->view           = state.view;
+            camera->projection     = state.projection;
+            camera->viewProjection = state.projection * state.view;
+            camera->position       = Vec4(state.cameraPosition, 1.0f);
+        }
+        // Draws recorded before EndFrame, on this context or a deferred one, read the camera constants
+        _device->FlushDynamicData();
+
+        const auto& color        = state.clearColor;
+        const float clearColor[] = {color.r, color.g, color.b, color.a};
         auto* rtv                = _device->GetBackBufferRTV();
         auto* dsv                = _device->GetDepthBufferDSV();
 
@@ -59,15 +90,123 @@ namespace X::Render {
                                    1.0f,
                                    0,
                                    Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        // Whatever the application draws directly on the immediate context until EndFrame
+        _gpuProfiler.BeginPass(context, "Application");
     }
 
-    void Renderer::EndFrame() const {
+    void Renderer::EndFrame() {
         if (!_device) return;
+
+        auto* context = _device->GetImmediateContext();
+
+        // Queued draws go first, then any command lists recorded in parallel
+        {
+            PROFILE_SCOPE("RenderQueue");
+            _gpuProfiler.EndPass(context);
+            _queue.Sort();
+            _queue.Prepare(_device->GetVertexRing(), _frameStats);
+            _device->FlushDynamicData();
+            _queue.Execute(context, _frameStats, &_gpuProfiler);
+        }
+        _stats = _frameStats;
+
+        if (!_commandLists.empty()) {
+            vector<ICommandList*> commandLists;
+            commandLists.reserve(_commandLists.size());
+            for (auto& commandList : _commandLists) {
+                if (commandList) { commandLists.push_back(commandList); }
+            }
+
+            _gpuProfiler.BeginPass(context, "CommandLists");
+            context->ExecuteCommandLists(CAST<u32>(commandLists.size()), commandLists.data());
+            _gpuProfiler.EndPass(context);
+            _commandLists.clear();
+
+            // Deferred contexts must be told the frame is over once their command lists have been submitted
+            for (u32 i = 0; i < _device->GetDeferredContextCount(); ++i) {
+                _device->GetDeferredContext(i)->FinishFrame();
+            }
+        }
+
+        _gpuProfiler.EndFrame(context);
         _device->Present();
     }
 
+    void Renderer::Submit(const Mesh& mesh, const Material& material, const Mat4& world, f32 depth, RenderPass pass) {
+        DrawPacket packet;
+        packet.mesh           = &mesh;
+        packet.material       = &material;
+        packet.transformIndex = _queue.AddTransform(world);
+        packet.depth          = depth;
+        packet.pass           = pass;
+        packet.lod            = CAST<u8>(SelectLod(mesh, world, depth));
+        _queue.Submit(packet);
+    }
+
+    u32 Renderer::SelectLod(const Mesh& mesh, const Mat4& world, f32 depth) const {
+        if (mesh.GetLodCount() < 2 || _lodPixelError <= 0.0f || depth <= 0.0f) return 0;
+
+        // Errors are in mesh units, so scale them by the world matrix's largest axis
+        const f32 scaleSquared = std::max(std::max(glm::dot(Vec3(world[0]), Vec3(world[0])),
+                                                   glm::dot(Vec3(world[1]), Vec3(world[1]))),
+                                          glm::dot(Vec3(world[2]), Vec3(world[2])));
+        const f32 scale        = std::sqrt(scaleSquared);
+        const f32 distance     = depth - mesh.GetRadius() * scale;
+        if (distance <= 0.0f) return 0;
+
+        return mesh.SelectLod(GetPixelsPerUnit(_lodProjection, distance, _height) * scale, _lodPixelError);
+    }
+
+    void Renderer::RecordParallel(JobSystem& jobs, u32 count, const RecordFunction& record) {
+        if (!_device || count == 0) return;
+
+        const u32 contextCount = _device->GetDeferredContextCount();
+        if (contextCount == 0) {
+            record(_device->GetImmediateContext(), 0, count);
+            return;
+        }
+
+        const u32 batchSize  = (count + contextCount - 1) / contextCount;
+        const u32 batchCount = (count + batchSize - 1) / batchSize;
+        const size_t first   = _commandLists.size();
+        _commandLists.resize(first + batchCount);
+
+        ITextureView* rtv = _device->GetBackBufferRTV();
+        ITextureView* dsv = _device->GetDepthBufferDSV();
+
+        jobs.ParallelFor(count, batchSize, [&](u32 begin, u32 end) {
+            const u32 batch         = begin / batchSize;
+            IDeviceContext* context = _device->GetDeferredContext(batch);
+
+            context->Begin(0);
+            // Deferred contexts cannot transition resources, BeginFrame already moved the targets into place
+            context->SetRenderTargets(1, &rtv, dsv, Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+            record(context, begin, end);
+            context->FinishCommandList(&_commandLists[first + batch]);
+        });
+    }
+
+    void Renderer::CaptureFrameState(FrameState& state) const {
+        state = _frameState;
+    }
+
     void Renderer::SetClearColor(f32 r, f32 g, f32 b, f32 a) {
-        _clearColor = {r, g, b, a};
+        _frameState.clearColor = {r, g, b, a};
+    }
+
+    void Renderer::SetLodPixelError(f32 pixels) {
+        _frameState.lodPixelError = pixels;
+    }
+
+    void Renderer::SetCamera(const Mat4& view, const Mat4& projection, const Vec3& position) {
+        _frameState.view           = view;
+        _frameState.projection     = projection;
+        _frameState.cameraPosition = position;
+    }
+
+    void Renderer::SetCamera(const Camera& camera) {
+        SetCamera(camera.GetView(), camera.GetProjection(), camera.GetPosition());
     }
 
     void Renderer::OnWindowResize(u32 width, u32 height) {
@@ -6,27 +6,93 @@
 
 #include "EnginePCH.h"
 #include "RenderDevice.h"
+#include "RenderDevice.hpp"
+#include "FrameState.hpp"
+#include "RenderQueue.hpp"
+#include "GpuProfiler.hpp"
 
 namespace X::Render {
 
+    // Uploaded once per frame through the constant ring, bind to material shaders as "CameraConstants"
+    struct CameraConstants {
+        Mat4 view;
+        Mat4 projection;
+        Mat4 viewProjection;
+        Vec4 position;
+    };
+
     class Renderer {
     public:
+        // Records commands for items [begin, end) into context
+        using RecordFunction = std::function<void(IDeviceContext* context, u32 begin, u32 end)>;
+
         Renderer();
         ~Renderer();
 
-        bool Initialize(GLFWwindow* window, u32 width, u32 height);
+        bool Initialize(GLFWwindow* window, u32 width, u32 height, const RenderDeviceConfig& config = {});
         void Shutdown();
 
-        void BeginFrame() const;
-        void EndFrame() const;
+        void BeginFrame(const FrameState& state);
+        void EndFrame();
+
+        // Queues a draw for the current frame, render thread only. The queue is sorted and executed at EndFrame. The
+        // mesh's LOD is picked from depth, the view-space distance to its origin, so the projected error of the
+        // nearest point of its bounds stays within the frame's lodPixelError.
+        void Submit(const Mesh& mesh,
+                    const Material& material,
+                    const Mat4& world,
+                    f32 depth       = 0.0f,
+                    RenderPass pass = RenderPass::Opaque);
+
+        // Counters for the last completed frame
+        const RenderStats& GetStats() const {
+            return _stats;
+        }
+
+        // GPU pass timings and pipeline statistics, a few frames behind the CPU. Empty if timestamp queries are not
+        // supported by the device.
+        const GpuFrameStats& GetGpuStats() const {
+            return _gpuProfiler.GetStats();
+        }
+
+        // This frame's camera constants. The buffer changes between frames, so materials set it on a dynamic or
+        // mutable variable with SetBufferRange(buffer, offset, size) after BeginFrame.
+        const GpuAllocation& GetCameraConstants() const {
+            return _cameraConstants;
+        }
+
+        // Splits count items over the deferred context pool and records them on the job system, one batch per
+        // context. Render targets are bound on every context before record is called. Command lists are executed on
+        // the immediate context at EndFrame in the order they were recorded (call order, then batch order), so the
+        // result does not depend on which worker finished first. Without deferred contexts (OpenGL) the items are
+        // recorded on the immediate context on the calling thread. Ring allocations are safe from record and are
+        // flushed at EndFrame before the command lists execute.
+        void RecordParallel(Core::JobSystem& jobs, u32 count, const RecordFunction& record);
+
+        // Copies the state set from the simulation side so it can be rendered later, possibly on another thread
+        void CaptureFrameState(FrameState& state) const;
 
         void SetClearColor(f32 r, f32 g, f32 b, f32 a);
+        void SetLodPixelError(f32 pixels);
+        void SetCamera(const Mat4& view, const Mat4& projection, const Vec3& position);
+        void SetCamera(const Camera& camera);
         void OnWindowResize(u32 width, u32 height);
 
+        u32 SelectLod(const Mesh& mesh, const Mat4& world, f32 depth) const;
+
         shared_ptr<RenderDevice> _device;
         u32 _width {0};
         u32 _height {0};
-        Vec4 _clearColor {0.1f, 0.1f, 0.2f, 1.0f};
+        FrameState _frameState;
+        Mat4 _lodProjection {1.0f};  // Projection and pixel error of the frame being recorded
+        f32 _lodPixelError {0.0f};
+        vector<RefCntAutoPtr<ICommandList>> _commandLists;
+        RenderQueue _queue;
+        GpuAllocation _cameraConstants;
+        RenderStats _frameStats;
+        RenderStats _stats;
+        GpuProfiler _gpuProfiler;
+        u64 _frameIndex {0};
     };
 
 }  // namespace X::Render
\ No newline at end of file
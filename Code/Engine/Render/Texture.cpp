@@ -0,0 +1,74 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include "Texture.hpp"
+#include "Core/Log.hpp"
+
+#include <atomic>
+
+namespace X::Render {
+    using namespace X::Core;
+
+    namespace {
+        std::atomic<u32> gNextTextureId {1};
+    }  // namespace
+
+    bool Texture::Create(IRenderDevice* device, const TextureImage& image, const char* name) {
+        const TextureLayout& layout = image.layout;
+        if (layout.width == 0 || layout.height == 0 || layout.mipLevels == 0 || layout.arraySize == 0 ||
+            image.subresourceCount != layout.mipLevels * layout.arraySize || !image.subresources) {
+            Log::Error("Texture {} has {} subresources for {} mips and {} slices",
+                       name,
+                       image.subresourceCount,
+                       layout.mipLevels,
+                       layout.arraySize);
+            return false;
+        }
+
+        // Only the descriptors are built here, the pixels are read by the device from wherever the image points
+        vector<Diligent::TextureSubResData> subresources(image.subresourceCount);
+        for (u32 i = 0; i < image.subresourceCount; ++i) {
+            const TextureSubresource& source = image.subresources[i];
+            if (!source.data || source.size == 0) {
+                Log::Error("Texture {} is missing subresource {}", name, i);
+                return false;
+            }
+            subresources[i].pData       = source.data;
+            subresources[i].Stride      = source.stride;
+            subresources[i].DepthStride = source.size;
+        }
+
+        Diligent::TextureDesc desc;
+        desc.Name      = name;
+        desc.Type      = layout.dimension;
+        desc.Width     = layout.width;
+        desc.Height    = layout.height;
+        desc.ArraySize = layout.arraySize;
+        desc.MipLevels = layout.mipLevels;
+        desc.Format    = layout.format;
+        desc.Usage     = Diligent::USAGE_IMMUTABLE;
+        desc.BindFlags = Diligent::BIND_SHADER_RESOURCE;
+
+        Diligent::TextureData data;
+        data.pSubResources   = subresources.data();
+        data.NumSubresources = image.subresourceCount;
+
+        RefCntAutoPtr<ITexture> texture;
+        device->CreateTexture(desc, &data, &texture);
+        if (!texture) {
+            Log::Error("Failed to create texture {} ({}x{}, {} mips)",
+                       name,
+                       layout.width,
+                       layout.height,
+                       layout.mipLevels);
+            return false;
+        }
+
+        _texture            = std::move(texture);
+        _shaderResourceView = _texture->GetDefaultView(Diligent::TEXTURE_VIEW_SHADER_RESOURCE);
+        _layout             = layout;
+        if (_id == 0) { _id = gNextTextureId.fetch_add(1, std::memory_order_relaxed); }
+        return true;
+    }
+}  // namespace X::Render
@@ -0,0 +1,63 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#pragma once
+
+#include "EnginePCH.h"
+
+namespace X::Render {
+
+    // Everything about a texture besides its pixels. Plain data, so asset archives store it as is.
+    struct TextureLayout {
+        u32 width {0};
+        u32 height {0};
+        u32 mipLevels {1};
+        u32 arraySize {1};  // 6 per cube
+        Diligent::TEXTURE_FORMAT format {Diligent::TEX_FORMAT_RGBA8_UNORM};
+        Diligent::RESOURCE_DIMENSION dimension {Diligent::RESOURCE_DIM_TEX_2D};
+    };
+
+    // One mip of one array slice, in the format's native row layout
+    struct TextureSubresource {
+        const void* data {nullptr};
+        u64 size {0};
+        u32 stride {0};  // Bytes per row, or per row of blocks for compressed formats
+    };
+
+    // A texture laid out exactly as the GPU expects it. Nothing is owned, so an image can point straight into a
+    // mapped asset archive.
+    struct TextureImage {
+        TextureLayout layout;
+        const TextureSubresource* subresources {nullptr};  // Slice major: every mip of slice 0, then slice 1...
+        u32 subresourceCount {0};
+    };
+
+    class Texture {
+    public:
+        // Creates an immutable shader resource texture from every mip of every slice, reading the pixels straight
+        // from the image. Logs and returns false when the image is incomplete or creation fails, leaving the texture
+        // unchanged.
+        bool Create(IRenderDevice* device, const TextureImage& image, const char* name = "Texture");
+
+        ITexture* GetTexture() const {
+            return _texture;
+        }
+        ITextureView* GetShaderResourceView() const {
+            return _shaderResourceView;
+        }
+        const TextureLayout& GetLayout() const {
+            return _layout;
+        }
+        u32 GetId() const {
+            return _id;
+        }
+
+    private:
+        RefCntAutoPtr<ITexture> _texture;
+        ITextureView* _shaderResourceView {nullptr};  // Owned by _texture
+        TextureLayout _layout;
+        u32 _id {0};
+    };
+
+}  // namespace X::Render
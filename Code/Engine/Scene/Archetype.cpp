@@ -0,0 +1,131 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include "Archetype.hpp"
+#include "Core/Log.hpp"
+
+namespace X::Scene {
+    namespace {
+        u32 AlignUp(u32 value, u32 alignment) {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+        void Relocate(const ComponentInfo& info, void* destination, void* source) {
+            if (info.trivial) {
+                std::memcpy(destination, source, info.size);
+                return;
+            }
+            info.moveConstruct(destination, source);
+            info.destroy(source);
+        }
+    }  // namespace
+
+    Archetype::Archetype(ComponentMask mask, Core::PoolAllocator& chunkPool) : _mask(mask), _chunkPool(chunkPool) {
+        std::fill(std::begin(_columnOf), std::end(_columnOf), kNoColumn);
+
+        u32 rowSize = sizeof(Entity);
+        for (u32 id = 0; id < kMaxComponents; ++id) {
+            if (!Has(CAST<ComponentId>(id))) continue;
+            const ComponentInfo& info = GetComponentInfo(CAST<ComponentId>(id));
+            _columnOf[id]             = CAST<u8>(_columns.size());
+            _columns.push_back({CAST<ComponentId>(id), 0, info.size, &info});
+            rowSize += info.size;
+        }
+
+        // Entities first, then each column on its own cache line. Start from the capacity ignoring padding and shrink
+        // until the padded layout fits.
+        const auto layout = [this](u32 capacity) {
+            u32 offset = CAST<u32>(sizeof(Entity)) * capacity;
+            for (Column& column : _columns) {
+                offset        = AlignUp(offset, std::max(kChunkAlignment, column.info->alignment));
+                column.offset = offset;
+                offset += column.size * capacity;
+            }
+            return offset;
+        };
+
+        u32 capacity = kChunkSize / rowSize;
+        while (capacity > 0 && layout(capacity) > kChunkSize) {
+            --capacity;
+        }
+        if (capacity == 0) {
+            Core::Log::Critical("Archetype row of {} bytes does not fit a {} byte chunk", rowSize, kChunkSize);
+            std::abort();
+        }
+        layout(capacity);
+        _chunkCapacity = capacity;
+    }
+
+    Archetype::~Archetype() {
+        Clear();
+    }
+
+    void Archetype::Clear() {
+        for (const Chunk& chunk : _chunks) {
+            for (const Column& column : _columns) {
+                if (column.info->trivial) continue;
+                for (u32 row = 0; row < chunk.count; ++row) {
+                    column.info->destroy(chunk.data + column.offset + CAST<size_t>(row) * column.size);
+                }
+            }
+            _chunkPool.Free(chunk.data);
+        }
+        _chunks.clear();
+        _entityCount = 0;
+    }
+
+    EntityLocation Archetype::AllocateRow(Entity entity) {
+        if (_chunks.empty() || _chunks.back().count == _chunkCapacity) {
+            void* data = _chunkPool.Allocate();
+            if (!data) throw std::bad_alloc();
+            _chunks.push_back({CAST<u8*>(data), 0});
+        }
+
+        Chunk& chunk               = _chunks.back();
+        const EntityLocation at    = {CAST<u32>(_chunks.size() - 1), chunk.count++};
+        GetEntities(chunk)[at.row] = entity;
+        ++_entityCount;
+        return at;
+    }
+
+    Entity Archetype::RemoveRow(const EntityLocation& location) {
+        Chunk& chunk      = _chunks[location.chunk];
+        Chunk& last       = _chunks.back();
+        const u32 lastRow = last.count - 1;
+        const bool isLast = &chunk == &last && location.row == lastRow;
+        Entity moved      = kInvalidEntity;
+
+        for (const Column& column : _columns) {
+            u8* removed = chunk.data + column.offset + CAST<size_t>(location.row) * column.size;
+            if (!column.info->trivial) { column.info->destroy(removed); }
+            if (!isLast) {
+                Relocate(*column.info, removed, last.data + column.offset + CAST<size_t>(lastRow) * column.size);
+            }
+        }
+        if (!isLast) {
+            moved                            = GetEntities(last)[lastRow];
+            GetEntities(chunk)[location.row] = moved;
+        }
+
+        --_entityCount;
+        if (--last.count == 0) {
+            _chunkPool.Free(last.data);
+            _chunks.pop_back();
+        }
+        return moved;
+    }
+
+    void Archetype::MoveRowFrom(Archetype& source, const EntityLocation& from, const EntityLocation& to) {
+        for (const Column& column : _columns) {
+            if (!source.Has(column.id)) continue;
+            void* destination = GetComponent(to, column.id);
+            void* origin      = source.GetComponent(from, column.id);
+            if (column.info->trivial) {
+                std::memcpy(destination, origin, column.size);
+            } else {
+                column.info->moveConstruct(destination, origin);
+            }
+        }
+    }
+}  // namespace X::Scene
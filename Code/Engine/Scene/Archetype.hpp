@@ -0,0 +1,107 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#pragma once
+
+#include "EnginePCH.h"
+#include "Component.hpp"
+#include "Entity.hpp"
+#include "Core/Memory.hpp"
+
+namespace X::Scene {
+
+    // Fixed-size block holding up to the archetype's chunk capacity rows. Each component is a contiguous array
+    // starting on its own cache line, preceded by the entities the rows belong to.
+    struct Chunk {
+        u8* data {nullptr};
+        u32 count {0};
+    };
+
+    struct EntityLocation {
+        u32 chunk {0};
+        u32 row {0};
+    };
+
+    // Every entity with exactly the same set of components. Rows are packed: all chunks are full except the last, and
+    // removing a row moves the archetype's last row into the gap, so iteration never sees holes.
+    class Archetype {
+    public:
+        static constexpr u32 kChunkSize      = 16 * 1024;
+        static constexpr u32 kChunkAlignment = 64;
+
+        Archetype(ComponentMask mask, Core::PoolAllocator& chunkPool);
+        ~Archetype();
+
+        Archetype(const Archetype&)            = delete;
+        Archetype& operator=(const Archetype&) = delete;
+
+        // Appends a row for entity with its components left unconstructed
+        EntityLocation AllocateRow(Entity entity);
+        // Destroys the row's components and fills it with the last row. Returns the entity that moved, or
+        // kInvalidEntity when the removed row was the last one.
+        Entity RemoveRow(const EntityLocation& location);
+        // Moves the components both archetypes share from a row of source into a row of this archetype. The source
+        // row still has to be removed afterwards.
+        void MoveRowFrom(Archetype& source, const EntityLocation& from, const EntityLocation& to);
+        // Destroys every row and returns the chunks to the pool
+        void Clear();
+
+        bool Has(ComponentId id) const {
+            return (_mask >> id) & 1;
+        }
+        bool Matches(ComponentMask required) const {
+            return (_mask & required) == required;
+        }
+
+        void* GetComponent(const EntityLocation& location, ComponentId id) const {
+            const Column& column = _columns[_columnOf[id]];
+            return _chunks[location.chunk].data + column.offset + CAST<size_t>(location.row) * column.size;
+        }
+        void* GetColumn(const Chunk& chunk, ComponentId id) const {
+            return chunk.data + _columns[_columnOf[id]].offset;
+        }
+        Entity* GetEntities(const Chunk& chunk) const {
+            return RCAST<Entity*>(chunk.data);
+        }
+
+        ComponentMask GetMask() const {
+            return _mask;
+        }
+        u32 GetChunkCapacity() const {
+            return _chunkCapacity;
+        }
+        u32 GetEntityCount() const {
+            return _entityCount;
+        }
+        u32 GetChunkCount() const {
+            return CAST<u32>(_chunks.size());
+        }
+        const Chunk& GetChunk(u32 index) const {
+            return _chunks[index];
+        }
+
+        // Cached transitions to the archetype with one component added or removed, filled in by the world
+        Archetype* addEdges[kMaxComponents] {};
+        Archetype* removeEdges[kMaxComponents] {};
+
+    private:
+        static constexpr u8 kNoColumn = 0xFF;
+
+        struct Column {
+            ComponentId id;
+            u32 offset;  // From the start of the chunk
+            u32 size;
+            const ComponentInfo* info;
+        };
+
+        ComponentMask _mask {0};
+        vector<Column> _columns;
+        u8 _columnOf[kMaxComponents] {};
+        u32 _chunkCapacity {0};
+        u32 _entityCount {0};
+        vector<Chunk> _chunks;
+        Core::PoolAllocator& _chunkPool;
+    };
+
+}  // namespace X::Scene
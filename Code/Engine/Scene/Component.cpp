@@ -0,0 +1,47 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include "Component.hpp"
+#include "Core/Log.hpp"
+
+#include <mutex>
+
+namespace X::Scene {
+    namespace {
+        struct ComponentRegistry {
+            std::mutex lock;
+            array<ComponentInfo, kMaxComponents> infos;
+            u32 count {0};
+        };
+
+        ComponentRegistry& GetRegistry() {
+            static ComponentRegistry registry;
+            return registry;
+        }
+    }  // namespace
+
+    ComponentId RegisterComponent(const ComponentInfo& info) {
+        auto& registry = GetRegistry();
+        std::lock_guard lock(registry.lock);
+        if (registry.count >= kMaxComponents) {
+            // Archetypes are keyed by a 64-bit mask, there is no way to continue
+            Core::Log::Critical("Too many component types, the limit is {}", kMaxComponents);
+            std::abort();
+        }
+
+        registry.infos[registry.count] = info;
+        return CAST<ComponentId>(registry.count++);
+    }
+
+    const ComponentInfo& GetComponentInfo(ComponentId id) {
+        // Entries are written once, before the id that indexes them is handed out
+        return GetRegistry().infos[id];
+    }
+
+    u32 GetComponentCount() {
+        auto& registry = GetRegistry();
+        std::lock_guard lock(registry.lock);
+        return registry.count;
+    }
+}  // namespace X::Scene
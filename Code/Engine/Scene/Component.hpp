@@ -0,0 +1,70 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#pragma once
+
+#include "EnginePCH.h"
+
+#include <type_traits>
+
+namespace X::Scene {
+
+    using ComponentId   = u8;
+    using ComponentMask = u64;  // One bit per ComponentId, identifies an archetype
+
+    inline constexpr u32 kMaxComponents = 64;
+
+    // Type-erased lifetime operations for one component type, so archetypes can construct, relocate and destroy
+    // columns without knowing their types
+    struct ComponentInfo {
+        u32 size {0};
+        u32 alignment {0};
+        bool trivial {false};  // Trivially copyable and destructible, relocated with memcpy and never destroyed
+        void (*construct)(void* destination) {nullptr};
+        void (*moveConstruct)(void* destination, void* source) {nullptr};
+        void (*destroy)(void* component) {nullptr};
+
+        template<typename T>
+        static ComponentInfo Of() {
+            static_assert(std::is_default_constructible_v<T> && std::is_move_constructible_v<T>,
+                          "Components must be default and move constructible");
+            static_assert(alignof(T) <= 64, "Components cannot be aligned beyond a cache line");
+            ComponentInfo info;
+            info.size          = sizeof(T);
+            info.alignment     = alignof(T);
+            info.trivial       = std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>;
+            info.construct     = [](void* destination) { new (destination) T(); };
+            info.moveConstruct = [](void* destination, void* source) {
+                new (destination) T(std::move(*CAST<T*>(source)));
+            };
+            info.destroy = [](void* component) { CAST<T*>(component)->~T(); };
+            return info;
+        }
+    };
+
+    // Assigns the next free id. Ids are handed out on first use of each type and are process-wide.
+    ComponentId RegisterComponent(const ComponentInfo& info);
+    const ComponentInfo& GetComponentInfo(ComponentId id);
+    u32 GetComponentCount();
+
+    namespace Detail {
+        template<typename T>
+        ComponentId ComponentIdOf() {
+            static const ComponentId id = RegisterComponent(ComponentInfo::Of<T>());
+            return id;
+        }
+    }  // namespace Detail
+
+    // T, const T and T& share one id
+    template<typename T>
+    ComponentId GetComponentId() {
+        return Detail::ComponentIdOf<std::remove_cvref_t<T>>();
+    }
+
+    template<typename... Ts>
+    ComponentMask GetComponentMask() {
+        return ((ComponentMask(1) << GetComponentId<Ts>()) | ... | ComponentMask(0));
+    }
+
+}  // namespace X::Scene
@@ -0,0 +1,25 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#pragma once
+
+#include "EnginePCH.h"
+
+namespace X::Scene {
+
+    // Index into the world's entity records plus the generation it was created with. Destroying an entity bumps the
+    // generation, so stale copies are detected instead of aliasing whatever reuses the slot.
+    struct Entity {
+        u32 index {~0u};
+        u32 generation {0};
+
+        bool IsValid() const {
+            return index != ~0u;
+        }
+        bool operator==(const Entity& other) const = default;
+    };
+
+    inline constexpr Entity kInvalidEntity {};
+
+}  // namespace X::Scene
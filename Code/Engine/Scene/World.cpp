@@ -0,0 +1,113 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include "World.hpp"
+
+namespace X::Scene {
+    World::World() : _chunkPool(Archetype::kChunkSize, 64, Archetype::kChunkAlignment) {}
+
+    World::~World() {
+        // Archetypes return their chunks to the pool, so they have to go first
+        _archetypes.clear();
+    }
+
+    void World::Destroy(Entity entity) {
+        if (!IsAlive(entity)) return;
+
+        Record& record                = _records[entity.index];
+        const EntityLocation location = {record.chunk, record.row};
+        Archetype* archetype          = record.archetype;
+        const Entity moved            = archetype->RemoveRow(location);
+        if (moved.IsValid()) { SetLocation(moved, archetype, location); }
+
+        record.archetype = nullptr;
+        ++record.generation;
+        _freeRecords.push_back(entity.index);
+        --_entityCount;
+    }
+
+    void World::Reserve(u32 entities) {
+        _records.reserve(entities);
+    }
+
+    void World::Clear() {
+        // Archetypes stay alive so queries holding on to them remain valid
+        for (const auto& archetype : _archetypes) {
+            archetype->Clear();
+        }
+
+        _freeRecords.clear();
+        for (u32 i = CAST<u32>(_records.size()); i > 0; --i) {
+            Record& record = _records[i - 1];
+            if (record.archetype) {
+                record.archetype = nullptr;
+                ++record.generation;
+            }
+            _freeRecords.push_back(i - 1);
+        }
+        _entityCount = 0;
+    }
+
+    WorldStats World::GetStats() const {
+        WorldStats stats;
+        stats.entities   = _entityCount;
+        stats.archetypes = CAST<u32>(_archetypes.size());
+        for (const auto& archetype : _archetypes) {
+            stats.chunks += archetype->GetChunkCount();
+        }
+        stats.chunkBytes = CAST<u64>(stats.chunks) * Archetype::kChunkSize;
+        return stats;
+    }
+
+    Entity World::AllocateEntity() {
+        u32 index;
+        if (!_freeRecords.empty()) {
+            index = _freeRecords.back();
+            _freeRecords.pop_back();
+        } else {
+            index = CAST<u32>(_records.size());
+            _records.emplace_back();
+        }
+
+        ++_entityCount;
+        return {index, _records[index].generation};
+    }
+
+    Archetype* World::FindOrCreateArchetype(ComponentMask mask) {
+        if (const auto it = _archetypeByMask.find(mask); it != _archetypeByMask.end()) return it->second;
+
+        _archetypes.push_back(make_unique<Archetype>(mask, _chunkPool));
+        Archetype* archetype   = _archetypes.back().get();
+        _archetypeByMask[mask] = archetype;
+        return archetype;
+    }
+
+    EntityLocation World::Migrate(Entity entity, ComponentId id, bool add) {
+        Record& record    = _records[entity.index];
+        Archetype* source = record.archetype;
+
+        Archetype*& edge = add ? source->addEdges[id] : source->removeEdges[id];
+        if (!edge) {
+            const ComponentMask bit = ComponentMask(1) << id;
+            edge                    = FindOrCreateArchetype(add ? source->GetMask() | bit : source->GetMask() & ~bit);
+        }
+        Archetype* target = edge;
+
+        const EntityLocation from = {record.chunk, record.row};
+        const EntityLocation to   = target->AllocateRow(entity);
+        target->MoveRowFrom(*source, from, to);
+
+        const Entity moved = source->RemoveRow(from);
+        if (moved.IsValid()) { SetLocation(moved, source, from); }
+        SetLocation(entity, target, to);
+        return to;
+    }
+
+    void World::SetLocation(Entity entity, Archetype* archetype, const EntityLocation& location) {
+        Record& record   = _records[entity.index];
+        record.archetype = archetype;
+        record.chunk     = location.chunk;
+        record.row       = location.row;
+    }
+}  // namespace X::Scene
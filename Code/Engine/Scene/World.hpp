@@ -0,0 +1,250 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#pragma once
+
+#include "EnginePCH.h"
+#include "Archetype.hpp"
+#include "Core/JobSystem.hpp"
+
+#include <type_traits>
+
+namespace X::Scene {
+
+    struct WorldStats {
+        u32 entities {0};
+        u32 archetypes {0};
+        u32 chunks {0};
+        u64 chunkBytes {0};  // Memory held by chunks, including the unused tail of each archetype's last chunk
+    };
+
+    // Entity-component store. Entities with the same set of components share an archetype and are packed into its
+    // chunks, so iterating a query walks contiguous component arrays. Creating, destroying and adding or removing
+    // components are O(1): rows are appended to the last chunk and removals fill the gap with the last row.
+    //
+    // Not thread-safe. Structural changes (Create, Destroy, Add, Remove) must not happen while a query is iterating,
+    // component values may be written from query callbacks.
+    class World {
+    public:
+        World();
+        ~World();
+
+        World(const World&)            = delete;
+        World& operator=(const World&) = delete;
+
+        template<typename... Ts>
+        Entity Create(Ts&&... components) {
+            Archetype* archetype    = FindOrCreateArchetype(GetComponentMask<std::remove_cvref_t<Ts>...>());
+            const Entity entity     = AllocateEntity();
+            const EntityLocation at = archetype->AllocateRow(entity);
+            (new (archetype->GetComponent(at, GetComponentId<Ts>()))
+               std::remove_cvref_t<Ts>(std::forward<Ts>(components)),
+             ...);
+            SetLocation(entity, archetype, at);
+            return entity;
+        }
+
+        // Destroys the entity and its components. Stale handles are ignored.
+        void Destroy(Entity entity);
+        bool IsAlive(Entity entity) const {
+            return entity.index < _records.size() && _records[entity.index].generation == entity.generation &&
+                   _records[entity.index].archetype;
+        }
+
+        // Adds the component, or assigns it when the entity already has one. Null when the entity is dead.
+        template<typename T, typename... Args>
+        T* Add(Entity entity, Args&&... args) {
+            if (!IsAlive(entity)) return nullptr;
+            const ComponentId id = GetComponentId<T>();
+            if (T* existing = Get<T>(entity)) {
+                *existing = T(std::forward<Args>(args)...);
+                return existing;
+            }
+            // Built before migrating, args may refer to components that are about to move
+            T value(std::forward<Args>(args)...);
+            const EntityLocation at = Migrate(entity, id, true);
+            return new (GetRecord(entity).archetype->GetComponent(at, id)) T(std::move(value));
+        }
+
+        template<typename T>
+        void Remove(Entity entity) {
+            const ComponentId id = GetComponentId<T>();
+            if (!IsAlive(entity) || !GetRecord(entity).archetype->Has(id)) return;
+            Migrate(entity, id, false);
+        }
+
+        template<typename T>
+        bool Has(Entity entity) const {
+            return IsAlive(entity) && GetRecord(entity).archetype->Has(GetComponentId<T>());
+        }
+
+        // Null when the entity is dead or lacks the component. The pointer is invalidated by structural changes.
+        template<typename T>
+        T* Get(Entity entity) const {
+            if (!IsAlive(entity)) return nullptr;
+            const Record& record = GetRecord(entity);
+            const ComponentId id = GetComponentId<T>();
+            if (!record.archetype->Has(id)) return nullptr;
+            return CAST<T*>(record.archetype->GetComponent({record.chunk, record.row}, id));
+        }
+
+        void Reserve(u32 entities);
+        void Clear();
+
+        // Archetypes are never destroyed, so the list only grows. Queries use its size to pick up new ones.
+        u32 GetArchetypeCount() const {
+            return CAST<u32>(_archetypes.size());
+        }
+        Archetype& GetArchetype(u32 index) const {
+            return *_archetypes[index];
+        }
+        u32 GetEntityCount() const {
+            return _entityCount;
+        }
+        WorldStats GetStats() const;
+
+    private:
+        struct Record {
+            Archetype* archetype {nullptr};  // Null when the slot is free
+            u32 chunk {0};
+            u32 row {0};
+            u32 generation {0};
+        };
+
+        Entity AllocateEntity();
+        Archetype* FindOrCreateArchetype(ComponentMask mask);
+        // Moves the entity to the archetype with component id added or removed. An added component is left
+        // unconstructed at the returned location.
+        EntityLocation Migrate(Entity entity, ComponentId id, bool add);
+        void SetLocation(Entity entity, Archetype* archetype, const EntityLocation& location);
+
+        const Record& GetRecord(Entity entity) const {
+            return _records[entity.index];
+        }
+
+        Core::PoolAllocator _chunkPool;
+        vector<unique_ptr<Archetype>> _archetypes;
+        unordered_map<ComponentMask, Archetype*> _archetypeByMask;
+        vector<Record> _records;
+        vector<u32> _freeRecords;
+        u32 _entityCount {0};
+    };
+
+    // Iterates every entity that has all of Ts, archetype by archetype and chunk by chunk. Declare read-only components
+    // as const. Matching archetypes are cached and only new archetypes are tested on later runs, so keep a query
+    // around instead of building one per frame.
+    template<typename... Ts>
+    class Query {
+    public:
+        static_assert(sizeof...(Ts) > 0, "Query needs at least one component");
+
+        explicit Query(World& world)
+            : _world(world), _mask(GetComponentMask<Ts...>()), _ids {GetComponentId<Ts>()...} {}
+
+        // fn(u32 count, const Entity* entities, Ts*... columns) once per chunk, for processing whole arrays at once
+        template<typename F>
+        void EachChunk(F&& fn) {
+            Refresh();
+            for (Archetype* archetype : _archetypes) {
+                for (u32 c = 0; c < archetype->GetChunkCount(); ++c) {
+                    RunChunk(*archetype, archetype->GetChunk(c), fn);
+                }
+            }
+        }
+
+        // fn(Ts&...) or fn(Entity, Ts&...) per entity
+        template<typename F>
+        void Each(F&& fn) {
+            EachChunk([&fn](u32 count, const Entity* entities, Ts*... columns) {
+                RunRows(fn, count, entities, columns...);
+            });
+        }
+
+        // Chunks are split across the job system, chunksPerJob at a time. Falls back to EachChunk when jobs is null.
+        // fn runs concurrently on different chunks, so it may only write the components it was handed.
+        template<typename F>
+        void ParallelEachChunk(Core::JobSystem* jobs, F&& fn, u32 chunksPerJob = 4) {
+            if (!jobs) {
+                EachChunk(fn);
+                return;
+            }
+
+            Refresh();
+            _chunkStarts.clear();
+            u32 total = 0;
+            for (Archetype* archetype : _archetypes) {
+                _chunkStarts.push_back(total);
+                total += archetype->GetChunkCount();
+            }
+
+            jobs->ParallelFor(total, chunksPerJob, [this, &fn](u32 begin, u32 end) {
+                // Archetype holding chunk begin, then walk forward
+                size_t a = std::upper_bound(_chunkStarts.begin(), _chunkStarts.end(), begin) - _chunkStarts.begin() - 1;
+                for (u32 global = begin; global < end; ++global) {
+                    while (a + 1 < _chunkStarts.size() && global >= _chunkStarts[a + 1]) {
+                        ++a;
+                    }
+                    Archetype& archetype = *_archetypes[a];
+                    RunChunk(archetype, archetype.GetChunk(global - _chunkStarts[a]), fn);
+                }
+            });
+        }
+
+        template<typename F>
+        void ParallelEach(Core::JobSystem* jobs, F&& fn, u32 chunksPerJob = 4) {
+            ParallelEachChunk(
+              jobs,
+              [&fn](u32 count, const Entity* entities, Ts*... columns) { RunRows(fn, count, entities, columns...); },
+              chunksPerJob);
+        }
+
+        // Number of matching entities
+        u32 GetCount() {
+            Refresh();
+            u32 count = 0;
+            for (const Archetype* archetype : _archetypes) {
+                count += archetype->GetEntityCount();
+            }
+            return count;
+        }
+
+    private:
+        void Refresh() {
+            const u32 archetypeCount = _world.GetArchetypeCount();
+            for (; _seenArchetypes < archetypeCount; ++_seenArchetypes) {
+                Archetype& archetype = _world.GetArchetype(_seenArchetypes);
+                if (archetype.Matches(_mask)) { _archetypes.push_back(&archetype); }
+            }
+        }
+
+        template<typename F>
+        void RunChunk(const Archetype& archetype, const Chunk& chunk, F& fn) const {
+            RunChunk(archetype, chunk, fn, std::index_sequence_for<Ts...> {});
+        }
+
+        template<typename F, size_t... I>
+        void RunChunk(const Archetype& archetype, const Chunk& chunk, F& fn, std::index_sequence<I...>) const {
+            fn(chunk.count, archetype.GetEntities(chunk), CAST<Ts*>(archetype.GetColumn(chunk, _ids[I]))...);
+        }
+
+        template<typename F>
+        static void RunRows(F& fn, u32 count, const Entity* entities, Ts*... columns) {
+            for (u32 i = 0; i < count; ++i) {
+                if constexpr (std::is_invocable_v<F&, Entity, Ts&...>) {
+                    fn(entities[i], columns[i]...);
+                } else {
+                    fn(columns[i]...);
+                }
+            }
+        }
+
+        World& _world;
+        ComponentMask _mask;
+        ComponentId _ids[sizeof...(Ts)];
+        vector<Archetype*> _archetypes;
+        vector<u32> _chunkStarts;
+        u32 _seenArchetypes {0};
+    };
+
+}  // namespace X::Scene
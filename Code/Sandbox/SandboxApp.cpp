@@ -10,7 +10,7 @@ namespace X {
     using namespace Core;
     using namespace Render;
 
-    SandboxApp::SandboxApp() : Application({"Sandbox"}) {}
+    SandboxApp::SandboxApp(const ApplicationConfig& config) : Application(config) {}
 
     void SandboxApp::Initialize() {
         Log::Info("Sandbox initialized");
@@ -10,7 +10,7 @@ namespace X {
 
     class SandboxApp : public Core::Application {
     public:
-        SandboxApp();
+        explicit SandboxApp(const Core::ApplicationConfig& config);
         virtual ~SandboxApp() = default;
 
         void Initialize() override;
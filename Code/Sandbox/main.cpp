@@ -5,19 +5,23 @@
 #include "Core/Log.hpp"
 
 namespace X::Core {
-    unique_ptr<Application> CreateApplication() {
-        return make_unique<SandboxApp>();
+    unique_ptr<Application> CreateApplication(const ApplicationConfig& config) {
+        return make_unique<SandboxApp>(config);
     }
 }  // namespace X::Core
 
-int main() {
+int main(int argc, char** argv) {
     using namespace X::Core;
 
     Log::Initialize();
     Log::Info("Starting sandbox");
 
+    ApplicationConfig config;
+    config.title = "Sandbox";
+    config       = Application::ParseCommandLine(argc, argv, config);
+
     try {
-        const auto app = CreateApplication();
+        const auto app = CreateApplication(config);
         if (app) {
             app->Run();
         } else {
@@ -25,7 +29,7 @@ int main() {
             return -1;
         }
     } catch (const std::exception& e) {
-        Log::Critical(e.what());
+        Log::Critical("{}", e.what());
         Log::Shutdown();
         return -1;
     }
@@ -0,0 +1,322 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+// Bakes the assets listed in a manifest into a single archive the engine maps at runtime. Meshes are simplified,
+// optimised and interleaved, textures decoded and mipmapped, so loading does no processing at all.
+//
+// Usage: AssetPacker <manifest> <output archive>
+//
+// Manifest lines, paths relative to the manifest, # starts a comment:
+//   mesh    <name> <file.obj> [split] [nolods] [lods=0.5,0.25,...]
+//   texture <name> <image file> [srgb] [nomips]
+//   shader  <name> <source file> <vertex|pixel|compute> [entry point]
+
+#include "Asset/ArchiveWriter.hpp"
+#include "Core/Log.hpp"
+
+#include <chrono>
+#include <filesystem>
+
+#if defined(ENGINE_HAS_STB)
+    #define STB_IMAGE_IMPLEMENTATION
+    #include <stb_image.h>
+#endif
+
+using namespace X;
+using namespace X::Core;
+
+namespace {
+    namespace fs = std::filesystem;
+
+    bool ReadText(const fs::path& path, str& text) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            Log::Error("Failed to open {}", path.string());
+            return false;
+        }
+        std::ostringstream stream;
+        stream << file.rdbuf();
+        text = stream.str();
+        return true;
+    }
+
+    // Positions, normals and texture coordinates of a Wavefront OBJ, with polygons fanned into triangles and a vertex
+    // per distinct position/uv/normal combination
+    bool LoadObj(const fs::path& path, Render::MeshData& data) {
+        str text;
+        if (!ReadText(path, text)) return false;
+
+        vector<Vec3> positions;
+        vector<Vec3> normals;
+        vector<Vec2> uvs;
+        unordered_map<u64, u32> vertices;
+        bool hasNormals = false;
+        bool hasUvs     = false;
+
+        // OBJ indices are 1-based and negative ones count back from the latest element
+        const auto resolve = [](i64 index, size_t count) -> i64 {
+            return index < 0 ? CAST<i64>(count) + index : index - 1;
+        };
+
+        std::istringstream lines(text);
+        str line;
+        u32 lineNumber = 0;
+        vector<u32> polygon;
+        while (std::getline(lines, line)) {
+            ++lineNumber;
+            std::istringstream tokens(line);
+            str type;
+            tokens >> type;
+            if (type == "v") {
+                Vec3& p = positions.emplace_back();
+                tokens >> p.x >> p.y >> p.z;
+            } else if (type == "vn") {
+                Vec3& n = normals.emplace_back();
+                tokens >> n.x >> n.y >> n.z;
+            } else if (type == "vt") {
+                Vec2& uv = uvs.emplace_back();
+                tokens >> uv.x >> uv.y;
+                // OBJ puts v = 0 at the bottom of the image
+                uv.y = 1.0f - uv.y;
+            } else if (type == "f") {
+                polygon.clear();
+                str corner;
+                while (tokens >> corner) {
+                    i64 indices[3] = {0, 0, 0};
+                    size_t start   = 0;
+                    for (u32 part = 0; part < 3 && start <= corner.size(); ++part) {
+                        const size_t slash = std::min(corner.find('/', start), corner.size());
+                        if (slash > start) { indices[part] = std::stoll(corner.substr(start, slash - start)); }
+                        start = slash + 1;
+                    }
+
+                    const i64 position = resolve(indices[0], positions.size());
+                    const i64 uv       = indices[1] != 0 ? resolve(indices[1], uvs.size()) : -1;
+                    const i64 normal   = indices[2] != 0 ? resolve(indices[2], normals.size()) : -1;
+                    if (position < 0 || position >= CAST<i64>(positions.size()) || uv >= CAST<i64>(uvs.size()) ||
+                        normal >= CAST<i64>(normals.size()) || position >= (1 << 21) || uv >= (1 << 21) ||
+                        normal >= (1 << 21)) {
+                        Log::Error("{}:{}: face corner {} is out of range", path.string(), lineNumber, corner);
+                        return false;
+                    }
+                    hasUvs     = hasUvs || uv >= 0;
+                    hasNormals = hasNormals || normal >= 0;
+
+                    const u64 key = CAST<u64>(position) | CAST<u64>(uv + 1) << 21 | CAST<u64>(normal + 1) << 42;
+                    auto [it, inserted] = vertices.try_emplace(key, CAST<u32>(data.positions.size()));
+                    if (inserted) {
+                        data.positions.push_back(positions[position]);
+                        data.uvs.push_back(uv >= 0 ? uvs[uv] : Vec2(0.0f));
+                        data.normals.push_back(normal >= 0 ? normals[normal] : Vec3(0.0f));
+                    }
+                    polygon.push_back(it->second);
+                }
+                for (size_t i = 2; i < polygon.size(); ++i) {
+                    data.indices.insert(data.indices.end(), {polygon[0], polygon[i - 1], polygon[i]});
+                }
+            }
+        }
+
+        if (!hasUvs) { data.uvs.clear(); }
+        if (!hasNormals) { data.normals.clear(); }
+        return true;
+    }
+
+    f32 ToLinear(u8 value) {
+        const f32 c = CAST<f32>(value) / 255.0f;
+        return c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+    }
+
+    u8 FromLinear(f32 value) {
+        const f32 c = value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+        return CAST<u8>(std::clamp(c, 0.0f, 1.0f) * 255.0f + 0.5f);
+    }
+
+    // Box-filtered RGBA8 mip chain down to 1x1, averaging colour in linear space for sRGB images. Alpha is always
+    // linear.
+    vector<vector<u8>> BuildMips(const u8* pixels, u32 width, u32 height, bool srgb, bool mips) {
+        vector<vector<u8>> levels;
+        levels.emplace_back(pixels, pixels + CAST<size_t>(width) * height * 4);
+        while (mips && (width > 1 || height > 1)) {
+            const u32 nextWidth      = std::max(width / 2, 1u);
+            const u32 nextHeight     = std::max(height / 2, 1u);
+            const vector<u8>& source = levels.back();
+            vector<u8> level(CAST<size_t>(nextWidth) * nextHeight * 4);
+            for (u32 y = 0; y < nextHeight; ++y) {
+                for (u32 x = 0; x < nextWidth; ++x) {
+                    for (u32 channel = 0; channel < 4; ++channel) {
+                        const bool linear = !srgb || channel == 3;
+                        f32 sum           = 0.0f;
+                        for (u32 sample = 0; sample < 4; ++sample) {
+                            const u32 sx   = std::min(x * 2 + (sample & 1), width - 1);
+                            const u32 sy   = std::min(y * 2 + (sample >> 1), height - 1);
+                            const u8 value = source[(CAST<size_t>(sy) * width + sx) * 4 + channel];
+                            sum += linear ? CAST<f32>(value) / 255.0f : ToLinear(value);
+                        }
+                        const f32 average = sum * 0.25f;
+                        level[(CAST<size_t>(y) * nextWidth + x) * 4 + channel] =
+                          linear ? CAST<u8>(average * 255.0f + 0.5f) : FromLinear(average);
+                    }
+                }
+            }
+            levels.push_back(std::move(level));
+            width  = nextWidth;
+            height = nextHeight;
+        }
+        return levels;
+    }
+
+    // RGBA8, whatever the source's channels
+    bool DecodeImage(const fs::path& path, vector<u8>& pixels, u32& width, u32& height) {
+#if defined(ENGINE_HAS_STB)
+        int w         = 0;
+        int h         = 0;
+        int channels  = 0;
+        stbi_uc* data = stbi_load(path.string().c_str(), &w, &h, &channels, 4);
+        if (!data) {
+            Log::Error("Failed to decode {}: {}", path.string(), stbi_failure_reason());
+            return false;
+        }
+        width  = CAST<u32>(w);
+        height = CAST<u32>(h);
+        pixels.assign(data, data + CAST<size_t>(width) * height * 4);
+        stbi_image_free(data);
+        return true;
+#else
+        Log::Error("Cannot decode {}, the packer was built without an image decoder (stb)", path.string());
+        return false;
+#endif
+    }
+
+    bool PackTexture(Asset::ArchiveWriter& writer, const str& name, const fs::path& path, bool srgb, bool mips) {
+        vector<u8> pixels;
+        u32 width  = 0;
+        u32 height = 0;
+        if (!DecodeImage(path, pixels, width, height)) return false;
+        const vector<vector<u8>> levels = BuildMips(pixels.data(), width, height, srgb, mips);
+
+        vector<Render::TextureSubresource> subresources;
+        u32 levelWidth = width;
+        for (const vector<u8>& level : levels) {
+            subresources.push_back({level.data(), level.size(), levelWidth * 4});
+            levelWidth = std::max(levelWidth / 2, 1u);
+        }
+
+        Render::TextureImage image;
+        image.layout.width     = width;
+        image.layout.height    = height;
+        image.layout.mipLevels = CAST<u32>(levels.size());
+        image.layout.format    = srgb ? Diligent::TEX_FORMAT_RGBA8_UNORM_SRGB : Diligent::TEX_FORMAT_RGBA8_UNORM;
+        image.subresources     = subresources.data();
+        image.subresourceCount = CAST<u32>(subresources.size());
+        return writer.AddTexture(name, image);
+    }
+
+    bool PackLine(Asset::ArchiveWriter& writer, const fs::path& root, const vector<str>& tokens) {
+        const str& type = tokens[0];
+        if (tokens.size() < 3) {
+            Log::Error("Expected '{} <name> <file> ...'", type);
+            return false;
+        }
+        const str& name      = tokens[1];
+        const fs::path path  = root / tokens[2];
+        const auto hasOption = [&](const char* option) {
+            return std::find(tokens.begin() + 3, tokens.end(), option) != tokens.end();
+        };
+
+        if (type == "mesh") {
+            Render::MeshData data;
+            if (!LoadObj(path, data)) return false;
+
+            Render::MeshDesc desc;
+            const bool split       = hasOption("split");
+            desc.name              = name.c_str();
+            desc.streams           = split ? Render::VertexStreams::Split : Render::VertexStreams::Interleaved;
+            desc.lodOptions.ratios = {0.5f, 0.25f, 0.125f};
+            if (hasOption("nolods")) { desc.lodOptions.ratios.clear(); }
+            for (size_t i = 3; i < tokens.size(); ++i) {
+                if (tokens[i].rfind("lods=", 0) != 0) continue;
+                desc.lodOptions.ratios.clear();
+                std::istringstream ratios(tokens[i].substr(5));
+                str ratio;
+                while (std::getline(ratios, ratio, ',')) {
+                    desc.lodOptions.ratios.push_back(std::stof(ratio));
+                }
+            }
+
+            Render::PackedMesh packed;
+            return Render::Mesh::Pack(data, desc, packed) && writer.AddMesh(name, packed);
+        }
+        if (type == "texture") { return PackTexture(writer, name, path, hasOption("srgb"), !hasOption("nomips")); }
+        if (type == "shader") {
+            static const unordered_map<str, Diligent::SHADER_TYPE> stages = {
+              {"vertex", Diligent::SHADER_TYPE_VERTEX},
+              {"pixel", Diligent::SHADER_TYPE_PIXEL},
+              {"compute", Diligent::SHADER_TYPE_COMPUTE},
+            };
+            const auto stage = tokens.size() > 3 ? stages.find(tokens[3]) : stages.end();
+            if (stage == stages.end()) {
+                Log::Error("Shader {} needs a stage: vertex, pixel or compute", name);
+                return false;
+            }
+            str source;
+            if (!ReadText(path, source)) return false;
+            return writer.AddShader(name, stage->second, source, tokens.size() > 4 ? tokens[4] : "main");
+        }
+
+        Log::Error("Unknown asset type '{}'", type);
+        return false;
+    }
+}  // namespace
+
+int main(int argc, char** argv) {
+    Log::Initialize();
+    if (argc != 3) {
+        Log::Error("Usage: AssetPacker <manifest> <output archive>");
+        Log::Shutdown();
+        return 1;
+    }
+
+    const auto start        = std::chrono::steady_clock::now();
+    const fs::path manifest = argv[1];
+    str text;
+    if (!ReadText(manifest, text)) {
+        Log::Shutdown();
+        return 1;
+    }
+
+    Asset::ArchiveWriter writer;
+    std::istringstream lines(text);
+    str line;
+    u32 lineNumber = 0;
+    u32 failures   = 0;
+    while (std::getline(lines, line)) {
+        ++lineNumber;
+        line = line.substr(0, line.find('#'));
+
+        vector<str> tokens;
+        std::istringstream stream(line);
+        for (str token; stream >> token;) {
+            tokens.push_back(token);
+        }
+        if (tokens.empty()) continue;
+
+        if (!PackLine(writer, manifest.parent_path(), tokens)) {
+            Log::Error("{}:{}: failed to pack '{}'", manifest.string(), lineNumber, line);
+            ++failures;
+        }
+    }
+
+    // A partial archive would only fail later at runtime, so nothing is written unless every asset packed
+    const bool written = failures == 0 && writer.Write(argv[2]);
+    if (written) {
+        const f64 seconds = std::chrono::duration<f64>(std::chrono::steady_clock::now() - start).count();
+        Log::Info("Packed {} assets in {:.2f} s", writer.GetAssetCount(), seconds);
+    } else if (failures > 0) {
+        Log::Error("{} assets failed to pack, {} was not written", failures, argv[2]);
+    }
+
+    Log::Shutdown();
+    return written ? 0 : 1;
+}